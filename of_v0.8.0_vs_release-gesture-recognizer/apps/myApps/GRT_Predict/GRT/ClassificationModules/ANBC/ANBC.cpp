@@ -49,6 +49,9 @@ ANBC& ANBC::operator=(const ANBC &rhs){
         this->weightsDataSet = rhs.weightsDataSet;
         this->weightsData = rhs.weightsData;
 		this->models = rhs.models;
+        this->predictionMu = rhs.predictionMu;
+        this->predictionInvVariance = rhs.predictionInvVariance;
+        this->predictionConstants = rhs.predictionConstants;
         
         //Classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -66,6 +69,9 @@ bool ANBC::clone(const Classifier *classifier){
         this->weightsDataSet = ptr->weightsDataSet;
         this->weightsData = ptr->weightsData;
 		this->models = ptr->models;
+        this->predictionMu = ptr->predictionMu;
+        this->predictionInvVariance = ptr->predictionInvVariance;
+        this->predictionConstants = ptr->predictionConstants;
         
         //Clone the classifier variables
         return copyBaseVariables( classifier );
@@ -78,10 +84,53 @@ bool ANBC::train(LabelledClassificationData &trainingData){
     return train(trainingData,nullRejectionCoeff);
 }
 
+bool ANBC::update(LabelledClassificationSample &sample){
+    
+    if( !trained ){
+        errorLog << "update(LabelledClassificationSample &sample) - ANBC Model Not Trained!" << endl;
+        return false;
+    }
+    
+    if( sample.getNumDimensions() != numFeatures ){
+        errorLog << "update(LabelledClassificationSample &sample) - The size of the sample (" << sample.getNumDimensions() << ") does not match the num features in the model (" << numFeatures << ")" << endl;
+        return false;
+    }
+    
+    UINT classIndex = numClasses;
+    for(UINT k=0; k<numClasses; k++){
+        if( models[k].classLabel == sample.getClassLabel() ){
+            classIndex = k;
+            break;
+        }
+    }
+    
+    if( classIndex == numClasses ){
+        errorLog << "update(LabelledClassificationSample &sample) - There is no model for class " << sample.getClassLabel() << ", the model needs to be retrained to add a new class!" << endl;
+        return false;
+    }
+    
+    VectorDouble x = sample.getSample();
+    if( useScaling ){
+        for(UINT n=0; n<numFeatures; n++){
+            x[n] = scale(x[n], ranges[n].minValue, ranges[n].maxValue, MIN_SCALE_VALUE, MAX_SCALE_VALUE);
+        }
+    }
+    
+    if( !models[classIndex].update( x ) ){
+        errorLog << "update(LabelledClassificationSample &sample) - Failed to update the model for class " << sample.getClassLabel() << ". The number of training samples of this class is not known, so the model needs to be retrained!" << endl;
+        return false;
+    }
+    
+    nullRejectionThresholds[ classIndex ] = models[ classIndex ].threshold;
+    
+    //Only the updated class has changed, but rebuilding the whole prediction model is cheap
+    return buildPredictionModel();
+}
+
 /* double predict(vVectorDouble x)
  This method returns the ID of the most likely class given the observation x and the trained models
  */
-bool ANBC::predict(VectorDouble inputVector){
+bool ANBC::predict_(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - ANBC Model Not Trained!" << endl;
@@ -107,10 +156,17 @@ bool ANBC::predict(VectorDouble inputVector){
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
     
+    //Compute the log likelihood of every class in one pass over the input features
+    for(UINT k=0; k<numClasses; k++){
+        classDistances[k] = predictionConstants[k];
+    }
+    for(UINT j=0; j<numFeatures; j++){
+        SIMD::subtractWeightedSquaredError(inputVector[j], &predictionMu[j*numClasses], &predictionInvVariance[j*numClasses], &classDistances[0], numClasses);
+    }
+    
     double classLikelihoodsSum = 0;
     double minDist = -99e+99;
 	for(UINT k=0; k<numClasses; k++){
-		classDistances[k] = models[k].predict( inputVector );
         
         //At this point the class likelihoods and class distances are the same thing
         classLikelihoods[k] = classDistances[k];
@@ -245,11 +301,50 @@ bool ANBC::train(LabelledClassificationData &labelledTrainingData,double gamma){
         nullRejectionThresholds[k] = models[k].threshold;
     }
     
+    //Build the prediction model
+    if( !buildPredictionModel() ){
+        errorLog << "train(LabelledClassificationData &labelledTrainingData,double gamma) - Failed to build the prediction model!" << endl;
+        models.clear();
+        return false;
+    }
+    
     //Flag that the models have been trained
     trained = true;
     return trained;
     
 }
+    
+bool ANBC::buildPredictionModel(){
+    
+    if( models.size() != numClasses ) return false;
+    
+    predictionMu.resize(numFeatures*numClasses);
+    predictionInvVariance.resize(numFeatures*numClasses);
+    predictionConstants.resize(numClasses);
+    
+    //The log of the weighted gaussian is log(w) - log(sigma*sqrt(2*PI)) - (x-mu)^2/(2*sigma^2), so everything except the
+    //last term can be computed once here
+    const double logSqrtTwoPI = 0.5*log( TWO_PI );
+    for(UINT k=0; k<numClasses; k++){
+        if( models[k].N != numFeatures || models[k].mu.size() != numFeatures || models[k].sigma.size() != numFeatures || models[k].weights.size() != numFeatures ){
+            return false;
+        }
+        predictionConstants[k] = 0;
+        for(UINT j=0; j<numFeatures; j++){
+            const UINT index = j*numClasses + k;
+            if( models[k].weights[j] > 0 ){
+                predictionMu[index] = models[k].mu[j];
+                predictionInvVariance[index] = 1.0 / ( 2.0 * models[k].sigma[j] * models[k].sigma[j] );
+                predictionConstants[k] += log( models[k].weights[j] ) - log( models[k].sigma[j] ) - logSqrtTwoPI;
+            }else{
+                predictionMu[index] = 0;
+                predictionInvVariance[index] = 0;
+            }
+        }
+    }
+    
+    return true;
+}
 
 bool ANBC::recomputeNullRejectionThresholds(){
 
@@ -334,6 +429,7 @@ bool ANBC::saveModelToFile(fstream &file){
 		file<<"Gamma: "<<models[k].gamma<<endl;
 		file<<"TrainingMu: "<<models[k].trainingMu<<endl;
 		file<<"TrainingSigma: "<<models[k].trainingSigma<<endl;
+		file<<"NumTrainingSamples: "<<models[k].numTrainingSamples<<endl;
 		
 		file<<"Mu:\n";
 		for(UINT j=0; j<models[k].N; j++){
@@ -511,8 +607,14 @@ bool ANBC::loadModelFromFile(fstream &file){
         models[k].sigma.resize(numFeatures);
         models[k].weights.resize(numFeatures);
         
-        //Load Mu, Sigma and Weights
+        //The number of training samples is optional, as older model files do not contain it
         file >> word;
+        if(word == "NumTrainingSamples:"){
+            file >> models[k].numTrainingSamples;
+            file >> word;
+        }else models[k].numTrainingSamples = 0;
+        
+        //Load Mu, Sigma and Weights
         if(word != "Mu:"){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the Mu vector for the "<<k+1<<"th model" << endl;
             return false;
@@ -558,6 +660,12 @@ bool ANBC::loadModelFromFile(fstream &file){
         }
     }
     
+    //Build the prediction model
+    if( !buildPredictionModel() ){
+        errorLog << "loadANBCModelFromFile(string filename) - Failed to build the prediction model" << endl;
+        return false;
+    }
+    
     //Flag that the model is trained
     trained = true;
     
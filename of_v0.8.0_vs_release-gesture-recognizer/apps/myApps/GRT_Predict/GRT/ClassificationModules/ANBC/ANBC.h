@@ -89,14 +89,26 @@ public:
     */
     virtual bool train(LabelledClassificationData &trainingData);
     
+    /**
+     This updates the model of the sample's class with a new training sample, without retraining the other classes.
+     The mean and standard deviation of each feature, and the training mu and sigma used for the null rejection threshold, are
+     updated with Welford's algorithm. The class must already be in the model, and the model must have been trained (or loaded
+     from a file that records the number of training samples of each class).
+     This overrides the update function in the MLBase base class.
+     
+     @param LabelledClassificationSample &sample: a reference to the new training sample
+     @return returns true if the ANBC model was updated, false otherwise
+    */
+    virtual bool update(LabelledClassificationSample &sample);
+    
     /**
      This predicts the class of the inputVector.
-     This overrides the predict function in the Classifier base class.
+     This overrides the predict_ function in the Classifier base class.
      
-     @param VectorDouble inputVector: the input vector to classify
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
      @return returns true if the prediction was performed, false otherwise
     */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
     
     /**
      This saves the trained ANBC model to a file.
@@ -200,9 +212,20 @@ public:
     bool clearWeights(){ weightsDataSet = false; weightsData.clear(); return true; }
 
 private:
+    /**
+     Builds the structure-of-arrays copy of the class models that is used by the predict function.
+     This is called automatically at the end of the training phase and after a model has been loaded from a file.
+     
+     @return returns true if the prediction model was built, false otherwise
+     */
+    bool buildPredictionModel();
+    
     bool weightsDataSet;                  //A flag to indicate if the user has manually set the weights buffer
     LabelledClassificationData weightsData; //The weights of each feature for each class for training the algorithm
 	vector< ANBC_Model > models;            //A buffer to hold all the models
+    VectorDouble predictionMu;              //The mean of each feature for each class, stored as [numFeatures numClasses] so all the classes can be evaluated together
+    VectorDouble predictionInvVariance;     //1/(2*sigma^2) for each feature and class, this is zero if the feature has no weight for that class
+    VectorDouble predictionConstants;       //The log normalisation and log weight terms for each class, these only depend on the trained model
     
     static RegisterClassifierModule< ANBC > registerModule;
 };
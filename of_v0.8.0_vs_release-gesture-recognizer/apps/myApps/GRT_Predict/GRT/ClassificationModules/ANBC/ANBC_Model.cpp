@@ -33,6 +33,7 @@ bool ANBC_Model::train(UINT classLabel,MatrixDouble &trainingData,VectorDouble &
 	UINT M = trainingData.getNumRows();
 	N = trainingData.getNumCols();
     this->classLabel = classLabel;
+    numTrainingSamples = M;
 
 	//Update the weights buffer
 	weights = weightsVector;
@@ -104,6 +105,33 @@ bool ANBC_Model::train(UINT classLabel,MatrixDouble &trainingData,VectorDouble &
 	return true;
 }
 
+bool ANBC_Model::update(const VectorDouble &x){
+    
+    //The running sums of squares can only be recovered from the sample standard deviations if there are at least 2 samples
+    if( x.size() != N || numTrainingSamples < 2 ){
+        return false;
+    }
+    
+    //Welford's update of the mean and sample standard deviation of each dimension
+    const double M = numTrainingSamples;
+    for(UINT j=0; j<N; j++){
+        const double delta = x[j] - mu[j];
+        mu[j] += delta / (M+1);
+        sigma[j] = sqrt( ( SQR(sigma[j]) * (M-1) + delta * (x[j] - mu[j]) ) / M );
+    }
+    
+    //Fold the likelihood of the new sample into the training mu and sigma. The likelihoods of the previous samples are not
+    //recomputed with the updated model, so the threshold will drift slightly from the value a full retrain would give
+    const double prediction = predict( x );
+    const double delta = prediction - trainingMu;
+    trainingMu += delta / (M+1);
+    trainingSigma = sqrt( ( SQR(trainingSigma) * (M-1) + delta * (prediction - trainingMu) ) / M );
+    threshold = trainingMu-(trainingSigma*gamma);
+    numTrainingSamples++;
+    
+    return true;
+}
+
 double ANBC_Model::predict(const VectorDouble &x){
 	double prediction = 0.0;
 	for(UINT j=0; j<N; j++){
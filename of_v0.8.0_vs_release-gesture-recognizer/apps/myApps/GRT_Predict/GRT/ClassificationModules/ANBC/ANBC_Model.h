@@ -27,10 +27,11 @@ namespace GRT{
 
 class ANBC_Model{
 public:
-	ANBC_Model(void){ N=0; classLabel = 0; gamma=2.0; threshold=0.0; trainingMu=0.0; trainingSigma=0.0;};
+	ANBC_Model(void){ N=0; classLabel = 0; numTrainingSamples = 0; gamma=2.0; threshold=0.0; trainingMu=0.0; trainingSigma=0.0;};
 	~ANBC_Model(void){};
 
 	bool train(UINT classLabel,MatrixDouble &trainingData,VectorDouble &weightsVector);
+	bool update(const VectorDouble &x);
 	double predict(const VectorDouble &observation);
 	double predictUnnormed(const VectorDouble &x);
 	inline double gauss(const double x,const double mu,const double sigma);
@@ -42,6 +43,7 @@ public:
     
 	UINT	N;					//The number of dimensions in the problem
     UINT classLabel;            //The label of the class this model represents
+    UINT numTrainingSamples;    //The number of samples the model was trained with, this is zero if it is not known
 	double threshold;			//The classification threshold value
 	double gamma;				//The number of standard deviations to use for the threshold
 	double trainingMu;			//The average confidence value in the training data
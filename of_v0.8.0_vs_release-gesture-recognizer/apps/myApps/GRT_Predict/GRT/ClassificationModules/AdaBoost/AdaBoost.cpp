@@ -58,6 +58,7 @@ AdaBoost& AdaBoost::operator=(const AdaBoost &rhs){
         if( rhs.weakClassifiers.size() > 0 ){
             for(UINT i=0; i<rhs.weakClassifiers.size(); i++){
                 WeakClassifier *weakClassiferPtr = rhs.weakClassifiers[i]->createNewInstance();
+                weakClassiferPtr->clone( rhs.weakClassifiers[i] );
                 weakClassifiers.push_back( weakClassiferPtr );
             }
         }
@@ -85,6 +86,7 @@ bool AdaBoost::clone(const Classifier *classifier){
         if( ptr->weakClassifiers.size() > 0 ){
             for(UINT i=0; i<ptr->weakClassifiers.size(); i++){
                 WeakClassifier *weakClassiferPtr = ptr->weakClassifiers[i]->createNewInstance();
+                weakClassiferPtr->clone( ptr->weakClassifiers[i] );
                 weakClassifiers.push_back( weakClassiferPtr );
             }
         }
@@ -124,6 +126,14 @@ bool AdaBoost::train(LabelledClassificationData &trainingData){
     //Create the error matrix
     MatrixDouble errorMatrix(K,M);
     
+    //Sort each feature once, the order is the same for every class and every boosting iteration (the scaling does not change
+    //the order), so weak classifiers that can use it do not need to search the data again each time they are trained
+    vector< vector< UINT > > sortedFeatureIndexs;
+    WeakClassifier::sortFeatureIndexs(trainingData,sortedFeatureIndexs);
+    for(UINT k=0; k<K; k++){
+        weakClassifiers[k]->setSortedFeatureIndexs( sortedFeatureIndexs );
+    }
+    
     for(UINT classIter=0; classIter<numClasses; classIter++){
         
         //Get the class label for the current class
@@ -166,6 +176,7 @@ bool AdaBoost::train(LabelledClassificationData &trainingData){
                 //Train the current classifier
                 if( !weakLearner->train(classData,weights) ){
                     errorLog << "Failed to train weakLearner!" << endl;
+                    for(UINT j=0; j<K; j++) weakClassifiers[j]->setSortedFeatureIndexs( vector< vector< UINT > >() );
                     return false;
                 }
                 
@@ -245,6 +256,11 @@ bool AdaBoost::train(LabelledClassificationData &trainingData){
         }
     }
     
+    //The sorted order is only valid for this training data, so clear it from the weak classifiers
+    for(UINT k=0; k<K; k++){
+        weakClassifiers[k]->setSortedFeatureIndexs( vector< vector< UINT > >() );
+    }
+    
     //Normalize the weights
     for(UINT k=0; k<numClasses; k++){
         models[k].normalizeWeights();
@@ -255,7 +271,7 @@ bool AdaBoost::train(LabelledClassificationData &trainingData){
     return true;
 }
 
-bool AdaBoost::predict(VectorDouble inputVector){
+bool AdaBoost::predict_(VectorDouble &inputVector){
     
     predictedClassLabel = 0;
 	maxLikelihood = -10000;
@@ -558,7 +574,9 @@ bool AdaBoost::setWeakClassifier(const WeakClassifier &weakClassifer){
     //Clear any previous weak classifers
     clearWeakClassifiers();
     
+    //Deep copy the weak classifier so any parameters it has (such as the DecisionStump training mode) are kept
     WeakClassifier *weakClassiferPtr = weakClassifer.createNewInstance();
+    weakClassiferPtr->clone( &weakClassifer );
     
     weakClassifiers.push_back( weakClassiferPtr );
     
@@ -568,6 +586,7 @@ bool AdaBoost::setWeakClassifier(const WeakClassifier &weakClassifer){
 bool AdaBoost::addWeakClassifier(const WeakClassifier &weakClassifer){
     
     WeakClassifier *weakClassiferPtr = weakClassifer.createNewInstance();
+    weakClassiferPtr->clone( &weakClassifer );
     weakClassifiers.push_back( weakClassiferPtr );
     
     return true;
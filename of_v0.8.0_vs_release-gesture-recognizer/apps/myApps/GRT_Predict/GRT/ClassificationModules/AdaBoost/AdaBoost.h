@@ -100,12 +100,12 @@ public:
     
     /**
      This predicts the class of the inputVector.
-     This overrides the predict function in the Classifier base class.
+     This overrides the predict_ function in the Classifier base class.
      
-     @param VectorDouble inputVector: the input vector to classify
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
      @return returns true if the prediction was performed, false otherwise
      */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
     
     /**
      This saves the trained AdaBoost model to a file.
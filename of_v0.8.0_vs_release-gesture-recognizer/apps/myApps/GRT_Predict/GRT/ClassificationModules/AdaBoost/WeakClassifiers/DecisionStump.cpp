@@ -32,8 +32,9 @@ namespace GRT{
 //Register the DecisionStump module with the WeakClassifier base class
 RegisterWeakClassifierModule< DecisionStump > DecisionStump::registerModule("DecisionStump");
     
-DecisionStump::DecisionStump(UINT numSteps){
+DecisionStump::DecisionStump(UINT numSteps,UINT trainingMode){
     this->numSteps = numSteps;
+    this->trainingMode = trainingMode;
     trained = false;
     numInputDimensions = 0;
     decisionFeatureIndex = 0;
@@ -59,6 +60,7 @@ DecisionStump& DecisionStump::operator=(const DecisionStump &rhs){
         this->decisionValue = rhs.decisionValue;
         this->direction = rhs.direction;
         this->numSteps = rhs.numSteps;
+        this->trainingMode = rhs.trainingMode;
         this->copyBaseVariables( &rhs );
     }
     return *this;
@@ -91,6 +93,14 @@ bool DecisionStump::train(LabelledClassificationData &trainingData, VectorDouble
         return false;
     }
     
+    if( trainingMode == PRESORTED_TRAINING ){
+        return trainPresorted(trainingData,weights);
+    }
+    return trainGridSearch(trainingData,weights);
+}
+    
+bool DecisionStump::trainGridSearch(LabelledClassificationData &trainingData, VectorDouble &weights){
+    
     //Pick the training sample to use as the stump feature
     const UINT M = trainingData.getNumSamples();
     UINT bestFeatureIndex = 0;
@@ -148,6 +158,98 @@ bool DecisionStump::train(LabelledClassificationData &trainingData, VectorDouble
     return true;
 }
 
+bool DecisionStump::trainPresorted(LabelledClassificationData &trainingData, VectorDouble &weights){
+    
+    const UINT M = trainingData.getNumSamples();
+    const UINT N = numInputDimensions;
+    
+    //Use the sorted order set by AdaBoost if it matches the training data, otherwise sort the data now
+    bool sortedOrderValid = sortedFeatureIndexs.size() == N;
+    for(UINT n=0; n<sortedFeatureIndexs.size() && sortedOrderValid; n++){
+        if( sortedFeatureIndexs[n].size() != M ) sortedOrderValid = false;
+    }
+    vector< vector< UINT > > localSortedFeatureIndexs;
+    if( !sortedOrderValid ){
+        if( !sortFeatureIndexs(trainingData,localSortedFeatureIndexs) ){
+            errorLog << "trainPresorted(LabelledClassificationData &trainingData, VectorDouble &weights) - Failed to sort the training data!" << endl;
+            return false;
+        }
+    }
+    const vector< vector< UINT > > &sortedIndexs = sortedOrderValid ? sortedFeatureIndexs : localSortedFeatureIndexs;
+    
+    //Get the total weight of each class
+    vector< bool > positiveClass( M );
+    double positiveWeight = 0;
+    double negativeWeight = 0;
+    for(UINT i=0; i<M; i++){
+        positiveClass[i] = trainingData[ i ].getClassLabel() == WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL;
+        if( positiveClass[i] ) positiveWeight += weights[i];
+        else negativeWeight += weights[i];
+    }
+    
+    //Find the best threshold for each feature with a single pass through the sorted values. After the first p+1 sorted samples,
+    //putting the threshold between sample p and p+1 gives:
+    //  rhsError = (positive weight on the left) + (negative weight on the right)
+    //  lhsError = (negative weight on the left) + (positive weight on the right)
+    //The features are independent so they are searched in parallel, although this is only worth it for larger datasets
+    VectorDouble featureErrors( N );
+    VectorDouble featureThresholds( N );
+    vector< UINT > featureDirections( N );
+    const UINT numWorkers = M*N >= 10000 ? Parallel::getNumWorkers( N ) : 1;
+    
+    Parallel::forEach(N,numWorkers,[&](UINT workerIndex,UINT n){
+        const vector< UINT > &order = sortedIndexs[n];
+        
+        //Start with the threshold at the minimum value, with the rhs direction this classifies everything as positive
+        double minError = negativeWeight;
+        double bestThreshold = trainingData[ order[0] ][ n ];
+        UINT bestDirection = 1;
+        
+        double positiveWeightLeft = 0;
+        double negativeWeightLeft = 0;
+        for(UINT p=0; p+1<M; p++){
+            const UINT i = order[p];
+            if( positiveClass[i] ) positiveWeightLeft += weights[i];
+            else negativeWeightLeft += weights[i];
+            
+            //We can only split between two different values
+            const double value = trainingData[ i ][ n ];
+            const double nextValue = trainingData[ order[p+1] ][ n ];
+            if( value == nextValue ) continue;
+            
+            const double rhsError = positiveWeightLeft + (negativeWeight - negativeWeightLeft);
+            const double lhsError = negativeWeightLeft + (positiveWeight - positiveWeightLeft);
+            if( rhsError < minError ){
+                minError = rhsError;
+                bestThreshold = value + (nextValue-value)*0.5;
+                bestDirection = 1; //1 means rhs
+            }
+            if( lhsError < minError ){
+                minError = lhsError;
+                bestThreshold = value + (nextValue-value)*0.5;
+                bestDirection = 0; //0 means lhs
+            }
+        }
+        
+        featureErrors[n] = minError;
+        featureThresholds[n] = bestThreshold;
+        featureDirections[n] = bestDirection;
+    });
+    
+    //Pick the feature with the minimum error, the features are checked in order so ties go to the lowest feature index
+    UINT bestFeatureIndex = 0;
+    for(UINT n=1; n<N; n++){
+        if( featureErrors[n] < featureErrors[bestFeatureIndex] ) bestFeatureIndex = n;
+    }
+    
+    decisionFeatureIndex = bestFeatureIndex;
+    decisionValue = featureThresholds[ bestFeatureIndex ];
+    direction = featureDirections[ bestFeatureIndex ];
+    trained = true;
+    
+    return true;
+}
+
 double DecisionStump::predict(const VectorDouble &x){
     if( direction == 1){
         if( x[ decisionFeatureIndex ] >= decisionValue ) return 1;
@@ -155,6 +257,11 @@ double DecisionStump::predict(const VectorDouble &x){
     return -1;
 }
     
+bool DecisionStump::setSortedFeatureIndexs(const vector< vector< UINT > > &sortedFeatureIndexs){
+    this->sortedFeatureIndexs = sortedFeatureIndexs;
+    return trainingMode == PRESORTED_TRAINING;
+}
+    
 bool DecisionStump::saveModelToFile(fstream &file){
     
     if(!file.is_open())
@@ -265,9 +372,22 @@ UINT DecisionStump::getNumSteps(){
     return numSteps;
 }
 
+UINT DecisionStump::getTrainingMode(){
+    return trainingMode;
+}
+
 double DecisionStump::getDecisionValue(){
     return decisionValue;
 }
+    
+bool DecisionStump::setTrainingMode(UINT trainingMode){
+    if( trainingMode != GRID_SEARCH_TRAINING && trainingMode != PRESORTED_TRAINING ){
+        errorLog << "setTrainingMode(UINT trainingMode) - Unknown training mode: " << trainingMode << endl;
+        return false;
+    }
+    this->trainingMode = trainingMode;
+    return true;
+}
 
 } //End of namespace GRT
 
@@ -34,7 +34,13 @@ namespace GRT{
     
 class DecisionStump : public WeakClassifier{
 public:
-    DecisionStump(UINT numSteps=100);
+    /**
+     Default Constructor
+     
+     @param UINT numSteps: the number of candidate thresholds that are tested for each feature when the GRID_SEARCH_TRAINING mode is used. Default value = 100
+     @param UINT trainingMode: sets how the threshold is found, this should be one of the TrainingModes. Default value = PRESORTED_TRAINING
+     */
+    DecisionStump(UINT numSteps=100,UINT trainingMode=PRESORTED_TRAINING);
     
     virtual ~DecisionStump();
     
@@ -48,6 +54,8 @@ public:
     
     virtual double predict(const VectorDouble &x);
     
+    virtual bool setSortedFeatureIndexs(const vector< vector< UINT > > &sortedFeatureIndexs);
+    
     virtual bool saveModelToFile(fstream &file);
     
     virtual bool loadModelFromFile(fstream &file);
@@ -60,12 +68,35 @@ public:
     
     UINT getNumSteps();
     
+    UINT getTrainingMode();
+    
     double getDecisionValue();
+    
+    /**
+     Sets the training mode, this should be one of the TrainingModes.
+     
+     @param UINT trainingMode: the new training mode
+     @return returns true if the training mode was updated, false otherwise
+     */
+    bool setTrainingMode(UINT trainingMode);
+    
+    /**
+     These are the two ways the DecisionStump can search for the best threshold. GRID_SEARCH_TRAINING tests numSteps evenly spaced
+     thresholds for each feature, which costs O(numSteps*M) per feature. PRESORTED_TRAINING walks through each feature in sorted order
+     once and tests every point between two different values, which costs O(M) per feature and finds the exact best threshold.
+     */
+    enum TrainingModes{GRID_SEARCH_TRAINING=0,PRESORTED_TRAINING};
+    
 protected:
+    bool trainGridSearch(LabelledClassificationData &trainingData, VectorDouble &weights);
+    bool trainPresorted(LabelledClassificationData &trainingData, VectorDouble &weights);
+    
     UINT decisionFeatureIndex;
     UINT direction;
     UINT numSteps;
+    UINT trainingMode;
     double decisionValue;
+    vector< vector< UINT > > sortedFeatureIndexs;  //The sorted sample indexs for each feature of the current training data, these are not copied with the model
     
     static RegisterWeakClassifierModule< DecisionStump > registerModule;
 };
@@ -30,7 +30,12 @@
 namespace GRT{
     
 WeakClassifier::StringWeakClassifierMap* WeakClassifier::stringWeakClassifierMap = NULL;
-UINT WeakClassifier::numWeakClassifierInstances = 0;
+//The instance counter is a function static so it is ready before the first module is registered, and it is atomic as
+//instances can be created and deleted by several training threads at the same time
+std::atomic< UINT >& WeakClassifier::getNumWeakClassifierInstances(){
+    static std::atomic< UINT > numWeakClassifierInstances( 0 );
+    return numWeakClassifierInstances;
+}
 
 WeakClassifier* WeakClassifier::createInstanceFromString(string const &weakClassifierType){
     
@@ -45,11 +50,11 @@ WeakClassifier::WeakClassifier(){
     weakClassifierType = "";
     trained = false;
     numInputDimensions = 0;
-    numWeakClassifierInstances++;
+    getNumWeakClassifierInstances()++;
 }
     
 WeakClassifier::~WeakClassifier(){
-    if( --numWeakClassifierInstances == 0 ){
+    if( --getNumWeakClassifierInstances() == 0 ){
         delete stringWeakClassifierMap;
         stringWeakClassifierMap = NULL;
     }
@@ -58,6 +63,32 @@ WeakClassifier::~WeakClassifier(){
 WeakClassifier* WeakClassifier::createNewInstance() const{
     return createInstanceFromString( weakClassifierType );
 }
+    
+bool WeakClassifier::sortFeatureIndexs(LabelledClassificationData &trainingData,vector< vector< UINT > > &sortedFeatureIndexs){
+    
+    const UINT M = trainingData.getNumSamples();
+    const UINT N = trainingData.getNumDimensions();
+    
+    sortedFeatureIndexs.clear();
+    if( M == 0 || N == 0 ) return false;
+    
+    sortedFeatureIndexs.resize( N );
+    Parallel::forEach(N,[&](UINT workerIndex,UINT n){
+        vector< IndexedDouble > column( M );
+        for(UINT i=0; i<M; i++){
+            column[i].index = i;
+            column[i].value = trainingData[i][n];
+        }
+        sort(column.begin(),column.end(),IndexedDouble::sortIndexedDoubleByValueAscending);
+        
+        sortedFeatureIndexs[n].resize( M );
+        for(UINT i=0; i<M; i++){
+            sortedFeatureIndexs[n][i] = column[i].index;
+        }
+    });
+    
+    return true;
+}
 
 } //End of namespace GRT
 
@@ -77,6 +77,20 @@ public:
         return 0;
     }
     
+    /**
+     Sets the sorted order of each feature of the training data that will be passed to the train function, this can be computed
+     with the sortFeatureIndexs function. Weak classifiers that search for a threshold on a single feature (such as the DecisionStump)
+     can then use the same sorted order for every boosting iteration, rather than searching the data again each time they are trained.
+     Weak classifiers that can not use the sorted order will ignore it. Pass in an empty vector to clear the sorted order once training
+     has finished.
+     
+     @param const vector< vector< UINT > > &sortedFeatureIndexs: the sample indexs of the training data, sorted in ascending order for each feature
+     @return returns true if the weak classifier will use the sorted order, false otherwise
+     */
+    virtual bool setSortedFeatureIndexs(const vector< vector< UINT > > &sortedFeatureIndexs){
+        return false;
+    }
+    
     virtual bool saveModelToFile(fstream &file){ return false; }
     virtual bool loadModelFromFile(fstream &file){ return false; }
     
@@ -117,6 +131,16 @@ public:
      */
     WeakClassifier* createNewInstance() const;
     
+    /**
+     Sorts the sample indexs of the training data in ascending order for each feature, so sortedFeatureIndexs[n][0] will be the index
+     of the sample with the smallest value for feature n. The features are sorted in parallel.
+     
+     @param LabelledClassificationData &trainingData: the training data to sort
+     @param vector< vector< UINT > > &sortedFeatureIndexs: the sorted indexs, this will have one row per feature
+     @return returns true if the data was sorted, false otherwise
+     */
+    static bool sortFeatureIndexs(LabelledClassificationData &trainingData,vector< vector< UINT > > &sortedFeatureIndexs);
+    
 protected:
     string weakClassifierType;
     bool trained;
@@ -133,7 +157,7 @@ protected:
     
 private:
     static StringWeakClassifierMap *stringWeakClassifierMap;
-    static UINT numWeakClassifierInstances;
+    static std::atomic< UINT >& getNumWeakClassifierInstances();
 };
     
 //These two functions/classes are used to register any new WeakClassification Module with the WeakClassifier base class
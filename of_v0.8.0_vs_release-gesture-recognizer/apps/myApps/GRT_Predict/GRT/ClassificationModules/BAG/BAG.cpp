@@ -28,6 +28,8 @@ RegisterClassifierModule< BAG >  BAG::registerModule("BAG");
 BAG::BAG(bool useScaling)
 {
     this->useScaling = useScaling;
+    randomSeed = 0;
+    useParallelPrediction = true;
     
     classifierType = "BAG";
     classifierMode = STANDARD_CLASSIFIER_MODE;
@@ -49,6 +51,8 @@ BAG& BAG::operator=(const BAG &rhs){
         
         //Copy the weights
         this->weights = rhs.weights;
+        this->randomSeed = rhs.randomSeed;
+        this->useParallelPrediction = rhs.useParallelPrediction;
         
         //Deep copy each classifier in the ensemble
         for(UINT i=0; i<rhs.getEnsembleSize(); i++){
@@ -71,6 +75,8 @@ bool BAG::clone(const Classifier *classifier){
         
         //Copy the weights
         this->weights = ptr->weights;
+        this->randomSeed = ptr->randomSeed;
+        this->useParallelPrediction = ptr->useParallelPrediction;
         
         //Deep copy each classifier in the ensemble
         for(UINT i=0; i<ptr->getEnsembleSize(); i++){
@@ -114,12 +120,27 @@ bool BAG::train(LabelledClassificationData &trainingData){
         }
     }
 
-    //Train the ensemble
+    //Give each classifier its own seed, drawn in order, so the bootstraps do not depend on the order the classifiers are trained in
+    Random random( randomSeed );
+    vector< unsigned long long > ensembleSeeds( ensembleSize );
     for(UINT i=0; i<ensembleSize; i++){
-        LabelledClassificationData boostedDataset = trainingData.getBootstrappedDataset();
+        ensembleSeeds[i] = (unsigned long long)random.getRandomNumberInt(1,numeric_limits<int>::max());
+    }
+    
+    //Train the ensemble, the classifiers are independent so they are trained in parallel. Each bootstrap is drawn as a list of
+    //sample indexes and only copied into a dataset by the thread that trains that classifier, so at most one copy per thread exists
+    vector< UINT > ensembleTrained( ensembleSize, 0 );
+    Parallel::forEach(ensembleSize,[&](UINT workerIndex,UINT i){
+        Random ensembleRandom( ensembleSeeds[i] );
+        vector< UINT > bootstrappedIndexes = trainingData.getBootstrappedIndexes( ensembleRandom );
+        LabelledClassificationData boostedDataset = trainingData.getSubset( bootstrappedIndexes );
         
         //Train the classifier with the bootstrapped dataset
-        if( !ensemble[i]->train( boostedDataset ) ){
+        ensembleTrained[i] = ensemble[i]->train( boostedDataset ) ? 1 : 0;
+    });
+    
+    for(UINT i=0; i<ensembleSize; i++){
+        if( !ensembleTrained[i] ){
             errorLog << "train(LabelledClassificationData &trainingData) - The classifier at ensemble index " << i << " failed training!" << endl;
             return false;
         }
@@ -133,7 +154,7 @@ bool BAG::train(LabelledClassificationData &trainingData){
     return trained;
 }
 
-bool BAG::predict(VectorDouble inputVector){
+bool BAG::predict_(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -165,18 +186,37 @@ bool BAG::predict(VectorDouble inputVector){
         classDistances[k] = 0;
     }
     
-    //Run the prediction for each classifier
-    double sum = 0;
+    //Run the prediction for each classifier, each classifier writes its result to its own slot so no locking is needed
     UINT ensembleSize = (UINT)ensemble.size();
+    ensemblePredictionResults.resize( ensembleSize );
+    ensemblePredictedClassLabels.resize( ensembleSize );
+    ensembleMaximumLikelihoods.resize( ensembleSize );
+    
+    //The ensemble is split into one contiguous block per worker, which keeps the overhead per classifier low
+    const bool runInParallel = useParallelPrediction && ensembleSize >= GRT_BAG_MIN_PARALLEL_ENSEMBLE_SIZE;
+    const UINT numWorkers = runInParallel ? Parallel::getNumWorkers( ensembleSize ) : 1;
+    Parallel::forEach(numWorkers,numWorkers,[&](UINT workerIndex,UINT blockIndex){
+        const UINT startIndex = (blockIndex*ensembleSize)/numWorkers;
+        const UINT endIndex = ((blockIndex+1)*ensembleSize)/numWorkers;
+        for(UINT i=startIndex; i<endIndex; i++){
+            ensemblePredictionResults[i] = ensemble[i]->predict(inputVector) ? 1 : 0;
+            ensemblePredictedClassLabels[i] = ensemble[i]->getPredictedClassLabel();
+            ensembleMaximumLikelihoods[i] = ensemble[i]->getMaximumLikelihood();
+        }
+    });
+    
+    //Add up the votes, in ensemble order so the result does not depend on the number of threads
+    double sum = 0;
     for(UINT i=0; i<ensembleSize; i++){
         
-        if( !ensemble[i]->predict(inputVector) ){
+        if( !ensemblePredictionResults[i] ){
             errorLog << "predict(VectorDouble inputVector) - The " << i << " classifier in the ensemble failed prediction!" << endl;
             return false;
         }
         
-        classLikelihoods[ getClassLabelIndexValue( ensemble[i]->getPredictedClassLabel() ) ] += weights[i];
-        classDistances[ getClassLabelIndexValue( ensemble[i]->getPredictedClassLabel() ) ] += ensemble[i]->getMaximumLikelihood() * weights[i];
+        const UINT classIndex = getClassLabelIndexValue( ensemblePredictedClassLabels[i] );
+        classLikelihoods[ classIndex ] += weights[i];
+        classDistances[ classIndex ] += ensembleMaximumLikelihoods[i] * weights[i];
         
         sum += weights[i];
     }
@@ -517,5 +557,15 @@ bool BAG::setWeights(const VectorDouble &weights){
     return true;
 }
 
+bool BAG::setRandomSeed(unsigned long long randomSeed){
+    this->randomSeed = randomSeed;
+    return true;
+}
+    
+bool BAG::enableParallelPrediction(bool useParallelPrediction){
+    this->useParallelPrediction = useParallelPrediction;
+    return true;
+}
+
 } //End of namespace GRT
 
@@ -38,6 +38,9 @@
 
 namespace GRT{
 
+//The number of classifiers an ensemble must have before the predict function runs them in parallel
+#define GRT_BAG_MIN_PARALLEL_ENSEMBLE_SIZE 50
+
 class BAG : public Classifier
 {
 public:
@@ -81,12 +84,12 @@ public:
     
     /**
      This predicts the class of the inputVector.
-     This overrides the predict function in the Classifier base class.
+     This overrides the predict_ function in the Classifier base class.
      
-     @param VectorDouble inputVector: the input vector to classify
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
      @return returns true if the prediction was performed, false otherwise
     */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
     
     /**
      This saves the trained BAG model to a file.
@@ -174,9 +177,34 @@ public:
      */
     bool setWeights(const VectorDouble &weights);
     
+    /**
+     Sets the seed used to draw the bootstrapped dataset for each classifier in the ensemble. Each classifier gets its own
+     random generator, seeded from this value, so training with the same seed and data will always give the same bootstraps
+     (even though the classifiers are trained in parallel). If the seed is zero then the system time is used.
+     
+     @param unsigned long long randomSeed: the new random seed
+     @return returns true if the random seed was updated
+     */
+    bool setRandomSeed(unsigned long long randomSeed);
+    
+    /**
+     Sets if the classifiers in the ensemble should be run in parallel in the predict function. This is enabled by default,
+     but an ensemble with less than GRT_BAG_MIN_PARALLEL_ENSEMBLE_SIZE classifiers is still run on the calling thread, as
+     waking up the worker threads takes longer than running a small ensemble of fast classifiers.
+     
+     @param bool useParallelPrediction: if true then the ensemble will be run in parallel
+     @return returns true if the parameter was updated
+     */
+    bool enableParallelPrediction(bool useParallelPrediction);
+    
 protected:
     VectorDouble weights;
     vector< Classifier* > ensemble;
+    unsigned long long randomSeed;              //The seed used to draw the bootstrapped datasets, zero means the system time is used
+    bool useParallelPrediction;                 //If true, the ensemble will be run in parallel by the predict function
+    vector< UINT > ensemblePredictionResults;   //1 if the prediction of the classifier at each ensemble index was successful, 0 otherwise
+    vector< UINT > ensemblePredictedClassLabels;    //The class label predicted by each classifier in the ensemble
+    VectorDouble ensembleMaximumLikelihoods;    //The maximum likelihood of each classifier in the ensemble
     static RegisterClassifierModule< BAG > registerModule;
 };
 
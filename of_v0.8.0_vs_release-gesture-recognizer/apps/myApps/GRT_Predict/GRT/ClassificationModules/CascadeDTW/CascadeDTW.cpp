@@ -0,0 +1,777 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CascadeDTW.h"
+
+namespace GRT{
+
+//Register the CascadeDTW module with the Classifier base class
+RegisterClassifierModule< CascadeDTW >  CascadeDTW::registerModule("CascadeDTW");
+
+CascadeDTW::CascadeDTW(UINT shortlistSize,UINT numFrames)
+{
+    this->shortlistSize = shortlistSize > 0 ? shortlistSize : 1;
+    this->numFrames = numFrames > 0 ? numFrames : 1;
+    useMean = true;
+    useStdDev = true;
+    useEuclideanNorm = false;
+    useRMS = false;
+    firstStageClassifier = new ANBC();
+
+    classifierType = "CascadeDTW";
+    classifierMode = TIMESERIES_CLASSIFIER_MODE;
+    debugLog.setProceedingText("[DEBUG CascadeDTW]");
+    errorLog.setProceedingText("[ERROR CascadeDTW]");
+    trainingLog.setProceedingText("[TRAINING CascadeDTW]");
+    warningLog.setProceedingText("[WARNING CascadeDTW]");
+}
+
+CascadeDTW::CascadeDTW(const CascadeDTW &rhs){
+    firstStageClassifier = NULL;
+    classifierType = "CascadeDTW";
+    classifierMode = TIMESERIES_CLASSIFIER_MODE;
+    debugLog.setProceedingText("[DEBUG CascadeDTW]");
+    errorLog.setProceedingText("[ERROR CascadeDTW]");
+    trainingLog.setProceedingText("[TRAINING CascadeDTW]");
+    warningLog.setProceedingText("[WARNING CascadeDTW]");
+    *this = rhs;
+}
+
+CascadeDTW::~CascadeDTW(void)
+{
+    clearFirstStageClassifier();
+}
+
+CascadeDTW& CascadeDTW::operator=(const CascadeDTW &rhs){
+	if( this != &rhs ){
+        this->dtw = rhs.dtw;
+        this->featureExtractor = rhs.featureExtractor;
+        this->shortlistSize = rhs.shortlistSize;
+        this->numFrames = rhs.numFrames;
+        this->useMean = rhs.useMean;
+        this->useStdDev = rhs.useStdDev;
+        this->useEuclideanNorm = rhs.useEuclideanNorm;
+        this->useRMS = rhs.useRMS;
+        this->shortlistRankCounts = rhs.shortlistRankCounts;
+        this->shortlist = rhs.shortlist;
+        this->continuousInputDataBuffer = rhs.continuousInputDataBuffer;
+
+        //Deep copy the first stage classifier
+        clearFirstStageClassifier();
+        if( rhs.firstStageClassifier != NULL ){
+            setFirstStageClassifier( *rhs.firstStageClassifier );
+        }
+
+        //Copy the base classifier variables
+        copyBaseVariables( (Classifier*)&rhs );
+	}
+	return *this;
+}
+
+bool CascadeDTW::clone(const Classifier *classifier){
+    if( classifier == NULL ) return false;
+
+    if( this->getClassifierType() == classifier->getClassifierType() ){
+        *this = *(CascadeDTW*)classifier;
+        return true;
+    }
+    return false;
+}
+
+bool CascadeDTW::train(LabelledTimeSeriesClassificationData &trainingData){
+
+    const UINT M = trainingData.getNumSamples();
+    trained = false;
+    classLabels.clear();
+    shortlistRankCounts.clear();
+
+    if( M == 0 ){
+        errorLog << "train(LabelledTimeSeriesClassificationData &trainingData) - Training data has zero samples!" << endl;
+        return false;
+    }
+
+    if( firstStageClassifier == NULL ){
+        errorLog << "train(LabelledTimeSeriesClassificationData &trainingData) - The first stage classifier has not been set!" << endl;
+        return false;
+    }
+
+    if( dtw.getRejectionMode() != DTW::TEMPLATE_THRESHOLDS ){
+        errorLog << "train(LabelledTimeSeriesClassificationData &trainingData) - The DTW rejection mode must be TEMPLATE_THRESHOLDS, the class likelihoods of the cascade depend on the shortlist size!" << endl;
+        return false;
+    }
+
+    //Train the DTW templates, using the null rejection settings of this instance
+    dtw.enableNullRejection( useNullRejection );
+    dtw.setNullRejectionCoeff( nullRejectionCoeff );
+    if( !dtw.train( trainingData ) ){
+        errorLog << "train(LabelledTimeSeriesClassificationData &trainingData) - Failed to train the DTW classifier!" << endl;
+        return false;
+    }
+
+    numFeatures = trainingData.getNumDimensions();
+    if( !featureExtractor.init(numFrames,numFrames,numFeatures,false,useMean,useStdDev,useEuclideanNorm,useRMS) ){
+        errorLog << "train(LabelledTimeSeriesClassificationData &trainingData) - Failed to initialize the feature extraction!" << endl;
+        return false;
+    }
+
+    //Compute the first stage features of each training example
+    LabelledClassificationData featureData( featureExtractor.getNumOutputDimensions() );
+    for(UINT i=0; i<M; i++){
+        if( !computeFirstStageFeatures( trainingData[i].getData() ) ){
+            warningLog << "train(LabelledTimeSeriesClassificationData &trainingData) - Failed to compute the features of training example " << i << ", it will not be used to train the first stage classifier" << endl;
+            continue;
+        }
+        featureData.addSample( trainingData[i].getClassLabel(), featureVector );
+    }
+
+    if( !firstStageClassifier->train( featureData ) ){
+        errorLog << "train(LabelledTimeSeriesClassificationData &trainingData) - Failed to train the first stage classifier!" << endl;
+        return false;
+    }
+
+    //Count how the first stage ranks the class of each training example, the shortlist recall for any shortlist size can then be
+    //read from these counts
+    const UINT K = firstStageClassifier->getNumClasses();
+    shortlistRankCounts.resize(K+1,0);
+    for(UINT i=0; i<featureData.getNumSamples(); i++){
+        UINT rank = K;
+        if( firstStageClassifier->predict( featureData[i].getSample() ) && rankClasses( classRanking ) ){
+            const vector< UINT > firstStageClassLabels = firstStageClassifier->getClassLabels();
+            for(UINT k=0; k<K; k++){
+                if( firstStageClassLabels[ classRanking[k] ] == featureData[i].getClassLabel() ){
+                    rank = k;
+                    break;
+                }
+            }
+        }
+        shortlistRankCounts[ rank ]++;
+    }
+
+    //Copy the DTW model
+    numClasses = dtw.getNumClasses();
+    classLabels = dtw.getClassLabels();
+    nullRejectionThresholds = dtw.getNullRejectionThresholds();
+    continuousInputDataBuffer.clear();
+    continuousInputDataBuffer.resize(dtw.averageTemplateLength,vector<double>(numFeatures,0));
+
+    //Flag that the algorithm has been trained
+    trained = true;
+
+    trainingLog << "Shortlist Recall (shortlist size " << shortlistSize << "): " << getShortlistRecall() << endl;
+
+    return trained;
+}
+
+bool CascadeDTW::predict_(VectorDouble &inputVector){
+
+    if( !trained ){
+        errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
+        return false;
+    }
+
+    predictedClassLabel = 0;
+    maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
+    for(UINT k=0; k<classLikelihoods.size(); k++){
+        classLikelihoods[k] = DEFAULT_NULL_LIKELIHOOD_VALUE;
+    }
+
+	if( inputVector.size() != numFeatures ){
+        errorLog << "predict(VectorDouble inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the num features in the model (" << numFeatures << ")" << endl;
+		return false;
+	}
+
+    //Add the new input to the circular buffer
+    continuousInputDataBuffer.push_back( inputVector );
+
+    if( continuousInputDataBuffer.getNumValuesInBuffer() < dtw.averageTemplateLength ){
+        //We haven't got enough samples yet so can't do the prediction
+        return true;
+    }
+
+    //Copy the data into a temporary matrix
+    MatrixDouble predictionTimeSeries(continuousInputDataBuffer.getSize(),numFeatures);
+    for(UINT i=0; i<predictionTimeSeries.getNumRows(); i++){
+        for(UINT j=0; j<predictionTimeSeries.getNumCols(); j++){
+            predictionTimeSeries[i][j] = continuousInputDataBuffer[i][j];
+        }
+    }
+
+    //Run the prediction
+    return predict( predictionTimeSeries );
+}
+
+bool CascadeDTW::predict(MatrixDouble timeSeries){
+
+    if( !trained ){
+        errorLog << "predict(MatrixDouble timeSeries) - Model Not Trained!" << endl;
+        return false;
+    }
+
+    predictedClassLabel = 0;
+    maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
+    shortlist.clear();
+    templateIndexes.clear();
+
+	if( timeSeries.getNumCols() != numFeatures ){
+        errorLog << "predict(MatrixDouble timeSeries) - The number of columns in the timeseries (" << timeSeries.getNumCols() << ") does not match the num features in the model (" << numFeatures << ")" << endl;
+		return false;
+	}
+
+    //Rank the classes with the first stage classifier and pick the DTW templates of the top classes. If the first stage can not rank
+    //the classes (or the timeseries is too short to compute the features) then all the templates are evaluated
+    if( shortlistSize < numClasses && computeFirstStageFeatures( timeSeries ) && firstStageClassifier->predict_( featureVector ) && rankClasses( classRanking ) ){
+        const vector< UINT > firstStageClassLabels = firstStageClassifier->getClassLabels();
+        for(UINT k=0; k<shortlistSize && k<classRanking.size(); k++){
+            const UINT classLabel = firstStageClassLabels[ classRanking[k] ];
+            for(UINT t=0; t<dtw.templatesBuffer.size(); t++){
+                if( dtw.templatesBuffer[t].classLabel == classLabel ){
+                    shortlist.push_back( classLabel );
+                    templateIndexes.push_back( t );
+                    break;
+                }
+            }
+        }
+    }
+
+    //The null rejection settings of this instance are used, in case they have been changed since the model was trained
+    dtw.enableNullRejection( useNullRejection );
+
+    bool predictionSuccess = false;
+    if( templateIndexes.size() > 0 ){
+        predictionSuccess = dtw.predict( timeSeries, templateIndexes );
+    }else predictionSuccess = dtw.predict( timeSeries );
+
+    if( !predictionSuccess ){
+        errorLog << "predict(MatrixDouble timeSeries) - The DTW classifier failed prediction!" << endl;
+        return false;
+    }
+
+    predictedClassLabel = dtw.getPredictedClassLabel();
+    maxLikelihood = dtw.getMaximumLikelihood();
+    bestDistance = dtw.getBestDistance();
+    classLikelihoods = dtw.getClassLikelihoods();
+    classDistances = dtw.getClassDistances();
+
+    return true;
+}
+
+bool CascadeDTW::bufferInputVector(const VectorDouble &inputVector){
+
+    if( !trained ){
+        errorLog << "bufferInputVector(const VectorDouble &inputVector) - Model Not Trained!" << endl;
+        return false;
+    }
+
+	if( inputVector.size() != numFeatures ){
+        errorLog << "bufferInputVector(const VectorDouble &inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the num features in the model (" << numFeatures << ")" << endl;
+		return false;
+	}
+
+    continuousInputDataBuffer.push_back( inputVector );
+
+    return true;
+}
+
+bool CascadeDTW::reset(){
+
+    shortlist.clear();
+    templateIndexes.clear();
+    if( trained ){
+        continuousInputDataBuffer.clear();
+        continuousInputDataBuffer.resize(dtw.averageTemplateLength,vector<double>(numFeatures,0));
+        dtw.reset();
+        if( firstStageClassifier != NULL ) firstStageClassifier->reset();
+    }
+
+    return Classifier::reset();
+}
+
+bool CascadeDTW::saveModelToFile(string filename){
+
+    if( !trained ) return false;
+
+	std::fstream file;
+	file.open(filename.c_str(), std::ios::out);
+
+    if( !saveModelToFile( file ) ){
+        return false;
+    }
+
+	file.close();
+
+	return true;
+}
+
+bool CascadeDTW::saveModelToFile(fstream &file){
+
+    if(!file.is_open())
+	{
+		errorLog <<"saveModelToFile(fstream &file) - The file is not open!" << endl;
+		return false;
+	}
+
+    if( firstStageClassifier == NULL ){
+        errorLog <<"saveModelToFile(fstream &file) - The first stage classifier has not been set!" << endl;
+		return false;
+    }
+
+	//Write the header info
+	file << "GRT_CASCADE_DTW_MODEL_FILE_V1.0\n";
+    file << "Trained: " << trained << endl;
+    file << "UseNullRejection: " << useNullRejection << endl;
+    file << "NullRejectionCoeff: " << nullRejectionCoeff << endl;
+    file << "ShortlistSize: " << shortlistSize << endl;
+    file << "NumFrames: " << numFrames << endl;
+    file << "UseMean: " << useMean << endl;
+    file << "UseStdDev: " << useStdDev << endl;
+    file << "UseEuclideanNorm: " << useEuclideanNorm << endl;
+    file << "UseRMS: " << useRMS << endl;
+    file << "FirstStageClassifierType: " << firstStageClassifier->getClassifierType() << endl;
+
+    if( trained ){
+        file << "NumFeatures: " << numFeatures << endl;
+
+        //Save the shortlist rank counts, so the shortlist recall is still available after the model has been loaded
+        file << "NumShortlistRanks: " << shortlistRankCounts.size() << endl;
+        file << "ShortlistRankCounts: ";
+        for(UINT k=0; k<shortlistRankCounts.size(); k++){
+            file << shortlistRankCounts[k];
+            if( k < shortlistRankCounts.size()-1 ) file << "\t";
+        }
+        file << endl;
+
+        //Save the two stages
+        file << "FirstStage: \n";
+        if( !firstStageClassifier->saveModelToFile( file ) ){
+            errorLog <<"saveModelToFile(fstream &file) - Failed to save the first stage classifier to file!" << endl;
+            return false;
+        }
+
+        file << "SecondStage: \n";
+        if( !dtw.saveModelToFile( file ) ){
+            errorLog <<"saveModelToFile(fstream &file) - Failed to save the DTW classifier to file!" << endl;
+            return false;
+        }
+    }
+
+    //NOTE: We do not need to close the file
+
+    return true;
+}
+
+bool CascadeDTW::loadModelFromFile(string filename){
+
+	std::fstream file;
+	file.open(filename.c_str(), std::ios::in);
+
+    if( !loadModelFromFile( file ) ){
+        return false;
+    }
+
+    file.close();
+
+	return true;
+
+}
+
+bool CascadeDTW::loadModelFromFile(fstream &file){
+
+    trained = false;
+    numFeatures = 0;
+    numClasses = 0;
+    classLabels.clear();
+    shortlistRankCounts.clear();
+
+    if(!file.is_open())
+    {
+        errorLog << "loadModelFromFile(string filename) - Could not open file to load model" << endl;
+        return false;
+    }
+
+    std::string word;
+    bool modelTrained = false;
+
+    //Find the file type header
+    file >> word;
+    if(word != "GRT_CASCADE_DTW_MODEL_FILE_V1.0"){
+        errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
+        return false;
+    }
+
+    file >> word;
+    if(word != "Trained:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find Trained Header" << endl;
+        return false;
+    }
+    file >> modelTrained;
+
+    file >> word;
+    if(word != "UseNullRejection:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find UseNullRejection!" << endl;
+        return false;
+    }
+    file >> useNullRejection;
+
+    file >> word;
+    if(word != "NullRejectionCoeff:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NullRejectionCoeff!" << endl;
+        return false;
+    }
+    file >> nullRejectionCoeff;
+
+    file >> word;
+    if(word != "ShortlistSize:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find ShortlistSize!" << endl;
+        return false;
+    }
+    file >> shortlistSize;
+
+    file >> word;
+    if(word != "NumFrames:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumFrames!" << endl;
+        return false;
+    }
+    file >> numFrames;
+
+    file >> word;
+    if(word != "UseMean:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find UseMean!" << endl;
+        return false;
+    }
+    file >> useMean;
+
+    file >> word;
+    if(word != "UseStdDev:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find UseStdDev!" << endl;
+        return false;
+    }
+    file >> useStdDev;
+
+    file >> word;
+    if(word != "UseEuclideanNorm:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find UseEuclideanNorm!" << endl;
+        return false;
+    }
+    file >> useEuclideanNorm;
+
+    file >> word;
+    if(word != "UseRMS:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find UseRMS!" << endl;
+        return false;
+    }
+    file >> useRMS;
+
+    //Create the first stage classifier
+    file >> word;
+    if(word != "FirstStageClassifierType:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find FirstStageClassifierType!" << endl;
+        return false;
+    }
+    file >> word;
+    clearFirstStageClassifier();
+    firstStageClassifier = createInstanceFromString( word );
+    if( firstStageClassifier == NULL ){
+        errorLog << "loadModelFromFile(string filename) - Could not create a new classifier instance from the classifierType: " << word << endl;
+        return false;
+    }
+
+    if( !modelTrained ){
+        return true;
+    }
+
+    file >> word;
+    if(word != "NumFeatures:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures!" << endl;
+        return false;
+    }
+    file >> numFeatures;
+
+    //Load the shortlist rank counts, there is one count for each first stage class plus one for the examples that were not ranked
+    UINT numShortlistRanks = 0;
+    file >> word;
+    if(word != "NumShortlistRanks:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumShortlistRanks!" << endl;
+        return false;
+    }
+    file >> numShortlistRanks;
+
+    file >> word;
+    if(word != "ShortlistRankCounts:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find ShortlistRankCounts!" << endl;
+        return false;
+    }
+    shortlistRankCounts.resize( numShortlistRanks, 0 );
+    for(UINT k=0; k<numShortlistRanks; k++){
+        file >> shortlistRankCounts[k];
+    }
+
+    //Load the two stages
+    file >> word;
+    if(word != "FirstStage:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find FirstStage!" << endl;
+        return false;
+    }
+    if( !firstStageClassifier->loadModelFromFile( file ) ){
+        errorLog << "loadModelFromFile(string filename) - Failed to load the first stage classifier!" << endl;
+        return false;
+    }
+
+    file >> word;
+    if(word != "SecondStage:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find SecondStage!" << endl;
+        return false;
+    }
+    if( !dtw.loadModelFromFile( file ) ){
+        errorLog << "loadModelFromFile(string filename) - Failed to load the DTW classifier!" << endl;
+        return false;
+    }
+
+    if( dtw.getRejectionMode() != DTW::TEMPLATE_THRESHOLDS ){
+        errorLog << "loadModelFromFile(string filename) - The DTW rejection mode must be TEMPLATE_THRESHOLDS, the class likelihoods of the cascade depend on the shortlist size!" << endl;
+        return false;
+    }
+
+    if( !featureExtractor.init(numFrames,numFrames,numFeatures,false,useMean,useStdDev,useEuclideanNorm,useRMS) ){
+        errorLog << "loadModelFromFile(string filename) - Failed to initialize the feature extraction!" << endl;
+        return false;
+    }
+
+    //Copy the DTW model
+    numClasses = dtw.getNumClasses();
+    classLabels = dtw.getClassLabels();
+    nullRejectionThresholds = dtw.getNullRejectionThresholds();
+    continuousInputDataBuffer.clear();
+    continuousInputDataBuffer.resize(dtw.averageTemplateLength,vector<double>(numFeatures,0));
+
+    //Resize the prediction results to make sure it is setup for realtime prediction
+    maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
+    bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
+    classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
+    classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
+
+    //Flag that the model has been trained
+    trained = true;
+
+    return true;
+}
+
+bool CascadeDTW::recomputeNullRejectionThresholds(){
+
+    if( !trained ) return false;
+
+    dtw.setNullRejectionCoeff( nullRejectionCoeff );
+    if( !dtw.recomputeNullRejectionThresholds() ){
+        return false;
+    }
+    nullRejectionThresholds = dtw.getNullRejectionThresholds();
+
+    return true;
+}
+
+bool CascadeDTW::computeShortlistRecall(LabelledTimeSeriesClassificationData &testData,double &recall){
+
+    recall = 0;
+
+    if( !trained ){
+        errorLog << "computeShortlistRecall(LabelledTimeSeriesClassificationData &testData,double &recall) - Model Not Trained!" << endl;
+        return false;
+    }
+
+    const UINT M = testData.getNumSamples();
+    if( M == 0 ){
+        errorLog << "computeShortlistRecall(LabelledTimeSeriesClassificationData &testData,double &recall) - The test data has zero samples!" << endl;
+        return false;
+    }
+
+    if( testData.getNumDimensions() != numFeatures ){
+        errorLog << "computeShortlistRecall(LabelledTimeSeriesClassificationData &testData,double &recall) - The number of dimensions in the test data (" << testData.getNumDimensions() << ") does not match the num features in the model (" << numFeatures << ")" << endl;
+        return false;
+    }
+
+    //An example counts as found if its class is in the shortlist, or if all the templates would be evaluated for it
+    const vector< UINT > firstStageClassLabels = firstStageClassifier->getClassLabels();
+    UINT numFound = 0;
+    for(UINT i=0; i<M; i++){
+        if( shortlistSize >= numClasses || !computeFirstStageFeatures( testData[i].getData() ) || !firstStageClassifier->predict( featureVector ) || !rankClasses( classRanking ) ){
+            numFound++;
+            continue;
+        }
+        for(UINT k=0; k<shortlistSize && k<classRanking.size(); k++){
+            if( firstStageClassLabels[ classRanking[k] ] == testData[i].getClassLabel() ){
+                numFound++;
+                break;
+            }
+        }
+    }
+
+    recall = numFound / double(M);
+
+    return true;
+}
+
+double CascadeDTW::getShortlistRecall() const{
+    return getShortlistRecall( shortlistSize );
+}
+
+double CascadeDTW::getShortlistRecall(UINT shortlistSize) const{
+
+    if( !trained || shortlistRankCounts.size() == 0 ) return 0;
+
+    //All the templates are evaluated if the shortlist includes every class
+    if( shortlistSize >= numClasses ) return 1;
+
+    UINT numFound = 0;
+    UINT numExamples = 0;
+    for(UINT k=0; k<shortlistRankCounts.size(); k++){
+        if( k < shortlistSize ) numFound += shortlistRankCounts[k];
+        numExamples += shortlistRankCounts[k];
+    }
+
+    return numExamples > 0 ? numFound / double(numExamples) : 0;
+}
+
+bool CascadeDTW::setShortlistSize(UINT shortlistSize){
+    if( shortlistSize > 0 ){
+        this->shortlistSize = shortlistSize;
+        return true;
+    }
+    errorLog << "setShortlistSize(UINT shortlistSize) - The shortlist size must be greater than zero!" << endl;
+    return false;
+}
+
+bool CascadeDTW::setDTW(const DTW &dtw){
+
+    //The likelihoods are normalized over the shortlisted templates only, so the likelihood based rejection modes can not be used
+    if( dtw.getRejectionMode() != DTW::TEMPLATE_THRESHOLDS ){
+        errorLog << "setDTW(const DTW &dtw) - The DTW rejection mode must be TEMPLATE_THRESHOLDS, the class likelihoods of the cascade depend on the shortlist size!" << endl;
+        return false;
+    }
+
+    trained = false;
+    this->dtw = dtw;
+
+    //The null rejection settings of the DTW are used by the cascade
+    this->useNullRejection = dtw.getNullRejectionEnabled();
+    this->nullRejectionCoeff = dtw.getNullRejectionCoeff();
+
+    return true;
+}
+
+bool CascadeDTW::setFirstStageClassifier(const Classifier &classifier){
+
+    if( classifier.getTimeseriesCompatible() ){
+        errorLog << "setFirstStageClassifier(const Classifier &classifier) - The first stage classifier can not be a timeseries classifier!" << endl;
+        return false;
+    }
+
+    Classifier *newClassifier = classifier.createNewInstance();
+
+    if( newClassifier == NULL ){
+        errorLog << "setFirstStageClassifier(const Classifier &classifier) - Failed to create a new instance of the classifier!" << endl;
+        return false;
+    }
+
+    if( !newClassifier->clone( &classifier ) ){
+        errorLog << "setFirstStageClassifier(const Classifier &classifier) - Failed to clone the classifier!" << endl;
+        delete newClassifier;
+        return false;
+    }
+
+    trained = false;
+    clearFirstStageClassifier();
+    firstStageClassifier = newClassifier;
+
+    return true;
+}
+
+bool CascadeDTW::setFirstStageFeatures(UINT numFrames,bool useMean,bool useStdDev,bool useEuclideanNorm,bool useRMS){
+
+    if( numFrames == 0 ){
+        errorLog << "setFirstStageFeatures(...) - The number of frames must be greater than zero!" << endl;
+        return false;
+    }
+
+    if( !useMean && !useStdDev && !useEuclideanNorm && !useRMS ){
+        errorLog << "setFirstStageFeatures(...) - At least one of the features must be used!" << endl;
+        return false;
+    }
+
+    trained = false;
+    this->numFrames = numFrames;
+    this->useMean = useMean;
+    this->useStdDev = useStdDev;
+    this->useEuclideanNorm = useEuclideanNorm;
+    this->useRMS = useRMS;
+
+    return true;
+}
+
+bool CascadeDTW::computeFirstStageFeatures(MatrixDouble &timeSeries){
+
+    //Offset the timeseries in the same way as the DTW classifier, so the features do not depend on where the gesture was performed
+    if( dtw.offsetUsingFirstSample && timeSeries.getNumRows() > 0 ){
+        const UINT numRows = timeSeries.getNumRows();
+        const UINT numCols = timeSeries.getNumCols();
+        if( offsetTimeSeries.getNumRows() != numRows || offsetTimeSeries.getNumCols() != numCols ){
+            offsetTimeSeries.resize( numRows, numCols );
+        }
+        for(UINT i=0; i<numRows; i++){
+            for(UINT j=0; j<numCols; j++){
+                offsetTimeSeries[i][j] = timeSeries[i][j] - timeSeries[0][j];
+            }
+        }
+        return featureExtractor.computeFeatures( offsetTimeSeries, featureVector );
+    }
+
+    return featureExtractor.computeFeatures( timeSeries, featureVector );
+}
+
+bool CascadeDTW::rankClasses(vector< UINT > &classIndexes){
+
+    //Order the classes of the first stage by their likelihood, ties are kept in class order
+    const VectorDouble &likelihoods = firstStageClassifier->getClassLikelihoods();
+    const UINT K = (UINT)likelihoods.size();
+
+    classIndexes.resize( K );
+    double maxLikelihood = 0;
+    for(UINT k=0; k<K; k++){
+        classIndexes[k] = k;
+        if( likelihoods[k] > maxLikelihood ) maxLikelihood = likelihoods[k];
+    }
+
+    //If none of the classes has a positive likelihood then the first stage can not rank them
+    if( K == 0 || !(maxLikelihood > 0) ){
+        return false;
+    }
+
+    std::stable_sort(classIndexes.begin(),classIndexes.end(),[&likelihoods](UINT a,UINT b){ return likelihoods[a] > likelihoods[b]; });
+
+    return true;
+}
+
+bool CascadeDTW::clearFirstStageClassifier(){
+    if( firstStageClassifier != NULL ){
+        delete firstStageClassifier;
+        firstStageClassifier = NULL;
+    }
+    return true;
+}
+
+} //End of namespace GRT
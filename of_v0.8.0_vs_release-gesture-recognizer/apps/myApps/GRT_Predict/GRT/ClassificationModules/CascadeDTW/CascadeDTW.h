@@ -0,0 +1,305 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @brief This class implements a two stage (cascade) timeseries classifier. The first stage is a fast classifier (ANBC by default)
+ that classifies the TimeDomainFeatures (the mean and standard deviation of a number of frames) of the timeseries, the top k
+ classes of the first stage are then used as a shortlist and only the DTW templates of these classes are evaluated by the second
+ stage DTW classifier. As the cost of the DTW classifier grows with the number of templates, this makes the prediction roughly
+ numClasses/k times faster, at the cost of missing the gesture whenever the first stage does not put the right class in the shortlist.
+
+ The shortlist recall (the fraction of training examples whose class was in the shortlist of the first stage) is computed for
+ every shortlist size during training, so the shortlist size can be tuned without retraining the model. If the first stage fails
+ to rank the classes (if all its likelihoods are zero for example) then all the templates are evaluated.
+
+ The null rejection, warping and preprocessing settings are those of the DTW classifier set with the setDTW function, the null
+ rejection settings can also be changed on the CascadeDTW itself. The class likelihoods are normalized over the shortlisted
+ templates only, so they (and the maximum likelihood) are higher than those of the full DTW classifier for the same input and can
+ not be compared across shortlist sizes. The DTW classifier must therefore use the TEMPLATE_THRESHOLDS rejection mode, as the
+ CLASS_LIKELIHOODS and THRESHOLDS_AND_LIKELIHOODS modes would reject differently for each shortlist size.
+ */
+
+#ifndef GRT_CASCADE_DTW_HEADER
+#define GRT_CASCADE_DTW_HEADER
+
+#include "../DTW/DTW.h"
+#include "../ANBC/ANBC.h"
+#include "../../FeatureExtractionModules/TimeDomainFeatures/TimeDomainFeatures.h"
+
+namespace GRT{
+
+class CascadeDTW : public Classifier
+{
+public:
+    /**
+     Default Constructor
+
+     @param UINT shortlistSize: sets the number of classes the first stage passes on to the DTW classifier. Default value = 2
+     @param UINT numFrames: sets the number of frames each timeseries is split into to compute the first stage features. Default value = 5
+     */
+	CascadeDTW(UINT shortlistSize=2,UINT numFrames=5);
+
+    /**
+     Default copy constructor
+
+     Defines how the data from the rhs CascadeDTW should be copied to this CascadeDTW
+
+     @param const CascadeDTW &rhs: another instance of a CascadeDTW
+     */
+    CascadeDTW(const CascadeDTW &rhs);
+
+    /**
+     Default Destructor
+     */
+	virtual ~CascadeDTW(void);
+
+    /**
+     Defines how the data from the rhs CascadeDTW should be copied to this CascadeDTW
+
+     @param const CascadeDTW &rhs: another instance of a CascadeDTW
+     @return returns a pointer to this instance of the CascadeDTW
+     */
+	CascadeDTW &operator=(const CascadeDTW &rhs);
+
+    /**
+     This is required for the Gesture Recognition Pipeline for when the pipeline.setClassifier(...) method is called.
+     It clones the data from the Base Class Classifier pointer (which should be pointing to an CascadeDTW instance) into this instance
+
+     @param Classifier *classifier: a pointer to the Classifier Base Class, this should be pointing to another CascadeDTW instance
+     @return returns true if the clone was successfull, false otherwise
+    */
+	virtual bool clone(const Classifier *classifier);
+
+    /**
+     This trains the CascadeDTW model, using the labelled timeseries classification data. The DTW classifier is trained first, then
+     the first stage classifier is trained with the features of each training example and the shortlist recall is computed.
+     This overrides the train function in the Classifier base class.
+
+     @param LabelledTimeSeriesClassificationData &trainingData: a reference to the training data
+     @return returns true if the CascadeDTW model was trained, false otherwise
+    */
+    virtual bool train(LabelledTimeSeriesClassificationData &trainingData);
+
+    /**
+     This predicts the class of the inputVector, the input is added to a buffer the length of the average DTW template and the
+     buffer is then classified in the same way as a timeseries.
+     This overrides the predict_ function in the Classifier base class.
+
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predict_(VectorDouble &inputVector);
+    using Classifier::predict;
+
+    /**
+     This predicts the class of the timeseries.
+     This overrides the predict function in the Classifier base class.
+
+     @param MatrixDouble timeSeries: the input timeseries to classify
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predict(MatrixDouble timeSeries);
+
+    /**
+     This adds the inputVector to the buffer used by the realtime prediction, without running a prediction.
+     This overrides the bufferInputVector function in the Classifier base class.
+
+     @param const VectorDouble &inputVector: the input vector to add to the buffer
+     @return returns true if the input vector was buffered, false otherwise
+     */
+    virtual bool bufferInputVector(const VectorDouble &inputVector);
+
+    /**
+     This resets the CascadeDTW classifier.
+
+     @return returns true if the CascadeDTW model was successfully reset, false otherwise.
+     */
+    virtual bool reset();
+
+    /**
+     This saves the trained CascadeDTW model to a file.
+     This overrides the saveModelToFile function in the Classifier base class.
+
+     @param string filename: the name of the file to save the CascadeDTW model to
+     @return returns true if the model was saved successfully, false otherwise
+    */
+    virtual bool saveModelToFile(string filename);
+
+    /**
+     This saves the trained CascadeDTW model to a file.
+     This overrides the saveModelToFile function in the Classifier base class.
+
+     @param fstream &file: a reference to the file the CascadeDTW model will be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToFile(fstream &file);
+
+    /**
+     This loads a trained CascadeDTW model from a file.
+     This overrides the loadModelFromFile function in the Classifier base class.
+
+     @param string filename: the name of the file to load the CascadeDTW model from
+     @return returns true if the model was loaded successfully, false otherwise
+    */
+    virtual bool loadModelFromFile(string filename);
+
+    /**
+     This loads a trained CascadeDTW model from a file.
+     This overrides the loadModelFromFile function in the Classifier base class.
+
+     @param fstream &file: a reference to the file the CascadeDTW model will be loaded from
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromFile(fstream &file);
+
+    /**
+     This recomputes the null rejection thresholds of the DTW classifier, using the current null rejection coefficient.
+
+     @return returns true if the null rejection thresholds were updated successfully, false otherwise
+     */
+    virtual bool recomputeNullRejectionThresholds();
+
+    /**
+     Computes the shortlist recall of a (test) dataset, this is the fraction of the examples whose class is in the shortlist of
+     the first stage classifier, using the current shortlist size. The model must be trained first.
+
+     @param LabelledTimeSeriesClassificationData &testData: a reference to the test data
+     @param double &recall: returns the shortlist recall, in the range [0 1]
+     @return returns true if the shortlist recall was computed, false otherwise
+     */
+    bool computeShortlistRecall(LabelledTimeSeriesClassificationData &testData,double &recall);
+
+    /**
+     Gets the shortlist recall of the training data for the current shortlist size.
+
+     @return returns the shortlist recall of the training data, or zero if the model has not been trained
+     */
+    double getShortlistRecall() const;
+
+    /**
+     Gets the shortlist recall of the training data for any shortlist size, this can be used to pick the shortlist size.
+
+     @param UINT shortlistSize: the shortlist size to get the recall for
+     @return returns the shortlist recall of the training data, or zero if the model has not been trained
+     */
+    double getShortlistRecall(UINT shortlistSize) const;
+
+    /**
+     Gets the number of classes the first stage passes on to the DTW classifier.
+
+     @return returns the shortlist size
+     */
+    UINT getShortlistSize() const{ return shortlistSize; }
+
+    /**
+     Gets the class labels in the shortlist of the last prediction, in the order they were ranked by the first stage classifier.
+     This is empty if all the templates were evaluated.
+
+     @return returns the class labels in the last shortlist
+     */
+    vector< UINT > getShortlist() const{ return shortlist; }
+
+    /**
+     Gets a reference to the DTW classifier used for the second stage.
+
+     @return returns a reference to the DTW classifier
+     */
+    const DTW& getDTW() const{ return dtw; }
+
+    /**
+     Gets a pointer to the first stage classifier.
+
+     @return returns a pointer to the first stage classifier
+     */
+    const Classifier* getFirstStageClassifier() const{ return firstStageClassifier; }
+
+    /**
+     Sets the number of classes the first stage passes on to the DTW classifier. This can be changed after the model has been
+     trained. If the shortlist size is greater than or equal to the number of classes then all the templates are evaluated.
+
+     @param UINT shortlistSize: the new shortlist size, must be greater than zero
+     @return returns true if the shortlist size was updated, false otherwise
+     */
+    bool setShortlistSize(UINT shortlistSize);
+
+    /**
+     Sets the DTW classifier used for the second stage, a copy of the DTW is used so it should be configured (null rejection,
+     warping radius, trimming, etc.) before this is called. The null rejection settings of the DTW are copied to the CascadeDTW.
+     The model will need to be retrained after this is called. The rejection mode of the DTW must be TEMPLATE_THRESHOLDS.
+
+     @param const DTW &dtw: the DTW classifier used for the second stage
+     @return returns true if the DTW classifier was set, false otherwise (if the DTW uses a likelihood based rejection mode)
+     */
+    bool setDTW(const DTW &dtw);
+
+    /**
+     Sets the classifier used for the first stage, a copy of the classifier is used. This must be a standard (non timeseries)
+     classifier that computes class likelihoods, such as ANBC or MinDist. The model will need to be retrained after this is called.
+
+     @param const Classifier &classifier: the classifier used for the first stage
+     @return returns true if the first stage classifier was set, false otherwise
+     */
+    bool setFirstStageClassifier(const Classifier &classifier);
+
+    /**
+     Sets the TimeDomainFeatures computed for the first stage classifier. Each timeseries is split into numFrames frames and the
+     selected features are computed for each frame and dimension. If the DTW classifier offsets each timeseries by its first sample
+     then the features are computed from the offset timeseries. The model will need to be retrained after this is called.
+
+     @param UINT numFrames: the number of frames each timeseries is split into, must be greater than zero
+     @param bool useMean: if true then the mean of each frame is used as a feature
+     @param bool useStdDev: if true then the standard deviation of each frame is used as a feature
+     @param bool useEuclideanNorm: if true then the euclidean norm of each frame is used as a feature
+     @param bool useRMS: if true then the root mean square of each frame is used as a feature
+     @return returns true if the features were set, false otherwise
+     */
+    bool setFirstStageFeatures(UINT numFrames,bool useMean,bool useStdDev,bool useEuclideanNorm,bool useRMS);
+
+protected:
+    bool computeFirstStageFeatures(MatrixDouble &timeSeries);
+    bool rankClasses(vector< UINT > &classIndexes);
+    bool clearFirstStageClassifier();
+
+    DTW dtw;                                        //The second stage DTW classifier
+    Classifier *firstStageClassifier;               //The first stage classifier, which ranks the classes for the shortlist
+    TimeDomainFeatures featureExtractor;            //Computes the first stage features of each timeseries
+    UINT shortlistSize;                             //The number of classes in the shortlist
+    UINT numFrames;                                 //The number of frames each timeseries is split into for the first stage features
+    bool useMean;
+    bool useStdDev;
+    bool useEuclideanNorm;
+    bool useRMS;
+    vector< UINT > shortlistRankCounts;             //The number of training examples whose class was ranked at each position by the first stage
+    vector< UINT > shortlist;                       //The class labels in the shortlist of the last prediction
+    vector< UINT > classRanking;                    //The class indexes of the first stage, ordered by their likelihood in the last prediction
+    vector< UINT > templateIndexes;                 //The DTW templates evaluated in the last prediction
+    MatrixDouble offsetTimeSeries;                  //The timeseries offset by its first sample, if the DTW offsets each timeseries
+    VectorDouble featureVector;                     //The first stage features of the last timeseries
+    CircularBuffer< VectorDouble > continuousInputDataBuffer;
+
+    static RegisterClassifierModule< CascadeDTW > registerModule;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_CASCADE_DTW_HEADER
@@ -72,6 +72,8 @@ DTW& DTW::operator=(const DTW &rhs){
 	if( this != &rhs ){
 		
 		this->templatesBuffer = rhs.templatesBuffer;
+        this->templateTrainingData = rhs.templateTrainingData;
+        this->templateDistances = rhs.templateDistances;
         this->distanceMatrices = rhs.distanceMatrices;
         this->warpPaths = rhs.warpPaths;
         this->rangesBuffer = rhs.rangesBuffer;
@@ -106,6 +108,8 @@ bool DTW::clone(const Classifier *classifier){
         
         DTW *ptr = (DTW*)classifier;
         this->templatesBuffer = ptr->templatesBuffer;
+        this->templateTrainingData = ptr->templateTrainingData;
+        this->templateDistances = ptr->templateDistances;
         this->distanceMatrices = ptr->distanceMatrices;
         this->warpPaths = ptr->warpPaths;
         this->rangesBuffer = ptr->rangesBuffer;
@@ -141,10 +145,10 @@ bool DTW::train(LabelledTimeSeriesClassificationData &trainingData){
 
 bool DTW::_train(LabelledTimeSeriesClassificationData &labelledTrainingData){
 
-	UINT bestIndex = 0;
-
 	//Cleanup Memory
 	templatesBuffer.clear();
+    templateTrainingData.clear();
+    templateDistances.clear();
     classLabels.clear();
 	trained = false;
     continuousInputDataBuffer.clear();
@@ -175,6 +179,8 @@ bool DTW::_train(LabelledTimeSeriesClassificationData &labelledTrainingData){
 	numTemplates = labelledTrainingData.getNumClasses();
     numFeatures = labelledTrainingData.getNumDimensions();
 	templatesBuffer.resize( numClasses );
+    templateTrainingData.resize( numClasses );
+    templateDistances.resize( numClasses );
     classLabels.resize( numClasses );
 	nullRejectionThresholds.resize( numClasses );
 	averageTemplateLength = 0;
@@ -191,9 +197,6 @@ bool DTW::_train(LabelledTimeSeriesClassificationData &labelledTrainingData){
 	for(UINT k=0; k<numTemplates; k++){
         //Get the class label for the cth class
         UINT classLabel = trainingData.getClassTracker()[k].classLabel;
-        LabelledTimeSeriesClassificationData classData = trainingData.getClassData( classLabel );
-		UINT numExamples = classData.getNumSamples();
-		bestIndex = 0;
 
         //Set the class label of this template
         templatesBuffer[k].classLabel = classLabel;
@@ -201,47 +204,11 @@ bool DTW::_train(LabelledTimeSeriesClassificationData &labelledTrainingData){
         //Set the kth class label
         classLabels[k] = classLabel;
         
-        trainingLog << "Training Template: " << k << " Class: " << classLabel << endl;
-
-		//Check to make sure we actually have some training examples
-		if(numExamples<1){
-            errorLog << "_train(LabelledTimeSeriesClassificationData &labelledTrainingData) - Can not train model: Num of Example is < 1! Class: " << classLabel << endl;
-			return false;
-		}
-
-		if(numExamples==1){//If we have just one training example then we have to use it as the template
-            bestIndex = 0;
-
-            nullRejectionThresholds[k] = 0.0;//TODO-We need a better way of calculating this!
-            warningLog << "_train(LabelledTimeSeriesClassificationData &labelledTrainingData) - Can't compute reject thresholds for class " << classLabel << " as there is only 1 training example" << endl;
-		}else{
-            //Search for the best training example for this class
-			if( !_train_NDDTW(classData,templatesBuffer[k],bestIndex) ){
-                errorLog << "_train(LabelledTimeSeriesClassificationData &labelledTrainingData) - Failed to train template for class with label: " << classLabel << endl;
-                return false;
-            }
-		}
-
-		//Add the template with the best index to the buffer
-		int trainingMethod = 0;
-		if(useSmoothing) trainingMethod = 1;
-
-		switch (trainingMethod) {
-			case(0)://Standard Training
-				templatesBuffer[k].timeSeries = classData[bestIndex].getData();
-				break;
-			case(1)://Training using Smoothing
-				//Smooth the data, reducing its size by a factor set by smoothFactor
-				smoothData(classData[ bestIndex ].getData(),smoothingFactor,templatesBuffer[k].timeSeries);
-				break;
-			default:
-				cout<<"Can not train model: Unknown training method \n";
-				return false;
-				break;
-		}
+        //Keep the training examples of this class, so the template can be updated later without the rest of the training data
+        templateTrainingData[k] = trainingData.getClassData( classLabel );
         
-        if( offsetUsingFirstSample ){
-            offsetTimeseries( templatesBuffer[k].timeSeries );
+        if( !trainTemplate( k ) ){
+            return false;
         }
 
 		//Add the average length of the training examples for this template to the overall averageTemplateLength
@@ -267,49 +234,190 @@ bool DTW::_train(LabelledTimeSeriesClassificationData &labelledTrainingData){
 	return true;
 }
 
-bool DTW::_train_NDDTW(LabelledTimeSeriesClassificationData &trainingData,DTWTemplate &dtwTemplate,UINT &bestIndex){
+bool DTW::update(LabelledTimeSeriesClassificationSample &sample){
+    
+    if( !trained ){
+        errorLog << "update(LabelledTimeSeriesClassificationSample &sample) - The DTW templates have not been trained!" << endl;
+        return false;
+    }
+    
+    if( sample.getData().getNumCols() != numFeatures ){
+        errorLog << "update(LabelledTimeSeriesClassificationSample &sample) - The number of features in the model (" << numFeatures << ") do not match that of the sample (" << sample.getData().getNumCols() << ")" << endl;
+        return false;
+    }
+    
+    if( templateTrainingData.size() != numTemplates ){
+        errorLog << "update(LabelledTimeSeriesClassificationSample &sample) - The training examples of the templates are not available (the model was loaded from a file), the model needs to be retrained before it can be updated!" << endl;
+        return false;
+    }
+    
+    LabelledTimeSeriesClassificationSample newSample( sample );
+    
+    if( trimTrainingData ){
+        LabelledTimeSeriesClassificationSampleTrimmer timeSeriesTrimmer(trimThreshold,maximumTrimPercentage);
+        if( !timeSeriesTrimmer.trimTimeSeries( newSample ) ){
+            errorLog << "update(LabelledTimeSeriesClassificationSample &sample) - The sample could not be trimmed!" << endl;
+            return false;
+        }
+    }
+    
+    //Process the sample in the same way as the training data, using the ranges of the original training data
+    if( useScaling ) scaleData( newSample.getData(), newSample.getData() );
+    if( useZNormalisation ) znormData( newSample.getData(), newSample.getData() );
+    
+    //Find the template for this class, adding a new template if this is the first example of the class
+    const UINT classLabel = newSample.getClassLabel();
+    UINT k = 0;
+    while( k < numTemplates && templatesBuffer[k].classLabel != classLabel ) k++;
+    if( k == numTemplates ){
+        DTWTemplate newTemplate;
+        newTemplate.classLabel = classLabel;
+        templatesBuffer.push_back( newTemplate );
+        templateTrainingData.push_back( LabelledTimeSeriesClassificationData( numFeatures ) );
+        templateDistances.push_back( MatrixDouble() );
+        classLabels.push_back( classLabel );
+        nullRejectionThresholds.push_back( 0 );
+        numTemplates++;
+        numClasses++;
+    }
+    
+    if( !templateTrainingData[k].addSample( classLabel, newSample.getData() ) ){
+        errorLog << "update(LabelledTimeSeriesClassificationSample &sample) - Failed to add the sample to the training examples of class " << classLabel << endl;
+        return false;
+    }
+    
+    //Retrain the template, this only computes the distances between the new example and the existing examples of the class
+    if( !trainTemplate( k ) ){
+        return false;
+    }
+    
+    UINT newAverageTemplateLength = 0;
+    for(UINT i=0; i<numTemplates; i++){
+        newAverageTemplateLength += templatesBuffer[i].averageTemplateLength;
+    }
+    newAverageTemplateLength = (UINT) newAverageTemplateLength/double(numTemplates);
+    if( newAverageTemplateLength != averageTemplateLength ){
+        averageTemplateLength = newAverageTemplateLength;
+        continuousInputDataBuffer.clear();
+        continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numFeatures,0));
+    }
+    
+    recomputeNullRejectionThresholds();
+    classLikelihoods.resize(numTemplates,DEFAULT_NULL_LIKELIHOOD_VALUE);
+    classDistances.resize(numTemplates,0);
+    
+    return true;
+}
+
+bool DTW::trainTemplate(const UINT k){
+    
+    LabelledTimeSeriesClassificationData &classData = templateTrainingData[k];
+    const UINT classLabel = templatesBuffer[k].classLabel;
+    const UINT numExamples = classData.getNumSamples();
+    UINT bestIndex = 0;
+    
+    trainingLog << "Training Template: " << k << " Class: " << classLabel << endl;
+
+    //Check to make sure we actually have some training examples
+    if(numExamples<1){
+        errorLog << "trainTemplate(const UINT k) - Can not train model: Num of Example is < 1! Class: " << classLabel << endl;
+        return false;
+    }
+
+    if(numExamples==1){//If we have just one training example then we have to use it as the template
+        bestIndex = 0;
+        templatesBuffer[k].trainingMu = 0.0;
+        templatesBuffer[k].trainingSigma = 0.0;
+        templatesBuffer[k].averageTemplateLength = classData[0].getLength();
+        templateDistances[k].resize(1,1);
+        templateDistances[k][0][0] = 0;
+
+        nullRejectionThresholds[k] = 0.0;//TODO-We need a better way of calculating this!
+        warningLog << "trainTemplate(const UINT k) - Can't compute reject thresholds for class " << classLabel << " as there is only 1 training example" << endl;
+    }else{
+        //Search for the best training example for this class
+        if( !_train_NDDTW(classData,templatesBuffer[k],bestIndex,templateDistances[k]) ){
+            errorLog << "trainTemplate(const UINT k) - Failed to train template for class with label: " << classLabel << endl;
+            return false;
+        }
+    }
+
+    //Add the template with the best index to the buffer
+    int trainingMethod = 0;
+    if(useSmoothing) trainingMethod = 1;
+
+    switch (trainingMethod) {
+        case(0)://Standard Training
+            templatesBuffer[k].timeSeries = classData[bestIndex].getData();
+            break;
+        case(1)://Training using Smoothing
+            //Smooth the data, reducing its size by a factor set by smoothFactor
+            smoothData(classData[ bestIndex ].getData(),smoothingFactor,templatesBuffer[k].timeSeries);
+            break;
+        default:
+            cout<<"Can not train model: Unknown training method \n";
+            return false;
+            break;
+    }
+    
+    if( offsetUsingFirstSample ){
+        offsetTimeseries( templatesBuffer[k].timeSeries );
+    }
+    
+    return true;
+}
+
+bool DTW::_train_NDDTW(LabelledTimeSeriesClassificationData &trainingData,DTWTemplate &dtwTemplate,UINT &bestIndex,MatrixDouble &distanceResults){
 
    UINT numExamples = trainingData.getNumSamples();
    VectorDouble results(numExamples,0.0);
-   MatrixDouble distanceResults(numExamples,numExamples);
    dtwTemplate.averageTemplateLength = 0;
     
-   for(UINT m=0; m<numExamples; m++){
+   //The distances between the first numKnownExamples examples are already in distanceResults (from a previous call), so only
+   //the distances to the new examples need to be computed
+   const UINT numKnownExamples = distanceResults.getNumRows() <= numExamples ? distanceResults.getNumRows() : 0;
+   if( numKnownExamples < numExamples ){
+       MatrixDouble newDistanceResults(numExamples,numExamples);
+       for(UINT m=0; m<numKnownExamples; m++){
+           for(UINT n=0; n<numKnownExamples; n++){
+               newDistanceResults[m][n] = distanceResults[m][n];
+           }
+       }
        
-	   MatrixDouble templateA; //The m'th template
-	   MatrixDouble templateB; //The n'th template
-	   dtwTemplate.averageTemplateLength += trainingData[m].getLength();
-
-	   //Smooth the data if required
-	   if( useSmoothing ) smoothData(trainingData[m].getData(),smoothingFactor,templateA);
-	   else templateA = trainingData[m].getData();
+       //Smooth and offset each example once, rather than for every pair
+       vector< MatrixDouble > templates( numExamples );
+       for(UINT m=0; m<numExamples; m++){
+           if( useSmoothing ) smoothData(trainingData[m].getData(),smoothingFactor,templates[m]);
+           else templates[m] = trainingData[m].getData();
+           
+           if( offsetUsingFirstSample ){
+               offsetTimeseries(templates[m]);
+           }
+       }
        
-       if( offsetUsingFirstSample ){
-           offsetTimeseries(templateA);
+       MatrixDouble distanceMatrix;
+       vector< IndexDist > warpPath;
+       for(UINT m=0; m<numExamples; m++){
+           for(UINT n=0; n<numExamples; n++){
+               if( m < numKnownExamples && n < numKnownExamples ) continue;
+               if(m!=n){
+                   //Compute the distance between the two time series
+                   double dist = computeDistance(templates[m],templates[n],distanceMatrix,warpPath);
+                   
+                   trainingLog << "Template: " << m << " Timeseries: " << n << " Dist: " << dist << endl;
+                   
+                   newDistanceResults[m][n] = dist;
+               }else newDistanceResults[m][n] = 0; //The distance is zero because the two timeseries are the same
+           }
+       }
+       distanceResults = newDistanceResults;
+   }
+    
+   for(UINT m=0; m<numExamples; m++){
+       dtwTemplate.averageTemplateLength += trainingData[m].getLength();
+       for(UINT n=0; n<numExamples; n++){
+           results[m] += distanceResults[m][n];
        }
-
-	   for(UINT n=0; n<numExamples; n++){
-		if(m!=n){
-		    //Smooth the data if required
-		    if( useSmoothing ) smoothData(trainingData[n].getData(),smoothingFactor,templateB);
-		    else templateB = trainingData[n].getData();
-            
-            if( offsetUsingFirstSample ){
-                offsetTimeseries(templateB);
-            }
-
-			//Compute the distance between the two time series
-            MatrixDouble distanceMatrix(templateA.getNumRows(),templateB.getNumRows());
-            vector< IndexDist > warpPath;
-			double dist = computeDistance(templateA,templateB,distanceMatrix,warpPath);
-            
-            trainingLog << "Template: " << m << " Timeseries: " << n << " Dist: " << dist << endl;
-
-			//Update the results values
-			distanceResults[m][n] = dist;
-			results[m] += dist;
-		}else distanceResults[m][n] = 0; //The distance is zero because the two timeseries are the same
-	   }
    }
 
 	for(UINT m=0; m<numExamples; m++) results[m]/=(numExamples-1);
@@ -352,6 +460,32 @@ bool DTW::_train_NDDTW(LabelledTimeSeriesClassificationData &trainingData,DTWTem
 
 
 bool DTW::predict(MatrixDouble inputTimeSeries){
+    return _predict( inputTimeSeries, NULL );
+}
+
+bool DTW::predict(MatrixDouble inputTimeSeries,const vector< UINT > &templateIndexes){
+
+    if( !trained ){
+        errorLog << "predict(MatrixDouble inputTimeSeries,const vector< UINT > &templateIndexes) - The DTW templates have not been trained!" << endl;
+        return false;
+    }
+
+    if( templateIndexes.size() == 0 ){
+        errorLog << "predict(MatrixDouble inputTimeSeries,const vector< UINT > &templateIndexes) - The template indexes are empty!" << endl;
+        return false;
+    }
+
+    for(UINT i=0; i<templateIndexes.size(); i++){
+        if( templateIndexes[i] >= numTemplates ){
+            errorLog << "predict(MatrixDouble inputTimeSeries,const vector< UINT > &templateIndexes) - The template index " << templateIndexes[i] << " is out of range, the number of templates is " << numTemplates << endl;
+            return false;
+        }
+    }
+
+    return _predict( inputTimeSeries, &templateIndexes );
+}
+
+bool DTW::_predict(MatrixDouble &inputTimeSeries,const vector< UINT > *templateIndexes){
 
     if( !trained ){
         errorLog << "predict(Matrix<double> &inputTimeSeries) - The DTW templates have not been trained!" << endl;
@@ -404,8 +538,16 @@ bool DTW::predict(MatrixDouble inputTimeSeries){
     if( distanceMatrices.size() != numTemplates ) distanceMatrices.resize( numTemplates );
     if( warpPaths.size() != numTemplates ) warpPaths.resize( numTemplates );
     
-	//Test the timeSeries against all the templates in the timeSeries buffer
-	for(UINT k=0; k<numTemplates; k++){
+	//Test the timeSeries against all the templates in the timeSeries buffer (or only the templates in the templateIndexes)
+    const UINT numEvaluatedTemplates = templateIndexes != NULL ? (UINT)templateIndexes->size() : numTemplates;
+    if( templateIndexes != NULL ){
+        //The templates that are not evaluated are given the maximum distance, so they can never be the closest template
+        for(UINT k=0; k<numTemplates; k++){
+            classDistances[k] = numeric_limits< double >::max();
+        }
+    }
+	for(UINT i=0; i<numEvaluatedTemplates; i++){
+        const UINT k = templateIndexes != NULL ? (*templateIndexes)[i] : i;
 		//Perform DTW
 		classDistances[k] = computeDistance(templatesBuffer[k].timeSeries,*timeSeriesPtr,distanceMatrices[k],warpPaths[k]);
         classLikelihoods[k] = classDistances[k];
@@ -413,19 +555,21 @@ bool DTW::predict(MatrixDouble inputTimeSeries){
 	}
 
 	//See which gave the min distance
-	UINT closestTemplateIndex = 0;
-	bestDistance = classDistances[0];
-	for(UINT k=1; k<numTemplates; k++){
+	UINT closestTemplateIndex = templateIndexes != NULL ? (*templateIndexes)[0] : 0;
+	bestDistance = classDistances[ closestTemplateIndex ];
+	for(UINT i=1; i<numEvaluatedTemplates; i++){
+        const UINT k = templateIndexes != NULL ? (*templateIndexes)[i] : i;
 		if( classDistances[k] < bestDistance ){
 			bestDistance = classDistances[k];
 			closestTemplateIndex = k;
 		}
 	}
     
-    //Normalize the class likelihoods and check which class has the maximum likelihood
-    UINT maxLikelihoodIndex = 0;
+    //Normalize the class likelihoods (over the evaluated templates) and check which class has the maximum likelihood
+    UINT maxLikelihoodIndex = closestTemplateIndex;
     maxLikelihood = 0;
-    for(UINT k=0; k<numTemplates; k++){
+    for(UINT i=0; i<numEvaluatedTemplates; i++){
+        const UINT k = templateIndexes != NULL ? (*templateIndexes)[i] : i;
         classLikelihoods[k] = (sum-classLikelihoods[k])/sum;
         if( classLikelihoods[k] > maxLikelihood ){
             maxLikelihood = classLikelihoods[k];
@@ -460,7 +604,7 @@ bool DTW::predict(MatrixDouble inputTimeSeries){
     return true;
 }
 
-bool DTW::predict(VectorDouble inputVector){
+bool DTW::predict_(VectorDouble &inputVector){
 
     if( !trained ){
         errorLog << "predict(vector<double> inputVector) - The model has not been trained!" << endl;
@@ -498,6 +642,23 @@ bool DTW::predict(VectorDouble inputVector){
 
 }
 
+bool DTW::bufferInputVector(const VectorDouble &inputVector){
+
+    if( !trained ){
+        errorLog << "bufferInputVector(const VectorDouble &inputVector) - The model has not been trained!" << endl;
+        return false;
+    }
+
+	if( numFeatures != inputVector.size() ){
+        errorLog << "bufferInputVector(const VectorDouble &inputVector) - The number of features in the model " << numFeatures << " does not match that of the input vector " << inputVector.size() << endl;
+        return false;
+    }
+
+    continuousInputDataBuffer.push_back( inputVector );
+
+    return true;
+}
+
 bool DTW::reset(){
     continuousInputDataBuffer.clear();
     if( trained ){
@@ -1143,6 +1304,8 @@ bool DTW::loadModelFromFile( fstream &file ){
     
     //Clean and reset the memory
     templatesBuffer.resize(numTemplates);
+    templateTrainingData.clear();
+    templateDistances.clear();
     classLabels.resize(numTemplates);
 	nullRejectionThresholds.resize(numTemplates);
     
@@ -140,14 +140,31 @@ public:
      */
     virtual bool train(LabelledTimeSeriesClassificationData &trainingData);
     
+    /**
+     This adds a new training example to a trained DTW model, only the template of the example's class is retrained.
+     The DTW model keeps the training examples of each template and the DTW distances between them, so adding an example to a class
+     with n examples only needs the 2n distances between the new example and the existing examples, rather than the n^2 distances a
+     full retrain of that class would need. If the example has a class label that is not in the model then a new template is added.
+     The example is scaled with the ranges of the original training data if useScaling is enabled.
+     
+     The training examples are not saved with the model, so a model that has been loaded from a file must be retrained before it
+     can be updated.
+     This overrides the update function in the MLBase base class.
+     
+     @param LabelledTimeSeriesClassificationSample &sample: a reference to the new training example
+     @return returns true if the DTW model was updated, false otherwise
+     */
+    virtual bool update(LabelledTimeSeriesClassificationSample &sample);
+    
     /**
      This predicts the class of the inputVector.
-     This overrides the predict function in the Classifier base class.
+     This overrides the predict_ function in the Classifier base class.
      
-     @param VectorDouble inputVector: the input vector to classify
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
      @return returns true if the prediction was performed, false otherwise
      */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
+    using Classifier::predict;
     
     /**
      This predicts the class of the timeseries.
@@ -157,6 +174,30 @@ public:
      @return returns true if the prediction was performed, false otherwise
      */
     virtual bool predict(MatrixDouble timeSeries);
+
+    /**
+     This predicts the class of the timeseries, only computing the DTW distances to the templates in the templateIndexes.
+     The templates that are not evaluated are given a class likelihood of zero and the maximum class distance, and the likelihoods
+     of the evaluated templates are normalized over the evaluated templates only. The likelihoods (and the maximum likelihood)
+     therefore depend on the templates that are evaluated and can not be compared with those of a full prediction or of a
+     prediction with a different set of templates, so only the TEMPLATE_THRESHOLDS rejection mode gives the same null rejection
+     as a full prediction. This is used by classifiers (such as the CascadeDTW) that use a cheaper model to select the templates
+     that are worth evaluating.
+
+     @param MatrixDouble timeSeries: the input timeseries to classify
+     @param const vector< UINT > &templateIndexes: the indexes of the templates to evaluate, this must not be empty
+     @return returns true if the prediction was performed, false otherwise
+     */
+    bool predict(MatrixDouble timeSeries,const vector< UINT > &templateIndexes);
+
+    /**
+     This adds the inputVector to the buffer used by the realtime prediction, without running a prediction.
+     This overrides the bufferInputVector function in the Classifier base class.
+
+     @param const VectorDouble &inputVector: the input vector to add to the buffer
+     @return returns true if the input vector was buffered, false otherwise
+     */
+    virtual bool bufferInputVector(const VectorDouble &inputVector);
     
     /**
      This saves the trained DTW model to a file.
@@ -257,7 +298,7 @@ public:
      
      @return returns an unsigned integer representing the current rejection mode
      */
-    UINT getRejectionMode(){ return rejectionMode; }
+    UINT getRejectionMode() const{ return rejectionMode; }
     
     /**
      Sets if z-normalization should be used for both training and realtime prediction.  This should be called before training the templates.
@@ -324,7 +365,9 @@ public:
 private:
 	//Public training and prediction methods
     bool _train(LabelledTimeSeriesClassificationData &trainingData);
-	bool _train_NDDTW(LabelledTimeSeriesClassificationData &trainingData,DTWTemplate &dtwTemplate,UINT &bestIndex);
+	bool _train_NDDTW(LabelledTimeSeriesClassificationData &trainingData,DTWTemplate &dtwTemplate,UINT &bestIndex,MatrixDouble &distanceResults);
+    bool trainTemplate(const UINT templateIndex);
+    bool _predict(MatrixDouble &inputTimeSeries,const vector< UINT > *templateIndexes);
 
 	//The actual DTW function
 	double computeDistance(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,MatrixDouble &distanceMatrix,vector< IndexDist > &warpPath);
@@ -344,6 +387,8 @@ private:
 
 public:
 	vector< DTWTemplate > templatesBuffer;		//A buffer to store the templates for each time series
+    vector< LabelledTimeSeriesClassificationData > templateTrainingData; //The (scaled and normalised) training examples of each template, these are kept so a template can be updated
+    vector< MatrixDouble > templateDistances;   //The DTW distances between each pair of training examples of each template
     vector< MatrixDouble > distanceMatrices;
     vector< vector< IndexDist > > warpPaths;
 	vector< MinMax >	rangesBuffer;			//A buffer to store the min-max ranges for scaling each channel
@@ -82,7 +82,7 @@ bool GMM::clone(const Classifier *classifier){
     return false;
 }
 
-bool GMM::predict(VectorDouble x){
+bool GMM::predict_(VectorDouble &x){
 
 	predictedClassLabel = 0;
 	
@@ -110,32 +110,37 @@ bool GMM::predict(VectorDouble x){
 	UINT bestIndex = 0;
 	maxLikelihood = 0;
     bestDistance = 0;
-    double sum = 0;
+    
+    //Work in log space so the likelihoods can still be ranked and normalized when they would underflow
+    double bestLogLikelihood = -numeric_limits<double>::infinity();
 	for(UINT k=0; k<numClasses; k++){
-        classDistances[k] = computeMixtureLikelihood(x,k);
-        
-        //cout << "K: " << k << " Dist: " << classDistances[k] << endl;
-        classLikelihoods[k] = classDistances[k];
-        sum += classLikelihoods[k];
-		if( classLikelihoods[k] > bestDistance ){
-			bestDistance = classLikelihoods[k];
+        classLikelihoods[k] = models[k].computeMixtureLogLikelihood(x);
+		if( classLikelihoods[k] > bestLogLikelihood ){
+			bestLogLikelihood = classLikelihoods[k];
 			bestIndex = k;
 		}
 	}
     
     //Normalize the likelihoods
-    for(unsigned int k=0; k<numClasses; k++){
+    double sum = 0;
+    for(UINT k=0; k<numClasses; k++){
+        classDistances[k] = exp( classLikelihoods[k] );
+        classLikelihoods[k] = exp( classLikelihoods[k] - bestLogLikelihood );
+        sum += classLikelihoods[k];
+    }
+    for(UINT k=0; k<numClasses; k++){
         classLikelihoods[k] /= sum;
     }
+    bestDistance = classDistances[bestIndex];
     maxLikelihood = classLikelihoods[bestIndex];
     
     if( useNullRejection ){
         
         //cout << "Dist: " << classDistances[bestIndex] << " RejectionThreshold: " << models[bestIndex].getRejectionThreshold() << endl;
         
-        //If the best distance is below the modles rejection threshold then set the predicted class label as the best class label
+        //If the best log likelihood is above the models rejection threshold then set the predicted class label as the best class label
         //Otherwise set the predicted class label as the default null rejection class label of 0
-        if( classDistances[bestIndex] >= models[bestIndex].getNullRejectionThreshold() ){
+        if( bestLogLikelihood >= models[bestIndex].getNullRejectionThreshold() ){
             predictedClassLabel = models[bestIndex].getClassLabel();
         }else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
    }else{
@@ -208,26 +213,30 @@ bool GMM::train(LabelledClassificationData &trainingData){
             models[k][j].mu = gaussianMixtureModel.getMu().getRowVector(j);
             models[k][j].sigma = gaussianMixtureModel.getSigma()[j];
             
-            //Compute the determinant and invSigma for the realtime prediction
-            LUDecomposition ludcmp(models[k][j].sigma);
-            if( !ludcmp.inverse( models[k][j].invSigma ) ){
+            //Compute the determinant and invSigma, these are saved with the model
+            Cholesky cholesky(models[k][j].sigma);
+            if( !cholesky.getSuccess() || !cholesky.inverse( models[k][j].invSigma ) ){
                 models.clear();
                 errorLog << "train(LabelledClassificationData &trainingData) - Failed to invert Matrix for class " << classLabel << "!" << endl;
                 return false;
             }
-            models[k][j].det = ludcmp.det();
+            models[k][j].det = exp( cholesky.logdet() );
         }
         
-        //Compute the normalize factor
-        models[k].recomputeNormalizationFactor();
+        //Build the Cholesky based prediction model, this also computes the normalize factor
+        if( !models[k].recomputePredictionModel() ){
+            models.clear();
+            errorLog << "train(LabelledClassificationData &trainingData) - Failed to build the prediction model for class " << classLabel << "!" << endl;
+            return false;
+        }
         
-        //Compute the rejection thresholds
+        //Compute the rejection thresholds, these are computed from the log likelihoods so they do not underflow with high dimensional data
         double mu = 0;
         double sigma = 0;
         VectorDouble predictionResults(classData.getNumSamples(),0);
         for(UINT i=0; i<classData.getNumSamples(); i++){
             vector< double > sample = classData[i].getSample();
-            predictionResults[i] = models[k].computeMixtureLikelihood( sample );
+            predictionResults[i] = models[k].computeMixtureLogLikelihood( sample );
             mu += predictionResults[i];
         }
         
@@ -235,10 +244,11 @@ bool GMM::train(LabelledClassificationData &trainingData){
         mu /= double( classData.getNumSamples() );
         
         //Calculate the standard deviation
-        for(UINT i=0; i<classData.getNumSamples(); i++) 
-            sigma += SQR( (predictionResults[i]-mu) );
-        sigma = sqrt( sigma / (double(classData.getNumSamples())-1.0) );
-        sigma = 0.2;
+        if( classData.getNumSamples() > 1 ){
+            for(UINT i=0; i<classData.getNumSamples(); i++) 
+                sigma += SQR( (predictionResults[i]-mu) );
+            sigma = sqrt( sigma / (double(classData.getNumSamples())-1.0) );
+        }
         
         //Set the models training mu and sigma 
         models[k].setTrainingMuAndSigma(mu,sigma);
@@ -305,7 +315,7 @@ bool GMM::saveModelToFile(fstream &file){
     }
     
     //Write the header info
-    file << "GRT_GMM_MODEL_FILE_V1.0\n";
+    file << "GRT_GMM_MODEL_FILE_V2.0\n";
     file << "NumFeatures: " << numFeatures << endl;
     file << "NumClasses: " << numClasses << endl;
     file << "NumMixtureModels: " << numMixtureModels << endl;
@@ -397,8 +407,11 @@ bool GMM::loadModelFromFile(fstream &file){
     std::string word;
     
     //Find the file type header
+    //The V1.0 format stores the training mu and the rejection threshold as likelihoods rather than log likelihoods
     file >> word;
-    if(word != "GRT_GMM_MODEL_FILE_V1.0"){
+    bool hasLogLikelihoodThresholds = false;
+    if( word == "GRT_GMM_MODEL_FILE_V2.0" ) hasLogLikelihoodThresholds = true;
+    else if(word != "GRT_GMM_MODEL_FILE_V1.0"){
         errorLog << "loadModelFromFile(fstream &file) - Could not find Model File Header" << endl;
         return false;
     }
@@ -543,6 +556,15 @@ bool GMM::loadModelFromFile(fstream &file){
         }
         file >>rejectionThreshold;
         
+        //Convert the V1.0 values to log likelihoods, the standard deviation of the log likelihoods is estimated as sigma/mu (the
+        //first order approximation of the spread of log(x) around mu), so the threshold can still be recomputed with a new gamma
+        if( !hasLogLikelihoodThresholds ){
+            trainingSigma = trainingMu > 0 ? trainingSigma / trainingMu : 0;
+            trainingMu = trainingMu > 0 ? log( trainingMu ) : -numeric_limits<double>::max();
+            rejectionThreshold = rejectionThreshold > 0 ? log( rejectionThreshold ) : -numeric_limits<double>::max();
+            models[k].setTrainingMuAndSigma(trainingMu, trainingSigma);
+        }
+        
         //Set the rejection threshold
         models[k].setNullRejectionThreshold(rejectionThreshold);
         
@@ -599,6 +621,12 @@ bool GMM::loadModelFromFile(fstream &file){
             
         }
         
+        //Build the prediction model from the sigma matrices
+        if( !models[k].recomputePredictionModel() ){
+            errorLog << "loadModelFromFile(fstream &file) - Failed to build the prediction model for model " << k+1 << endl;
+            return false;
+        }
+        
     }
     
     //Set the null rejection thresholds
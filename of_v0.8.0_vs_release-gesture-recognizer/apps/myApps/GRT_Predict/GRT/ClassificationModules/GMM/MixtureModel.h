@@ -83,7 +83,9 @@ public:
     MixtureModel(){
         classLabel = 0;
         K = 0;
+        N = 0;
         normFactor = 1;
+        logNormFactor = 0;
         nullRejectionThreshold = 0;
         trainingMu = 0;
         trainingSigma = 0;
@@ -98,12 +100,97 @@ public:
 	}
     
     double computeMixtureLikelihood(const vector<double> &x){
+        return exp( computeMixtureLogLikelihood(x) );
+    }
+    
+    /**
+     Computes the log of the normalized mixture likelihood of x.  The mixture scores are combined with log-sum-exp,
+     so this will not underflow for samples that are far from every mixture.  The prediction model must have been
+     built with recomputePredictionModel() before this function is called.
+     
+     @param const vector<double> &x: the sample to evaluate, this should have N dimensions
+     @return returns the log likelihood of x, normalized by the normalization factor
+     */
+    double computeMixtureLogLikelihood(const vector<double> &x){
+        const UINT P = N*(N+1)/2;
+        
+        //Compute the residual for every mixture first, so the Mahalanobis terms below run over contiguous memory
+        for(UINT k=0; k<K; k++){
+            const double *m = &mixtureMu[k*N];
+            double *d = &residuals[k*N];
+            for(UINT i=0; i<N; i++) d[i] = x[i] - m[i];
+        }
+        
+        //Since sigma = L*L', the Mahalanobis distance is |inv(L)*(x-mu)|^2, where inv(L) is lower triangular
+        double maxLogLikelihood = -numeric_limits<double>::infinity();
+        for(UINT k=0; k<K; k++){
+            const double *invL = &invCholeskyFactors[k*P];
+            const double *d = &residuals[k*N];
+            double mahalanobis = 0;
+            for(UINT i=0; i<N; i++){
+                const double z = SIMD::dot(invL + i*(i+1)/2, d, i+1);
+                mahalanobis += z*z;
+            }
+            mixtureLogLikelihoods[k] = logNormConstants[k] - 0.5*mahalanobis;
+            if( mixtureLogLikelihoods[k] > maxLogLikelihood ) maxLogLikelihood = mixtureLogLikelihoods[k];
+        }
+        
         double sum = 0;
         for(UINT k=0; k<K; k++){
-            sum += gauss(x,gaussModels[k].det,gaussModels[k].mu,gaussModels[k].invSigma);
+            sum += exp( mixtureLogLikelihoods[k] - maxLogLikelihood );
         }
-        //Normalize the mixture likelihood
-        return sum/normFactor;
+        return maxLogLikelihood + log( sum ) - logNormFactor;
+    }
+    
+    /**
+     Builds the prediction model from the sigma matrix of each mixture.  This computes the Cholesky factor of each sigma,
+     inverts it, stores the factors and means contiguously and precomputes the log normalization constants.
+     This also updates the normalization factor.
+     
+     @return returns true if the prediction model was built, false if any of the sigma matrices are not positive definite
+     */
+    bool recomputePredictionModel(){
+        if( K == 0 || gaussModels.size() != K ) return false;
+        
+        N = (UINT)gaussModels[0].mu.size();
+        const UINT P = N*(N+1)/2;
+        const double logTwoPI = log( TWO_PI );
+        mixtureMu.resize(K*N);
+        invCholeskyFactors.resize(K*P);
+        logNormConstants.resize(K);
+        mixtureLogLikelihoods.resize(K);
+        residuals.resize(K*N);
+        
+        VectorDouble e(N);
+        VectorDouble column(N);
+        for(UINT k=0; k<K; k++){
+            if( gaussModels[k].mu.size() != N || gaussModels[k].sigma.getNumRows() != N || gaussModels[k].sigma.getNumCols() != N ) return false;
+            
+            Cholesky cholesky( gaussModels[k].sigma );
+            if( !cholesky.getSuccess() ) return false;
+            
+            //Solve L * column = e_j for each column j of inv(L), and pack the lower triangle row by row
+            double *invL = &invCholeskyFactors[k*P];
+            for(UINT j=0; j<N; j++){
+                std::fill(e.begin(),e.end(),0.0);
+                e[j] = 1.0;
+                cholesky.elsolve(e,column);
+                for(UINT i=j; i<N; i++) invL[i*(i+1)/2 + j] = column[i];
+            }
+            
+            for(UINT i=0; i<N; i++) mixtureMu[k*N+i] = gaussModels[k].mu[i];
+            logNormConstants[k] = -0.5*( N*logTwoPI + cholesky.logdet() );
+        }
+        
+        //The normalization factor is the sum of each mixture evaluated at its own mean
+        double maxConstant = logNormConstants[0];
+        for(UINT k=1; k<K; k++) if( logNormConstants[k] > maxConstant ) maxConstant = logNormConstants[k];
+        double sum = 0;
+        for(UINT k=0; k<K; k++) sum += exp( logNormConstants[k] - maxConstant );
+        logNormFactor = maxConstant + log( sum );
+        normFactor = exp( logNormFactor );
+        
+        return true;
     }
     
     bool resize(UINT K){
@@ -116,27 +203,21 @@ public:
         return false;
     }
     
+    /**
+     Recomputes the null rejection threshold from the training mu and sigma.  These are the mean and standard deviation of the
+     log likelihoods of the training samples, so the threshold is also a log likelihood and can be negative.
+     
+     @param double gamma: the number of standard deviations below the training mu the threshold is set to
+     @return returns true if the threshold was updated
+     */
     bool recomputeNullRejectionThreshold(double gamma){
-        double newRejectionThreshold = 0;
-        //TODO - Need a way of improving the null rejection threshold for the GMMs!!!!
-        newRejectionThreshold = trainingMu - (trainingSigma*gamma);
-        newRejectionThreshold = 0.02;
-        
-        //Make sure that the new rejection threshold is greater than zero
-        if( newRejectionThreshold > 0 ){
-            this->gamma = gamma;
-            this->nullRejectionThreshold = newRejectionThreshold;
-            return true;
-        }
-        return false;
+        this->gamma = gamma;
+        this->nullRejectionThreshold = trainingMu - (trainingSigma*gamma);
+        return true;
     }
     
     bool recomputeNormalizationFactor(){
-        normFactor = 0;
-        for(UINT k=0; k<K; k++){
-            normFactor += gauss(gaussModels[k].mu,gaussModels[k].det,gaussModels[k].mu,gaussModels[k].invSigma);
-        }
-        return true;
+        return recomputePredictionModel();
     }
     
     bool printModelValues(){
@@ -189,28 +270,7 @@ public:
         return true;
     }
     
-private:    
-    double gauss(const VectorDouble &x,double det,const VectorDouble &mu,Matrix<double> &invSigma){
-        
-        double y = 0;
-        double sum = 0;
-        const UINT N = (UINT)x.size();
-        VectorDouble temp(N,0);
-        
-        //Compute the first part of the equation
-        y = (1.0/pow(TWO_PI,N/2.0)) * (1.0/pow(det,0.5));
-        
-        //Compute the later half    
-        for(UINT i=0; i<N; i++){
-            for(UINT j=0; j<N; j++){
-                temp[i] += (x[j]-mu[j]) * invSigma[j][i];
-            }
-            sum += (x[i]-mu[i]) * temp[i];
-        }
-        
-        return ( y*exp( -0.5*sum ) );
-    }
-    
+private:
     UINT classLabel;
     UINT K;
     double nullRejectionThreshold;
@@ -218,8 +278,17 @@ private:
 	double trainingMu;                      //The average confidence value in the training data
 	double trainingSigma;                   //The simga confidence value in the training data
     double normFactor;
+    double logNormFactor;
     vector< GuassModel > gaussModels;
     
+    //The prediction model, this is built from the gaussModels by recomputePredictionModel()
+    UINT N;                                 //The number of dimensions of each mixture
+    VectorDouble mixtureMu;                 //The mean of each mixture, stored as [K N]
+    VectorDouble invCholeskyFactors;        //The inverse of the Cholesky factor of each sigma, each stored as a packed lower triangle
+    VectorDouble logNormConstants;          //The log of the gaussian normalization term for each mixture
+    VectorDouble mixtureLogLikelihoods;     //A buffer for the log likelihood of each mixture
+    VectorDouble residuals;                 //A buffer for x-mu for each mixture, stored as [K N]
+    
 };
     
 }//End of namespace GRT
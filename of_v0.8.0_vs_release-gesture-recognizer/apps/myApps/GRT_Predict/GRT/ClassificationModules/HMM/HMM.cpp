@@ -36,6 +36,7 @@ HMM::HMM(UINT numStates,UINT numSymbols,UINT modelType,UINT delta,UINT maxNumIte
 	this->delta = delta;
 	this->maxNumIter = maxNumIter;
 	this->minImprovement = minImprovement;
+    useSlidingWindowCorrection = true;
     useNullRejection = true;
     
     classifierMode = TIMESERIES_CLASSIFIER_MODE;
@@ -61,6 +62,7 @@ HMM& HMM::operator=(const HMM &rhs){
         this->delta = rhs.delta;
         this->maxNumIter = rhs.maxNumIter;
         this->minImprovement = rhs.minImprovement;
+        this->useSlidingWindowCorrection = rhs.useSlidingWindowCorrection;
         this->models = rhs.models;
         
         copyBaseVariables( (Classifier*)&rhs );
@@ -81,6 +83,7 @@ bool HMM::clone(const Classifier *classifier){
         this->delta = ptr->delta;
         this->maxNumIter = ptr->maxNumIter;
         this->minImprovement = ptr->minImprovement;
+        this->useSlidingWindowCorrection = ptr->useSlidingWindowCorrection;
         this->models = ptr->models;
         
         return copyBaseVariables( classifier );
@@ -116,29 +119,38 @@ bool HMM::train(LabelledTimeSeriesClassificationData &trainingData){
 	models.resize( numClasses );
     classLabels.resize( numClasses );
 
-	//Init the models
+	//Init the models, each model gets its own seed as the models are trained at the same time
+	Random random;
 	for(UINT k=0; k<numClasses; k++){
 		models[k].resetModel(numStates,numSymbols,modelType,delta);
 		models[k].maxNumIter = maxNumIter;
 		models[k].minImprovement = minImprovement;
+		models[k].useSlidingWindowCorrection = useSlidingWindowCorrection;
+		models[k].randomSeed = (unsigned long long)random.getRandomNumberInt(1,numeric_limits<int>::max());
 	}
     
-    //Train each of the models
+    //Convert each classes training data into a list of observation sequences
+    vector< vector< vector< UINT > > > observationSequences( numClasses );
     for(UINT k=0; k<numClasses; k++){
         //Get the class ID of this gesture
         UINT classID = trainingData.getClassTracker()[k].classLabel;
         classLabels[k] = classID;
         
-        //Convert this classes training data into a list of observation sequences
         LabelledTimeSeriesClassificationData classData = trainingData.getClassData( classID );
-        vector< vector< UINT > > observationSequences;
-        if( !convertDataToObservationSequence( classData, observationSequences ) ){
+        if( !convertDataToObservationSequence( classData, observationSequences[k] ) ){
             return false;
         }
-        
-        //Train the model
-		if( !models[k].train( observationSequences ) ){
-            errorLog << "train(LabelledTimeSeriesClassificationData &trainingData) - Failed to train HMM for class " << classID << endl;
+    }
+    
+    //Train each of the models, the classes are independent so they are trained in parallel
+    vector< UINT > modelTrained( numClasses, 0 );
+    Parallel::forEach(numClasses,[&](UINT workerIndex,UINT k){
+        modelTrained[k] = models[k].train( observationSequences[k] ) ? 1 : 0;
+    });
+    
+    for(UINT k=0; k<numClasses; k++){
+		if( !modelTrained[k] ){
+            errorLog << "train(LabelledTimeSeriesClassificationData &trainingData) - Failed to train HMM for class " << classLabels[k] << endl;
             return false;
         }
 	}
@@ -147,31 +159,24 @@ bool HMM::train(LabelledTimeSeriesClassificationData &trainingData){
     nullRejectionThresholds.resize(numClasses);
     
     for(UINT k=0; k<numClasses; k++){
-        //Get the class ID of this gesture
-        UINT classID = trainingData.getClassTracker()[k].classLabel;
-        classLabels[k] = classID;
-        
-        //Convert this classes training data into a list of observation sequences
-        LabelledTimeSeriesClassificationData classData = trainingData.getClassData( classID );
-        vector< vector< UINT > > observationSequences;
-        if( !convertDataToObservationSequence( classData, observationSequences ) ){
-            return false;
-        }
+        UINT classID = classLabels[k];
         
         //Test the model
         double loglikelihood = 0;
         double avgLoglikelihood = 0;
-        for(UINT i=0; i<observationSequences.size(); i++){
-            loglikelihood = models[k].predict( observationSequences[i] );
+        for(UINT i=0; i<observationSequences[k].size(); i++){
+            loglikelihood = models[k].predict( observationSequences[k][i] );
             avgLoglikelihood += fabs( loglikelihood );
-            cout << "Class: " << classID << " PredictedLogLikelihood: " << -loglikelihood << endl;
+            debugLog << "Class: " << classID << " PredictedLogLikelihood: " << -loglikelihood << endl;
         }
-        nullRejectionThresholds[k] = -( avgLoglikelihood / double( observationSequences.size() ) );
-        cout << "Class: " << classID << " NullRejectionThreshold: " << nullRejectionThresholds[k] << endl;
+        nullRejectionThresholds[k] = -( avgLoglikelihood / double( observationSequences[k].size() ) );
+        trainingLog << "Class: " << classID << " NullRejectionThreshold: " << nullRejectionThresholds[k] << endl;
 	}
     
-    for(UINT k=0; k<numClasses; k++){
-        models[k].printAB();
+    if( debugLog.loggingEnabled() ){
+        for(UINT k=0; k<numClasses; k++){
+            models[k].printAB();
+        }
     }
     
     trained = true;
@@ -179,7 +184,7 @@ bool HMM::train(LabelledTimeSeriesClassificationData &trainingData){
 	return true;
 }
     
-bool HMM::predict(VectorDouble inputVector){
+bool HMM::predict_(VectorDouble &inputVector){
     
     predictedClassLabel = 0;
 	maxLikelihood = -10000;
@@ -228,6 +233,31 @@ bool HMM::predict(VectorDouble inputVector){
     return true;
 }
     
+bool HMM::bufferInputVector(const VectorDouble &inputVector){
+    return predict( inputVector );
+}
+
+bool HMM::reset(){
+    
+    Classifier::reset();
+    
+    for(UINT k=0; k<models.size(); k++){
+        models[k].reset();
+    }
+    
+    return true;
+}
+    
+bool HMM::enableSlidingWindowCorrection(bool useSlidingWindowCorrection){
+    
+    this->useSlidingWindowCorrection = useSlidingWindowCorrection;
+    for(UINT k=0; k<models.size(); k++){
+        models[k].useSlidingWindowCorrection = useSlidingWindowCorrection;
+    }
+    
+    return true;
+}
+    
     /*
 
 UINT HMM::predict(vector<UINT> &obs,vector<double> &likelihoodResults){
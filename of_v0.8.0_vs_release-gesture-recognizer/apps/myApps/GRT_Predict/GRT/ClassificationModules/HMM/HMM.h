@@ -61,12 +61,42 @@ public:
     
     /**
      This predicts the class of the inputVector.
-     This overrides the predict function in the Classifier base class.
+     This overrides the predict_ function in the Classifier base class.
      
-     @param VectorDouble inputVector: the input vector to classify
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
      @return returns true if the prediction was performed, false otherwise
      */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
+    using Classifier::predict;
+    
+    /**
+     This adds the inputVector to the realtime observation window of each of the class models. The forward variable of each model
+     is advanced by the same step that computes its likelihood, so this runs a full prediction and the HMM gets no speedup from the
+     multi-rate mode of the GestureRecognitionPipeline.
+     This overrides the bufferInputVector function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to add to the observation windows
+     @return returns true if the input vector was buffered, false otherwise
+     */
+    virtual bool bufferInputVector(const VectorDouble &inputVector);
+    
+    /**
+     This resets the HMM classifier, clearing the realtime observation window of each of the class models.
+     This overrides the reset function in the Classifier base class.
+     
+     @return returns true if the HMM classifier was reset, false otherwise
+     */
+    virtual bool reset();
+    
+    /**
+     Sets if the streaming forward variable of each class model should be restarted at the start of the observation window
+     once every window length.  This is enabled by default, disabling it makes the realtime likelihoods conditional on
+     all of the symbols seen since the last reset.
+     
+     @param bool useSlidingWindowCorrection: the new useSlidingWindowCorrection setting
+     @return returns true if the setting was updated
+     */
+    bool enableSlidingWindowCorrection(bool useSlidingWindowCorrection);
     
     /**
      This saves the trained ANBC model to a file.
@@ -115,6 +145,7 @@ public:
 	UINT delta;				//The number of states a model can move to in a LeftRight model
 	UINT maxNumIter;		//The maximum number of iter allowed during the full training
 	double minImprovement;  //The minimum improvement value for each model during training
+    bool useSlidingWindowCorrection;    //Sets if the realtime forward variable of each model is restarted at the start of the window
     
     static RegisterClassifierModule< HMM > registerModule;
 };
@@ -35,6 +35,10 @@ HiddenMarkovModel::HiddenMarkovModel(){
 	modelType = ERGODIC;
 	logLikelihood = 0.0;
 	minImprovement = 1.0e-5;
+	randomSeed = 0;
+	useSlidingWindowCorrection = true;
+	streamingLogLikelihood = 0;
+	numStreamingSamples = 0;
     
     debugLog.setProceedingText("[DEBUG HiddenMarkovModel]");
     errorLog.setProceedingText("[ERROR HiddenMarkovModel]");
@@ -59,6 +63,10 @@ HiddenMarkovModel::HiddenMarkovModel(UINT numStates,UINT numSymbols,UINT modelTy
 	cThreshold = -1000;
 	logLikelihood = 0.0;
 	minImprovement = 1.0e-5;
+	randomSeed = 0;
+	useSlidingWindowCorrection = true;
+	streamingLogLikelihood = 0;
+	numStreamingSamples = 0;
     
     debugLog.setProceedingText("[DEBUG HiddenMarkovModel]");
     errorLog.setProceedingText("[ERROR HiddenMarkovModel]");
@@ -79,6 +87,10 @@ HiddenMarkovModel::HiddenMarkovModel(const MatrixDouble &a,const MatrixDouble &b
 	logLikelihood = 0.0;
 	minImprovement = 1.0e-10;
 	modelTrained = false;
+	randomSeed = 0;
+	useSlidingWindowCorrection = true;
+	streamingLogLikelihood = 0;
+	numStreamingSamples = 0;
     
     debugLog.setProceedingText("[DEBUG HiddenMarkovModel]");
     errorLog.setProceedingText("[ERROR HiddenMarkovModel]");
@@ -123,7 +135,7 @@ bool HiddenMarkovModel::randomizeMatrices(UINT numStates,UINT numSymbols){
 	//Fill Transition and Symbol Matrices randomly
     //It's best to choose values in the range [0.9 1.1] rather than [0 1]
     //That way, no single value will get too large or too small a weight when the values are normalized
-	Random random;
+	Random random( randomSeed );
 	for(UINT i=0; i<a.getNumRows(); i++)
 		for(UINT j=0; j<a.getNumCols(); j++)
 			a[i][j] = random.getRandomNumberUniform(0.9,1);
@@ -185,11 +197,95 @@ double HiddenMarkovModel::predict(UINT newSample){
         return 0;
     }
     
+    if( newSample >= numSymbols ){
+        errorLog << "predict(UINT newSample) - The new sample (" << newSample << ") is not a valid symbol!" << endl;
+        return 0;
+    }
+    
+    if( streamingAlpha.size() != numStates ){
+        streamingAlpha.resize(numStates);
+        streamingAlphaBuffer.resize(numStates);
+    }
+    
     observationSequence.push_back( newSample );
     
-    vector< UINT > obs = observationSequence.getDataAsVector();
+    //Advance the forward variable by one step and slide the window of log scale factors
+    const double logScaleFactor = forwardStep( newSample, numStreamingSamples == 0 );
+    if( streamingLogScaleFactors.getBufferFilled() ){
+        streamingLogLikelihood -= streamingLogScaleFactors[0];
+    }
+    streamingLogScaleFactors.push_back( logScaleFactor );
+    streamingLogLikelihood += logScaleFactor;
+    numStreamingSamples++;
+    
+    //Restart the forward variable at the start of the window, this costs O(T*N^2) but only runs once every T samples
+    if( useSlidingWindowCorrection && observationSequence.getBufferFilled() && numStreamingSamples >= 2*observationSequence.getSize() ){
+        restartForwardFromWindow();
+    }
     
-    return predict(obs);
+    return streamingLogLikelihood;
+}
+    
+double HiddenMarkovModel::forwardStep(UINT newSample,bool firstSample){
+    
+    const UINT N = numStates;
+    double sum = 0;
+    
+    if( firstSample ){
+        for(UINT i=0; i<N; i++){
+            streamingAlpha[i] = pi[i]*b[i][ newSample ];
+            sum += streamingAlpha[i];
+        }
+    }else{
+        for(UINT j=0; j<N; j++){
+            double value = 0;
+            for(UINT i=0; i<N; i++){
+                value += streamingAlpha[i] * a[i][j];
+            }
+            streamingAlphaBuffer[j] = value * b[j][ newSample ];
+            sum += streamingAlphaBuffer[j];
+        }
+        std::swap(streamingAlpha,streamingAlphaBuffer);
+    }
+    
+    //If the symbol can not be reached from any active state then restart from pi so the forward variable stays valid
+    if( sum <= 0 ){
+        if( firstSample ) return log( numeric_limits<double>::min() );
+        const double logScaleFactor = forwardStep( newSample, true );
+        return logScaleFactor + log( numeric_limits<double>::min() );
+    }
+    
+    for(UINT i=0; i<N; i++) streamingAlpha[i] /= sum;
+    
+    return log( sum );
+}
+    
+bool HiddenMarkovModel::restartForwardFromWindow(){
+    
+    const UINT T = observationSequence.getNumValuesInBuffer();
+    streamingLogLikelihood = 0;
+    streamingLogScaleFactors.resize( streamingLogScaleFactors.getSize() );
+    for(UINT t=0; t<T; t++){
+        const double logScaleFactor = forwardStep( observationSequence[t], t == 0 );
+        streamingLogScaleFactors.push_back( logScaleFactor );
+        streamingLogLikelihood += logScaleFactor;
+    }
+    numStreamingSamples = T;
+    
+    return true;
+}
+    
+bool HiddenMarkovModel::reset(){
+    
+    const UINT windowSize = observationSequence.getSize();
+    if( windowSize > 0 ){
+        observationSequence.resize( windowSize );
+        streamingLogScaleFactors.resize( windowSize );
+    }
+    streamingLogLikelihood = 0;
+    numStreamingSamples = 0;
+    
+    return true;
 }
   
 /*double predictLogLikelihood(Vector<UINT> &obs)
@@ -385,6 +481,48 @@ bool HiddenMarkovModel::forwardBackward(HMMTrainingObject &hmm,const vector<UINT
     return true;
 }
 
+/*bool accumulateReestimationSums(...)
+- Adds the expected state, transition and emission counts for one sequence to the accumulator, this must be called
+  straight after forwardBackward has been run on the same sequence. The sums only depend on the current a, b and pi, so
+  they can be computed for each sequence independently and added together before the model is updated.
+*/
+bool HiddenMarkovModel::accumulateReestimationSums(const HMMTrainingObject &hmm,const vector<UINT> &obs,HMMTrainingAccumulator &accumulator){
+    
+	const UINT N = numStates;
+	const UINT T = (unsigned int)obs.size();
+	UINT t,i,j = 0;
+	double g = 0;
+	
+	accumulator.logLikelihood += hmm.pk;
+	
+	//The state occupancy at time t is alpha[t][i]*beta[t][i]/c[t], as both alpha and beta are scaled by c[t]
+	for(t=0; t<T; t++){
+		const UINT o = obs[t];
+		for(i=0; i<N; i++){
+			g = hmm.alpha[t][i] * hmm.beta[t][i] / hmm.c[t];
+			accumulator.bNum[i][o] += g;
+			accumulator.bDenom[i] += g;
+			if( t+1 < T ) accumulator.aDenom[i] += g;
+			if( t == 0 ) accumulator.piNum[i] += g;
+		}
+	}
+	
+	//The expected transitions from i to j at time t are alpha[t][i] * a[i][j] * b[j][o(t+1)] * beta[t+1][j], the a[i][j] term
+	//is the same for every t so it is applied once when a is re-estimated
+	VectorDouble &bBeta = accumulator.stateBuffer;
+	for(t=0; t+1<T; t++){
+		const UINT o = obs[t+1];
+		for(j=0; j<N; j++) bBeta[j] = b[j][o] * hmm.beta[t+1][j];
+		for(i=0; i<N; i++){
+			const double alpha = hmm.alpha[t][i];
+			double *aNum = accumulator.aNum[i];
+			for(j=0; j<N; j++) aNum[j] += alpha * bBeta[j];
+		}
+	}
+	
+	return true;
+}
+
 /*bool batchTrain(Vector<UINT> &obs)
 - This method 
 */
@@ -449,6 +587,9 @@ bool HiddenMarkovModel::train(const vector< vector<UINT> > &trainingData){
     averageObsLength = (UINT)floor( averageObsLength/double(numObs) );
     observationSequence.resize( averageObsLength );
     estimatedStates.resize( averageObsLength );
+    streamingLogScaleFactors.resize( averageObsLength );
+    streamingLogLikelihood = 0;
+    numStreamingSamples = 0;
     
     //Finally, flag that the model was trained
     modelTrained = true;
@@ -459,30 +600,39 @@ bool HiddenMarkovModel::train(const vector< vector<UINT> > &trainingData){
 bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,UINT maxIter, UINT &currentIter,double &newLoglikelihood){
     
     const UINT numObs = (unsigned int)obs.size();
-    UINT i,j,k,t = 0;
-    double num,denom,oldLoglikelihood = 0;
+    UINT i,j,k = 0;
+    double oldLoglikelihood = 0;
     bool keepTraining = true;
     trainingLog.clear();
     
-    //Create the array to hold the data for each training instance
-    vector< HMMTrainingObject > hmms( numObs );
-    
-    //Create epislon and gamma to hold the re-estimation variables
-    vector< vector< MatrixDouble > > epsilon( numObs );
-    vector< MatrixDouble > gamma( numObs );
+    if( numObs == 0 ){
+        errorLog << "train_(...) - There are no observation sequences to train the model with!" << endl;
+        return false;
+    }
     
-    //Resize the hmms, epsilon and gamma matrices so they are ready to be filled
+    //The E-step is run in parallel across the observation sequences. Each worker has its own trellis, sized to the
+    //longest sequence so it can be reused for every sequence and every iteration, and its own re-estimation sums,
+    //which are added together once per iteration
+    UINT maxT = 0;
     for(k=0; k<numObs; k++){
-        const UINT T = (unsigned int)obs[k].size();
-        gamma[k].resize(T,numStates);
-        epsilon[k].resize(T);
-        for(t=0; t<T; t++) epsilon[k][t].resize(numStates,numStates);
-        
-        //Resize alpha, beta and phi
-        hmms[k].alpha.resize(T,numStates);
-        hmms[k].beta.resize(T,numStates);
-        hmms[k].c.resize(T);
+        if( obs[k].size() == 0 ){
+            errorLog << "train_(...) - Observation sequence " << k << " is empty!" << endl;
+            return false;
+        }
+        if( obs[k].size() > maxT ) maxT = (unsigned int)obs[k].size();
+    }
+    
+    const UINT numWorkers = Parallel::getNumWorkers( numObs );
+    vector< HMMTrainingObject > hmms( numWorkers );
+    vector< HMMTrainingAccumulator > accumulators( numWorkers );
+    for(k=0; k<numWorkers; k++){
+        hmms[k].alpha.resize(maxT,numStates);
+        hmms[k].beta.resize(maxT,numStates);
+        hmms[k].c.resize(maxT);
+        accumulators[k].resize(numStates,numSymbols);
     }
+    HMMTrainingAccumulator sums;
+    sums.resize(numStates,numSymbols);
     
     //For each training seq, run one pass of the forward backward
     //algorithm then reestimate a and b using the Baum-Welch
@@ -491,18 +641,37 @@ bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,UINT maxIter, U
     currentIter = 0;
     
     do{
-        newLoglikelihood = 0.0;
-        
         //Run the forwardbackward algorithm for each training example
-        for(k=0; k<numObs; k++){
-            if( !forwardBackward(hmms[k],obs[k]) ){
+        for(k=0; k<numWorkers; k++) accumulators[k].clear();
+        
+        Parallel::forEach(numObs,numWorkers,[&](UINT workerIndex,UINT obsIndex){
+            HMMTrainingAccumulator &accumulator = accumulators[ workerIndex ];
+            if( !forwardBackward(hmms[ workerIndex ],obs[ obsIndex ]) ){
+                accumulator.valid = false;
+                return;
+            }
+            accumulateReestimationSums(hmms[ workerIndex ],obs[ obsIndex ],accumulator);
+        });
+        
+        //Reduce the sums from each worker
+        sums.clear();
+        for(k=0; k<numWorkers; k++){
+            const HMMTrainingAccumulator &accumulator = accumulators[k];
+            if( !accumulator.valid ){
                 return false;
             }
-            newLoglikelihood += hmms[k].pk;
+            sums.logLikelihood += accumulator.logLikelihood;
+            for(i=0; i<numStates; i++){
+                for(j=0; j<numStates; j++) sums.aNum[i][j] += accumulator.aNum[i][j];
+                for(j=0; j<numSymbols; j++) sums.bNum[i][j] += accumulator.bNum[i][j];
+                sums.aDenom[i] += accumulator.aDenom[i];
+                sums.bDenom[i] += accumulator.bDenom[i];
+                sums.piNum[i] += accumulator.piNum[i];
+            }
         }
         
         //Set the new log likelihood as the average of the observations
-        newLoglikelihood /= numObs;
+        newLoglikelihood = sums.logLikelihood / numObs;
         
         trainingLog.push_back( newLoglikelihood );
         
@@ -512,8 +681,7 @@ bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,UINT maxIter, U
         
         debugLog << "Iter: "<<currentIter<<" logLikelihood: "<<newLoglikelihood<<" change: "<<oldLoglikelihood - newLoglikelihood<<endl;
         
-        printAB();
-        //PAUSE;
+        if( debugLog.loggingEnabled() ) printAB();
         
         oldLoglikelihood = newLoglikelihood;
         
@@ -522,27 +690,9 @@ bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,UINT maxIter, U
 
             //Re-estimate A
             for(i=0; i<numStates; i++){
-                
-                //Compute the denominator of A (which is independent of j)
-                denom = 0;
-                for(k=0; k<numObs; k++){
-                    for(t=0; t<obs[k].size()-1; t++){
-                        denom += hmms[k].alpha[t][i] * hmms[k].beta[t][i] / hmms[k].c[t];
-                    }
-                }
-                
-                //Compute the numerator and also update a[i][j]
-                if( denom > 0 ){
+                if( sums.aDenom[i] > 0 ){
                     for(j=0; j<numStates; j++){
-                        num = 0;
-                        for(k=0; k<numObs; k++){
-                            for(t=0; t<obs[k].size()-1; t++){
-                                num += hmms[k].alpha[t][i] * a[i][j] * b[j][ obs[k][t+1] ] * hmms[k].beta[t+1][j];
-                            }
-                        }
-                    
-                        //Update a[i][j]
-                        a[i][j] = num/denom;
+                        a[i][j] = a[i][j] * sums.aNum[i][j] / sums.aDenom[i];
                     }
                 }else{
                     errorLog << "Denom is zero for A!" << endl;
@@ -553,27 +703,15 @@ bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,UINT maxIter, U
             //Re-estimate B
             bool renormB = false;
             for(i=0; i<numStates; i++){
+                if( sums.bDenom[i] == 0 ){
+                    errorLog << "Denominator is zero for B!" << endl;
+                    return false;
+                }
                 for(j=0; j<numSymbols; j++){
-                    num=0.0;
-                    denom = 0.0;
-                    for(k=0; k<numObs; k++){
-                        const UINT T = (unsigned int)obs[k].size();
-                        for(t=0; t<T; t++){
-                            if( obs[k][t] == j ){
-                                num += hmms[k].alpha[t][i] * hmms[k].beta[t][i] / hmms[k].c[t];
-                            }
-                            denom += hmms[k].alpha[t][i] * hmms[k].beta[t][i] / hmms[k].c[t];
-                        }
-                    }
-                    
-                    if( denom == 0 ){
-                        errorLog << "Denominator is zero for B!" << endl;
-                        return false;
-                    }
                     //Update b[i][j]
                     //If there are no observations at all for a state then the probabilities will be zero which is bad
                     //So instead we flag that B needs to be renormalized later
-                    if( num > 0 ) b[i][j] = denom > 0 ? num/denom : 1.0e-5;
+                    if( sums.bNum[i][j] > 0 ) b[i][j] = sums.bNum[i][j] / sums.bDenom[i];
                     else{ b[i][j] = 0; renormB = true; }
                 }
             }
@@ -592,52 +730,17 @@ bool HiddenMarkovModel::train_(const vector< vector<UINT> > &obs,UINT maxIter, U
             
             //Re-estimate Pi - only if the model type is ERGODIC, otherwise Pi[0] == 1 and everything else is 0
             if (modelType==ERGODIC ){
-                for(k=0; k<numObs; k++){
-                    const UINT T = (unsigned int)obs[k].size();
-                    //Compute epsilon
-                    for(t=0; t<T-1; t++){
-                        denom = 0.0;
-                        for(i=0; i<numStates; i++){
-                            for(j=0; j<numStates; j++){
-                                epsilon[k][t][i][j] = hmms[k].alpha[t][i] * a[i][j] * b[j][ obs[k][t+1] ] * hmms[k].beta[t+1][j];
-                                denom += epsilon[k][t][i][j];
-                            }
-                        }
-                        //Normalize Epsilon
-                        for(i=0; i<numStates; i++){
-                            for(j=0; j<numStates; j++){
-                                if(denom!=0) epsilon[k][t][i][j] /= denom;
-                                else{ epsilon[k][t][i][j] = 0; }
-                            }
-                        }
-                    }
-                    
-                    //Compute gamma
-                    for(t=0; t<T-1; t++){
-                        for(i=0; i<numStates; i++){
-                            gamma[k][t][i]= 0.0;
-                            for(j=0; j<numStates; j++)
-                                gamma[k][t][i] += epsilon[k][t][i][j];
-                        }
-                    }
-                }
-                
-                double sum = 0;
                 for(i=0; i<numStates; i++){
-                    sum=0.0;
-                    for(k=0; k<numObs; k++){
-                        sum += gamma[k][0][i];
-                    }
-                    pi[i] = sum / numObs;
+                    pi[i] = sums.piNum[i] / numObs;
                 }
             }
         }
         
     }while(keepTraining);
     
-    cout << "TrainingLog: " << endl;
+    debugLog << "TrainingLog: " << endl;
     for(UINT i=0; i<trainingLog.size(); i++){
-        cout << trainingLog[i] << endl;
+        debugLog << trainingLog[i] << endl;
     }
     
     return true;
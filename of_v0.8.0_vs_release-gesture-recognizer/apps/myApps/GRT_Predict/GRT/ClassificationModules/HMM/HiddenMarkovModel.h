@@ -38,6 +38,41 @@ public:
 	double pk;				//P( O | Model )
 };
 
+//This class holds the Baum-Welch re-estimation sums for one training thread, they are added together once per iteration
+class HMMTrainingAccumulator{
+public:
+	HMMTrainingAccumulator(){
+		logLikelihood = 0.0;
+		valid = true;
+	}
+	~HMMTrainingAccumulator(){}
+	void resize(UINT numStates,UINT numSymbols){
+		aNum.resize(numStates,numStates);
+		bNum.resize(numStates,numSymbols);
+		aDenom.resize(numStates);
+		bDenom.resize(numStates);
+		piNum.resize(numStates);
+		stateBuffer.resize(numStates);
+	}
+	void clear(){
+		aNum.setAllValues(0);
+		bNum.setAllValues(0);
+		std::fill(aDenom.begin(),aDenom.end(),0.0);
+		std::fill(bDenom.begin(),bDenom.end(),0.0);
+		std::fill(piNum.begin(),piNum.end(),0.0);
+		logLikelihood = 0.0;
+		valid = true;
+	}
+	MatrixDouble aNum;          //The expected number of transitions from state i to state j (without the a[i][j] term)
+	MatrixDouble bNum;          //The expected number of times symbol k is emitted in state i
+	VectorDouble aDenom;        //The expected number of transitions from state i
+	VectorDouble bDenom;        //The expected number of times in state i
+	VectorDouble piNum;         //The expected number of times of starting in state i
+	VectorDouble stateBuffer;   //A temporary buffer used while the sums are computed
+	double logLikelihood;       //The sum of pk for each sequence
+	bool valid;                 //Set to false if the forward backward algorithm failed for any sequence
+};
+
 class HiddenMarkovModel{
 
 public:
@@ -49,17 +84,42 @@ public:
     
     bool resetModel(UINT numStates,UINT numSymbols,UINT modelType,UINT delta);
     bool train(const vector< vector<UINT> > &trainingData);
+    
+    /**
+     Adds a new symbol to the realtime observation window and returns the log likelihood of the window.
+     The forward variable is kept normalized between calls and advanced by one step for each new symbol, so each call
+     costs O(numStates^2) regardless of the window length.  If useSlidingWindowCorrection is true then the forward
+     variable is restarted from pi at the start of the window once every window length, which stops old symbols that
+     have left the window from influencing the result.
+     
+     @param UINT newSample: the new symbol
+     @return returns the log likelihood of the current observation window
+     */
     double predict(UINT newSample);
     double predict(const vector<UINT> &obs);
+    
+    /**
+     Clears the realtime observation window and the streaming forward variable.
+     
+     @return returns true if the model was reset
+     */
+    bool reset();
     VectorDouble getTrainingLog();
 
 public:
     bool randomizeMatrices(UINT numStates,UINT numSymbols);
 	double predictLogLikelihood(vector<UINT> &obs);
 	bool forwardBackward(HMMTrainingObject &trainingObject,const vector<UINT> &obs);
+	bool accumulateReestimationSums(const HMMTrainingObject &trainingObject,const vector<UINT> &obs,HMMTrainingAccumulator &accumulator);
     bool train_(const vector< vector<UINT> > &obs,UINT maxIter, UINT &currentIter,double &newLoglikelihood);
     void printAB();
     
+protected:
+    double forwardStep(UINT newSample,bool firstSample);
+    bool restartForwardFromWindow();
+    
+public:
+    
 	UINT numStates;             //The number of states for this model
 	UINT numSymbols;            //The number of symbols for this model
 	MatrixDouble a;             //The transitions probability matrix
@@ -76,8 +136,15 @@ public:
 	double logLikelihood;	//The log likelihood of an observation sequence given the modal, calculated by the forward method
 	double cThreshold;		//The classification threshold for this model
 	double minImprovement;	//The minimum improvement value for the training loop
+	unsigned long long randomSeed;	//The seed used to randomize the matrices before training, if this is zero then the system time is used
     CircularBuffer<UINT> observationSequence;
     vector< UINT > estimatedStates;
+    bool useSlidingWindowCorrection;        //If true, the streaming forward variable is restarted at the start of the window once every window length
+    VectorDouble streamingAlpha;            //The normalized forward variable for the realtime prediction
+    VectorDouble streamingAlphaBuffer;      //A buffer for the next forward variable
+    CircularBuffer<double> streamingLogScaleFactors;    //The log of the normalization factor of each step in the observation window
+    double streamingLogLikelihood;          //The sum of the streamingLogScaleFactors
+    UINT numStreamingSamples;               //The number of samples the streaming forward variable has been advanced by since the last restart
 
 	enum HMMModelTypes{ERGODIC=0,LEFTRIGHT=1};
     
@@ -59,6 +59,7 @@ KNN& KNN::operator=(const KNN &rhs){
         this->trainingMu = rhs.trainingMu;
         this->trainingSigma = rhs.trainingSigma;
         this->rejectionThresholds = rhs.rejectionThresholds;
+        this->trainingCounts = rhs.trainingCounts;
         
         //Classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -82,6 +83,7 @@ bool KNN::clone(const Classifier *classifier){
         this->trainingMu = ptr->trainingMu;
         this->trainingSigma = ptr->trainingSigma;
         this->rejectionThresholds = ptr->rejectionThresholds;
+        this->trainingCounts = ptr->trainingCounts;
         
         //Classifier variables
         return copyBaseVariables( classifier );
@@ -217,7 +219,8 @@ bool KNN::train_(LabelledClassificationData &trainingData,UINT K){
         const unsigned int numTrainingExamples = trainingData.getNumSamples();
         vector< IndexedDouble > predictionResults( numTrainingExamples );
         for(UINT i=0; i<numTrainingExamples; i++){
-            predict( trainingData[i].getSample(), K);
+            VectorDouble sample = trainingData[i].getSample();
+            predict_( sample, K );
 
             UINT classLabelIndex = 0;
             for(UINT k=0; k<numClasses; k++){
@@ -251,6 +254,7 @@ bool KNN::train_(LabelledClassificationData &trainingData,UINT K){
                 trainingSigma[ j ] = 1.0;
             }
         }
+        trainingCounts = counter;
 
         //Check to see if any of the mu or sigma values are zero or NaN
         bool errorFound = false;
@@ -291,7 +295,99 @@ bool KNN::train_(LabelledClassificationData &trainingData,UINT K){
     return true;
 }
 
-bool KNN::predict(VectorDouble inputVector){
+bool KNN::update(LabelledClassificationSample &sample){
+
+    if( !trained ){
+        errorLog << "update(LabelledClassificationSample &sample) - KNN model has not been trained" << endl;
+        return false;
+    }
+
+    if( sample.getNumDimensions() != numFeatures ){
+        errorLog << "update(LabelledClassificationSample &sample) - the size of the sample " << sample.getNumDimensions() << " does not match the number of features " << numFeatures <<  endl;
+        return false;
+    }
+
+    const UINT classLabel = sample.getClassLabel();
+    VectorDouble x = sample.getSample();
+
+    //The training data is stored scaled, so the new sample needs to be scaled with the ranges of the original training data
+    if( useScaling ){
+        for(UINT j=0; j<numFeatures; j++){
+            x[j] = scale(x[j], ranges[j].minValue, ranges[j].maxValue, 0, 1);
+        }
+    }
+
+    if( !trainingData.addSample(classLabel, x) ){
+        errorLog << "update(LabelledClassificationSample &sample) - Failed to add the sample to the training data" << endl;
+        return false;
+    }
+
+    //Add a new class if this is the first sample for this class label
+    bool classFound = false;
+    for(UINT k=0; k<numClasses; k++){
+        if( classLabels[k] == classLabel ){
+            classFound = true;
+            break;
+        }
+    }
+    if( !classFound ){
+        numClasses++;
+        classLabels.push_back( classLabel );
+        rejectionThresholds.push_back( 0 );
+        if( trainingMu.size() > 0 ){
+            trainingMu.push_back( 0 );
+            trainingSigma.push_back( 1.0 );
+            trainingCounts.push_back( 0 );
+        }
+    }
+
+    //If the model was trained with null rejection, update the rejection statistics of the class the new sample is predicted as
+    if( trainingMu.size() == numClasses ){
+
+        //If the model was loaded from a file then the counts were not saved, so use the number of training samples in each class
+        //(not counting the new sample, which has already been added to the training data but not to the statistics)
+        if( trainingCounts.size() != numClasses ){
+            trainingCounts.resize( numClasses, 0 );
+            for(UINT k=0; k<numClasses; k++){
+                trainingCounts[k] = trainingData.getClassTracker()[ trainingData.getClassLabelIndexValue( classLabels[k] ) ].counter;
+                if( classLabels[k] == classLabel ) trainingCounts[k]--;
+            }
+        }
+
+        bool tempUseNullRejection = useNullRejection;
+        useNullRejection = false;
+        VectorDouble unscaledSample = sample.getSample();
+        if( !predict_(unscaledSample, K) ){
+            useNullRejection = tempUseNullRejection;
+            errorLog << "update(LabelledClassificationSample &sample) - Failed to predict the class of the new sample" << endl;
+            return false;
+        }
+        useNullRejection = tempUseNullRejection;
+
+        UINT classLabelIndex = 0;
+        for(UINT k=0; k<numClasses; k++){
+            if( predictedClassLabel == classLabels[k] ){
+                classLabelIndex = k;
+                break;
+            }
+        }
+
+        //Welford's update of the mean and sample standard deviation, a class with a single distance has a sigma of 1 (as in the training)
+        const double n = trainingCounts[ classLabelIndex ];
+        const double distance = classDistances[ classLabelIndex ];
+        const double m2 = n > 1 ? SQR( trainingSigma[ classLabelIndex ] ) * (n-1) : 0;
+        const double delta = distance - trainingMu[ classLabelIndex ];
+        trainingMu[ classLabelIndex ] += delta / (n+1);
+        trainingSigma[ classLabelIndex ] = n > 0 ? sqrt( (m2 + delta * (distance - trainingMu[ classLabelIndex ])) / n ) : 1.0;
+        trainingCounts[ classLabelIndex ] = n+1;
+
+        recomputeNullRejectionThresholds();
+    }
+
+    return true;
+}
+
+bool KNN::predict_(VectorDouble &inputVector){
 
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - KNN model has not been trained" << endl;
@@ -303,10 +399,10 @@ bool KNN::predict(VectorDouble inputVector){
         return false;
     }
 
-    return predict(inputVector,K);
+    return predict_(inputVector,K);
 }
 
-bool KNN::predict(VectorDouble inputVector,UINT K){
+bool KNN::predict_(VectorDouble &inputVector,UINT K){
 
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector,UINT K) - KNN model has not been trained" << endl;
@@ -686,6 +782,12 @@ bool KNN::loadModelFromFile(fstream &file){
         trainingData.addSample(classLabel, sample);
     }
     
+    //The class labels are not saved, so get them from the training data (in the same order as the train function)
+    classLabels.resize(numClasses);
+    for(UINT k=0; k<numClasses; k++){
+        classLabels[k] = trainingData.getClassTracker()[k].classLabel;
+    }
+    
     //Flag that the model has been trained
     trained = true;
     
@@ -757,6 +859,7 @@ void KNN::clear(){
     trainingMu.clear();
     trainingSigma.clear();
     rejectionThresholds.clear();
+    trainingCounts.clear();
 }
 
 double KNN::computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b){
@@ -92,14 +92,27 @@ public:
     */
     virtual bool train(LabelledClassificationData &trainingData);
     
+    /**
+     This adds a new training sample to a trained KNN model, without retraining the model.
+     The sample is appended to the training data (scaled with the ranges of the original training data if useScaling is enabled), 
+     so it will be used as a neighbour by all future predictions. If the sample has a class label that is not in the model then a 
+     new class is added. If null rejection is enabled then the training mu and sigma of the predicted class are updated with the 
+     distance of the new sample (using Welford's algorithm) and the rejection threshold of that class is recomputed.
+     This overrides the update function in the MLBase base class.
+     
+     @param LabelledClassificationSample &sample: a reference to the new training sample
+     @return returns true if the KNN model was updated, false otherwise
+    */
+    virtual bool update(LabelledClassificationSample &sample);
+    
     /**
      This predicts the class of the inputVector.
-     This overrides the predict function in the Classifier base class.
+     This overrides the predict_ function in the Classifier base class.
      
-     @param VectorDouble inputVector: the input vector to classify
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
      @return returns true if the prediction was performed, false otherwise
     */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
     
     /**
      This saves the trained KNN model to a file.
@@ -217,7 +230,7 @@ public:
 
 protected:
     bool train_(LabelledClassificationData &trainingData,UINT K);
-    bool predict(VectorDouble inputVector,UINT K);
+    bool predict_(VectorDouble &inputVector,UINT K);
     void clear();
     double computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b);
     double computeCosineDistance(const VectorDouble &a,const VectorDouble &b);
@@ -232,6 +245,7 @@ protected:
     VectorDouble trainingMu;                    ///> Holds the average max-class distance of the training data for each of classes
     VectorDouble trainingSigma;                 ///> Holds the stddev of the max-class distance of the training data for each of classes
     VectorDouble rejectionThresholds;           ///> Holds the rejection threshold for each of the classes
+    VectorDouble trainingCounts;                ///> Holds the number of training distances the trainingMu and trainingSigma of each class were computed from
     
     static RegisterClassifierModule< KNN > registerModule;
     
@@ -194,7 +194,7 @@ bool LDA::train(LabelledClassificationData &trainingData){
     return true;
 }
 
-bool LDA::predict(VectorDouble inputVector){
+bool LDA::predict_(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(vector< double > inputVector) - LDA Model Not Trained!" << endl;
@@ -74,7 +74,47 @@ bool MinDist::train(LabelledClassificationData &trainingData){
     return train(trainingData,nullRejectionCoeff);
 }
 
-bool MinDist::predict(VectorDouble inputVector){
+bool MinDist::update(LabelledClassificationSample &sample){
+    
+    if( !trained ){
+        errorLog << "update(LabelledClassificationSample &sample) - MinDist Model Not Trained!" << endl;
+        return false;
+    }
+    
+    if( sample.getNumDimensions() != numFeatures ){
+        errorLog << "update(LabelledClassificationSample &sample) - The size of the sample (" << sample.getNumDimensions() << ") does not match the num features in the model (" << numFeatures << ")" << endl;
+        return false;
+    }
+    
+    UINT classIndex = numClasses;
+    for(UINT k=0; k<numClasses; k++){
+        if( models[k].getClassLabel() == sample.getClassLabel() ){
+            classIndex = k;
+            break;
+        }
+    }
+    
+    if( classIndex == numClasses ){
+        errorLog << "update(LabelledClassificationSample &sample) - There is no model for class " << sample.getClassLabel() << ", the model needs to be retrained to add a new class!" << endl;
+        return false;
+    }
+    
+    VectorDouble x = sample.getSample();
+    if( useScaling ){
+        for(UINT n=0; n<numFeatures; n++){
+            x[n] = scale(x[n], ranges[n].minValue, ranges[n].maxValue, 0, 1);
+        }
+    }
+    
+    if( !models[classIndex].update( x ) ){
+        errorLog << "update(LabelledClassificationSample &sample) - Failed to update the model for class " << sample.getClassLabel() << ". The number of training samples in each cluster is not known, so the model needs to be retrained!" << endl;
+        return false;
+    }
+    
+    return true;
+}
+
+bool MinDist::predict_(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - MinDist Model Not Trained!" << endl;
@@ -264,6 +304,14 @@ bool MinDist::saveModelToFile(fstream &file){
 		file << "Gamma: " << models[k].getGamma() << endl;
 		file << "TrainingMu: " << models[k].getTrainingMu() << endl;
 		file << "TrainingSigma: " << models[k].getTrainingSigma() << endl;
+        vector< UINT > clusterCounts = models[k].getClusterCounts();
+        if( clusterCounts.size() == models[k].getNumClusters() ){
+            file << "ClusterCounts: ";
+            for(UINT i=0; i<clusterCounts.size(); i++){
+                file << clusterCounts[i] << "\t";
+            }
+            file << endl;
+        }
         file << "ClusterData:" << endl;
         Matrix<double> clusters = models[k].getClusters();
         for(UINT i=0; i<models[k].getNumClusters(); i++){
@@ -412,7 +460,17 @@ bool MinDist::loadModelFromFile(fstream &file){
         }
         file >> trainingSigma;
 
+        //The cluster counts are optional, as older model files do not contain them
+        vector< UINT > clusterCounts;
         file >> word;
+        if( word == "ClusterCounts:" ){
+            clusterCounts.resize( numClusters );
+            for(UINT i=0; i<numClusters; i++){
+                file >> clusterCounts[i];
+            }
+            file >> word;
+        }
+        
         if( word != "ClusterData:" ){
             errorLog << "loadModelFromFile(string filename) - Could not load the ClusterData for class " << k << endl;
             return false;
@@ -428,6 +486,7 @@ bool MinDist::loadModelFromFile(fstream &file){
 
         models[k].setClassLabel( classLabels[k] );
         models[k].setClusters( clusters );
+        models[k].setClusterCounts( clusterCounts );
 		models[k].setGamma( gamma );
         models[k].setRejectionThreshold( rejectionThreshold );
         models[k].setTrainingSigma( trainingSigma );
@@ -79,14 +79,26 @@ public:
     */
     virtual bool train(LabelledClassificationData &trainingData);
     
+    /**
+     This updates the model of the sample's class with a new training sample, without retraining the other classes.
+     The closest cluster of the class is moved towards the sample (an online k-means step), and the training mu and sigma used
+     for the null rejection threshold are updated with Welford's algorithm. The class must already be in the model, and the model
+     must have been trained (or loaded from a file that records the number of training samples in each cluster).
+     This overrides the update function in the MLBase base class.
+     
+     @param LabelledClassificationSample &sample: a reference to the new training sample
+     @return returns true if the MinDist model was updated, false otherwise
+    */
+    virtual bool update(LabelledClassificationSample &sample);
+    
     /**
      This predicts the class of the inputVector.
-     This overrides the predict function in the Classifier base class.
+     This overrides the predict_ function in the Classifier base class.
      
-     @param VectorDouble inputVector: the input vector to classify
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
      @return returns true if the prediction was performed, false otherwise
     */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
     
     /**
      This saves the trained MinDist model to a file.
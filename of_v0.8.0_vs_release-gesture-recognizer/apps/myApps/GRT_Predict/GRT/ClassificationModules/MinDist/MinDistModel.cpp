@@ -42,6 +42,7 @@ MinDistModel& MinDistModel:: operator=(const MinDistModel &rhs){
 		this->trainingMu = rhs.trainingMu;
 		this->trainingSigma = rhs.trainingSigma;
 		this->clusters = rhs.clusters;
+		this->clusterCounts = rhs.clusterCounts;
 	}
 	return *this;
 }
@@ -67,6 +68,7 @@ bool MinDistModel::train(UINT classLabel,MatrixDouble &trainingData,UINT numClus
 	}
 	
 	clusters = kmeans.getClusters();
+	clusterCounts = kmeans.getClassCountVector();
     
 	//Compute the rejection thresholds
 	rejectionThreshold = 0;
@@ -102,6 +104,39 @@ bool MinDistModel::train(UINT classLabel,MatrixDouble &trainingData,UINT numClus
 	
 }
 
+bool MinDistModel::update(const VectorDouble &x){
+	
+	const UINT M = getNumTrainingSamples();
+	if( x.size() != numFeatures || clusterCounts.size() != numClusters || M < 2 ){
+		return false;
+	}
+	
+	//Move the closest cluster towards the new sample
+	UINT closestCluster = 0;
+	double minDist = numeric_limits<double>::max();
+	for(UINT k=0; k<numClusters; k++){
+		const double dist = SIMD::squaredDistance(clusters[k],&x[0],numFeatures);
+		if( dist < minDist ){
+			minDist = dist;
+			closestCluster = k;
+		}
+	}
+	clusterCounts[ closestCluster ]++;
+	const double learningRate = 1.0 / double( clusterCounts[ closestCluster ] );
+	for(UINT n=0; n<numFeatures; n++){
+		clusters[ closestCluster ][n] += learningRate * ( x[n] - clusters[ closestCluster ][n] );
+	}
+	
+	//Fold the distance of the new sample into the training mu and sigma
+	const double prediction = predict( x );
+	const double delta = prediction - trainingMu;
+	trainingMu += delta / (M+1);
+	trainingSigma = sqrt( ( SQR(trainingSigma) * (M-1) + delta * (prediction - trainingMu) ) / M );
+	rejectionThreshold = trainingMu+(trainingSigma*gamma);
+	
+	return true;
+}
+
 double MinDistModel::predict(const VectorDouble &inputVector){
 	
 	double minDist = numeric_limits<double>::max();
@@ -137,6 +172,14 @@ UINT MinDistModel::getNumFeatures(){
 UINT MinDistModel::getNumClusters(){
 	return numClusters;
 }
+
+UINT MinDistModel::getNumTrainingSamples(){
+	UINT numTrainingSamples = 0;
+	for(UINT k=0; k<clusterCounts.size(); k++){
+		numTrainingSamples += clusterCounts[k];
+	}
+	return numTrainingSamples;
+}
     
 double MinDistModel::getRejectionThreshold(){
     return rejectionThreshold;
@@ -157,6 +200,10 @@ double MinDistModel::getTrainingSigma(){
 MatrixDouble MinDistModel::getClusters(){
 	return clusters;
 }
+
+vector< UINT > MinDistModel::getClusterCounts(){
+	return clusterCounts;
+}
     
 bool MinDistModel::setClassLabel(UINT classLabel){
     this->classLabel = classLabel;
@@ -170,6 +217,11 @@ bool MinDistModel::setClusters(MatrixDouble &clusters){
     return true;
 }
 
+bool MinDistModel::setClusterCounts(const vector< UINT > &clusterCounts){
+    this->clusterCounts = clusterCounts;
+    return true;
+}
+
 bool MinDistModel::setGamma(double gamma){
     this->gamma = gamma;
     return true;
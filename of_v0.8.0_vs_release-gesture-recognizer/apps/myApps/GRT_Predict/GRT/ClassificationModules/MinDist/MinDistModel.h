@@ -57,6 +57,17 @@ public:
 	MinDistModel &operator=(const MinDistModel &rhs);
 	
 	bool train(UINT classLabel,MatrixDouble &trainingData,UINT numClusters);
+	
+	/**
+	 Updates the model with a new training sample. The closest cluster is moved towards the sample by 1/n of the distance, where n is
+	 the number of samples in that cluster (including the new one), so each cluster stays the mean of the samples assigned to it.
+	 The training mu and sigma are then updated with the distance of the new sample using Welford's algorithm.
+	 
+	 @param const VectorDouble &x: the new training sample
+	 @return returns true if the model was updated, false if the number of samples in each cluster is not known
+	 */
+	bool update(const VectorDouble &x);
+	
 	double predict(const VectorDouble &observation);
 	void recomputeThresholdValue();
 	
@@ -64,14 +75,17 @@ public:
 	UINT getNumFeatures();
 	UINT getNumClusters();
 	UINT getDistanceMode();
+	UINT getNumTrainingSamples();
     double getRejectionThreshold();
     double getGamma();
     double getTrainingMu();
     double getTrainingSigma();
     MatrixDouble getClusters();
+    vector< UINT > getClusterCounts();
     
     bool setClassLabel(UINT classLabel);
     bool setClusters(MatrixDouble &clusters);
+    bool setClusterCounts(const vector< UINT > &clusterCounts);
     bool setGamma(double gamma);
     bool setRejectionThreshold(double rejectionThreshold);
     bool setTrainingSigma(double trainingSigma);
@@ -87,6 +101,7 @@ private:
 	double trainingMu;			//The average confidence value in the training data
 	double trainingSigma;		//The simga confidence value in the training data
 	MatrixDouble clusters;
+	vector< UINT > clusterCounts;	//The number of training samples assigned to each cluster, this is empty if it is not known
 };
 
 } //End of namespace GRT
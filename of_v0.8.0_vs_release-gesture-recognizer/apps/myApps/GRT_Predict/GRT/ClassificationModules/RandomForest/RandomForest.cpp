@@ -0,0 +1,941 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RandomForest.h"
+
+namespace GRT{
+
+//The number of training samples in each chunk of the out-of-bag pass
+#define GRT_RANDOM_FOREST_CHUNK_SIZE 256
+
+//Register the RandomForest module with the Classifier base class
+RegisterClassifierModule< RandomForest >  RandomForest::registerModule("RandomForest");
+
+RandomForest::RandomForest(UINT forestSize,UINT maxDepth,UINT minNumSamplesPerNode,bool useScaling,bool useNullRejection,double nullRejectionCoeff)
+{
+    this->forestSize = forestSize > 0 ? forestSize : 1;
+    this->maxDepth = maxDepth > 0 ? maxDepth : 1;
+    this->minNumSamplesPerNode = minNumSamplesPerNode > 2 ? minNumSamplesPerNode : 2;
+    this->useScaling = useScaling;
+    this->useNullRejection = useNullRejection;
+    this->nullRejectionCoeff = nullRejectionCoeff;
+    numRandomFeatures = 0;
+    numHistogramBins = 32;
+    randomSeed = 0;
+
+    classifierType = "RandomForest";
+    classifierMode = STANDARD_CLASSIFIER_MODE;
+    debugLog.setProceedingText("[DEBUG RandomForest]");
+    errorLog.setProceedingText("[ERROR RandomForest]");
+    trainingLog.setProceedingText("[TRAINING RandomForest]");
+    warningLog.setProceedingText("[WARNING RandomForest]");
+}
+
+RandomForest::~RandomForest(void)
+{
+}
+
+RandomForest& RandomForest::operator=(const RandomForest &rhs){
+	if( this != &rhs ){
+        this->forestSize = rhs.forestSize;
+        this->maxDepth = rhs.maxDepth;
+        this->minNumSamplesPerNode = rhs.minNumSamplesPerNode;
+        this->numRandomFeatures = rhs.numRandomFeatures;
+        this->numHistogramBins = rhs.numHistogramBins;
+        this->randomSeed = rhs.randomSeed;
+        this->treeRoots = rhs.treeRoots;
+        this->treeDepths = rhs.treeDepths;
+        this->nodeFeatureIndex = rhs.nodeFeatureIndex;
+        this->nodeThreshold = rhs.nodeThreshold;
+        this->nodeChildren = rhs.nodeChildren;
+        this->nodeLeafOffset = rhs.nodeLeafOffset;
+        this->leafValues = rhs.leafValues;
+        this->trainingMu = rhs.trainingMu;
+        this->trainingSigma = rhs.trainingSigma;
+
+        //Copy the base classifier variables
+        copyBaseVariables( (Classifier*)&rhs );
+	}
+	return *this;
+}
+
+bool RandomForest::clone(const Classifier *classifier){
+    if( classifier == NULL ) return false;
+
+    if( this->getClassifierType() == classifier->getClassifierType() ){
+        RandomForest *ptr = (RandomForest*)classifier;
+
+        this->forestSize = ptr->forestSize;
+        this->maxDepth = ptr->maxDepth;
+        this->minNumSamplesPerNode = ptr->minNumSamplesPerNode;
+        this->numRandomFeatures = ptr->numRandomFeatures;
+        this->numHistogramBins = ptr->numHistogramBins;
+        this->randomSeed = ptr->randomSeed;
+        this->treeRoots = ptr->treeRoots;
+        this->treeDepths = ptr->treeDepths;
+        this->nodeFeatureIndex = ptr->nodeFeatureIndex;
+        this->nodeThreshold = ptr->nodeThreshold;
+        this->nodeChildren = ptr->nodeChildren;
+        this->nodeLeafOffset = ptr->nodeLeafOffset;
+        this->leafValues = ptr->leafValues;
+        this->trainingMu = ptr->trainingMu;
+        this->trainingSigma = ptr->trainingSigma;
+
+        //Copy the base classifier variables
+        return copyBaseVariables( classifier );
+    }
+    return false;
+}
+
+bool RandomForest::train(LabelledClassificationData &trainingData){
+
+    const UINT M = trainingData.getNumSamples();
+    const UINT N = trainingData.getNumDimensions();
+    const UINT K = trainingData.getNumClasses();
+
+    //Clear any previous model
+    clear();
+
+    if( M == 0 ){
+        errorLog << "train(LabelledClassificationData &trainingData) - Training data has zero samples!" << endl;
+        return false;
+    }
+
+    if( numHistogramBins < 2 || numHistogramBins > 256 ){
+        errorLog << "train(LabelledClassificationData &trainingData) - The number of histogram bins must be in the range [2 256]!" << endl;
+        return false;
+    }
+
+    numFeatures = N;
+    numClasses = K;
+    classLabels = trainingData.getClassLabels();
+    ranges = trainingData.getRanges();
+
+    //Pack the training data into one row-major buffer and convert the class labels to class indexs
+    VectorDouble inputs( (size_t)M*N );
+    vector< UINT > labels( M );
+    for(UINT i=0; i<M; i++){
+        LabelledClassificationSample &sample = trainingData[i];
+        labels[i] = getClassLabelIndexValue( sample.getClassLabel() );
+        double *x = &inputs[ (size_t)i*N ];
+        for(UINT n=0; n<N; n++){
+            x[n] = useScaling ? scale(sample[n],ranges[n].minValue,ranges[n].maxValue,0,1) : sample[n];
+        }
+    }
+
+    //Compute the histogram bin edges of each feature from the quantiles of its training values. Each edge is a training value, so
+    //the thresholds of the trees are always values that were seen in the training data
+    binEdges.resize( N );
+    Parallel::forEach(N,[&](UINT workerIndex,UINT n){
+        VectorDouble values( M );
+        for(UINT i=0; i<M; i++){
+            values[i] = inputs[ (size_t)i*N+n ];
+        }
+        std::sort(values.begin(),values.end());
+
+        VectorDouble &edges = binEdges[n];
+        edges.clear();
+        for(UINT b=1; b<numHistogramBins; b++){
+            const double edge = values[ (size_t)b*M/numHistogramBins ];
+            if( edge < values[M-1] && (edges.size() == 0 || edge > edges.back()) ){
+                edges.push_back( edge );
+            }
+        }
+    });
+
+    //Quantise the training data, the bin of a value is the number of edges below it
+    vector< unsigned char > bins( (size_t)M*N );
+    for(UINT i=0; i<M; i++){
+        for(UINT n=0; n<N; n++){
+            const VectorDouble &edges = binEdges[n];
+            bins[ (size_t)i*N+n ] = (unsigned char)( std::lower_bound(edges.begin(),edges.end(),inputs[(size_t)i*N+n]) - edges.begin() );
+        }
+    }
+
+    //Give each tree its own seed, drawn in order, so the forest does not depend on the order the trees are trained in
+    Random random( randomSeed );
+    vector< unsigned long long > treeSeeds( forestSize );
+    for(UINT t=0; t<forestSize; t++){
+        treeSeeds[t] = (unsigned long long)random.getRandomNumberInt(1,numeric_limits<int>::max());
+    }
+
+    //Train the trees, the trees are independent so they are trained in parallel
+    vector< Tree > trees( forestSize );
+    vector< unsigned char > inBag( (size_t)forestSize*M, 0 );
+    vector< UINT > treeTrained( forestSize, 0 );
+    Parallel::forEach(forestSize,[&](UINT workerIndex,UINT t){
+        Random treeRandom( treeSeeds[t] );
+
+        //Draw the bootstrapped dataset as a list of sample indexes, recording which samples were used so the rest can be used as out-of-bag samples
+        vector< UINT > sampleIndexes( M );
+        for(UINT i=0; i<M; i++){
+            sampleIndexes[i] = (UINT)treeRandom.getRandomNumberInt(0,M);
+            inBag[ (size_t)t*M + sampleIndexes[i] ] = 1;
+        }
+
+        treeTrained[t] = trainTree(bins,labels,sampleIndexes,treeRandom,trees[t]) ? 1 : 0;
+    });
+
+    for(UINT t=0; t<forestSize; t++){
+        if( !treeTrained[t] ){
+            errorLog << "train(LabelledClassificationData &trainingData) - Failed to train tree " << t << "!" << endl;
+            clear();
+            return false;
+        }
+    }
+
+    //Compile the trees into the flat node arrays, in tree order
+    treeRoots.resize( forestSize );
+    treeDepths.resize( forestSize );
+    for(UINT t=0; t<forestSize; t++){
+        const Tree &tree = trees[t];
+        const UINT nodeOffset = (UINT)nodeChildren.size();
+        const UINT leafOffset = (UINT)leafValues.size();
+        treeRoots[t] = nodeOffset;
+        treeDepths[t] = tree.depth;
+        for(UINT j=0; j<tree.children.size(); j++){
+            nodeFeatureIndex.push_back( tree.featureIndex[j] );
+            nodeThreshold.push_back( tree.threshold[j] );
+            nodeChildren.push_back( tree.children[j] + nodeOffset );
+            nodeLeafOffset.push_back( tree.leafOffset[j] + leafOffset );
+        }
+        leafValues.insert(leafValues.end(),tree.leafValues.begin(),tree.leafValues.end());
+
+        trainingLog << "Tree: " << t << " NumNodes: " << tree.children.size() << " Depth: " << treeDepths[t] << endl;
+        trees[t] = Tree();
+    }
+
+    //Flag that the algorithm has been trained so the out-of-bag likelihoods can be computed
+    trained = true;
+
+    computeOutOfBagLikelihoods(inputs,labels,inBag);
+    recomputeNullRejectionThresholds();
+
+    //Resize the prediction results to make sure it is setup for realtime prediction
+    classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
+    classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
+    binEdges.clear();
+
+    return true;
+}
+
+bool RandomForest::trainTree(const vector< unsigned char > &bins,const vector< UINT > &labels,vector< UINT > &sampleIndexes,Random &random,Tree &tree){
+
+    struct NodeData{
+        UINT node;
+        UINT start;
+        UINT end;
+        UINT depth;
+    };
+
+    const UINT N = numFeatures;
+    const UINT K = numClasses;
+    UINT numFeaturesPerSplit = numRandomFeatures > 0 ? numRandomFeatures : (UINT)( sqrt(double(N)) + 0.5 );
+    if( numFeaturesPerSplit > N ) numFeaturesPerSplit = N;
+
+    vector< UINT > featureOrder( N );
+    for(UINT n=0; n<N; n++) featureOrder[n] = n;
+    vector< UINT > classCounts( K );
+    vector< UINT > leftCounts( K );
+    vector< UINT > histogram( (size_t)numHistogramBins*K );
+
+    //Add the root node, the tree is grown depth first but the two children of a node are always added together
+    tree.featureIndex.assign(1,0);
+    tree.threshold.assign(1,0);
+    tree.children.assign(1,0);
+    tree.leafOffset.assign(1,0);
+    tree.leafValues.clear();
+    tree.depth = 0;
+
+    vector< NodeData > stack;
+    NodeData root = {0,0,(UINT)sampleIndexes.size(),0};
+    stack.push_back( root );
+
+    while( stack.size() > 0 ){
+        const NodeData nodeData = stack.back();
+        stack.pop_back();
+
+        const UINT numSamples = nodeData.end - nodeData.start;
+        UINT *indexes = &sampleIndexes[ nodeData.start ];
+
+        //Count the classes at this node
+        std::fill(classCounts.begin(),classCounts.end(),0);
+        for(UINT i=0; i<numSamples; i++){
+            classCounts[ labels[ indexes[i] ] ]++;
+        }
+
+        double parentScore = 0;
+        UINT numNonZeroClasses = 0;
+        for(UINT k=0; k<K; k++){
+            parentScore += double(classCounts[k])*classCounts[k];
+            if( classCounts[k] > 0 ) numNonZeroClasses++;
+        }
+        parentScore /= numSamples;
+
+        //Find the best split, the gini impurity is minimized by maximizing sum(left^2)/numLeft + sum(right^2)/numRight
+        UINT bestFeature = 0;
+        UINT bestBin = 0;
+        double bestScore = parentScore + 1.0e-10;
+        bool splitFound = false;
+
+        if( nodeData.depth < maxDepth && numSamples >= minNumSamplesPerNode && numNonZeroClasses > 1 ){
+            for(UINT j=0; j<numFeaturesPerSplit; j++){
+                //Pick the next random feature, using a partial Fisher-Yates shuffle
+                std::swap(featureOrder[j],featureOrder[ random.getRandomNumberInt(j,N) ]);
+                const UINT n = featureOrder[j];
+                const UINT numBins = (UINT)binEdges[n].size() + 1;
+                if( numBins < 2 ) continue;
+
+                //Build the class histogram of this feature
+                std::fill(histogram.begin(),histogram.begin()+(size_t)numBins*K,0);
+                for(UINT i=0; i<numSamples; i++){
+                    const UINT index = indexes[i];
+                    histogram[ bins[ (size_t)index*N+n ]*K + labels[index] ]++;
+                }
+
+                //Scan the bins, trying each bin edge as the threshold
+                std::fill(leftCounts.begin(),leftCounts.end(),0);
+                UINT numLeft = 0;
+                for(UINT b=0; b+1<numBins; b++){
+                    const UINT *row = &histogram[ (size_t)b*K ];
+                    for(UINT k=0; k<K; k++){
+                        leftCounts[k] += row[k];
+                        numLeft += row[k];
+                    }
+                    if( numLeft == 0 ) continue;
+                    const UINT numRight = numSamples - numLeft;
+                    if( numRight == 0 ) break;
+
+                    double leftScore = 0;
+                    double rightScore = 0;
+                    for(UINT k=0; k<K; k++){
+                        const double left = leftCounts[k];
+                        const double right = double(classCounts[k]) - left;
+                        leftScore += left*left;
+                        rightScore += right*right;
+                    }
+                    const double score = leftScore/numLeft + rightScore/numRight;
+                    if( score > bestScore ){
+                        bestScore = score;
+                        bestFeature = n;
+                        bestBin = b;
+                        splitFound = true;
+                    }
+                }
+            }
+        }
+
+        if( !splitFound ){
+            //Make this node a leaf, the leaf points back to itself with an infinite threshold
+            tree.featureIndex[ nodeData.node ] = 0;
+            tree.threshold[ nodeData.node ] = numeric_limits< double >::infinity();
+            tree.children[ nodeData.node ] = nodeData.node;
+            tree.leafOffset[ nodeData.node ] = (UINT)tree.leafValues.size();
+            for(UINT k=0; k<K; k++){
+                tree.leafValues.push_back( double(classCounts[k]) / numSamples );
+            }
+            if( nodeData.depth > tree.depth ) tree.depth = nodeData.depth;
+            continue;
+        }
+
+        //Split the samples, the samples in bins [0 bestBin] go to the left child
+        UINT *middle = std::partition(indexes,indexes+numSamples,[&](UINT index){ return bins[ (size_t)index*N+bestFeature ] <= bestBin; });
+        const UINT numLeft = (UINT)(middle - indexes);
+
+        const UINT leftChild = (UINT)tree.children.size();
+        tree.featureIndex[ nodeData.node ] = bestFeature;
+        tree.threshold[ nodeData.node ] = binEdges[ bestFeature ][ bestBin ];
+        tree.children[ nodeData.node ] = leftChild;
+        tree.leafOffset[ nodeData.node ] = 0;
+        for(UINT j=0; j<2; j++){
+            tree.featureIndex.push_back( 0 );
+            tree.threshold.push_back( 0 );
+            tree.children.push_back( 0 );
+            tree.leafOffset.push_back( 0 );
+        }
+
+        NodeData right = {leftChild+1,nodeData.start+numLeft,nodeData.end,nodeData.depth+1};
+        NodeData left = {leftChild,nodeData.start,nodeData.start+numLeft,nodeData.depth+1};
+        stack.push_back( right );
+        stack.push_back( left );
+    }
+
+    return true;
+}
+
+void RandomForest::computeOutOfBagLikelihoods(const VectorDouble &inputs,const vector< UINT > &labels,const vector< unsigned char > &inBag){
+
+    const UINT M = (UINT)labels.size();
+    const UINT K = numClasses;
+    const UINT numTrees = (UINT)treeRoots.size();
+
+    //Predict each training sample with the trees that did not see it, recording the class it was predicted as and the likelihood
+    //of that class. Samples that were in the bag of every tree are given the index K and skipped
+    vector< IndexedDouble > predictionResults( M );
+    const UINT numChunks = (M + GRT_RANDOM_FOREST_CHUNK_SIZE - 1) / GRT_RANDOM_FOREST_CHUNK_SIZE;
+    Parallel::forEach(numChunks,[&](UINT workerIndex,UINT c){
+        const UINT start = c*GRT_RANDOM_FOREST_CHUNK_SIZE;
+        const UINT end = start+GRT_RANDOM_FOREST_CHUNK_SIZE < M ? start+GRT_RANDOM_FOREST_CHUNK_SIZE : M;
+        VectorDouble likelihoods( K );
+        for(UINT i=start; i<end; i++){
+            std::fill(likelihoods.begin(),likelihoods.end(),0.0);
+            UINT numOutOfBagTrees = 0;
+            for(UINT t=0; t<numTrees; t++){
+                if( inBag[ (size_t)t*M+i ] ) continue;
+                accumulateLeafValues(&inputs[ (size_t)i*numFeatures ],t,&likelihoods[0]);
+                numOutOfBagTrees++;
+            }
+
+            predictionResults[i].index = K;
+            predictionResults[i].value = 0;
+            if( numOutOfBagTrees == 0 ) continue;
+
+            UINT maxIndex = 0;
+            for(UINT k=1; k<K; k++){
+                if( likelihoods[k] > likelihoods[maxIndex] ) maxIndex = k;
+            }
+            predictionResults[i].index = maxIndex;
+            predictionResults[i].value = likelihoods[maxIndex] / numOutOfBagTrees;
+        }
+    });
+
+    //Compute the mean and standard deviation of the likelihoods for each class, in sample order
+    VectorDouble counter(K,0);
+    trainingMu.assign(K,0);
+    trainingSigma.assign(K,0);
+    for(UINT i=0; i<M; i++){
+        if( predictionResults[i].index == K ) continue;
+        trainingMu[ predictionResults[i].index ] += predictionResults[i].value;
+        counter[ predictionResults[i].index ]++;
+    }
+
+    for(UINT k=0; k<K; k++){
+        if( counter[k] > 0 ) trainingMu[k] /= counter[k];
+    }
+
+    for(UINT i=0; i<M; i++){
+        if( predictionResults[i].index == K ) continue;
+        trainingSigma[ predictionResults[i].index ] += SQR( predictionResults[i].value - trainingMu[ predictionResults[i].index ] );
+    }
+
+    for(UINT k=0; k<K; k++){
+        if( counter[k] > 1 ) trainingSigma[k] = sqrt( trainingSigma[k] / (counter[k]-1) );
+        else trainingSigma[k] = 0;
+
+        if( counter[k] == 0 ){
+            warningLog << "computeOutOfBagLikelihoods(...) - There are no out-of-bag predictions for class " << classLabels[k] << ", null rejection will not reject this class!" << endl;
+        }
+    }
+}
+
+bool RandomForest::predict_(VectorDouble &inputVector){
+
+    predictedClassLabel = 0;
+	maxLikelihood = 0;
+    bestDistance = 0;
+
+    if( !trained ){
+        errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
+        return false;
+    }
+
+	if( inputVector.size() != numFeatures ){
+        errorLog << "predict(VectorDouble inputVector) - The size of the input vector (" << inputVector.size() << ") does not match the num features in the model (" << numFeatures << endl;
+		return false;
+	}
+
+    if( useScaling ){
+        for(UINT n=0; n<numFeatures; n++){
+            inputVector[n] = scale(inputVector[n], ranges[n].minValue, ranges[n].maxValue, 0, 1);
+        }
+    }
+
+    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses);
+    if( classDistances.size() != numClasses ) classDistances.resize(numClasses);
+    std::fill(classLikelihoods.begin(),classLikelihoods.end(),0.0);
+
+    //Walk each tree and average the class distributions of the leaves
+    const UINT numTrees = (UINT)treeRoots.size();
+    for(UINT t=0; t<numTrees; t++){
+        accumulateLeafValues(&inputVector[0],t,&classLikelihoods[0]);
+    }
+
+    UINT maxIndex = 0;
+    for(UINT k=0; k<numClasses; k++){
+        classLikelihoods[k] /= numTrees;
+        classDistances[k] = classLikelihoods[k];
+        if( classLikelihoods[k] > classLikelihoods[maxIndex] ) maxIndex = k;
+    }
+
+    maxLikelihood = classLikelihoods[ maxIndex ];
+    bestDistance = classDistances[ maxIndex ];
+
+    if( useNullRejection ){
+        if( maxLikelihood >= nullRejectionThresholds[ maxIndex ] ){
+            predictedClassLabel = classLabels[ maxIndex ];
+        }else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+    }else predictedClassLabel = classLabels[ maxIndex ];
+
+    return true;
+}
+
+void RandomForest::clear(){
+    trained = false;
+    treeRoots.clear();
+    treeDepths.clear();
+    nodeFeatureIndex.clear();
+    nodeThreshold.clear();
+    nodeChildren.clear();
+    nodeLeafOffset.clear();
+    leafValues.clear();
+    trainingMu.clear();
+    trainingSigma.clear();
+    nullRejectionThresholds.clear();
+    binEdges.clear();
+}
+
+bool RandomForest::recomputeNullRejectionThresholds(){
+
+    if( !trained ) return false;
+
+    nullRejectionThresholds.resize( numClasses );
+    for(UINT k=0; k<numClasses; k++){
+        nullRejectionThresholds[k] = trainingMu[k] - (trainingSigma[k]*nullRejectionCoeff);
+    }
+
+    return true;
+}
+
+bool RandomForest::setNullRejectionCoeff(double nullRejectionCoeff){
+
+    if( nullRejectionCoeff > 0 ){
+        this->nullRejectionCoeff = nullRejectionCoeff;
+        recomputeNullRejectionThresholds();
+        return true;
+    }
+    return false;
+}
+
+bool RandomForest::saveModelToFile(string filename){
+
+    if( !trained ) return false;
+
+	std::fstream file;
+	file.open(filename.c_str(), std::ios::out);
+
+    if( !saveModelToFile( file ) ){
+        return false;
+    }
+
+	file.close();
+
+	return true;
+}
+
+bool RandomForest::saveModelToFile(fstream &file){
+
+    if(!file.is_open())
+	{
+		errorLog <<"saveModelToFile(fstream &file) - The file is not open!" << endl;
+		return false;
+	}
+
+	//Write the header info
+	file << "GRT_RANDOM_FOREST_MODEL_FILE_V1.0\n";
+    file << "Trained: " << trained << endl;
+    file << "NumFeatures: " << numFeatures << endl;
+	file << "NumClasses: " << numClasses << endl;
+    file << "UseScaling: " << useScaling << endl;
+    file << "UseNullRejection: " << useNullRejection << endl;
+    file << "NullRejectionCoeff: " << nullRejectionCoeff << endl;
+    file << "ForestSize: " << forestSize << endl;
+    file << "MaxDepth: " << maxDepth << endl;
+    file << "MinNumSamplesPerNode: " << minNumSamplesPerNode << endl;
+    file << "NumRandomFeatures: " << numRandomFeatures << endl;
+    file << "NumHistogramBins: " << numHistogramBins << endl;
+
+    if( !trained ) return true;
+
+    ///Write the ranges if needed
+    if( useScaling ){
+        file << "Ranges: \n";
+        for(UINT n=0; n<ranges.size(); n++){
+            file << ranges[n].minValue << "\t" << ranges[n].maxValue << endl;
+        }
+    }
+
+    //Save the class labels
+    file << "ClassLabels: ";
+    for(UINT k=0; k<numClasses; k++){
+        file << classLabels[k];
+        if( k < numClasses-1 ) file << "\t";
+        else file << "\n";
+    }
+
+    file << "TrainingMu: ";
+    for(UINT k=0; k<numClasses; k++){
+        file << trainingMu[k] << "\t";
+    }file << endl;
+
+    file << "TrainingSigma: ";
+    for(UINT k=0; k<numClasses; k++){
+        file << trainingSigma[k] << "\t";
+    }file << endl;
+
+    //The thresholds are training values, so they are saved at full precision to make sure the loaded forest splits the same way
+    const std::streamsize precision = file.precision( 17 );
+
+    file << "NumTrees: " << treeRoots.size() << endl;
+    file << "Trees: \n";
+    for(UINT t=0; t<treeRoots.size(); t++){
+        file << treeRoots[t] << "\t" << treeDepths[t] << endl;
+    }
+
+    //Each node is saved as: featureIndex child leafOffset threshold, a node is a leaf if its child is itself
+    file << "NumNodes: " << nodeChildren.size() << endl;
+    file << "Nodes: \n";
+    for(UINT j=0; j<nodeChildren.size(); j++){
+        const bool isLeaf = nodeChildren[j] == j;
+        file << nodeFeatureIndex[j] << "\t" << nodeChildren[j] << "\t" << nodeLeafOffset[j] << "\t" << (isLeaf ? 0 : nodeThreshold[j]) << endl;
+    }
+
+    file << "NumLeafValues: " << leafValues.size() << endl;
+    file << "LeafValues: \n";
+    for(UINT j=0; j<leafValues.size(); j+=numClasses){
+        for(UINT k=0; k<numClasses; k++){
+            file << leafValues[j+k];
+            if( k < numClasses-1 ) file << "\t";
+            else file << "\n";
+        }
+    }
+
+    file.precision( precision );
+
+    return true;
+}
+
+bool RandomForest::loadModelFromFile(string filename){
+
+	std::fstream file;
+	file.open(filename.c_str(), std::ios::in);
+
+    if( !loadModelFromFile( file ) ){
+        return false;
+    }
+
+    file.close();
+
+	return true;
+}
+
+bool RandomForest::loadModelFromFile(fstream &file){
+
+    clear();
+    numFeatures = 0;
+    numClasses = 0;
+    classLabels.clear();
+
+    if(!file.is_open())
+    {
+        errorLog << "loadModelFromFile(string filename) - Could not open file to load model" << endl;
+        return false;
+    }
+
+    std::string word;
+    bool modelTrained = false;
+
+    //Find the file type header
+    file >> word;
+    if(word != "GRT_RANDOM_FOREST_MODEL_FILE_V1.0"){
+        errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
+        return false;
+    }
+
+    file >> word;
+    if(word != "Trained:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find Trained Header" << endl;
+        return false;
+    }
+    file >> modelTrained;
+
+    file >> word;
+    if(word != "NumFeatures:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures!" << endl;
+        return false;
+    }
+    file >> numFeatures;
+
+    file >> word;
+    if(word != "NumClasses:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumClasses!" << endl;
+        return false;
+    }
+    file >> numClasses;
+
+    file >> word;
+    if(word != "UseScaling:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find UseScaling!" << endl;
+        return false;
+    }
+    file >> useScaling;
+
+    file >> word;
+    if(word != "UseNullRejection:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find UseNullRejection!" << endl;
+        return false;
+    }
+    file >> useNullRejection;
+
+    file >> word;
+    if(word != "NullRejectionCoeff:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NullRejectionCoeff!" << endl;
+        return false;
+    }
+    file >> nullRejectionCoeff;
+
+    file >> word;
+    if(word != "ForestSize:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find ForestSize!" << endl;
+        return false;
+    }
+    file >> forestSize;
+
+    file >> word;
+    if(word != "MaxDepth:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find MaxDepth!" << endl;
+        return false;
+    }
+    file >> maxDepth;
+
+    file >> word;
+    if(word != "MinNumSamplesPerNode:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find MinNumSamplesPerNode!" << endl;
+        return false;
+    }
+    file >> minNumSamplesPerNode;
+
+    file >> word;
+    if(word != "NumRandomFeatures:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumRandomFeatures!" << endl;
+        return false;
+    }
+    file >> numRandomFeatures;
+
+    file >> word;
+    if(word != "NumHistogramBins:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumHistogramBins!" << endl;
+        return false;
+    }
+    file >> numHistogramBins;
+
+    if( !modelTrained ) return true;
+
+    ///Read the ranges if needed
+    if( useScaling ){
+        //Resize the ranges buffer
+        ranges.resize(numFeatures);
+
+        file >> word;
+        if(word != "Ranges:"){
+            errorLog << "loadModelFromFile(string filename) - Could not find the Ranges!" << endl;
+            return false;
+        }
+        for(UINT n=0; n<ranges.size(); n++){
+            file >> ranges[n].minValue;
+            file >> ranges[n].maxValue;
+        }
+    }
+
+    //Load the class labels
+    file >> word;
+    if(word != "ClassLabels:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find the ClassLabels!" << endl;
+        return false;
+    }
+    classLabels.resize( numClasses );
+    for(UINT k=0; k<numClasses; k++){
+        file >> classLabels[k];
+    }
+
+    file >> word;
+    if(word != "TrainingMu:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find TrainingMu!" << endl;
+        return false;
+    }
+    trainingMu.resize( numClasses );
+    for(UINT k=0; k<numClasses; k++){
+        file >> trainingMu[k];
+    }
+
+    file >> word;
+    if(word != "TrainingSigma:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find TrainingSigma!" << endl;
+        return false;
+    }
+    trainingSigma.resize( numClasses );
+    for(UINT k=0; k<numClasses; k++){
+        file >> trainingSigma[k];
+    }
+
+    UINT numTrees = 0;
+    file >> word;
+    if(word != "NumTrees:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumTrees!" << endl;
+        return false;
+    }
+    file >> numTrees;
+
+    file >> word;
+    if(word != "Trees:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find Trees!" << endl;
+        return false;
+    }
+    treeRoots.resize( numTrees );
+    treeDepths.resize( numTrees );
+    for(UINT t=0; t<numTrees; t++){
+        file >> treeRoots[t];
+        file >> treeDepths[t];
+    }
+
+    UINT numNodes = 0;
+    file >> word;
+    if(word != "NumNodes:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumNodes!" << endl;
+        return false;
+    }
+    file >> numNodes;
+
+    file >> word;
+    if(word != "Nodes:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find Nodes!" << endl;
+        return false;
+    }
+    nodeFeatureIndex.resize( numNodes );
+    nodeThreshold.resize( numNodes );
+    nodeChildren.resize( numNodes );
+    nodeLeafOffset.resize( numNodes );
+    for(UINT j=0; j<numNodes; j++){
+        file >> nodeFeatureIndex[j];
+        file >> nodeChildren[j];
+        file >> nodeLeafOffset[j];
+        file >> nodeThreshold[j];
+        if( nodeChildren[j] == j ) nodeThreshold[j] = numeric_limits< double >::infinity();
+    }
+
+    UINT numLeafValues = 0;
+    file >> word;
+    if(word != "NumLeafValues:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find NumLeafValues!" << endl;
+        return false;
+    }
+    file >> numLeafValues;
+
+    file >> word;
+    if(word != "LeafValues:"){
+        errorLog << "loadModelFromFile(string filename) - Could not find LeafValues!" << endl;
+        return false;
+    }
+    leafValues.resize( numLeafValues );
+    for(UINT j=0; j<numLeafValues; j++){
+        file >> leafValues[j];
+    }
+
+    //Check the forest is valid, so the predict function never reads outside the node arrays
+    if( numTrees == 0 ){
+        errorLog << "loadModelFromFile(string filename) - The forest has no trees!" << endl;
+        clear();
+        return false;
+    }
+    for(UINT t=0; t<numTrees; t++){
+        if( treeRoots[t] >= numNodes ){
+            errorLog << "loadModelFromFile(string filename) - The root of tree " << t << " is not a valid node!" << endl;
+            clear();
+            return false;
+        }
+    }
+    for(UINT j=0; j<numNodes; j++){
+        const bool isLeaf = nodeChildren[j] == j;
+        const bool validChild = isLeaf || (size_t)nodeChildren[j]+1 < numNodes;
+        const bool validLeaf = !isLeaf || (size_t)nodeLeafOffset[j]+numClasses <= leafValues.size();
+        if( !validChild || !validLeaf || nodeFeatureIndex[j] >= numFeatures ){
+            errorLog << "loadModelFromFile(string filename) - Node " << j << " is not valid!" << endl;
+            clear();
+            return false;
+        }
+    }
+
+    //Flag that the model has been trained
+    trained = true;
+
+    //Compute the null rejection thresholds
+    recomputeNullRejectionThresholds();
+
+    //Resize the prediction results to make sure it is setup for realtime prediction
+    maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
+    bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
+    classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
+    classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
+
+    return true;
+}
+
+bool RandomForest::setForestSize(UINT forestSize){
+    if( forestSize > 0 ){
+        this->forestSize = forestSize;
+        return true;
+    }
+    return false;
+}
+
+bool RandomForest::setMaxDepth(UINT maxDepth){
+    if( maxDepth > 0 ){
+        this->maxDepth = maxDepth;
+        return true;
+    }
+    return false;
+}
+
+bool RandomForest::setMinNumSamplesPerNode(UINT minNumSamplesPerNode){
+    if( minNumSamplesPerNode >= 2 ){
+        this->minNumSamplesPerNode = minNumSamplesPerNode;
+        return true;
+    }
+    return false;
+}
+
+bool RandomForest::setNumRandomFeatures(UINT numRandomFeatures){
+    this->numRandomFeatures = numRandomFeatures;
+    return true;
+}
+
+bool RandomForest::setNumHistogramBins(UINT numHistogramBins){
+    if( numHistogramBins >= 2 && numHistogramBins <= 256 ){
+        this->numHistogramBins = numHistogramBins;
+        return true;
+    }
+    return false;
+}
+
+bool RandomForest::setRandomSeed(unsigned long long randomSeed){
+    this->randomSeed = randomSeed;
+    return true;
+}
+
+} //End of namespace GRT
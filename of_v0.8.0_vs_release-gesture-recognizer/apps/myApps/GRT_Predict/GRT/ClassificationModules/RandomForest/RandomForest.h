@@ -0,0 +1,289 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @brief This class implements a Random Forest classifier. A Random Forest is an ensemble of decision trees, each tree is
+ trained on a bootstrapped copy of the training data and each split only considers a random subset of the features. The
+ prediction is the average of the class distributions at the leaves each tree reaches.
+
+ Each feature is quantised into a small number of histogram bins (using the quantiles of the training data) before training,
+ so finding the best split at a node only needs one pass over its samples to build the class histogram of each candidate
+ feature. The trees are trained in parallel.
+
+ Once trained, the trees are compiled into flat node arrays (the feature index, threshold and child index of every node are
+ stored in separate arrays), with the two children of a node stored next to each other. Each leaf points back to itself
+ with an infinite threshold, so the predict function walks each tree for exactly the depth of that tree without checking
+ for leaves, and the cost of a prediction only depends on the depth of the trees.
+
+ If null rejection is enabled, a prediction is rejected if the likelihood of the predicted class is below the rejection
+ threshold of that class. The thresholds are computed from the out-of-bag likelihoods of the training samples, as
+ trainingMu - trainingSigma * nullRejectionCoeff.
+ */
+
+#ifndef GRT_RANDOM_FOREST_HEADER
+#define GRT_RANDOM_FOREST_HEADER
+
+#include "../../GestureRecognitionPipeline/Classifier.h"
+
+namespace GRT{
+
+class RandomForest : public Classifier
+{
+public:
+    /**
+     Default Constructor
+
+     @param UINT forestSize: the number of trees in the forest. Default value = 10
+     @param UINT maxDepth: the maximum depth of each tree. Default value = 10
+     @param UINT minNumSamplesPerNode: nodes with fewer training samples than this will not be split. Default value = 5
+     @param bool useScaling: sets if the training and real-time data should be scaled between [0 1]. Default value = false
+     @param bool useNullRejection: sets if null rejection will be used for the realtime prediction. Default value = false
+     @param double nullRejectionCoeff: sets the null rejection coefficient, this is a multipler controlling the null rejection threshold for each class. Default value = 3.0
+     */
+	RandomForest(UINT forestSize=10,UINT maxDepth=10,UINT minNumSamplesPerNode=5,bool useScaling=false,bool useNullRejection=false,double nullRejectionCoeff=3.0);
+
+    /**
+     Default Destructor
+     */
+	virtual ~RandomForest(void);
+
+    /**
+     Defines how the data from the rhs RandomForest should be copied to this RandomForest
+
+     @param const RandomForest &rhs: another instance of a RandomForest
+     @return returns a pointer to this instance of the RandomForest
+     */
+	RandomForest &operator=(const RandomForest &rhs);
+
+    /**
+     This is required for the Gesture Recognition Pipeline for when the pipeline.setClassifier(...) method is called.
+     It clones the data from the Base Class Classifier pointer (which should be pointing to a RandomForest instance) into this instance
+
+     @param Classifier *classifier: a pointer to the Classifier Base Class, this should be pointing to another RandomForest instance
+     @return returns true if the clone was successfull, false otherwise
+    */
+	virtual bool clone(const Classifier *classifier);
+
+    /**
+     This trains the RandomForest model, using the labelled classification data.
+     This overrides the train function in the Classifier base class.
+
+     @param LabelledClassificationData &trainingData: a reference to the training data
+     @return returns true if the RandomForest model was trained, false otherwise
+    */
+    virtual bool train(LabelledClassificationData &trainingData);
+
+    /**
+     This predicts the class of the inputVector.
+     This overrides the predict_ function in the Classifier base class.
+
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predict_(VectorDouble &inputVector);
+
+    /**
+     This saves the trained RandomForest model to a file.
+     This overrides the saveModelToFile function in the Classifier base class.
+
+     @param string filename: the name of the file to save the RandomForest model to
+     @return returns true if the model was saved successfully, false otherwise
+    */
+    virtual bool saveModelToFile(string filename);
+
+    /**
+     This saves the trained RandomForest model to a file.
+     This overrides the saveModelToFile function in the Classifier base class.
+
+     @param fstream &file: a reference to the file the RandomForest model will be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveModelToFile(fstream &file);
+
+    /**
+     This loads a trained RandomForest model from a file.
+     This overrides the loadModelFromFile function in the Classifier base class.
+
+     @param string filename: the name of the file to load the RandomForest model from
+     @return returns true if the model was loaded successfully, false otherwise
+    */
+    virtual bool loadModelFromFile(string filename);
+
+    /**
+     This loads a trained RandomForest model from a file.
+     This overrides the loadModelFromFile function in the Classifier base class.
+
+     @param fstream &file: a reference to the file the RandomForest model will be loaded from
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadModelFromFile(fstream &file);
+
+    /**
+     This recomputes the null rejection thresholds for each class from the out-of-bag training likelihoods.
+     This overrides the recomputeNullRejectionThresholds function in the Classifier base class.
+
+     @return returns true if the null rejection thresholds were updated successfully, false otherwise
+     */
+    virtual bool recomputeNullRejectionThresholds();
+
+    /**
+     Sets the nullRejectionCoeff parameter and recomputes the null rejection thresholds.
+
+     @param double nullRejectionCoeff: the new null rejection coefficient, this should be greater than zero
+     @return returns true if the nullRejectionCoeff was updated successfully, false otherwise
+     */
+    virtual bool setNullRejectionCoeff(double nullRejectionCoeff);
+
+    UINT getForestSize() const{ return forestSize; }
+    UINT getMaxDepth() const{ return maxDepth; }
+    UINT getMinNumSamplesPerNode() const{ return minNumSamplesPerNode; }
+    UINT getNumRandomFeatures() const{ return numRandomFeatures; }
+    UINT getNumHistogramBins() const{ return numHistogramBins; }
+
+    /**
+     Gets the total number of nodes (split nodes and leaves) in the trained forest.
+
+     @return returns the number of nodes, this will be zero if the model has not been trained
+     */
+    UINT getNumNodes() const{ return (UINT)nodeChildren.size(); }
+
+    /**
+     Gets the depth of each tree in the trained forest, this is the number of steps the predict function takes through each tree.
+
+     @return returns the depth of each tree
+     */
+    vector< UINT > getTreeDepths() const{ return treeDepths; }
+
+    /**
+     Sets the number of trees in the forest. This must be greater than zero and will be used the next time the model is trained.
+
+     @param UINT forestSize: the new number of trees
+     @return returns true if the parameter was updated
+     */
+    bool setForestSize(UINT forestSize);
+
+    /**
+     Sets the maximum depth of each tree. This must be greater than zero and will be used the next time the model is trained.
+
+     @param UINT maxDepth: the new maximum depth
+     @return returns true if the parameter was updated
+     */
+    bool setMaxDepth(UINT maxDepth);
+
+    /**
+     Sets the minimum number of training samples a node needs to be split. This must be at least 2.
+
+     @param UINT minNumSamplesPerNode: the new minimum number of samples
+     @return returns true if the parameter was updated
+     */
+    bool setMinNumSamplesPerNode(UINT minNumSamplesPerNode);
+
+    /**
+     Sets the number of features that are randomly chosen as split candidates at each node. If this is zero (the default) then
+     the square root of the number of features is used.
+
+     @param UINT numRandomFeatures: the new number of random features
+     @return returns true if the parameter was updated
+     */
+    bool setNumRandomFeatures(UINT numRandomFeatures);
+
+    /**
+     Sets the maximum number of histogram bins each feature is quantised into, this must be in the range [2 256]. More bins give
+     finer thresholds but make each split slower to find.
+
+     @param UINT numHistogramBins: the new number of bins
+     @return returns true if the parameter was updated
+     */
+    bool setNumHistogramBins(UINT numHistogramBins);
+
+    /**
+     Sets the seed used to draw the bootstrapped dataset and the random features of each tree. Each tree gets its own random
+     generator, seeded from this value, so training with the same seed and data will always give the same forest (even though
+     the trees are trained in parallel). If the seed is zero then the system time is used.
+
+     @param unsigned long long randomSeed: the new random seed
+     @return returns true if the random seed was updated
+     */
+    bool setRandomSeed(unsigned long long randomSeed);
+
+protected:
+    /**
+     A tree while it is being trained, before it is compiled into the flat node arrays of the forest.
+     */
+    struct Tree{
+        vector< UINT > featureIndex;
+        VectorDouble threshold;
+        vector< UINT > children;
+        vector< UINT > leafOffset;
+        VectorDouble leafValues;
+        UINT depth;
+    };
+
+    void clear();
+    bool trainTree(const vector< unsigned char > &bins,const vector< UINT > &labels,vector< UINT > &sampleIndexes,Random &random,Tree &tree);
+    UINT addLeaf(const vector< UINT > &labels,const UINT *sampleIndexes,const UINT numSamples,Tree &tree);
+    void computeOutOfBagLikelihoods(const VectorDouble &inputs,const vector< UINT > &labels,const vector< unsigned char > &inBag);
+
+    /**
+     Walks each tree for the input x and adds the class distribution of the leaf it reaches to likelihoods.
+     */
+    inline void accumulateLeafValues(const double *x,const UINT treeIndex,double *likelihoods) const{
+        UINT node = treeRoots[ treeIndex ];
+        for(UINT d=0; d<treeDepths[ treeIndex ]; d++){
+            //Leaves have an infinite threshold and point back to themselves, so the walk stays at the leaf once it gets there
+            node = nodeChildren[ node ] + ( x[ nodeFeatureIndex[ node ] ] > nodeThreshold[ node ] ? 1 : 0 );
+        }
+        const double *values = &leafValues[ nodeLeafOffset[ node ] ];
+        for(UINT k=0; k<numClasses; k++){
+            likelihoods[k] += values[k];
+        }
+    }
+
+    UINT forestSize;
+    UINT maxDepth;
+    UINT minNumSamplesPerNode;
+    UINT numRandomFeatures;                 //The number of features tried at each split, zero means sqrt(numFeatures)
+    UINT numHistogramBins;
+    unsigned long long randomSeed;          //The seed used to train the forest, zero means the system time is used
+
+    //The compiled forest, the nodes of all the trees are stored in these arrays
+    vector< UINT > treeRoots;               //The index of the root node of each tree
+    vector< UINT > treeDepths;              //The depth of each tree
+    vector< UINT > nodeFeatureIndex;        //The feature each node splits on
+    VectorDouble nodeThreshold;             //Samples go to the right child if feature > threshold, this is infinite for leaves
+    vector< UINT > nodeChildren;            //The index of the left child of each node (the right child is the next node), leaves point to themselves
+    vector< UINT > nodeLeafOffset;          //The offset of the class distribution of each leaf in leafValues
+    VectorDouble leafValues;                //The class distribution of each leaf, numClasses values per leaf
+
+    VectorDouble trainingMu;                //The mean out-of-bag likelihood of each class for its own training samples
+    VectorDouble trainingSigma;             //The standard deviation of the out-of-bag likelihood of each class
+
+    //Training buffers
+    vector< VectorDouble > binEdges;        //The histogram bin edges of each feature, a value is in bin b if binEdges[b-1] < value <= binEdges[b]
+
+    static RegisterClassifierModule< RandomForest > registerModule;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_RANDOM_FOREST_HEADER
@@ -1,6 +1,23 @@
 
 #include "libsvm.h"
 
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+	#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define LIBSVM_USE_SSE2
+#endif
+
 namespace LIBSVM {
 
 int libsvm_version = LIBSVM_VERSION;
@@ -33,6 +50,119 @@ static inline double powi(double base, int times)
 #define TAU 1e-12
 #define Malloc(type,n) (type *)malloc((n)*sizeof(type))
 
+//
+// Dense vector helpers, used when every sample stores the feature indices 1..dim without gaps
+//
+static inline double dense_dot(const double *a, const double *b, int n)
+{
+	int k = 0;
+#ifdef LIBSVM_USE_SSE2
+	__m128d s0 = _mm_setzero_pd();
+	__m128d s1 = _mm_setzero_pd();
+	for(; k+4<=n; k+=4)
+	{
+		s0 = _mm_add_pd(s0,_mm_mul_pd(_mm_loadu_pd(a+k),_mm_loadu_pd(b+k)));
+		s1 = _mm_add_pd(s1,_mm_mul_pd(_mm_loadu_pd(a+k+2),_mm_loadu_pd(b+k+2)));
+	}
+	double t[2];
+	_mm_storeu_pd(t,_mm_add_pd(s0,s1));
+	double sum = t[0] + t[1];
+#else
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	for(; k+4<=n; k+=4)
+	{
+		s0 += a[k]*b[k];
+		s1 += a[k+1]*b[k+1];
+		s2 += a[k+2]*b[k+2];
+		s3 += a[k+3]*b[k+3];
+	}
+	double sum = (s0+s1) + (s2+s3);
+#endif
+	for(; k<n; k++)
+		sum += a[k]*b[k];
+	return sum;
+}
+
+static inline double dense_squared_distance(const double *a, const double *b, int n)
+{
+	int k = 0;
+#ifdef LIBSVM_USE_SSE2
+	__m128d s0 = _mm_setzero_pd();
+	__m128d s1 = _mm_setzero_pd();
+	for(; k+4<=n; k+=4)
+	{
+		__m128d d0 = _mm_sub_pd(_mm_loadu_pd(a+k),_mm_loadu_pd(b+k));
+		__m128d d1 = _mm_sub_pd(_mm_loadu_pd(a+k+2),_mm_loadu_pd(b+k+2));
+		s0 = _mm_add_pd(s0,_mm_mul_pd(d0,d0));
+		s1 = _mm_add_pd(s1,_mm_mul_pd(d1,d1));
+	}
+	double t[2];
+	_mm_storeu_pd(t,_mm_add_pd(s0,s1));
+	double sum = t[0] + t[1];
+#else
+	double sum = 0;
+#endif
+	for(; k<n; k++)
+	{
+		double d = a[k] - b[k];
+		sum += d*d;
+	}
+	return sum;
+}
+
+// returns the number of features if all l samples are dense and of equal length, -1 otherwise
+static int dense_dimension(int l, svm_node * const * x)
+{
+	int dim = -1;
+	for(int i=0;i<l;i++)
+	{
+		int k = 0;
+		while(x[i][k].index != -1)
+		{
+			if(x[i][k].index != k+1) return -1;
+			++k;
+		}
+		if(dim == -1) dim = k;
+		else if(dim != k) return -1;
+	}
+	return dim;
+}
+
+// the number of bytes of physical memory currently available, or 0 if it can not be queried
+static double available_memory()
+{
+#if defined(_WIN32)
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	if(GlobalMemoryStatusEx(&status))
+		return (double)status.ullAvailPhys;
+	return 0;
+#elif defined(_SC_AVPHYS_PAGES) && defined(_SC_PAGESIZE)
+	long pages = sysconf(_SC_AVPHYS_PAGES);
+	long page_size = sysconf(_SC_PAGESIZE);
+	if(pages > 0 && page_size > 0)
+		return (double)pages * (double)page_size;
+	return 0;
+#else
+	return 0;
+#endif
+}
+
+// the kernel cache size in bytes: param.cache_size MB, or if that is <= 0, enough for the
+// full l*l matrix capped at a quarter of the available memory
+static long int kernel_cache_size(int l, const svm_parameter& param)
+{
+	double size = param.cache_size*(1<<20);
+	if(param.cache_size <= 0)
+	{
+		double full = (double)l * (double)l * sizeof(Qfloat) + (double)l * 64;
+		double avail = available_memory() / 4;
+		if(avail <= 0) avail = 100.0*(1<<20);
+		size = min(full,avail);
+	}
+	return (long int)min(size,(double)LONG_MAX);
+}
+
 static void print_string_stdout(const char *s)
 {
 	fputs(s,stdout);
@@ -70,9 +200,12 @@ public:
 	// (p >= len if nothing needs to be filled)
 	int get_data(const int index, Qfloat **data, int len);
 	void swap_index(int i, int j);	
+	void print_statistics() const;
 private:
 	int l;
 	long int size;
+	double hits;		// requests answered without computing any kernel value
+	double misses;
 	struct head_t
 	{
 		head_t *prev, *next;	// a circular list
@@ -86,7 +219,7 @@ private:
 	void lru_insert(head_t *h);
 };
 
-Cache::Cache(int l_,long int size_):l(l_),size(size_)
+Cache::Cache(int l_,long int size_):l(l_),size(size_),hits(0),misses(0)
 {
 	head = (head_t *)calloc(l,sizeof(head_t));	// initialized to 0
 	size /= sizeof(Qfloat);
@@ -126,6 +259,8 @@ int Cache::get_data(const int index, Qfloat **data, int len)
 
 	if(more > 0)
 	{
+		++misses;
+
 		// free old space
 		while(size < more)
 		{
@@ -142,12 +277,19 @@ int Cache::get_data(const int index, Qfloat **data, int len)
 		size -= more;
         std::swap(h->len,len);
 	}
+	else ++hits;
 
 	lru_insert(h);
 	*data = h->data;
 	return len;
 }
 
+void Cache::print_statistics() const
+{
+	double total = hits + misses;
+	info("kernel cache: hits = %.0f, misses = %.0f, hit rate = %.2f%%\n",hits,misses,total > 0 ? 100.0*hits/total : 0.0);
+}
+
 void Cache::swap_index(int i, int j)
 {
 	if(i==j) return;
@@ -207,6 +349,7 @@ public:
 	{
 		std::swap(x[i],x[j]);
 		if(x_square) std::swap(x_square[i],x_square[j]);
+		if(dense_x) std::swap(dense_x[i],dense_x[j]);
 	}
 protected:
 
@@ -216,6 +359,11 @@ private:
 	const svm_node **x;
 	double *x_square;
 
+	// dense copy of x, only set if every sample has the same gap-free feature indices
+	int dense_dim;
+	double *dense_data;
+	const double **dense_x;
+
 	// svm_parameter
 	const int kernel_type;
 	const int degree;
@@ -243,6 +391,22 @@ private:
 	{
 		return x[i][(int)(x[j][0].value)].value;
 	}
+	double kernel_linear_dense(int i, int j) const
+	{
+		return dense_dot(dense_x[i],dense_x[j],dense_dim);
+	}
+	double kernel_poly_dense(int i, int j) const
+	{
+		return powi(gamma*dense_dot(dense_x[i],dense_x[j],dense_dim)+coef0,degree);
+	}
+	double kernel_rbf_dense(int i, int j) const
+	{
+		return exp(-gamma*dense_squared_distance(dense_x[i],dense_x[j],dense_dim));
+	}
+	double kernel_sigmoid_dense(int i, int j) const
+	{
+		return tanh(gamma*dense_dot(dense_x[i],dense_x[j],dense_dim)+coef0);
+	}
 };
 
 Kernel::Kernel(int l, svm_node * const * x_, const svm_parameter& param)
@@ -278,12 +442,47 @@ Kernel::Kernel(int l, svm_node * const * x_, const svm_parameter& param)
 	}
 	else
 		x_square = 0;
+
+	// switch to the dense kernels if the samples allow it, this avoids walking the sparse index lists
+	dense_dim = kernel_type == PRECOMPUTED ? -1 : dense_dimension(l,x_);
+	dense_data = 0;
+	dense_x = 0;
+	if(dense_dim > 0)
+	{
+		dense_data = new double[(size_t)l*dense_dim];
+		dense_x = new const double*[l];
+		for(int i=0;i<l;i++)
+		{
+			double *row = dense_data + (size_t)i*dense_dim;
+			for(int k=0;k<dense_dim;k++)
+				row[k] = x_[i][k].value;
+			dense_x[i] = row;
+		}
+
+		switch(kernel_type)
+		{
+			case LINEAR:
+				kernel_function = &Kernel::kernel_linear_dense;
+				break;
+			case POLY:
+				kernel_function = &Kernel::kernel_poly_dense;
+				break;
+			case RBF:
+				kernel_function = &Kernel::kernel_rbf_dense;
+				break;
+			case SIGMOID:
+				kernel_function = &Kernel::kernel_sigmoid_dense;
+				break;
+		}
+	}
 }
 
 Kernel::~Kernel()
 {
 	delete[] x;
 	delete[] x_square;
+	delete[] dense_x;
+	delete[] dense_data;
 }
 
 double Kernel::dot(const svm_node *px, const svm_node *py)
@@ -1265,7 +1464,7 @@ public:
 	:Kernel(prob.l, prob.x, param)
 	{
 		clone(y,y_,prob.l);
-		cache = new Cache(prob.l,(long int)(param.cache_size*(1<<20)));
+		cache = new Cache(prob.l,kernel_cache_size(prob.l,param));
 		QD = new double[prob.l];
 		for(int i=0;i<prob.l;i++)
 			QD[i] = (this->*kernel_function)(i,i);
@@ -1298,6 +1497,7 @@ public:
 
 	~SVC_Q()
 	{
+		cache->print_statistics();
 		delete[] y;
 		delete cache;
 		delete[] QD;
@@ -1314,7 +1514,7 @@ public:
 	ONE_CLASS_Q(const svm_problem& prob, const svm_parameter& param)
 	:Kernel(prob.l, prob.x, param)
 	{
-		cache = new Cache(prob.l,(long int)(param.cache_size*(1<<20)));
+		cache = new Cache(prob.l,kernel_cache_size(prob.l,param));
 		QD = new double[prob.l];
 		for(int i=0;i<prob.l;i++)
 			QD[i] = (this->*kernel_function)(i,i);
@@ -1346,6 +1546,7 @@ public:
 
 	~ONE_CLASS_Q()
 	{
+		cache->print_statistics();
 		delete cache;
 		delete[] QD;
 	}
@@ -1361,7 +1562,7 @@ public:
 	:Kernel(prob.l, prob.x, param)
 	{
 		l = prob.l;
-		cache = new Cache(l,(long int)(param.cache_size*(1<<20)));
+		cache = new Cache(l,kernel_cache_size(l,param));
 		QD = new double[2*l];
 		sign = new schar[2*l];
 		index = new int[2*l];
@@ -1412,6 +1613,7 @@ public:
 
 	~SVR_Q()
 	{
+		cache->print_statistics();
 		delete cache;
 		delete[] sign;
 		delete[] index;
@@ -2998,9 +3200,7 @@ const char *svm_check_parameter(const svm_problem *prob, const svm_parameter *pa
 		return "degree of polynomial kernel < 0";
 
 	// cache_size,eps,C,nu,p,shrinking
-
-	if(param->cache_size <= 0)
-		return "cache_size <= 0";
+	// (cache_size <= 0 sizes the kernel cache from the available memory)
 
 	if(param->eps <= 0)
 		return "eps <= 0";
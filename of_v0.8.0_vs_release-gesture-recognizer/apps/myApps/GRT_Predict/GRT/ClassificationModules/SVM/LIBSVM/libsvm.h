@@ -93,7 +93,7 @@ struct svm_parameter
 	double coef0;	/* for poly/sigmoid */
 
 	/* these are for training only */
-	double cache_size; /* in MB */
+	double cache_size; /* in MB, <= 0 sizes the cache from the available memory */
 	double eps;	/* stopping criteria */
 	double C;	/* for C_SVC, EPSILON_SVR and NU_SVR */
 	int nr_weight;		/* for C_SVC */
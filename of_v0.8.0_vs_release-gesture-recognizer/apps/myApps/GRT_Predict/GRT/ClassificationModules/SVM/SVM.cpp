@@ -39,7 +39,7 @@ SVM::SVM(UINT kernelType,UINT svmType,bool useScaling,bool useNullRejection,bool
 	param.gamma = 0;
 	param.coef0 = 0;
 	param.nu = 0.5;
-	param.cache_size = 100;
+	param.cache_size = 0; //Size the kernel cache from the available memory
 	param.C = 1;
 	param.eps = 1e-3;
 	param.p = 0.1;
@@ -150,7 +150,7 @@ bool SVM::train(LabelledClassificationData &trainingData){
     return true;
 }
 
-bool SVM::predict(VectorDouble inputVector){
+bool SVM::predict_(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - The SVM model has not been trained!" << endl;
@@ -163,12 +163,12 @@ bool SVM::predict(VectorDouble inputVector){
     }
     
     if( param.probability == 1 ){
-        if( !predict_( inputVector, maxLikelihood, classLikelihoods ) ){
+        if( !predictSVM( inputVector, maxLikelihood, classLikelihoods ) ){
             errorLog << "predict(VectorDouble inputVector) - Prediction Failed!" << endl;
             return false;
         }
     }else{
-        if( !predict_( inputVector ) ){
+        if( !predictSVM( inputVector ) ){
             errorLog << "predict(VectorDouble inputVector) - Prediction Failed!" << endl;
             return false;
         }
@@ -210,7 +210,7 @@ bool SVM::init(UINT kernelType,UINT svmType,bool useScaling,bool useNullRejectio
 	param.gamma = gamma;
 	param.coef0 = coef0;
 	param.nu = nu;
-	param.cache_size = 100;
+	param.cache_size = 0; //Size the kernel cache from the available memory
 	param.C = C;
 	param.eps = 1e-3;
 	param.p = 0.1;
@@ -256,7 +256,7 @@ void SVM::initDefaultSVMSettings(){
 	param.gamma = 0;
 	param.coef0 = 0;
 	param.nu = 0.5;
-	param.cache_size = 100;
+	param.cache_size = 0; //Size the kernel cache from the available memory
 	param.C = 1;
 	param.eps = 1e-3;
 	param.p = 0.1;
@@ -358,7 +358,7 @@ bool SVM::trainSVM(){
 		return trained;
 }
     
-bool SVM::predict_(VectorDouble &inputVector){
+bool SVM::predictSVM(VectorDouble &inputVector){
 
 		if( !trained || inputVector.size() != numFeatures ) return false;
 
@@ -392,7 +392,7 @@ bool SVM::predict_(VectorDouble &inputVector){
 		return true;
 }
 
-bool SVM::predict_(VectorDouble &inputVector,double &maxProbability, vector<double> &probabilites){
+bool SVM::predictSVM(VectorDouble &inputVector,double &maxProbability, vector<double> &probabilites){
 
 		if( !trained || param.probability == 0 || inputVector.size() != numFeatures ) return false;
 
@@ -1112,6 +1112,11 @@ bool SVM::setC(double C){
     return true;
 }
     
+bool SVM::setCacheSize(double cacheSize){
+    this->param.cache_size = cacheSize;
+    return true;
+}
+    
 bool SVM::setKFoldCrossValidationValue(UINT kFoldValue){
     if( kFoldValue > 0 ){
         this->kFoldValue = kFoldValue;
@@ -105,12 +105,12 @@ public:
     
     /**
      This predicts the class of the inputVector.
-     This overrides the predict function in the Classifier base class.
+     This overrides the predict_ function in the Classifier base class.
      
-     @param VectorDouble inputVector: the input vector to classify
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
      @return returns true if the prediction was performed, false otherwise
      */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
     
     /**
      This saves the trained SVM model to a file.
@@ -323,6 +323,15 @@ public:
      */
     bool setC(double C);
     
+    /**
+     Sets the size of the kernel cache used during training, in MB.
+     If the cacheSize is less than or equal to zero then the cache will be sized automatically from the available memory (this is the default).
+     
+     @param double cacheSize: the new cache size in MB
+     @return returns true if the cache size was updated, false otherwise
+     */
+    bool setCacheSize(double cacheSize);
+    
     /**
      Sets the kFold cross validation value.
      
@@ -355,8 +364,8 @@ protected:
     bool convertLabelledClassificationDataToLIBSVMFormat(LabelledClassificationData &trainingData);
 	bool trainSVM();
     
-	bool predict_(VectorDouble &inputVector);
-	bool predict_(VectorDouble &inputVector,double &maxProbability, vector<double> &probabilites);
+	bool predictSVM(VectorDouble &inputVector);
+	bool predictSVM(VectorDouble &inputVector,double &maxProbability, vector<double> &probabilites);
     
 	bool problemSet;
 	struct svm_model *model;
@@ -31,6 +31,8 @@ Softmax::Softmax(bool useScaling)
     minChange = 1.0e-10;
     maxNumIterations = 1000;
     learningRate = 0.01;
+    batchSize = 1;
+    validationSetSize = 0;
     classifierType = "Softmax";
     classifierMode = STANDARD_CLASSIFIER_MODE;
     debugLog.setProceedingText("[DEBUG Softmax]");
@@ -48,6 +50,8 @@ Softmax& Softmax::operator=(const Softmax &rhs){
         this->learningRate = rhs.learningRate;
         this->minChange = rhs.minChange;
         this->maxNumIterations = rhs.maxNumIterations;
+        this->batchSize = rhs.batchSize;
+        this->validationSetSize = rhs.validationSetSize;
         this->models = rhs.models;
         
         //Copy the base classifier variables
@@ -65,6 +69,8 @@ bool Softmax::clone(const Classifier *classifier){
         this->learningRate = ptr->learningRate;
         this->minChange = ptr->minChange;
         this->maxNumIterations = ptr->maxNumIterations;
+        this->batchSize = ptr->batchSize;
+        this->validationSetSize = ptr->validationSetSize;
         this->models = ptr->models;
         
         //Copy the base classifier variables
@@ -93,17 +99,44 @@ bool Softmax::train(LabelledClassificationData &trainingData){
     classLabels.resize(K);
     ranges = trainingData.getRanges();
     
-    //Train a regression model for each class in the training data
-    for(UINT k=0; k<numClasses; k++){
-        
-        //Set the class label
+    //Copy the training data into one contiguous block for the gradient descent, scaling it if needed
+    VectorDouble inputs( (size_t)M*N );
+    for(UINT i=0; i<M; i++){
+        double *x = &inputs[ (size_t)i*N ];
+        for(UINT j=0; j<N; j++){
+            x[j] = useScaling ? scale(trainingData[i][j],ranges[j].minValue,ranges[j].maxValue,0,1) : trainingData[i][j];
+        }
+    }
+    
+    //Each class gets its own random seed, drawn in class order, so the training order does not depend on the number of threads
+    Random random;
+    vector< unsigned long long > randomSeeds(K);
+    for(UINT k=0; k<K; k++){
         classLabels[k] = trainingData.getClassTracker()[k].classLabel;
-        
-        //Train the model
-        if( !trainSoftmaxModel(classLabels[k],models[k],trainingData) ){
+        randomSeeds[k] = (unsigned long long)random.getRandomNumberInt(1,numeric_limits< int >::max());
+    }
+    
+    //Train a regression model for each class in the training data, the classes are independent so they are trained in parallel
+    vector< MiniBatchGradientDescent > gradientDescent(K);
+    vector< UINT > modelTrained(K,0);
+    Parallel::forEach(K,[&](UINT workerIndex,UINT k){
+        gradientDescent[k].setRandomSeed( randomSeeds[k] );
+        modelTrained[k] = trainSoftmaxModel(classLabels[k],models[k],trainingData,inputs,gradientDescent[k]) ? 1 : 0;
+    });
+    
+    for(UINT k=0; k<K; k++){
+        if( !modelTrained[k] ){
             errorLog << "train(LabelledClassificationData &labelledTrainingData) - Failed to train model for class: " << classLabels[k] << endl;
             return false;
         }
+        
+        //Log the training errors, this is done here so the log is in class order
+        const VectorDouble &trainingErrors = gradientDescent[k].getTrainingErrors();
+        double lastError = 0;
+        for(UINT iter=0; iter<trainingErrors.size(); iter++){
+            trainingLog << "Class: " << classLabels[k] << " Epoch: " << iter+1 << " SSE: " << trainingErrors[iter] << " Delta: " << fabs( trainingErrors[iter]-lastError ) << endl;
+            lastError = trainingErrors[iter];
+        }
     }
     
     //Flag that the algorithm has been trained
@@ -111,7 +144,7 @@ bool Softmax::train(LabelledClassificationData &trainingData){
     return trained;
 }
 
-bool Softmax::predict(VectorDouble inputVector){
+bool Softmax::predict_(VectorDouble &inputVector){
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -170,19 +203,11 @@ bool Softmax::predict(VectorDouble inputVector){
     return true;
 }
     
-bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,LabelledClassificationData &data){
+bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,LabelledClassificationData &data,const VectorDouble &inputs,MiniBatchGradientDescent &gradientDescent){
     
-    double error = 0;
-    double errorSum = 0;
-    double lastErrorSum = 0;
-    double delta = 0;
-    UINT N = data.getNumDimensions();
-    UINT M = data.getNumSamples();
-    UINT iter = 0;
-    bool keepTraining = true;
-    Random random;
+    const UINT N = data.getNumDimensions();
+    const UINT M = data.getNumSamples();
     VectorDouble y(M);
-    vector< UINT > randomTrainingOrder(M);
     
     //Init the model
     model.init( classLabel,  N );
@@ -192,52 +217,14 @@ bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,LabelledClas
         y[i] = data[i].getClassLabel()==classLabel ? 1.0 : 0;
     }
     
-    //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
-    //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
-    //training samples. This random order is then used at each epoch.
-    for(UINT i=0; i<M; i++){
-        randomTrainingOrder[i] = i;
-    }
-    std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
+    //Run the main gradient descent training algorithm
+    gradientDescent.setLearningRate( learningRate );
+    gradientDescent.setMinChange( minChange );
+    gradientDescent.setMaxNumEpochs( maxNumIterations );
+    gradientDescent.setBatchSize( batchSize );
+    gradientDescent.setValidationSetSize( validationSetSize );
     
-    //Run the main stochastic gradient descent training algorithm
-    while( keepTraining ){
-        
-        //Run one epoch of training using stochastic gradient descent
-        errorSum = 0;
-        for(UINT m=0; m<M; m++){
-            
-            //Select the random sample
-            UINT i = randomTrainingOrder[m];
-            
-            //Compute the error, given the current weights
-            error = y[i] - model.compute( data[i].getSample() );
-            errorSum += error;
-            
-            //Update the weights
-            for(UINT j=0; j<N; j++){
-                model.w[j] += learningRate  * error * data[i][j];
-            }
-            model.w0 += learningRate  * error;
-        }
-        
-        //Compute the error
-        delta = fabs( errorSum-lastErrorSum );
-        lastErrorSum = errorSum;
-        
-        //Check to see if we should stop
-        if( delta <= minChange ){
-            keepTraining = false;
-        }
-        
-        if( ++iter >= maxNumIterations ){
-            keepTraining = false;
-        }
-        
-        trainingLog << "Epoch: " << iter << " TotalError: " << errorSum << " Delta: " << delta << endl;
-    }
-    
-    return true;
+    return gradientDescent.train(inputs,y,N,MiniBatchGradientDescent::LOGISTIC_LINK,model.w0,model.w);
 }
     
 bool Softmax::saveModelToFile(string filename){
@@ -447,6 +434,22 @@ bool Softmax::setMaxNumIterations(UINT maxNumIterations){
     return false;
 }
 
+bool Softmax::setBatchSize(UINT batchSize){
+    if( batchSize > 0 ){
+        this->batchSize = batchSize;
+        return true;
+    }
+    return false;
+}
+
+bool Softmax::setValidationSetSize(UINT validationSetSize){
+    if( validationSetSize < 100 ){
+        this->validationSetSize = validationSetSize;
+        return true;
+    }
+    return false;
+}
+
 double Softmax::getLearningRate(){
     return learningRate;
 }
@@ -458,6 +461,14 @@ double Softmax::getMinChange(){
 UINT Softmax::getMaxNumIterations(){
     return maxNumIterations;
 }
+
+UINT Softmax::getBatchSize(){
+    return batchSize;
+}
+
+UINT Softmax::getValidationSetSize(){
+    return validationSetSize;
+}
     
 vector< SoftmaxModel > Softmax::getModels(){
     return models;
@@ -62,12 +62,7 @@ public:
     }
     
     double compute(const VectorDouble &x){
-        double sum = 0;
-        for(UINT i=0; i<N; i++){
-            sum += x[i]*w[i];
-        }
-        sum += w0;
-        return (1.0 / (1.0+exp(-sum)));
+        return MiniBatchGradientDescent::compute(&x[0],N,MiniBatchGradientDescent::LOGISTIC_LINK,w0,&w[0]);
     }
     
     UINT classLabel;
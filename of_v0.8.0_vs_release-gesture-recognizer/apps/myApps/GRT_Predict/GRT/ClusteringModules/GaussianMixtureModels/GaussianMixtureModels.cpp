@@ -3,6 +3,10 @@
 
 namespace GRT {
 
+//The samples are split into at most this many chunks, each chunk has its own copy of the sufficient statistics
+#define GMM_MAX_NUM_CHUNKS 32
+#define GMM_MIN_CHUNK_SIZE 256
+    
 GaussianMixtureModels::GaussianMixtureModels(){
     debugLog.setProceedingText("[DEBUG GaussianMixtureModel]");
     errorLog.setProceedingText("[ERROR GaussianMixtureModel]");
@@ -12,6 +16,10 @@ GaussianMixtureModels::GaussianMixtureModels(){
     minChange = 1.0e-2;
     modelTrained = false;
     failed = false;
+    useDiagonalCovariance = false;
+    minVariance = 1.0e-6;
+    numChunks = 0;
+    chunkSize = 0;
 }
 
 GaussianMixtureModels::~GaussianMixtureModels(){}
@@ -30,6 +38,11 @@ bool GaussianMixtureModels::train(UnlabelledClassificationData &trainingData,UIN
         return false;
     }
 
+    if( K == 0 || K > trainingData.getNumSamples() ){
+        errorLog << "train(UnlabelledClassificationData &trainingData,unsigned int K) - Training Failed! K must be greater than zero and not more than the number of samples!" << endl;
+        return false;
+    }
+
 	//Set the training data
 	data = trainingData.getDataAsMatrixDouble();
 
@@ -38,9 +51,8 @@ bool GaussianMixtureModels::train(UnlabelledClassificationData &trainingData,UIN
 	N = data.getNumCols();
 	this->K = K;
 	
-	//Resize mu and resp
+	//Resize mu
 	mu.resize(K,N);
-	resp.resize(M,K);
 	
 	//Resize sigma
 	sigma.resize(K);
@@ -51,28 +63,47 @@ bool GaussianMixtureModels::train(UnlabelledClassificationData &trainingData,UIN
 	//Resize frace and lndets
 	frac.resize(K);
 	lndets.resize(K);
+    choleskyFactors.resize( (size_t)K*N*N );
+
+    //Setup the chunks and their sufficient statistics
+    chunkSize = (M + GMM_MAX_NUM_CHUNKS - 1) / GMM_MAX_NUM_CHUNKS;
+    if( chunkSize < GMM_MIN_CHUNK_SIZE ) chunkSize = GMM_MIN_CHUNK_SIZE;
+    numChunks = (M + chunkSize - 1) / chunkSize;
+    chunkWeights.resize( (size_t)numChunks*K );
+    chunkSums.resize( (size_t)numChunks*K*N );
+    chunkSquares.resize( (size_t)numChunks*K*(useDiagonalCovariance ? N : N*N) );
+    chunkLoglikes.resize( numChunks );
+
+    //Compute the mean and variance of the training data
+    dataMean.clear();
+    dataMean.resize(N,0);
+    VectorDouble dataVariance(N,0);
+    for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<N; j++) dataMean[j] += data[i][j];
+    }
+    for(UINT j=0; j<N; j++) dataMean[j] /= double(M);
+    for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<N; j++) dataVariance[j] += SQR( data[i][j]-dataMean[j] );
+    }
+    for(UINT j=0; j<N; j++) dataVariance[j] /= double(M);
 
 	//Pick K random starting points for the inital guesses of Mu
 	Random random;
 	vector< unsigned int > randomIndexs(M);
 	for(unsigned int i=0; i<M; i++) randomIndexs[i] = i;
-	for(unsigned int i=0; i<M*100; i++){
-		unsigned int indexA = random.getRandomNumberInt(0,M);
-		unsigned int indexB = random.getRandomNumberInt(0,M);
-		if( indexA != indexB ) SWAP(randomIndexs[indexA],randomIndexs[indexB]);
-	}
 	for(unsigned int k=0; k<K; k++){
+		std::swap(randomIndexs[k],randomIndexs[ random.getRandomNumberInt(k,M) ]);
 		for(unsigned int n=0; n<N; n++){
 			mu[k][n] = data[ randomIndexs[k] ][n];
 		}
 	}
 
-	//Setup sigma and the uniform prior on P(k)
+	//Setup sigma and the uniform prior on P(k), each Gaussian starts with the variance of the whole dataset
 	for(unsigned int k=0; k<K; k++){
 		frac[k] = 1.0/double(K);
 		for(UINT i=0; i<N; i++){
 			for(UINT j=0; j<N; j++) sigma[k][i][j] = 0;
-			sigma[k][i][i] = 1.0e-10;   //Set the diagonal to a small number
+			sigma[k][i][i] = dataVariance[i] + minVariance;
 		}
 	}
 
@@ -83,7 +114,7 @@ bool GaussianMixtureModels::train(UnlabelledClassificationData &trainingData,UIN
     
 	while( keepGoing ){
 		change = estep();
-		mstep();
+		if( !failed ) mstep();
 
 		if( fabs( change ) < minChange ) keepGoing = false;
 		if( ++iterCounter >= maxIter ) keepGoing = false;
@@ -111,69 +142,142 @@ bool GaussianMixtureModels::train(UnlabelledClassificationData &trainingData,UIN
 
 double GaussianMixtureModels::estep(){
 
-	double tmp,sum,max,oldloglike;
-	VectorDouble u(N);
-	VectorDouble v(N);
-	for(UINT j=0; j<N; j++) u[j] = v[j] = 0;
-
-	oldloglike = loglike;
+	double oldloglike = loglike;
 
+    //Factorize each covariance matrix, the diagonal case only needs the standard deviations
+    VectorDouble logFrac(K);
 	for(UINT k=0; k<K; k++){
-		Cholesky choltmp( sigma[k] );
-		if( !choltmp.getSuccess() ){ failed = true; return 0; }
-		lndets[k] = choltmp.logdet();
-
-		for(UINT i=0; i<M; i++){
-			for(UINT j=0; j<N; j++) u[j] = data[i][j] - mu[k][j];
-			if( !choltmp.elsolve(u,v) ){ failed = true; return 0; }
-			sum=0;
-			for(UINT j=0; j<N; j++) sum += SQR(v[j]);
-			resp[i][k] = -0.5*(sum + lndets[k]) + log(frac[k]);
-		}
+        double *L = &choleskyFactors[ (size_t)k*N*N ];
+        if( useDiagonalCovariance ){
+            lndets[k] = 0;
+            for(UINT j=0; j<N; j++){
+                if( sigma[k][j][j] <= 0 ){ failed = true; return 0; }
+                L[j*N+j] = sqrt( sigma[k][j][j] );
+                lndets[k] += log( sigma[k][j][j] );
+            }
+        }else{
+            Cholesky choltmp( sigma[k] );
+            if( !choltmp.getSuccess() ){ failed = true; return 0; }
+            lndets[k] = choltmp.logdet();
+            for(UINT i=0; i<N; i++){
+                for(UINT j=0; j<N; j++) L[i*N+j] = choltmp.el[i][j];
+            }
+        }
+        logFrac[k] = log( frac[k] );
 	}
 
+    //Compute the responsibilities of each sample and add them to the sufficient statistics of its chunk
+    const UINT squaresSize = useDiagonalCovariance ? N : N*N;
+    Parallel::forEach(numChunks,[&](UINT workerIndex,UINT c){
+        const UINT end = (c+1)*chunkSize < M ? (c+1)*chunkSize : M;
+        double *weights = &chunkWeights[ (size_t)c*K ];
+        double *sums = &chunkSums[ (size_t)c*K*N ];
+        double *squares = &chunkSquares[ (size_t)c*K*squaresSize ];
+        std::fill(weights,weights+K,0.0);
+        std::fill(sums,sums+K*N,0.0);
+        std::fill(squares,squares+K*squaresSize,0.0);
+        VectorDouble u(N), v(N), x(N), resp(K);
+        double chunkLoglike = 0;
+
+        for(UINT i=c*chunkSize; i<end; i++){
+            const double *sample = data[i];
+
+            //Compute the log of the weighted likelihood of each Gaussian
+            double max = -numeric_limits< double >::max();
+            for(UINT k=0; k<K; k++){
+                const double *L = &choleskyFactors[ (size_t)k*N*N ];
+                double sum = 0;
+                for(UINT j=0; j<N; j++) u[j] = sample[j] - mu[k][j];
+                if( useDiagonalCovariance ){
+                    for(UINT j=0; j<N; j++) sum += SQR( u[j] / L[j*N+j] );
+                }else{
+                    //Solve L v = u by forward substitution
+                    for(UINT j=0; j<N; j++){
+                        v[j] = (u[j] - SIMD::dot(L+j*N,&v[0],j)) / L[j*N+j];
+                        sum += SQR( v[j] );
+                    }
+                }
+                resp[k] = -0.5*(sum + lndets[k]) + logFrac[k];
+                if( resp[k] > max ) max = resp[k];
+            }
+
+            //Normalize the responsibilities using the log-sum-exp, so they can not all underflow to zero, resp is left holding exp(resp-max)
+            double sum = 0;
+            for(UINT k=0; k<K; k++){
+                resp[k] = exp( resp[k]-max );
+                sum += resp[k];
+            }
+            chunkLoglike += max + log( sum );
+
+            //Add the sample to the statistics, relative to the data mean
+            for(UINT j=0; j<N; j++) x[j] = sample[j] - dataMean[j];
+            for(UINT k=0; k<K; k++){
+                const double r = resp[k] / sum;
+                if( r == 0 ) continue;
+                weights[k] += r;
+                SIMD::multiplyAdd(r,&x[0],sums+k*N,N);
+                if( useDiagonalCovariance ){
+                    double *sq = squares + k*N;
+                    for(UINT j=0; j<N; j++) sq[j] += r * SQR( x[j] );
+                }else{
+                    //Only the upper triangle is needed, the lower triangle is copied in the M step
+                    double *sq = squares + (size_t)k*N*N;
+                    for(UINT j=0; j<N; j++) SIMD::multiplyAdd(r*x[j],&x[j],sq+j*N+j,N-j);
+                }
+            }
+        }
+        chunkLoglikes[c] = chunkLoglike;
+    });
+
 	//Compute the overall likelihood of the entire estimated paramter set
 	loglike = 0;
-	for(UINT i=0; i<M; i++){
-		sum=0;
-		max = -99.9e99;
-		for(UINT k=0; k<K; k++) if( resp[i][k] > max ) max = resp[i][k];
-		for(UINT k=0; k<K; k++) sum += exp( resp[i][k]-max );
-		tmp = max + log( sum );
-		for(UINT k=0; k<K; k++) resp[i][k] = exp( resp[i][k] - tmp );
-		loglike += tmp;
-	}
+	for(UINT c=0; c<numChunks; c++) loglike += chunkLoglikes[c];
 
 	return (loglike - oldloglike);
 }
 
 void GaussianMixtureModels::mstep(){
 
-	double wgt, sum;
+    //Sum the statistics of each chunk in order, so the results do not depend on the number of threads
+    const UINT squaresSize = useDiagonalCovariance ? N : N*N;
+    double *weights = &chunkWeights[0];
+    double *sums = &chunkSums[0];
+    double *squares = &chunkSquares[0];
+    for(UINT c=1; c<numChunks; c++){
+        SIMD::multiplyAdd(1.0,&chunkWeights[ (size_t)c*K ],weights,K);
+        SIMD::multiplyAdd(1.0,&chunkSums[ (size_t)c*K*N ],sums,K*N);
+        SIMD::multiplyAdd(1.0,&chunkSquares[ (size_t)c*K*squaresSize ],squares,K*squaresSize);
+    }
+
 	for(UINT k=0; k<K; k++){
-		wgt = 0.0;
-		for(UINT m=0; m<M; m++) wgt += resp[m][k];
+		const double wgt = weights[k];
 		frac[k] = wgt/double(M);
+
+        //A Gaussian that has no samples keeps its last mean and covariance
+        if( wgt <= 0 ) continue;
+
+        const double *mean = sums + k*N;
 		for(UINT n=0; n<N; n++){
-			sum = 0;
-			for(UINT m=0; m<M; m++) sum += resp[m][k] * data[m][n];
-			mu[k][n] = sum/wgt;
-			for(UINT j=0; j<N; j++){
-				sum = 0;
-				for(UINT m=0; m<M; m++){
-					sum += resp[m][k] * (data[m][n]-mu[k][n]) * (data[m][j]-mu[k][j]);
-				}
-				sigma[k][n][j] = sum/wgt;
-			}
-		}
-	}
+			mu[k][n] = dataMean[n] + mean[n]/wgt;
+        }
 
-}
+        if( useDiagonalCovariance ){
+            for(UINT n=0; n<N; n++){
+                const double variance = squares[k*N+n]/wgt - SQR( mean[n]/wgt );
+                sigma[k][n][n] = (variance > 0 ? variance : 0) + minVariance;
+            }
+        }else{
+            const double *sq = squares + (size_t)k*N*N;
+            for(UINT n=0; n<N; n++){
+                for(UINT j=n; j<N; j++){
+                    sigma[k][n][j] = sigma[k][j][n] = sq[n*N+j]/wgt - (mean[n]/wgt) * (mean[j]/wgt);
+                }
+                if( sigma[k][n][n] < 0 ) sigma[k][n][n] = 0;
+                sigma[k][n][n] += minVariance;
+            }
+        }
+	}
 
-inline void GaussianMixtureModels::SWAP(UINT &a,UINT &b){
-	UINT temp = b;
-	b = a;
-	a = temp;
 }
 
 bool GaussianMixtureModels::computeInvAndDet(){
@@ -182,12 +286,12 @@ bool GaussianMixtureModels::computeInvAndDet(){
 	invSigma.resize(K);
 
 	for(UINT k=0; k<K; k++){
-		LUDecomposition lu(sigma[k]);
-		if( !lu.inverse( invSigma[k] ) ){
+		Cholesky cholesky(sigma[k]);
+		if( !cholesky.getSuccess() || !cholesky.inverse( invSigma[k] ) ){
             errorLog << "computeInvAndDet() - Matrix Inversion Failed!" << endl;
             return false;
         }
-		det[k] = lu.det();
+		det[k] = exp( cholesky.logdet() );
 	}
 
     return true;
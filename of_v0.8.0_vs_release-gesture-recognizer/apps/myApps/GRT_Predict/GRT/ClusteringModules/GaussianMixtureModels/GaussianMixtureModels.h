@@ -19,6 +19,12 @@
  
  This code is based on the GMM code from Numerical Recipes (3rd Edition)
  
+ The E step works in the log domain and adds each sample's responsibilities straight into the sufficient statistics of the
+ M step (the weight, sum and sum of squares of each Gaussian), so the responsibility matrix is never stored. The samples are
+ split into a fixed number of chunks that are processed in parallel, each with its own statistics, which are then summed in
+ chunk order so the results do not depend on the number of threads. Each covariance matrix is factorized with a Cholesky
+ decomposition, or can be restricted to a diagonal matrix for speed.
+ 
  */
 #ifndef GRT_GAUSSIAN_MIXTURE_MODELS_HEADER
 #define GRT_GAUSSIAN_MIXTURE_MODELS_HEADER
@@ -61,12 +67,22 @@ public:
         }
         return false;
     }
+    bool setUseDiagonalCovariance(bool useDiagonalCovariance){
+        this->useDiagonalCovariance = useDiagonalCovariance;
+        return true;
+    }
+    bool setMinVariance(double minVariance){
+        if( minVariance >= 0 ){
+            this->minVariance = minVariance;
+            return true;
+        }
+        return false;
+    }
 	
 private:
     double estep();
 	void mstep();
 	bool computeInvAndDet();
-	inline void SWAP(UINT &a,UINT &b);
 	inline double SQR(double v){ return v*v; }
     
 	UINT N;                                     //The number of dimensions in the training data
@@ -77,7 +93,7 @@ private:
 	double minChange;                           //The minimum change value that signals if the training routine has converged
 	MatrixDouble data;                        //A matrix holding the training data
 	MatrixDouble mu;                          //A matrix holding the estimated mean values of each Gaussian
-	MatrixDouble resp;                        //The responsibility matrix
+	VectorDouble dataMean;                    //The mean of the training data, the statistics are summed relative to this to reduce rounding errors
 	VectorDouble frac;                        //A vector holding the P(k)'s
 	VectorDouble lndets;                      //A vector holding the log detminants of SIGMA'k
 	VectorDouble det;                         
@@ -85,6 +101,19 @@ private:
 	vector< MatrixDouble > invSigma;
 	bool modelTrained;
     bool failed;
+    bool useDiagonalCovariance;                 //If true then only the diagonal of each covariance matrix is estimated
+    double minVariance;                         //This is added to the diagonal of each covariance matrix so a Gaussian can not collapse onto a few samples
+    
+    //The Cholesky factor of each covariance matrix, stored as K [N N] row-major lower triangular matrices
+    VectorDouble choleskyFactors;
+    
+    //The sufficient statistics for each chunk of samples
+    UINT numChunks;
+    UINT chunkSize;
+    VectorDouble chunkWeights;
+    VectorDouble chunkSums;
+    VectorDouble chunkSquares;
+    VectorDouble chunkLoglikes;
     
     DebugLog debugLog;
     ErrorLog errorLog;
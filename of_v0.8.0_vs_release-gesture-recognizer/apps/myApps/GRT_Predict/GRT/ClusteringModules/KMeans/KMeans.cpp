@@ -22,6 +22,10 @@
 
 namespace GRT{
 
+//The number of distance computations in each chunk of the parallel steps, this needs to be large enough to cover the cost of starting a thread
+#define KMEANS_MIN_CHUNK_WORK 65536
+#define KMEANS_MIN_CHUNK_SIZE 1024
+
 //Constructor,destructor
 KMeans::KMeans(){
     M = N = K = nchg = 0;
@@ -31,7 +35,10 @@ KMeans::KMeans(){
     finalTheta = 0;
     numTrainingIterations = 0;
     computeTheta = true;
+    useKMeansPlusPlus = true;
     trained = false;
+    batchSize = 0;
+    numChunks = 0;
 }
 
 KMeans::~KMeans(){
@@ -54,14 +61,11 @@ bool KMeans::predict(VectorDouble inputVector,UINT &predictedClassLabel,double &
 	predictedClassLabel = 0;
 	maxLikelihood = 0;
 	classLikelihoods.clear();
-	classLikelihoods.resize( clusters.getNumCols() );
+	classLikelihoods.resize( clusters.getNumRows() );
 	
 	for(UINT i=0; i<clusters.getNumRows(); i++){
 		
-		double dist = 0;
-		for(UINT j=0; j<clusters.getNumCols(); j++){
-			dist += SQR( inputVector[j]-clusters[i][j] );
-		}
+		double dist = SIMD::squaredDistance(&inputVector[0],clusters[i],clusters.getNumCols());
         //We don't need to compute the sqrt as it works without it and is faster
 		
 		classLikelihoods[i] = dist;
@@ -186,15 +190,7 @@ bool KMeans::train(UINT K,UnlabelledClassificationData &trainingData){
 	classLabels.clear();
 
     //Convert the training data into one matrix
-	UINT M = trainingData.getNumSamples();
-    UINT N = trainingData.getNumDimensions();
-
-    MatrixDouble data(M,N);
-    for(UINT i=0; i<M; i++){
-        for(UINT j=0; j<N; j++){
-            data[i][j] = trainingData[i][j];
-        }
-    }
+    MatrixDouble data = trainingData.getDataAsMatrixDouble();
 	
 	return train(K,data);
 }
@@ -215,8 +211,12 @@ bool KMeans::train(UINT K,MatrixDouble &data){
 	assign.resize(M);
 	count.resize(K);
 
+    if( useKMeansPlusPlus ){
+        initClustersKMeansPlusPlus( data );
+        return train( data );
+    }
+
 	//Randomly pick k data points as the starting clusters
-	Random random;
 	UINT indexA, indexB, tempIndex;
 	vector< UINT > randIndexs(M);
 	for(UINT i=0; i<M; i++) randIndexs[i] = i;
@@ -230,7 +230,7 @@ bool KMeans::train(UINT K,MatrixDouble &data){
 
 	for(UINT k=0; k<K; k++){
 		for(UINT j=0; j<N; j++){
-            clusters[k][j] = data[ randIndexs[k] ][j];
+            clusters[k][j] = data[ randIndexs[k%M] ][j];
 		}
 	}
 
@@ -254,6 +254,7 @@ bool KMeans::train(MatrixDouble &data){
 	bool keepTraining = true;
     bool converged = false;
     double theta = 0;
+    double lastTheta = 0;
     thetaTracker.clear();
     finalTheta = 0;
     numTrainingIterations = 0;
@@ -270,6 +271,21 @@ bool KMeans::train(MatrixDouble &data){
     for(UINT m=0; m<M; m++) assign[m] = K+1;
 	for(UINT k=0; k<K; k++) count[k] = 0;
 
+    //Setup the bounds and the per chunk buffers
+    upperBounds.resize(M);
+    lowerBounds.resize(M);
+    clusterMovement.clear();
+    clusterMovement.resize(K,0);
+    halfMinClusterDistance.resize(K);
+    numChunks = (M + getChunkSize() - 1) / getChunkSize();
+    chunkSums.resize( (size_t)numChunks*K*N );
+    chunkCounts.resize( (size_t)numChunks*K );
+    chunkErrors.resize( numChunks );
+
+    if( batchSize > 0 && batchSize < M ){
+        return trainMiniBatch( data );
+    }
+
     //Run the training loop
 	while( keepTraining ){
 
@@ -286,8 +302,9 @@ bool KMeans::train(MatrixDouble &data){
 		if( computeTheta ) theta = calculateTheta(data);
 		if( numChanged == 0 && currentIter > minNumEpochs ){ converged = true; keepTraining = false; }
 		if( currentIter >= maxNumEpochs ){ keepTraining = false; }
-		if( fabs( finalTheta - theta ) < minChange && computeTheta && currentIter > minNumEpochs && numChanged < M/100.0*5.0 ){ converged = true; keepTraining = false; }
+		if( fabs( lastTheta - theta ) < minChange && computeTheta && currentIter > minNumEpochs && numChanged < M/100.0*5.0 ){ converged = true; keepTraining = false; }
         if( computeTheta )  thetaTracker.push_back( theta );
+        lastTheta = theta;
 	}
 
     finalTheta = theta;
@@ -297,72 +314,271 @@ bool KMeans::train(MatrixDouble &data){
 	return converged;
 }
 
+bool KMeans::trainMiniBatch(const MatrixDouble &data){
+
+    UINT currentIter = 0;
+    bool keepTraining = true;
+    vector< UINT > batch( batchSize );
+    vector< UINT > batchAssign( batchSize );
+    vector< UINT > clusterCounts(K,0);
+    MatrixDouble lastClusters;
+    const UINT batchChunkSize = getChunkSize();
+    const UINT numBatchChunks = (batchSize + batchChunkSize - 1) / batchChunkSize;
+
+    //Each epoch moves the clusters towards a random batch of samples, with a learning rate of 1/n for a cluster that has seen n samples
+    while( keepTraining ){
+
+        for(UINT i=0; i<batchSize; i++){
+            batch[i] = random.getRandomNumberInt(0,M);
+        }
+
+        //Find the closest cluster to each sample in the batch
+        Parallel::forEach(numBatchChunks,[&](UINT workerIndex,UINT c){
+            const UINT end = (c+1)*batchChunkSize < batchSize ? (c+1)*batchChunkSize : batchSize;
+            for(UINT i=c*batchChunkSize; i<end; i++){
+                const double *x = data[ batch[i] ];
+                double minDist = numeric_limits< double >::max();
+                for(UINT k=0; k<K; k++){
+                    const double dist = SIMD::squaredDistance(x,clusters[k],N);
+                    if( dist < minDist ){ minDist = dist; batchAssign[i] = k; }
+                }
+            }
+        });
+
+        //Update the clusters in batch order
+        lastClusters = clusters;
+        for(UINT i=0; i<batchSize; i++){
+            const UINT k = batchAssign[i];
+            const double learningRate = 1.0 / double( ++clusterCounts[k] );
+            const double *x = data[ batch[i] ];
+            double *cluster = clusters[k];
+            for(UINT n=0; n<N; n++){
+                cluster[n] += learningRate * (x[n] - cluster[n]);
+            }
+        }
+
+        double movement = 0;
+        for(UINT k=0; k<K; k++){
+            movement += SIMD::squaredDistance(clusters[k],lastClusters[k],N);
+        }
+
+        currentIter++;
+        if( movement < minChange && currentIter > minNumEpochs ){ keepTraining = false; }
+        if( currentIter >= maxNumEpochs ){ keepTraining = false; }
+    }
+
+    //Assign the full dataset to the final clusters
+    estep(data);
+    for(UINT k=0; k<K; k++) count[k] = 0;
+    for(UINT m=0; m<M; m++) count[ assign[m] ]++;
+
+    finalTheta = calculateTheta(data);
+    if( computeTheta ) thetaTracker.push_back( finalTheta );
+    numTrainingIterations = currentIter;
+    trained = true;
+
+    //The mini-batch updates do not settle on a fixed assignment, so the training has finished once the clusters stop moving or the epochs run out
+    return true;
+}
+
+void KMeans::initClustersKMeansPlusPlus(const MatrixDouble &data){
+
+    //Start with a random sample, then pick each new cluster with a probability proportional to its squared distance to the closest cluster
+    VectorDouble minDist(M,numeric_limits< double >::max());
+    const UINT chunkSize = getChunkSize();
+    const UINT numInitChunks = (M + chunkSize - 1) / chunkSize;
+    VectorDouble chunkTotals( numInitChunks );
+    UINT index = random.getRandomNumberInt(0,M);
+
+    for(UINT k=0; k<K; k++){
+        for(UINT n=0; n<N; n++){
+            clusters[k][n] = data[index][n];
+        }
+        if( k+1 == K ) break;
+
+        const double *cluster = clusters[k];
+        Parallel::forEach(numInitChunks,[&](UINT workerIndex,UINT c){
+            const UINT end = (c+1)*chunkSize < M ? (c+1)*chunkSize : M;
+            double total = 0;
+            for(UINT m=c*chunkSize; m<end; m++){
+                const double dist = SIMD::squaredDistance(data[m],cluster,N);
+                if( dist < minDist[m] ) minDist[m] = dist;
+                total += minDist[m];
+            }
+            chunkTotals[c] = total;
+        });
+
+        double total = 0;
+        for(UINT c=0; c<numInitChunks; c++) total += chunkTotals[c];
+
+        //If every sample is already a cluster then just reuse a random sample
+        if( total <= 0 ){
+            index = random.getRandomNumberInt(0,M);
+            continue;
+        }
+
+        //Find the chunk and then the sample the random value falls in
+        double target = random.getRandomNumberUniform(0,total);
+        UINT c = 0;
+        while( c+1 < numInitChunks && target >= chunkTotals[c] ){
+            target -= chunkTotals[c++];
+        }
+        const UINT end = (c+1)*chunkSize < M ? (c+1)*chunkSize : M;
+        index = end-1;
+        for(UINT m=c*chunkSize; m<end; m++){
+            if( target < minDist[m] ){ index = m; break; }
+            target -= minDist[m];
+        }
+    }
+}
+
 UINT KMeans::estep(const MatrixDouble &data) {
-		UINT k,m,n,kmin;
-		double dmin,d;
-		nchg = 0;
-		kmin = 0;
-
-		//Reset Count
-		for (k=0;k<K;k++) count[k] = 0;
-
-		//Search for the closest center and reasign if needed
-		for (m=0; m<M; m++) {
-			dmin = 9.99e+99;
-			for (k=0; k<K; k++) {
-				d = 0.0;
-				for (n=0; n<N; n++)
-					d += SQR( data[m][n]-clusters[k][n] );
-				if (d <= dmin){ dmin = d; kmin = k; }
-			}
-			if ( kmin != assign[m] ){
-                nchg++;
+
+    //Half the distance from each cluster to its closest other cluster, a sample that is closer than this to its cluster can not be closer to any other cluster
+    for(UINT k=0; k<K; k++){
+        double minDist = numeric_limits< double >::max();
+        for(UINT j=0; j<K; j++){
+            if( j == k ) continue;
+            const double dist = SIMD::squaredDistance(clusters[k],clusters[j],N);
+            if( dist < minDist ) minDist = dist;
+        }
+        halfMinClusterDistance[k] = K > 1 ? 0.5*sqrt( minDist ) : minDist;
+    }
+
+    //The lower bounds all move down by the largest cluster movement, except for the samples in that cluster which use the second largest movement
+    UINT maxMovementIndex = 0;
+    double maxMovement = 0;
+    double secondMaxMovement = 0;
+    for(UINT k=0; k<K; k++){
+        if( clusterMovement[k] > maxMovement ){
+            secondMaxMovement = maxMovement;
+            maxMovement = clusterMovement[k];
+            maxMovementIndex = k;
+        }else if( clusterMovement[k] > secondMaxMovement ){
+            secondMaxMovement = clusterMovement[k];
+        }
+    }
+
+    //Search for the closest center and reasign if needed
+    const UINT chunkSize = getChunkSize();
+    Parallel::forEach(numChunks,[&](UINT workerIndex,UINT c){
+        const UINT end = (c+1)*chunkSize < M ? (c+1)*chunkSize : M;
+        UINT numChanged = 0;
+        for(UINT m=c*chunkSize; m<end; m++){
+            const double *x = data[m];
+            const UINT k = assign[m];
+
+            if( k < K ){
+                //Update the bounds with the cluster movement from the last M step, then skip the sample if it can not have changed cluster
+                upperBounds[m] += clusterMovement[k];
+                lowerBounds[m] -= k == maxMovementIndex ? secondMaxMovement : maxMovement;
+                const double bound = halfMinClusterDistance[k] > lowerBounds[m] ? halfMinClusterDistance[k] : lowerBounds[m];
+                if( upperBounds[m] <= bound ) continue;
+
+                //Tighten the upper bound and check again
+                upperBounds[m] = sqrt( SIMD::squaredDistance(x,clusters[k],N) );
+                if( upperBounds[m] <= bound ) continue;
+            }
+
+            //Find the closest and second closest clusters
+            double minDist = numeric_limits< double >::max();
+            double secondMinDist = numeric_limits< double >::max();
+            UINT kmin = 0;
+            for(UINT j=0; j<K; j++){
+                const double dist = SIMD::squaredDistance(x,clusters[j],N);
+                if( dist < minDist ){
+                    secondMinDist = minDist;
+                    minDist = dist;
+                    kmin = j;
+                }else if( dist < secondMinDist ){
+                    secondMinDist = dist;
+                }
+            }
+            upperBounds[m] = sqrt( minDist );
+            lowerBounds[m] = sqrt( secondMinDist );
+
+            if( kmin != k ){
+                numChanged++;
                 assign[m] = kmin;
             }
-			count[kmin]++;
-		}
-		return nchg;
+        }
+        chunkCounts[c] = numChanged;
+    });
+
+    nchg = 0;
+    for(UINT c=0; c<numChunks; c++) nchg += chunkCounts[c];
+    for(UINT k=0; k<K; k++) clusterMovement[k] = 0;
+
+    return nchg;
 }
 
 void KMeans::mstep(const MatrixDouble &data) {
-    UINT n,k,m;
-
-    //Reset means to zero
-    for (k=0;k<K;k++)
-        for (n=0;n<N;n++)
-            clusters[k][n] = 0.;
-
-    //Get new mean by adding assigned data points and dividing by the number of values in each cluster
-    for(m=0; m<M; m++)
-        for(n=0; n<N; n++)
-            clusters[ assign[m] ][n] += data[m][n];
-
-    for (k=0; k<K; k++) {
-        if (count[k] > 0){
-            for (n=0; n<N; n++){
-                clusters[k][n] /= double(count[k]);
-            }
+
+    //Add up the samples assigned to each cluster, one chunk of samples per task
+    const UINT chunkSize = getChunkSize();
+    Parallel::forEach(numChunks,[&](UINT workerIndex,UINT c){
+        const UINT end = (c+1)*chunkSize < M ? (c+1)*chunkSize : M;
+        double *sums = &chunkSums[ (size_t)c*K*N ];
+        UINT *counts = &chunkCounts[ (size_t)c*K ];
+        std::fill(sums,sums+K*N,0.0);
+        std::fill(counts,counts+K,0);
+        for(UINT m=c*chunkSize; m<end; m++){
+            SIMD::multiplyAdd(1.0,data[m],sums+assign[m]*N,N);
+            counts[ assign[m] ]++;
         }
+    });
+
+    //Sum the chunks in order, so the clusters do not depend on the number of threads
+    double *sums = &chunkSums[0];
+    for(UINT c=1; c<numChunks; c++){
+        SIMD::multiplyAdd(1.0,&chunkSums[ (size_t)c*K*N ],sums,K*N);
+    }
+    for(UINT k=0; k<K; k++){
+        count[k] = 0;
+        for(UINT c=0; c<numChunks; c++) count[k] += chunkCounts[ (size_t)c*K + k ];
+    }
+
+    //Get the new mean by dividing by the number of values in each cluster, a cluster with no values keeps its last position
+    for(UINT k=0; k<K; k++){
+        if( count[k] > 0 ){
+            double *mean = sums + k*N;
+            for(UINT n=0; n<N; n++){
+                mean[n] /= double(count[k]);
+            }
+            clusterMovement[k] = sqrt( SIMD::squaredDistance(mean,clusters[k],N) );
+            for(UINT n=0; n<N; n++){
+                clusters[k][n] = mean[n];
+            }
+        }else clusterMovement[k] = 0;
     }
 }
 
 double KMeans::calculateTheta(const MatrixDouble &data){
 
-	double theta = 0;
+    const UINT chunkSize = getChunkSize();
+    Parallel::forEach(numChunks,[&](UINT workerIndex,UINT c){
+        const UINT end = (c+1)*chunkSize < M ? (c+1)*chunkSize : M;
+        double theta = 0;
+        for(UINT m=c*chunkSize; m<end; m++){
+            theta += SIMD::squaredDistance(clusters[ assign[m] ],data[m],N);
+        }
+        chunkErrors[c] = theta;
+    });
 
-	for(UINT m=0; m<M; m++){
-		UINT k = assign[m];
-		double sum = 0;
-		for(UINT n=0;n<N;n++){
-				sum += SQR(clusters[k][n] - data[m][n]);
-		}
-		theta += sum;
-	}
+	double theta = 0;
+    for(UINT c=0; c<numChunks; c++){
+        theta += chunkErrors[c];
+    }
 
 	return theta;
 
 }
 
+UINT KMeans::getChunkSize() const{
+    const UINT chunkSize = KMEANS_MIN_CHUNK_WORK / (K*N > 0 ? K*N : 1);
+    return chunkSize > KMEANS_MIN_CHUNK_SIZE ? chunkSize : KMEANS_MIN_CHUNK_SIZE;
+}
+
 
 bool KMeans::saveModelToFile(string fileName){
 
@@ -454,7 +670,8 @@ bool KMeans::loadModelFromFile(string fileName){
    }
 
 	//Load the class labels
-	if( word != "Clusters:" ){
+	file >> word;
+	if( word != "ClassLabels:" ){
 		file.close();
 		return false;
 	}
@@ -501,4 +718,19 @@ bool KMeans::setMaxNumEpochs(UINT maxNumEpochs){
     return false;
 }
 
+bool KMeans::setUseKMeansPlusPlus(bool useKMeansPlusPlus){
+    this->useKMeansPlusPlus = useKMeansPlusPlus;
+    return true;
+}
+
+bool KMeans::setBatchSize(UINT batchSize){
+    this->batchSize = batchSize;
+    return true;
+}
+
+bool KMeans::setRandomSeed(unsigned long long randomSeed){
+    random = Random( randomSeed );
+    return true;
+}
+
 }//End of namespace GRT
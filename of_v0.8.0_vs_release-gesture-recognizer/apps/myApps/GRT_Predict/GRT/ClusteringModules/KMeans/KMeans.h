@@ -23,7 +23,10 @@
  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  
  @section DESCRIPTION
-
+ The KMeans class clusters data into K clusters. The clusters are seeded using k-means++ (or K random samples if this is disabled).
+ Each full epoch uses Hamerly's bounds to skip the distance computations for samples that can not have changed cluster, and the
+ assignment and update steps are split across several threads. For very large datasets, setBatchSize can be used to train the
+ clusters with mini-batch k-means instead, in which case each epoch is a single random batch of samples.
  */
 
 #ifndef GRT_KMEANS_HEADER
@@ -67,12 +70,18 @@ public:
     bool setMinChange(double minChange);
     bool setMinNumEpochs(UINT minNumEpochs);
     bool setMaxNumEpochs(UINT maxNumEpochs);
+    bool setUseKMeansPlusPlus(bool useKMeansPlusPlus);
+    bool setBatchSize(UINT batchSize);
+    bool setRandomSeed(unsigned long long randomSeed);
 
 private:
 	bool train(MatrixDouble &data);
+    bool trainMiniBatch(const MatrixDouble &data);
+    void initClustersKMeansPlusPlus(const MatrixDouble &data);
     UINT estep(const MatrixDouble &data);
 	void mstep(const MatrixDouble &data);
 	double calculateTheta(const MatrixDouble &data);
+    UINT getChunkSize() const;
 	inline double SQR(const double a) {return a*a;};
 
 	UINT M;                             //Number of training examples
@@ -89,7 +98,22 @@ private:
 	vector< UINT > assign, count;
     VectorDouble thetaTracker;
 	bool computeTheta;
+    bool useKMeansPlusPlus;
     bool trained;
+    UINT batchSize;                     //The number of samples in each mini-batch, 0 trains on the full dataset
+    Random random;
+    
+    //Hamerly's bounds, the distance from each sample to its cluster and a lower bound on its distance to any other cluster
+    VectorDouble upperBounds;
+    VectorDouble lowerBounds;
+    VectorDouble clusterMovement;       //How far each cluster moved in the last M step
+    VectorDouble halfMinClusterDistance;//Half the distance from each cluster to its closest other cluster
+    
+    //The per chunk buffers for the parallel steps, these are summed in chunk order so the results do not depend on the number of threads
+    UINT numChunks;
+    VectorDouble chunkSums;
+    vector< UINT > chunkCounts;
+    VectorDouble chunkErrors;
 		
 };
     
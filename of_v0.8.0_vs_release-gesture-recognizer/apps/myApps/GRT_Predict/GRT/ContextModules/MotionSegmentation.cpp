@@ -0,0 +1,303 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ and associated documentation files (the "Software"), to deal in the Software without restriction, 
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial 
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT 
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "MotionSegmentation.h"
+
+namespace GRT{
+	
+//Register the MotionSegmentation module with the Context base class
+RegisterContextModule< MotionSegmentation > MotionSegmentation::registerModule("MOTION_SEGMENTATION");
+    
+MotionSegmentation::MotionSegmentation(UINT numDimensions,double startVelocityThreshold,double stopVelocityThreshold,double startEnergyThreshold,UINT energyWindowSize){
+    contextType = "MOTION_SEGMENTATION";
+    debugLog.setProceedingText("[DEBUG MotionSegmentation]");
+    errorLog.setProceedingText("[ERROR MotionSegmentation]");
+    warningLog.setProceedingText("[WARNING MotionSegmentation]");
+    
+    minSegmentLength = 10;
+    maxSegmentLength = 300;
+    stopDelay = 5;
+    bufferSegments = true;
+    
+    init(numDimensions,startVelocityThreshold,stopVelocityThreshold,startEnergyThreshold,energyWindowSize);
+}
+    
+MotionSegmentation::MotionSegmentation(const MotionSegmentation &rhs){
+    contextType = "MOTION_SEGMENTATION";
+    *this = rhs;
+}
+
+MotionSegmentation::~MotionSegmentation(){
+    
+}
+    
+MotionSegmentation& MotionSegmentation::operator=(const MotionSegmentation &rhs){
+    if( this != &rhs ){
+        this->startVelocityThreshold = rhs.startVelocityThreshold;
+        this->stopVelocityThreshold = rhs.stopVelocityThreshold;
+        this->startEnergyThreshold = rhs.startEnergyThreshold;
+        this->energyWindowSize = rhs.energyWindowSize;
+        this->minSegmentLength = rhs.minSegmentLength;
+        this->maxSegmentLength = rhs.maxSegmentLength;
+        this->stopDelay = rhs.stopDelay;
+        this->bufferSegments = rhs.bufferSegments;
+        this->velocityFilter = rhs.velocityFilter;
+        this->energyFilter = rhs.energyFilter;
+        this->derivative = rhs.derivative;
+        this->velocity = rhs.velocity;
+        this->energy = rhs.energy;
+        this->segmentActive = rhs.segmentActive;
+        this->segmentReady = rhs.segmentReady;
+        this->segmentLength = rhs.segmentLength;
+        this->numStationarySamples = rhs.numStationarySamples;
+        this->numSegmentsDetected = rhs.numSegmentsDetected;
+        this->numSegmentsDiscarded = rhs.numSegmentsDiscarded;
+        this->segmentBuffer = rhs.segmentBuffer;
+        this->preRollBuffer = rhs.preRollBuffer;
+        this->preRollVelocity = rhs.preRollVelocity;
+        this->preRollWritePtr = rhs.preRollWritePtr;
+        this->numPreRollSamples = rhs.numPreRollSamples;
+        
+        //Copy the base variables
+        copyBaseVariables( (Context*)&rhs );
+    }
+    return *this;
+}
+    
+bool MotionSegmentation::clone(const Context *context){
+    
+    if( context == NULL ) return false;
+    
+    if( this->getContextType() == context->getContextType() ){
+        *this = *(MotionSegmentation*)context;
+        return true;
+    }
+    
+    errorLog << "clone(const Context *context) - Context Types Do Not Match!" << endl;
+    
+    return false;
+}
+
+bool MotionSegmentation::process(const VectorDouble &inputVector){
+    
+    if( !initialized ){
+        errorLog << "process(const VectorDouble &inputVector) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( inputVector.size() != numInputDimensions ){
+        errorLog << "process(const VectorDouble &inputVector) - The size of the inputVector (" << inputVector.size() << ") does not match that of the module (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    const UINT N = numInputDimensions;
+    data = inputVector;
+    segmentReady = false;
+    
+    //Update the speed and the motion energy
+    velocityFilter.processBlock(&inputVector[0],&derivative[0],1);
+    velocity = sqrt( SIMD::dot(&derivative[0],&derivative[0],N) );
+    
+    energyFilter.computeFeatures( inputVector );
+    const VectorDouble &movementIndex = energyFilter.getFeatureVector();
+    energy = SIMD::dot(&movementIndex[0],&movementIndex[0],N);
+    
+    if( !segmentActive ){
+        if( velocity >= startVelocityThreshold && energy >= startEnergyThreshold && energyFilter.getFeatureDataReady() ){
+            startSegment();
+        }else{
+            //Keep the sample in case the next segment starts soon
+            for(UINT j=0; j<N; j++) preRollBuffer[ preRollWritePtr ][j] = inputVector[j];
+            preRollVelocity[ preRollWritePtr ] = velocity;
+            preRollWritePtr = (preRollWritePtr+1) % energyWindowSize;
+            if( numPreRollSamples < energyWindowSize ) numPreRollSamples++;
+            
+            okToContinue = false;
+            return true;
+        }
+    }
+    
+    //Add the sample to the segment
+    for(UINT j=0; j<N; j++) segmentBuffer[ segmentLength ][j] = inputVector[j];
+    segmentLength++;
+    
+    if( velocity < stopVelocityThreshold ) numStationarySamples++;
+    else numStationarySamples = 0;
+    
+    //If the segments are not collected, the pipeline is open for every sample in the segment (including the last one)
+    okToContinue = !bufferSegments;
+    
+    if( numStationarySamples >= stopDelay || segmentLength >= maxSegmentLength ){
+        endSegment();
+    }
+    
+    return true;
+}
+
+bool MotionSegmentation::reset(){
+    if( !initialized ) return false;
+    
+    velocityFilter.reset();
+    energyFilter.reset();
+    velocity = 0;
+    energy = 0;
+    segmentActive = false;
+    segmentReady = false;
+    segmentLength = 0;
+    numStationarySamples = 0;
+    preRollWritePtr = 0;
+    numPreRollSamples = 0;
+    okToContinue = false;
+    
+    return true;
+}
+    
+bool MotionSegmentation::getSegment(MatrixDouble &segment) const{
+    
+    if( !segmentReady || !bufferSegments ) return false;
+    
+    segment.resize(segmentLength,numInputDimensions);
+    for(UINT i=0; i<segmentLength; i++){
+        for(UINT j=0; j<numInputDimensions; j++){
+            segment[i][j] = segmentBuffer[i][j];
+        }
+    }
+    
+    return true;
+}
+    
+bool MotionSegmentation::init(UINT numDimensions,double startVelocityThreshold,double stopVelocityThreshold,double startEnergyThreshold,UINT energyWindowSize){
+    
+    initialized = false;
+    
+    if( numDimensions == 0 ){
+        errorLog << "init(...) - The number of dimensions must be greater than zero!" << endl;
+        return false;
+    }
+    
+    if( energyWindowSize == 0 ){
+        errorLog << "init(...) - The energyWindowSize must be greater than zero!" << endl;
+        return false;
+    }
+    
+    if( stopVelocityThreshold > startVelocityThreshold ){
+        errorLog << "init(...) - The stopVelocityThreshold must not be greater than the startVelocityThreshold!" << endl;
+        return false;
+    }
+    
+    if( maxSegmentLength <= energyWindowSize ){
+        errorLog << "init(...) - The maxSegmentLength (" << maxSegmentLength << ") must be greater than the energyWindowSize (" << energyWindowSize << ")!" << endl;
+        return false;
+    }
+    
+    this->startVelocityThreshold = startVelocityThreshold;
+    this->stopVelocityThreshold = stopVelocityThreshold;
+    this->startEnergyThreshold = startEnergyThreshold;
+    this->energyWindowSize = energyWindowSize;
+    numInputDimensions = numDimensions;
+    numOutputDimensions = numDimensions;
+    numSegmentsDetected = 0;
+    numSegmentsDiscarded = 0;
+    
+    velocityFilter.init(Derivative::FIRST_DERIVATIVE,1,numDimensions,true,3);
+    energyFilter.init(energyWindowSize,numDimensions);
+    derivative.resize(numDimensions,0);
+    segmentBuffer.resize(maxSegmentLength,numDimensions);
+    preRollBuffer.resize(energyWindowSize,numDimensions);
+    preRollVelocity.resize(energyWindowSize,0);
+    
+    initialized = true;
+    
+    return reset();
+}
+    
+bool MotionSegmentation::setSegmentLengthLimits(UINT minSegmentLength,UINT maxSegmentLength){
+    
+    if( minSegmentLength > maxSegmentLength || maxSegmentLength <= energyWindowSize ){
+        errorLog << "setSegmentLengthLimits(UINT minSegmentLength,UINT maxSegmentLength) - The maxSegmentLength must be greater than the minSegmentLength and the energyWindowSize!" << endl;
+        return false;
+    }
+    
+    this->minSegmentLength = minSegmentLength;
+    this->maxSegmentLength = maxSegmentLength;
+    
+    if( initialized ){
+        segmentBuffer.resize(maxSegmentLength,numInputDimensions);
+        return reset();
+    }
+    return true;
+}
+    
+bool MotionSegmentation::setStopDelay(UINT stopDelay){
+    if( stopDelay == 0 ){
+        errorLog << "setStopDelay(UINT stopDelay) - The stopDelay must be greater than zero!" << endl;
+        return false;
+    }
+    this->stopDelay = stopDelay;
+    return true;
+}
+    
+bool MotionSegmentation::setBufferSegments(bool bufferSegments){
+    this->bufferSegments = bufferSegments;
+    return true;
+}
+    
+void MotionSegmentation::startSegment(){
+    
+    //The energy rises more slowly than the speed, so the movement may have started a few samples before the segment was
+    //detected. Start the segment with the samples just before it that were already moving, oldest first
+    UINT numMovingSamples = 0;
+    while( numMovingSamples < numPreRollSamples ){
+        const UINT index = (preRollWritePtr + energyWindowSize - numMovingSamples - 1) % energyWindowSize;
+        if( preRollVelocity[ index ] < stopVelocityThreshold ) break;
+        numMovingSamples++;
+    }
+    
+    //The filtered speed lags the input by one sample, so also keep the sample before the first moving sample, and the sample
+    //before that, which is the position the movement started from
+    numMovingSamples = min(numMovingSamples+2,numPreRollSamples);
+    
+    const UINT firstSample = (preRollWritePtr + energyWindowSize - numMovingSamples) % energyWindowSize;
+    for(UINT i=0; i<numMovingSamples; i++){
+        const UINT index = (firstSample + i) % energyWindowSize;
+        for(UINT j=0; j<numInputDimensions; j++) segmentBuffer[i][j] = preRollBuffer[index][j];
+    }
+    segmentLength = numMovingSamples;
+    numStationarySamples = 0;
+    segmentActive = true;
+}
+    
+void MotionSegmentation::endSegment(){
+    
+    //Remove the stationary samples at the end of the segment
+    segmentLength -= numStationarySamples;
+    
+    if( segmentLength >= minSegmentLength ){
+        segmentReady = true;
+        numSegmentsDetected++;
+    }else numSegmentsDiscarded++;
+    
+    segmentActive = false;
+    numStationarySamples = 0;
+    preRollWritePtr = 0;
+    numPreRollSamples = 0;
+}
+    
+}//End of namespace GRT
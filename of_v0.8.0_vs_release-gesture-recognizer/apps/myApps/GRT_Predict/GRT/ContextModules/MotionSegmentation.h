@@ -0,0 +1,210 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+ 
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ and associated documentation files (the "Software"), to deal in the Software without restriction, 
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial 
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT 
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ 
+ 
+ @section DESCRIPTION
+ The MotionSegmentation context module detects the start and end of a movement (such as a hand gesture) in the input data, so
+ an expensive timeseries classifier (such as DTW) only needs to run once per candidate gesture, rather than on every sample while
+ nobody is moving.
+ 
+ For each input vector, the module computes the speed (the magnitude of the first derivative, computed with the Derivative module)
+ and the motion energy (the sum of the variance of each dimension over the last energyWindowSize samples, computed with the
+ MovementIndex module). A segment starts when both the speed and the energy are above their start thresholds. The segment ends
+ when the speed has stayed below the stop velocity threshold for stopDelay samples, or when the segment reaches the maximum
+ segment length. The stop threshold should be lower than the start threshold, so a movement that briefly slows down does not
+ split into several segments. The energy threshold stops single samples of tracker noise from starting a segment.
+ 
+ As the energy rises more slowly than the speed, each segment also contains the samples (up to energyWindowSize samples) just
+ before the start of the segment whose speed was already above the stop velocity threshold, plus the position the movement
+ started from. The stationary samples at the end
+ of the segment are removed, so the segment only contains the movement (in the same way the DTW classifier trims its training
+ data). Segments shorter than the minimum segment length are discarded.
+ 
+ The module should be added to the START_OF_PIPELINE context level. By default the module keeps the pipeline closed while it
+ collects a segment, and when a segment ends the pipeline passes the complete segment to the predict(MatrixDouble) function, so
+ the classifier is given the whole gesture at once. If bufferSegments is set to false, the pipeline is instead opened for each
+ sample inside a segment, which can be used with classifiers that work on single samples.
+ */
+
+#ifndef GRT_MOTION_SEGMENTATION_HEADER
+#define GRT_MOTION_SEGMENTATION_HEADER
+
+#include "../Util/GRTCommon.h"
+#include "../GestureRecognitionPipeline/Context.h"
+#include "../PreProcessingModules/Derivative.h"
+#include "../FeatureExtractionModules/MovementIndex/MovementIndex.h"
+
+namespace GRT{
+
+class MotionSegmentation : public Context{
+public:
+    /**
+     Default constructor. Initializes the MotionSegmentation module.
+     
+     @param UINT numDimensions: the number of dimensions in the input data. Default value = 1
+     @param double startVelocityThreshold: the speed (per sample) the input must reach to start a segment. Default value = 1.0
+     @param double stopVelocityThreshold: a segment ends when the speed stays below this value for stopDelay samples. Default value = 0.5
+     @param double startEnergyThreshold: the motion energy the input must reach to start a segment. Default value = 0.0
+     @param UINT energyWindowSize: the number of samples used to compute the motion energy. Default value = 10
+     */
+    MotionSegmentation(UINT numDimensions=1,double startVelocityThreshold=1.0,double stopVelocityThreshold=0.5,double startEnergyThreshold=0.0,UINT energyWindowSize=10);
+    
+    /**
+     Copy constructor, copies the MotionSegmentation from the rhs instance to this instance.
+     
+     @param const MotionSegmentation &rhs: another instance of this class from which the data will be copied to this instance
+     */
+    MotionSegmentation(const MotionSegmentation &rhs);
+    
+    /**
+     Default Destructor
+     */
+    virtual ~MotionSegmentation(void);
+    
+    /**
+     Sets the equals operator, copies the data from the rhs instance to this instance.
+     
+     @param const MotionSegmentation &rhs: another instance of this class from which the data will be copied to this instance
+     @return a reference to this instance
+     */
+    MotionSegmentation& operator=(const MotionSegmentation &rhs);
+    
+    /**
+     Sets the Context clone function, overwriting the base Context function.
+     This function is called by the GestureRecognitionPipeline when the user adds a new Context module to the pipeline.
+     
+     @param const Context *context: a pointer to another instance of this class, the values of that instance will be cloned to this instance
+     @return returns true if the clone was successful, false otherwise
+     */
+    virtual bool clone(const Context *context);
+    
+    /**
+     Sets the Context process function, overwriting the base Context function.
+     Updates the speed and motion energy with the new input vector and updates the state of the current segment.
+     
+     @param const VectorDouble &inputVector: the new input vector, this must have numDimensions elements
+     @return returns true if the data was processed, false otherwise
+     */
+    virtual bool process(const VectorDouble &inputVector);
+    
+    /**
+     Sets the Context reset function, overwriting the base Context function.
+     Resets the derivative and motion energy filters and discards any segment that is being collected.
+     
+     @return returns true if the module was reset, false otherwise
+     */
+    virtual bool reset();
+    
+    /**
+     Gets the segment that ended with the most recent input vector.
+     
+     @param MatrixDouble &segment: returns the segment, as a [M N] matrix where M is the length of the segment
+     @return returns true if a segment ended with the most recent input vector, false otherwise
+     */
+    virtual bool getSegment(MatrixDouble &segment) const;
+    
+    /**
+     Initializes the MotionSegmentation module, this will discard any segment that is being collected.
+     
+     @param UINT numDimensions: the number of dimensions in the input data
+     @param double startVelocityThreshold: the speed (per sample) the input must reach to start a segment
+     @param double stopVelocityThreshold: a segment ends when the speed stays below this value for stopDelay samples
+     @param double startEnergyThreshold: the motion energy the input must reach to start a segment
+     @param UINT energyWindowSize: the number of samples used to compute the motion energy
+     @return returns true if the module was initialized, false otherwise
+     */
+    bool init(UINT numDimensions,double startVelocityThreshold,double stopVelocityThreshold,double startEnergyThreshold,UINT energyWindowSize);
+    
+    /**
+     Sets the minimum and maximum number of samples in a segment. Segments shorter than the minimum length are discarded, and a
+     segment is ended when it reaches the maximum length. This will discard any segment that is being collected.
+     
+     @param UINT minSegmentLength: the minimum number of samples in a segment
+     @param UINT maxSegmentLength: the maximum number of samples in a segment, this must be greater than the energyWindowSize
+     @return returns true if the lengths were updated, false otherwise
+     */
+    bool setSegmentLengthLimits(UINT minSegmentLength,UINT maxSegmentLength);
+    
+    /**
+     Sets the number of samples the speed must stay below the stop velocity threshold for a segment to end.
+     
+     @param UINT stopDelay: the number of samples, must be greater than zero
+     @return returns true if the value was updated, false otherwise
+     */
+    bool setStopDelay(UINT stopDelay);
+    
+    /**
+     Sets if the module should collect each segment and give the complete segment to the classifier (true), or open the pipeline
+     for each sample inside a segment (false).
+     
+     @param bool bufferSegments: sets if the segments should be collected
+     @return returns true if the value was updated
+     */
+    bool setBufferSegments(bool bufferSegments);
+    
+    bool getSegmentActive() const { return segmentActive; }
+    bool getSegmentReady() const { return segmentReady; }
+    UINT getSegmentLength() const { return segmentLength; }
+    UINT getNumSegmentsDetected() const { return numSegmentsDetected; }
+    UINT getNumSegmentsDiscarded() const { return numSegmentsDiscarded; }
+    double getVelocity() const { return velocity; }
+    double getEnergy() const { return energy; }
+    
+protected:
+    void startSegment();
+    void endSegment();
+    
+    double startVelocityThreshold;
+    double stopVelocityThreshold;
+    double startEnergyThreshold;
+    UINT energyWindowSize;
+    UINT minSegmentLength;
+    UINT maxSegmentLength;
+    UINT stopDelay;
+    bool bufferSegments;
+    
+    Derivative velocityFilter;                          ///< Computes the first derivative of the input
+    MovementIndex energyFilter;                         ///< Computes the standard deviation of each dimension over the energy window
+    VectorDouble derivative;
+    double velocity;
+    double energy;
+    
+    bool segmentActive;
+    bool segmentReady;
+    UINT segmentLength;
+    UINT numStationarySamples;
+    UINT numSegmentsDetected;
+    UINT numSegmentsDiscarded;
+    MatrixDouble segmentBuffer;                         ///< The current segment, [maxSegmentLength N]
+    MatrixDouble preRollBuffer;                         ///< A ring buffer of the last energyWindowSize samples before a segment starts
+    VectorDouble preRollVelocity;                       ///< The speed of each sample in the preRollBuffer
+    UINT preRollWritePtr;
+    UINT numPreRollSamples;
+    
+    static RegisterContextModule< MotionSegmentation > registerModule;
+};
+    
+}//End of namespace GRT
+
+#endif //GRT_MOTION_SEGMENTATION_HEADER
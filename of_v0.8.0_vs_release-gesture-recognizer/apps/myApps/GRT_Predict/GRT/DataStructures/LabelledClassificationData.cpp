@@ -873,16 +873,56 @@ LabelledClassificationData LabelledClassificationData::getClassData(UINT classLa
 LabelledClassificationData LabelledClassificationData::getBootstrappedDataset(UINT numSamples){
     
     Random rand;
+    return getSubset( getBootstrappedIndexes(rand,numSamples) );
+}
+    
+vector< UINT > LabelledClassificationData::getBootstrappedIndexes(Random &random,UINT numSamples){
+    
+    if( numSamples == 0 ) numSamples = totalNumSamples;
+    if( totalNumSamples == 0 ) return vector< UINT >();
+    
+    vector< UINT > sampleIndexes( numSamples );
+    for(UINT i=0; i<numSamples; i++){
+        sampleIndexes[i] = (UINT)random.getRandomNumberInt(0, totalNumSamples);
+    }
+    
+    return sampleIndexes;
+}
+    
+LabelledClassificationData LabelledClassificationData::getSubset(const vector< UINT > &sampleIndexes){
+    
     LabelledClassificationData newDataset;
-    newDataset.setNumDimensions( getNumDimensions() );
+    newDataset.setNumDimensions( numDimensions );
     newDataset.setAllowNullGestureClass( allowNullGestureClass );
     
-    if( numSamples == 0 ) numSamples = totalNumSamples;
+    const UINT numSamples = (UINT)sampleIndexes.size();
+    for(UINT i=0; i<numSamples; i++){
+        if( sampleIndexes[i] >= totalNumSamples ){
+            errorLog << "getSubset(const vector< UINT > &sampleIndexes) - The sample index " << sampleIndexes[i] << " is out of range!" << endl;
+            return LabelledClassificationData();
+        }
+    }
     
+    //Copy the samples directly and count the classes, rather than calling addSample for each sample
+    newDataset.data.reserve( numSamples );
     for(UINT i=0; i<numSamples; i++){
-        UINT randomIndex = rand.getRandomNumberInt(0, totalNumSamples);
-        newDataset.addSample(data[randomIndex].getClassLabel(), data[randomIndex].getSample());
+        LabelledClassificationSample &sample = data[ sampleIndexes[i] ];
+        const UINT classLabel = sample.getClassLabel();
+        newDataset.data.push_back( sample );
+        
+        bool labelFound = false;
+        for(UINT k=0; k<newDataset.classTracker.size(); k++){
+            if( classLabel == newDataset.classTracker[k].classLabel ){
+                newDataset.classTracker[k].counter++;
+                labelFound = true;
+                break;
+            }
+        }
+        if( !labelFound ){
+            newDataset.classTracker.push_back( ClassTracker(classLabel,1) );
+        }
     }
+    newDataset.totalNumSamples = numSamples;
     
     return newDataset;
 }
@@ -1156,19 +1196,8 @@ MatrixDouble LabelledClassificationData::getClassStdDev(){
 
 MatrixDouble LabelledClassificationData::getCovarianceMatrix(){
 	
-	VectorDouble mean = getMean();
-	MatrixDouble covariance(numDimensions,numDimensions);
-	
-	for(UINT j=0; j<numDimensions; j++){
-		for(UINT k=0; k<numDimensions; k++){
-			for(UINT i=0; i<totalNumSamples; i++){
-				covariance[j][k] += (data[i][j]-mean[j]) * (data[i][k]-mean[k]) ;
-			}
-			covariance[j][k] /= double(totalNumSamples-1);
-		}
-	}
-	
-	return covariance;
+	//Copy the samples into one matrix so the blocked covariance function in MatrixDouble can be used
+	return getDataAsMatrixDouble().getCovarianceMatrix();
 }
 
 vector< MatrixDouble > LabelledClassificationData::getHistogramData(UINT numBins){
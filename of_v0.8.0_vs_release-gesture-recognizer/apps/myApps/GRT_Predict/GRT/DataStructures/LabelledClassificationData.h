@@ -304,8 +304,32 @@ public:
     LabelledClassificationData getClassData(UINT classLabel);
     
     
+    /**
+     Returns a new dataset with numSamples samples drawn at random (with replacement) from this dataset.
+     
+     @param UINT numSamples: the number of samples in the new dataset, if this is zero then the new dataset will be the same size as this dataset
+     @return returns the bootstrapped dataset
+     */
     LabelledClassificationData getBootstrappedDataset(UINT numSamples=0);
     
+    /**
+     Returns the indexes of numSamples samples drawn at random (with replacement) from this dataset, using the random generator passed in.
+     Using a separately seeded Random instance for each bootstrap makes the bootstraps repeatable, even when several are drawn at the same time.
+     
+     @param Random &random: the random generator used to pick the samples
+     @param UINT numSamples: the number of indexes to draw, if this is zero then the size of this dataset will be used
+     @return returns a vector containing the indexes of the bootstrapped samples
+     */
+    vector< UINT > getBootstrappedIndexes(Random &random,UINT numSamples=0);
+    
+    /**
+     Returns a new dataset containing the samples at the given indexes, indexes can appear more than once.
+     
+     @param const vector< UINT > &sampleIndexes: the indexes of the samples that should be copied into the new dataset
+     @return returns a dataset containing the samples at the given indexes, this will be empty if any of the indexes are out of range
+     */
+    LabelledClassificationData getSubset(const vector< UINT > &sampleIndexes);
+    
 	/**
      Reformats the LabelledClassificationData as LabelledRegressionData to enable regression algorithms like the MLP to be used as a classifier.
 	 This sets the number of targets in the regression data equal to the number of classes in the classification data.  The output target ouput of each regression sample will therefore
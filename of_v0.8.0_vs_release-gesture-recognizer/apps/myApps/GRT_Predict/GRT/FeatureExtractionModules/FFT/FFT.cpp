@@ -25,12 +25,14 @@ namespace GRT{
 //Register the FFT module with the FeatureExtraction base class
 RegisterFeatureExtractionModule< FFT > FFT::registerModule("FFT");
 
-FFT::FFT(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindowFunction,bool computeMagnitude,bool computePhase):tempBuffer(NULL){ 
+FFT::FFT(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindowFunction,bool computeMagnitude,bool computePhase){ 
     featureExtractionType = "FFT"; 
     initialized = false; 
     featureDataReady = false;
     numInputDimensions = 0;
     numOutputDimensions = 0;
+    numSlidingUpdates = 0;
+    slidingDFTReady = false;
     
     if( isPowerOfTwo(fftWindowSize) && hopSize > 0 && numDimensions > 0 ){
         init(fftWindowSize,hopSize,numDimensions,fftWindowFunction,computeMagnitude,computePhase);
@@ -43,19 +45,10 @@ FFT::FFT(const FFT &rhs){
 }
     
 FFT::~FFT(void){
-    if( tempBuffer != NULL ){
-        delete[] tempBuffer;
-        tempBuffer = NULL;
-    }
 }
     
 FFT& FFT::operator=(const FFT &rhs){
     if( this != &rhs ){
-        if( tempBuffer != NULL ){
-            delete[] tempBuffer;
-            tempBuffer = NULL;
-        }
-        
         this->hopSize = rhs.hopSize;
         this->dataBufferSize = rhs.dataBufferSize;
         this->fftWindowSize = rhs.fftWindowSize;
@@ -66,8 +59,11 @@ FFT& FFT::operator=(const FFT &rhs){
         this->dataBuffer = rhs.dataBuffer;
         this->fft = rhs.fft;
         this->windowSizeMap = rhs.windowSizeMap;
-		this->tempBuffer = NULL;
-		if( this->dataBufferSize > 0 ) this->tempBuffer = new double[ this->dataBufferSize ];
+        this->numSlidingUpdates = rhs.numSlidingUpdates;
+        this->slidingDFTReady = rhs.slidingDFTReady;
+        this->fftInput = rhs.fftInput;
+        this->spectrumReal = rhs.spectrumReal;
+        this->spectrumImag = rhs.spectrumImag;
         
         copyBaseVariables( (FeatureExtraction*)&rhs );
     }
@@ -227,11 +223,6 @@ bool FFT::init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindow
         return false;
     }
     
-    if( tempBuffer != NULL ){
-        delete[] tempBuffer;
-        tempBuffer = NULL;
-    }
-       
     this->dataBufferSize = fftWindowSize;
     this->fftWindowSize = fftWindowSize;
     this->hopSize = hopSize;
@@ -240,7 +231,8 @@ bool FFT::init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindow
     this->computePhase = computePhase;
     hopCounter = 0;
     featureDataReady = false;
-    tempBuffer = new double[ dataBufferSize ];
+    numSlidingUpdates = 0;
+    slidingDFTReady = false;
     numInputDimensions = numDimensions;
     
     //Set the output size, the fftWindowSize is divided by 2 because the FFT is symmetrical so only half the actual FFT is returned
@@ -256,6 +248,12 @@ bool FFT::init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindow
     dataBuffer.resize(dataBufferSize,VectorDouble(numDimensions,0));
     fft.clear();
     fft.resize(numDimensions);
+    fftInput.clear();
+    fftInput.resize(dataBufferSize*numDimensions,0);
+    spectrumReal.clear();
+    spectrumReal.resize(dataBufferSize/2*numDimensions,0);
+    spectrumImag.clear();
+    spectrumImag.resize(dataBufferSize/2*numDimensions,0);
     
     for(unsigned int i=0; i<numDimensions; i++){
         if( !fft[i].init(fftWindowSize,fftWindowFunction,computeMagnitude,computePhase) ){
@@ -314,23 +312,47 @@ bool FFT::update(const VectorDouble &x){
     }
 #endif
 
+    featureDataReady = false;
+    
+    const bool useSlidingDFT = hopSize == 1 && fftWindowFunction == RECTANGULAR_WINDOW;
+    
+    //If the sliding DFT is being used, the previous results are updated with the new sample before it is added to the buffer
+    if( useSlidingDFT && slidingDFTReady ){
+        if( dataBuffer.getBufferFilled() ){
+            fft[0].slideDFT( &x[0], &dataBuffer[0][0], numInputDimensions, &spectrumReal[0], &spectrumImag[0] );
+        }else fft[0].addToDFT( &x[0], dataBuffer.getNumValuesInBuffer(), numInputDimensions, &spectrumReal[0], &spectrumImag[0] );
+    }
+
     //Add the current input to the data buffers
     dataBuffer.push_back(x);
     
-    featureDataReady = false;
-    
     if( ++hopCounter == hopSize ){
         hopCounter = 0;
-        //Compute the FFT for each dimension
-        for(UINT j=0; j<numInputDimensions; j++){
+        
+        //Compute the FFT of all the dimensions. If the sliding DFT is being used, this is only done once every fftWindowSize samples
+        if( !useSlidingDFT || !slidingDFTReady || ++numSlidingUpdates >= fftWindowSize ){
             
-            //Copy the input data for this dimension into the temp buffer
+            //Copy the input data into the interleaved temp buffer
             for(UINT i=0; i<dataBufferSize; i++){
-                tempBuffer[i] = dataBuffer[i][j];
+                const VectorDouble &sample = dataBuffer[i];
+                for(UINT j=0; j<numInputDimensions; j++){
+                    fftInput[ i*numInputDimensions + j ] = sample[j];
+                }
             }
             
-            //Compute the FFT
-            if( !fft[j].computeFFT( tempBuffer ) ){
+            //All the dimensions share the same FFT window size and window function, so the first FFT is used to compute them all
+            if( !fft[0].computeFFT( &fftInput[0], numInputDimensions, &spectrumReal[0], &spectrumImag[0] ) ){
+                errorLog << "update(const VectorDouble &x) - Failed to compute FFT!" << endl;
+                return false;
+            }
+            
+            numSlidingUpdates = 0;
+            slidingDFTReady = useSlidingDFT;
+        }
+        
+        //Compute the magnitude and phase of each dimension
+        for(UINT j=0; j<numInputDimensions; j++){
+            if( !fft[j].computeSpectrum( &spectrumReal[j], &spectrumImag[j], numInputDimensions ) ){
                 errorLog << "update(const VectorDouble &x) - Failed to compute FFT!" << endl;
                 return false;
             }
@@ -395,6 +417,7 @@ bool FFT::setHopSize(UINT hopSize){
     if( hopSize > 0 ){
         this->hopSize = hopSize;
         hopCounter = 0;
+        slidingDFTReady = false;
         return true;
     }
     errorLog << "setHopSize(UINT hopSize) - The hopSize value must be greater than zero!" << endl;
@@ -414,6 +437,7 @@ bool FFT::setFFTWindowSize(UINT fftWindowSize){
     
 bool FFT::setFFTWindowFunction(UINT fftWindowFunction){
     if( validateFFTWindowFunction( fftWindowFunction ) ){
+        if( initialized ) return init(fftWindowSize, hopSize, numInputDimensions, fftWindowFunction, computeMagnitude, computePhase);
         this->fftWindowFunction = fftWindowFunction;
         return true;
     }
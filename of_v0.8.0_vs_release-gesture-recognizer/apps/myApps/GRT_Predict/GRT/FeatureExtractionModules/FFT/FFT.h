@@ -40,6 +40,11 @@
  and 2 represents the magnitude and phase vectors. If you only really need the magnitude or phase of a signal, as opposed to both, then you can turn off the computation 
  and concatenation of the element you do not need to save unnecessary computations and memory copies, this can either be done in the FFT's constructor or by using the 
  setComputeMagnitude(bool computeMagnitude) and setComputePhase(bool computePhase) functions.
+ 
+ The FFTs of all the dimensions are computed together on the interleaved input data. If the hopSize is 1 and the window function
+ is the RECTANGULAR_WINDOW, the FFT results are not recomputed for every sample but are instead updated with a sliding DFT, which
+ costs O(M) per dimension for each new sample instead of O(M log M). The results are still recomputed with an FFT once every
+ fftWindowSize samples, so the rounding errors of the sliding DFT can not build up.
  */
 
 #ifndef GRT_FFT_HEADER
@@ -239,6 +244,14 @@ public:
      */   
     bool getComputePhase(){ if(initialized){ return computePhase; } return false; }
     
+    /**
+     Returns if the FFT results are being updated with a sliding DFT, which is the case when the hopSize is 1 and the window function
+     is the RECTANGULAR_WINDOW.
+     
+	 @return true if the FFT results are being updated with a sliding DFT and if the FFT has been initialized, otherwise false will be returned
+     */
+    bool getUseSlidingDFT(){ if(initialized){ return hopSize == 1 && fftWindowFunction == RECTANGULAR_WINDOW; } return false; }
+    
     /**
      Returns the FFT results computed from the last FFT of the input signal.
      
@@ -309,7 +322,11 @@ protected:
     UINT hopCounter;                                            ///< Keeps track of how many input samples the FFT has seen
     bool computeMagnitude;                                      ///< Tracks if the magnitude (and power) of the FFT need to be computed
     bool computePhase;                                          ///< Tracks if the phase of the FFT needs to be computed
-    double *tempBuffer;                                         ///< A temporary buffer used to store the input data for the FFT
+    UINT numSlidingUpdates;                                     ///< Counts the sliding DFT updates since the FFT results were last recomputed
+    bool slidingDFTReady;                                       ///< Tracks if the spectrum buffers hold the DFT of the current dataBuffer
+    VectorDouble fftInput;                                      ///< A temporary buffer used to store the interleaved input data for the FFT
+    VectorDouble spectrumReal;                                  ///< The interleaved real part of the FFT results of each dimension
+    VectorDouble spectrumImag;                                  ///< The interleaved imaginary part of the FFT results of each dimension
     CircularBuffer< VectorDouble > dataBuffer;                  ///< A circular buffer used to store the previous M inputs
     vector< FastFourierTransform > fft;                         ///< A buffer used to store the FFT results
     std::map< unsigned int, unsigned int > windowSizeMap;            ///< A map to relate the FFTWindowSize enumerations to actual values
@@ -35,8 +35,6 @@ FastFourierTransform::FastFourierTransform(){
     windowSize = 0;
     windowFunction = RECTANGULAR_WINDOW;
     averagePower = 0;
-    
-    initFFT();
 }
     
 FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
@@ -46,7 +44,6 @@ FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
     this->windowSize = rhs.windowSize;
     this->windowFunction = rhs.windowFunction;
     this->averagePower = 0;
-    this->initFFT();
     
     if( rhs.initialized ){
         this->init(rhs.windowSize,rhs.windowFunction,rhs.computeMagnitude,rhs.computePhase);
@@ -59,6 +56,7 @@ FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
             this->phase[i] = rhs.phase[i];
             this->power[i] = rhs.power[i];
         }
+        this->averagePower = rhs.averagePower;
     }
 }
 
@@ -75,7 +73,6 @@ FastFourierTransform& FastFourierTransform::operator=(const FastFourierTransform
         this->windowSize = rhs.windowSize;
         this->windowFunction = rhs.windowFunction;
         this->averagePower = 0;
-        this->initFFT();
         
         if( rhs.initialized ){
             this->init(rhs.windowSize,rhs.windowFunction,rhs.computeMagnitude,rhs.computePhase);
@@ -88,6 +85,7 @@ FastFourierTransform& FastFourierTransform::operator=(const FastFourierTransform
                 this->phase[i] = rhs.phase[i];
                 this->power[i] = rhs.power[i];
             }
+            this->averagePower = rhs.averagePower;
         }
     }
     return *this;
@@ -108,8 +106,6 @@ bool FastFourierTransform::init(unsigned int windowSize,unsigned int windowFunct
         return false;
     }
     
-    initFFT();
-    
     this->windowSize = windowSize;
     this->windowFunction = windowFunction;
     this->computeMagnitude = computeMagnitude;
@@ -118,18 +114,12 @@ bool FastFourierTransform::init(unsigned int windowSize,unsigned int windowFunct
     //Init the memory
     fftReal.resize( windowSize );
     fftImag.resize( windowSize );
-    tmpReal.resize( windowSize/2 );
-    tmpImag.resize( windowSize/2 );
     magnitude.resize( windowSize );
     phase.resize( windowSize );
     power.resize( windowSize );
     averagePower = 0;
     
     //Zero the memory
-    for(UINT i=0; i<windowSize/2; i++){
-        tmpReal[i] = 0;
-        tmpImag[i] = 0;
-    }
     for(UINT i=0; i<windowSize; i++){
         fftReal[i] = 0;
         fftImag[i] = 0;
@@ -138,6 +128,41 @@ bool FastFourierTransform::init(unsigned int windowSize,unsigned int windowFunct
         power[i] = 0;
     }
     
+    //Precompute the window function
+    windowCoefficients.resize( windowSize );
+    for(UINT i=0; i<windowSize; i++){
+        switch( windowFunction ){
+            case RECTANGULAR_WINDOW:
+                windowCoefficients[i] = 1.0;
+                break;
+            case BARTLETT_WINDOW:
+                if( i < windowSize/2 ) windowCoefficients[i] = i / (double) (windowSize / 2);
+                else windowCoefficients[i] = 1.0 - ((i - windowSize/2) / (double) (windowSize/2));
+                break;
+            case HAMMING_WINDOW:
+                windowCoefficients[i] = 0.54 - 0.46 * cos(2 * PI * i / (windowSize - 1));
+                break;
+            case HANNING_WINDOW:
+                windowCoefficients[i] = 0.50 - 0.50 * cos(2 * PI * i / (windowSize - 1));
+                break;
+        }
+    }
+    
+    //Precompute the twiddle factors, these are shared by the complex FFT, the real FFT and the sliding DFT
+    twiddleReal.resize( windowSize );
+    twiddleImag.resize( windowSize );
+    for(UINT i=0; i<windowSize; i++){
+        twiddleReal[i] = cos( 2 * PI * i / windowSize );
+        twiddleImag[i] = sin( 2 * PI * i / windowSize );
+    }
+    
+    //Precompute the bit reversal ordering of the half size complex FFT
+    const int numBits = numberOfBitsNeeded( windowSize/2 );
+    bitReverseTable.resize( windowSize/2 );
+    for(UINT i=0; i<windowSize/2; i++){
+        bitReverseTable[i] = (unsigned int)reverseBits( i, numBits );
+    }
+    
     //Flag that the FFT has been initialized
     initialized = true;
     
@@ -150,18 +175,186 @@ bool FastFourierTransform::computeFFT(double *data){
         return false;
     }
     
-    //Window the input data
-    if( !windowData(data) ){
+    //Perform the FFT
+    if( !computeFFT(data, 1, &fftReal[0], &fftImag[0]) ){
+        return false;
+    }
+    
+    return computeSpectrum( &fftReal[0], &fftImag[0], 1 );
+}
+    
+/*
+ * Real Fast Fourier Transform
+ *
+ * This function was based on the code in Numerical Recipes in C. The real input is packed into a complex FFT of half the
+ * size (the even samples in the real part and the odd samples in the imaginary part), and the results of the complex FFT
+ * are then split back into the spectrum of the real input. Each channel of the interleaved input is transformed with the
+ * same butterflies, so the inner loops run over the channels.
+ */
+bool FastFourierTransform::computeFFT(const double *data,const unsigned int numChannels,double *realOut,double *imagOut){
+    
+    if( !initialized || data == NULL || realOut == NULL || imagOut == NULL || numChannels == 0 ){
+        return false;
+    }
+    
+    const unsigned int half = windowSize / 2;
+    const bool useWindow = windowFunction != RECTANGULAR_WINDOW;
+    unsigned int c = 0;
+    
+    //Window the input data and copy it into the outputs in the bit reversal ordering
+    for(unsigned int i=0; i<half; i++){
+        const double *even = data + (2*i)*numChannels;
+        const double *odd = even + numChannels;
+        double *re = realOut + bitReverseTable[i]*numChannels;
+        double *im = imagOut + bitReverseTable[i]*numChannels;
+        if( useWindow ){
+            const double evenWeight = windowCoefficients[2*i];
+            const double oddWeight = windowCoefficients[2*i+1];
+            for(c=0; c<numChannels; c++){
+                re[c] = even[c] * evenWeight;
+                im[c] = odd[c] * oddWeight;
+            }
+        }else{
+            for(c=0; c<numChannels; c++){
+                re[c] = even[c];
+                im[c] = odd[c];
+            }
+        }
+    }
+    
+    //Do the complex FFT
+    for(unsigned int blockSize=2; blockSize<=half; blockSize <<= 1){
+        const unsigned int blockEnd = blockSize / 2;
+        const unsigned int twiddleStep = windowSize / blockSize;
+        
+        for(unsigned int i=0; i<half; i+=blockSize){
+            for(unsigned int n=0; n<blockEnd; n++){
+                const double wr = twiddleReal[ n*twiddleStep ];
+                const double wi = twiddleImag[ n*twiddleStep ];
+                double *rj = realOut + (i+n)*numChannels;
+                double *ij = imagOut + (i+n)*numChannels;
+                double *rk = rj + blockEnd*numChannels;
+                double *ik = ij + blockEnd*numChannels;
+                for(c=0; c<numChannels; c++){
+                    const double tr = wr * rk[c] - wi * ik[c];
+                    const double ti = wr * ik[c] + wi * rk[c];
+                    rk[c] = rj[c] - tr;
+                    ik[c] = ij[c] - ti;
+                    rj[c] += tr;
+                    ij[c] += ti;
+                }
+            }
+        }
+    }
+    
+    //Split the results of the complex FFT into the spectrum of the real input
+    for(unsigned int i=1; i<half/2; i++){
+        const double wr = twiddleReal[i];
+        const double wi = twiddleImag[i];
+        double *r1 = realOut + i*numChannels;
+        double *i1 = imagOut + i*numChannels;
+        double *r3 = realOut + (half-i)*numChannels;
+        double *i3 = imagOut + (half-i)*numChannels;
+        for(c=0; c<numChannels; c++){
+            const double h1r = 0.5 * (r1[c] + r3[c]);
+            const double h1i = 0.5 * (i1[c] - i3[c]);
+            const double h2r = 0.5 * (i1[c] + i3[c]);
+            const double h2i = -0.5 * (r1[c] - r3[c]);
+            
+            r1[c] = h1r + wr * h2r - wi * h2i;
+            i1[c] = h1i + wr * h2i + wi * h2r;
+            r3[c] = h1r - wr * h2r + wi * h2i;
+            i3[c] = -h1i + wr * h2i + wi * h2r;
+        }
+    }
+    
+    //The real part of bin 0 is the DC value, the imaginary part of bin 0 is the Nyquist value
+    for(c=0; c<numChannels; c++){
+        const double h1r = realOut[c];
+        realOut[c] = h1r + imagOut[c];
+        imagOut[c] = h1r - imagOut[c];
+    }
+    
+    return true;
+}
+    
+bool FastFourierTransform::slideDFT(const double *newSample,const double *oldSample,const unsigned int numChannels,double *real,double *imag){
+    
+    if( !initialized || newSample == NULL || oldSample == NULL || real == NULL || imag == NULL ){
+        return false;
+    }
+    
+    const unsigned int half = windowSize / 2;
+    unsigned int c = 0;
+    
+    //The DC and Nyquist values (the Nyquist value changes sign as every sample moves back by one position)
+    for(c=0; c<numChannels; c++){
+        const double delta = newSample[c] - oldSample[c];
+        real[c] += delta;
+        imag[c] = -(imag[c] + delta);
+    }
+    
+    //Each bin k is shifted by one sample, which rotates it by -2 PI k / windowSize
+    for(unsigned int k=1; k<half; k++){
+        const double wr = twiddleReal[k];
+        const double wi = twiddleImag[k];
+        double *re = real + k*numChannels;
+        double *im = imag + k*numChannels;
+        for(c=0; c<numChannels; c++){
+            const double a = re[c] + newSample[c] - oldSample[c];
+            const double b = im[c];
+            re[c] = a * wr + b * wi;
+            im[c] = b * wr - a * wi;
+        }
+    }
+    
+    return true;
+}
+    
+bool FastFourierTransform::addToDFT(const double *sample,const unsigned int index,const unsigned int numChannels,double *real,double *imag){
+    
+    if( !initialized || sample == NULL || real == NULL || imag == NULL || index >= windowSize ){
+        return false;
+    }
+    
+    const unsigned int half = windowSize / 2;
+    const double nyquistSign = index % 2 == 0 ? 1.0 : -1.0;
+    unsigned int c = 0;
+    
+    for(c=0; c<numChannels; c++){
+        real[c] += sample[c];
+        imag[c] += sample[c] * nyquistSign;
+    }
+    
+    unsigned int twiddleIndex = 0;
+    for(unsigned int k=1; k<half; k++){
+        twiddleIndex = (twiddleIndex + index) % windowSize;
+        const double wr = twiddleReal[ twiddleIndex ];
+        const double wi = twiddleImag[ twiddleIndex ];
+        double *re = real + k*numChannels;
+        double *im = imag + k*numChannels;
+        for(c=0; c<numChannels; c++){
+            re[c] += sample[c] * wr;
+            im[c] += sample[c] * wi;
+        }
+    }
+    
+    return true;
+}
+    
+bool FastFourierTransform::computeSpectrum(const double *real,const double *imag,const unsigned int stride){
+    
+    if( !initialized || real == NULL || imag == NULL ){
         return false;
     }
     
-    //Perform the FFT
-    realFFT(data, &fftReal[0], &fftImag[0]);
-	
     averagePower = 0;
     
     for(unsigned int i = 0; i<windowSize/2; i++){
         
+        fftReal[i] = real[ i*stride ];
+        fftImag[i] = imag[ i*stride ];
+        
         if( computeMagnitude ){
             power[i] = fftReal[i]*fftReal[i] + fftImag[i]*fftImag[i];
             averagePower += power[i];
@@ -179,37 +372,6 @@ bool FastFourierTransform::computeFFT(double *data){
     return true;
 }
     
-bool FastFourierTransform::windowData(double *data){
-    
-    switch( windowFunction ){
-        case RECTANGULAR_WINDOW:
-            return true;
-            break;
-        case BARTLETT_WINDOW:
-            for(unsigned int i=0; i<windowSize/2; i++) {
-                data[i] *= (i / (double) (windowSize / 2));
-                data[i + (windowSize/2)] *= (1.0 - (i / (double) (windowSize/2)));
-            }
-            return true;
-            break;
-        case HAMMING_WINDOW:
-            for(unsigned int i=0; i<windowSize; i++)
-                data[i] *= 0.54 - 0.46 * cos(2 * PI * i / (windowSize - 1));
-            return true;
-            break;
-        case HANNING_WINDOW:
-            for(unsigned int i=0; i <windowSize; i++)
-                data[i] *= 0.50 - 0.50 * cos(2 * PI * i / (windowSize - 1));
-            return true;
-            break;
-        default:
-            return false;
-            break;
-    }
-    
-    return false;
-}
-    
 VectorDouble FastFourierTransform::getMagnitudeData(){
     
     if( !initialized ) return VectorDouble();
@@ -263,155 +425,6 @@ double* FastFourierTransform::getPowerDataPtr(){
     return &power[0];
 }
     
-/*
- * Real Fast Fourier Transform
- *
- * This function was based on the code in Numerical Recipes in C.
- * In Num. Rec., the inner loop is based on a single 1-based array
- * of interleaved real and imaginary numbers.  Because we have two
- * separate zero-based arrays, our indices are quite different.
- * Here is the correspondence between Num. Rec. indices and our indices:
- *
- * i1  <->  real[i]
- * i2  <->  imag[i]
- * i3  <->  real[n/2-i]
- * i4  <->  imag[n/2-i]
- */
-
-bool FastFourierTransform::realFFT(double *RealIn, double *RealOut, double *ImagOut){
-    int NumSamples = (int)windowSize;
-    int Half = NumSamples / 2;
-    int i;
-    
-    double theta = PI / Half;
-    
-    for (i = 0; i < Half; i++) {
-        tmpReal[i] = RealIn[2 * i];
-        tmpImag[i] = RealIn[2 * i + 1];
-    }
-    
-    if( !FFT(Half, 0, &tmpReal[0], &tmpImag[0], RealOut, ImagOut) ){
-        return false;
-    }
-    
-    double wtemp = double(sin(0.5 * theta));
-    
-    double wpr = -2.0 * wtemp * wtemp;
-    double wpi = double (sin(theta));
-    double wr = 1.0 + wpr;
-    double wi = wpi;
-    
-    int i3;
-    
-    double h1r, h1i, h2r, h2i;
-    
-    for (i = 1; i < Half / 2; i++) {
-        
-        i3 = Half - i;
-        
-        h1r = 0.5 * (RealOut[i] + RealOut[i3]);
-        h1i = 0.5 * (ImagOut[i] - ImagOut[i3]);
-        h2r = 0.5 * (ImagOut[i] + ImagOut[i3]);
-        h2i = -0.5 * (RealOut[i] - RealOut[i3]);
-        
-        RealOut[i] = h1r + wr * h2r - wi * h2i;
-        ImagOut[i] = h1i + wr * h2i + wi * h2r;
-        RealOut[i3] = h1r - wr * h2r + wi * h2i;
-        ImagOut[i3] = -h1i + wr * h2i + wi * h2r;
-        
-        wr = (wtemp = wr) * wpr - wi * wpi + wr;
-        wi = wi * wpr + wtemp * wpi + wi;
-    }
-    
-    RealOut[0] = (h1r = RealOut[0]) + ImagOut[0];
-    ImagOut[0] = h1r - ImagOut[0];
-    
-    return true;
-}
-
-bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,double *RealIn, double *ImagIn, double *RealOut, double *ImagOut){
-    int NumBits;                 /* Number of bits needed to store indices */
-    int i, j, k, n;
-    int BlockSize, BlockEnd;
-    
-    double angle_numerator = 2.0 * PI;
-    double tr, ti;                /* temp real, temp imaginary */
-    
-    if( !isPowerOfTwo(numSamples) ) {
-        fprintf(stderr, "%d is not a power of two\n", numSamples);
-        return false;
-    }
-    
-    if( bitTable.size() == 0 ) initFFT();
-    
-    if( inverseTransform ) angle_numerator = -angle_numerator;
-    
-    NumBits = numberOfBitsNeeded(numSamples);
-    
-    //Simultaneously data copy and bit-reversal ordering into outputs...
-    for(i = 0; i < numSamples; i++) {
-        j = fastReverseBits(i, NumBits);
-        RealOut[j] = RealIn[i];
-        ImagOut[j] = (ImagIn == NULL) ? 0.0 : ImagIn[i];
-    }
-    
-    //Do the FFT
-    BlockEnd = 1;
-    for (BlockSize = 2; BlockSize <= numSamples; BlockSize <<= 1) {
-        
-        double delta_angle = angle_numerator / (double) BlockSize;
-        
-        double sm2 = sin(-2 * delta_angle);
-        double sm1 = sin(-delta_angle);
-        double cm2 = cos(-2 * delta_angle);
-        double cm1 = cos(-delta_angle);
-        double w = 2 * cm1;
-        double ar0, ar1, ar2, ai0, ai1, ai2;
-        
-        for (i = 0; i < numSamples; i += BlockSize) {
-            ar2 = cm2;
-            ar1 = cm1;
-            
-            ai2 = sm2;
-            ai1 = sm1;
-            
-            for (j = i, n = 0; n < BlockEnd; j++, n++) {
-                ar0 = w * ar1 - ar2;
-                ar2 = ar1;
-                ar1 = ar0;
-                
-                ai0 = w * ai1 - ai2;
-                ai2 = ai1;
-                ai1 = ai0;
-                
-                k = j + BlockEnd;
-                tr = ar0 * RealOut[k] - ai0 * ImagOut[k];
-                ti = ar0 * ImagOut[k] + ai0 * RealOut[k];
-                
-                RealOut[k] = RealOut[j] - tr;
-                ImagOut[k] = ImagOut[j] - ti;
-                
-                RealOut[j] += tr;
-                ImagOut[j] += ti;
-            }
-        }
-        
-        BlockEnd = BlockSize;
-    }
-    
-    //Need to normalize the results if we are computing the inverse transform
-    if( inverseTransform ){
-        double denom = (double) numSamples;
-        
-        for(i = 0; i < numSamples; i++) {
-            RealOut[i] /= denom;
-            ImagOut[i] /= denom;
-        }
-    }
-    
-    return true;
-}
-    
 int FastFourierTransform::numberOfBitsNeeded(int powerOfTwo)
 {
     for (int i = 0;; i++){
@@ -434,30 +447,6 @@ int FastFourierTransform::reverseBits(int index, int numBits)
     return rev;
 }
 
-void FastFourierTransform::initFFT()
-{
-    bitTable.resize( MAX_FAST_BITS );
-    
-    int len = 2;
-    for (int b = 1; b <= MAX_FAST_BITS; b++) {
-        
-        bitTable[b - 1].resize(len);
-        
-        for (int i = 0; i < len; i++)
-            bitTable[b - 1][i] = reverseBits(i, b);
-        
-        len <<= 1;
-    }
-}
-
-inline int FastFourierTransform::fastReverseBits(int i, int numBits)
-{
-    if (numBits <= MAX_FAST_BITS)
-        return bitTable[numBits - 1][i];
-    else
-        return reverseBits(i, numBits);
-}
-    
 inline bool FastFourierTransform::isPowerOfTwo(unsigned int x){
     if (x < 2) return false;
     if (x & (x - 1)) return false;
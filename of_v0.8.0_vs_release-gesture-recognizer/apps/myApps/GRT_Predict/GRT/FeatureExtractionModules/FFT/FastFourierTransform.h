@@ -42,10 +42,67 @@ public:
     
     FastFourierTransform& operator=(const FastFourierTransform &rhs);
     
+    /**
+     Initializes the FFT and precomputes the tables (the window coefficients, twiddle factors and bit reversal indices) used by
+     each transform, so no trigonometric functions are called when the FFT is computed.
+     */
     bool init(unsigned int windowSize,unsigned int windowFunction = RECTANGULAR_WINDOW,bool computeMagnitude = true,bool computePhase = true);
     
     bool computeFFT(double *data);
     
+    /**
+     Computes the FFT of several channels at once, using the tables of this instance. The input data is interleaved, so the
+     value of channel c at sample i is data[ i*numChannels + c ], and the results are interleaved in the same way. The butterflies
+     of each stage are run over all the channels at once, which is faster than computing a separate FFT for each channel.
+     The results are in the same format as the single channel FFT, windowSize/2 bins where the imaginary part of bin 0 holds
+     the value of the Nyquist bin. They can be passed to the computeSpectrum function of the instance used for each channel.
+     
+     @param const double *data: the interleaved input data, this must contain windowSize*numChannels values
+     @param const unsigned int numChannels: the number of channels in the input data
+     @param double *realOut: returns the interleaved real part of the results, this must have space for windowSize/2*numChannels values
+     @param double *imagOut: returns the interleaved imaginary part of the results, this must have space for windowSize/2*numChannels values
+     @return returns true if the FFT was computed, false otherwise
+     */
+    bool computeFFT(const double *data,const unsigned int numChannels,double *realOut,double *imagOut);
+    
+    /**
+     Updates the results of a rectangular window FFT when the oldest sample leaves the window and a new sample is added to the
+     end of the window (a sliding DFT). This costs O(windowSize/2) per channel instead of O(windowSize log windowSize) for a new FFT,
+     but rounding errors build up slowly, so the results should be recomputed with computeFFT every so often.
+     
+     @param const double *newSample: the new sample (one value per channel)
+     @param const double *oldSample: the sample that is leaving the window (one value per channel)
+     @param const unsigned int numChannels: the number of channels
+     @param double *real: the interleaved real part of the results, these are updated in place
+     @param double *imag: the interleaved imaginary part of the results, these are updated in place
+     @return returns true if the results were updated, false otherwise
+     */
+    bool slideDFT(const double *newSample,const double *oldSample,const unsigned int numChannels,double *real,double *imag);
+    
+    /**
+     Updates the results of a rectangular window FFT when a value of zero at the given position in the window is replaced with
+     a new sample, which is how a CircularBuffer is filled before it is full. This costs O(windowSize/2) per channel.
+     
+     @param const double *sample: the new sample (one value per channel)
+     @param const unsigned int index: the position of the new sample in the window
+     @param const unsigned int numChannels: the number of channels
+     @param double *real: the interleaved real part of the results, these are updated in place
+     @param double *imag: the interleaved imaginary part of the results, these are updated in place
+     @return returns true if the results were updated, false otherwise
+     */
+    bool addToDFT(const double *sample,const unsigned int index,const unsigned int numChannels,double *real,double *imag);
+    
+    /**
+     Sets the results of this FFT from the (possibly interleaved) results of computeFFT, slideDFT or addToDFT, and computes the
+     magnitude, phase and power of the spectrum.
+     
+     @param const double *real: the real part of the results of the channel
+     @param const double *imag: the imaginary part of the results of the channel
+     @param const unsigned int stride: the distance between two bins in the real and imag arrays (the number of channels)
+     @return returns true if the spectrum was computed, false otherwise
+     */
+    bool computeSpectrum(const double *real,const double *imag,const unsigned int stride = 1);
+    
     VectorDouble getMagnitudeData();
     VectorDouble getPhaseData();
     VectorDouble getPowerData();
@@ -57,13 +114,8 @@ public:
     UINT getFFTSize(){ return windowSize; }
     
 protected:
-    bool windowData(double *data);
-    bool realFFT(double *RealIn, double *RealOut, double *ImagOut);
-    bool FFT(int NumSamples,bool InverseTransform,double *RealIn, double *ImagIn, double *RealOut, double *ImagOut);
     int numberOfBitsNeeded(int PowerOfTwo);
     int reverseBits(int index, int NumBits);
-    void initFFT();
-    inline int fastReverseBits(int i, int NumBits);
     inline bool isPowerOfTwo(unsigned int x);
     
     unsigned int windowSize;
@@ -73,14 +125,14 @@ protected:
     bool computePhase;
     VectorDouble fftReal;
     VectorDouble fftImag;
-    VectorDouble tmpReal;
-    VectorDouble tmpImag;
     VectorDouble magnitude;
     VectorDouble phase;
     VectorDouble power;
     double averagePower;
-    const static int MAX_FAST_BITS = 16;
-    vector< vector< int > > bitTable;
+    VectorDouble windowCoefficients;            ///< The window function value for each sample in the window
+    VectorDouble twiddleReal;                   ///< cos(2 PI i / windowSize) for i in [0 windowSize-1]
+    VectorDouble twiddleImag;                   ///< sin(2 PI i / windowSize) for i in [0 windowSize-1]
+    vector< unsigned int > bitReverseTable;     ///< The bit reversed index of each sample of the windowSize/2 complex FFT
     
 public:
     enum WindowFunctionOptions{RECTANGULAR_WINDOW=0,BARTLETT_WINDOW,HAMMING_WINDOW,HANNING_WINDOW};
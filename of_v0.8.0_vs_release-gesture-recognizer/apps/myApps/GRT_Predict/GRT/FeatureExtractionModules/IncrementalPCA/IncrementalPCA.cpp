@@ -0,0 +1,508 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ and associated documentation files (the "Software"), to deal in the Software without restriction, 
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial 
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT 
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "IncrementalPCA.h"
+
+namespace GRT{
+    
+//Register the IncrementalPCA module with the FeatureExtraction base class
+RegisterFeatureExtractionModule< IncrementalPCA > IncrementalPCA::registerModule("IncrementalPCA");
+    
+IncrementalPCA::IncrementalPCA(UINT numDimensions,UINT numPrincipalComponents,double amnesicFactor,bool updateWhileProcessing){
+    featureExtractionType = "IncrementalPCA";
+    debugLog.setProceedingText("[DEBUG IncrementalPCA]");
+    errorLog.setProceedingText("[ERROR IncrementalPCA]");
+    warningLog.setProceedingText("[WARNING IncrementalPCA]");
+    
+    this->updateWhileProcessing = updateWhileProcessing;
+    init(numDimensions,numPrincipalComponents,amnesicFactor);
+}
+    
+IncrementalPCA::IncrementalPCA(const IncrementalPCA &rhs){
+    //Invoke the equals operator to copy the data from the rhs instance to this instance
+    *this = rhs;
+}
+
+IncrementalPCA::~IncrementalPCA(){
+    
+}
+    
+IncrementalPCA& IncrementalPCA::operator=(const IncrementalPCA &rhs){
+    if(this!=&rhs){
+        this->modelTrained = rhs.modelTrained;
+        this->updateWhileProcessing = rhs.updateWhileProcessing;
+        this->numPrincipalComponents = rhs.numPrincipalComponents;
+        this->numSamples = rhs.numSamples;
+        this->amnesicFactor = rhs.amnesicFactor;
+        this->mean = rhs.mean;
+        this->components = rhs.components;
+        this->projection = rhs.projection;
+        this->projectionOffsets = rhs.projectionOffsets;
+        this->residual = rhs.residual;
+        
+        //Copy the base variables
+        copyBaseVariables( (FeatureExtraction*)&rhs );
+    }
+    return *this;
+}
+    
+bool IncrementalPCA::clone(const FeatureExtraction *featureExtraction){
+    
+    if( featureExtraction == NULL ) return false;
+    
+    if( this->getFeatureExtractionType() == featureExtraction->getFeatureExtractionType() ){
+        //Invoke the equals operator to copy the data from the rhs instance to this instance
+        *this = *(IncrementalPCA*)featureExtraction;
+        return true;
+    }
+    
+    errorLog << "clone(FeatureExtraction *featureExtraction) -  FeatureExtraction Types Do Not Match!" << endl;
+    
+    return false;
+}
+    
+bool IncrementalPCA::computeFeatures(const VectorDouble &inputVector){
+    
+    //Update the model with the new input if needed
+    if( updateWhileProcessing ){
+        if( !update( inputVector ) ){
+            return false;
+        }
+        
+        //Until each component has been started there are no features, the feature vector is left at zero
+        if( !modelTrained ){
+            featureDataReady = false;
+            return true;
+        }
+    }
+    
+    //Project the input onto the principal subspace
+    return project( inputVector );
+}
+
+bool IncrementalPCA::reset(){
+    featureDataReady = false;
+    return true;
+}
+    
+bool IncrementalPCA::saveSettingsToFile(string filename){
+    
+    if( !initialized ){
+        errorLog << "saveSettingsToFile(string filename) - The feature extraction module has not been initialized" << endl;
+        return false;
+    }
+    
+    std::fstream file;
+    file.open(filename.c_str(), std::ios::out);
+    
+    if( !saveSettingsToFile( file ) ){
+        file.close();
+        return false;
+    }
+    
+    file.close();
+    
+    return true;
+}
+
+bool IncrementalPCA::loadSettingsFromFile(string filename){
+    
+    std::fstream file;
+    file.open(filename.c_str(), std::ios::in);
+    
+    if( !loadSettingsFromFile( file ) ){
+        file.close();
+        initialized = false;
+        return false;
+    }
+    
+    file.close();
+    
+    return true;
+}
+
+bool IncrementalPCA::saveSettingsToFile(fstream &file){
+    
+    if( !file.is_open() ){
+        errorLog << "saveSettingsToFile(fstream &file) - The file is not open!" << endl;
+        return false;
+    }
+    
+    file << "INCREMENTAL_PCA_FILE_V1.0" << endl;
+	
+    if( !saveBaseSettingsToFile( file ) ){
+        errorLog << "saveSettingsToFile(fstream &file) - Failed to save base feature extraction settings to file!" << endl;
+        return false;
+    }
+    
+    file << "NumPrincipalComponents: " << numPrincipalComponents << endl;
+    file << "AmnesicFactor: " << amnesicFactor << endl;
+    file << "UpdateWhileProcessing: " << updateWhileProcessing << endl;
+    file << "NumSamples: " << numSamples << endl;
+    
+    //The unnormalized components are saved so the model can continue to learn after it has been loaded
+    file.precision( 17 );
+    file << "Mean: ";
+    for(UINT j=0; j<numInputDimensions; j++){
+        file << mean[j];
+        if( j != numInputDimensions-1 ) file << "\t";
+        else file << endl;
+    }
+    file << "Components: \n";
+    for(UINT k=0; k<numPrincipalComponents; k++){
+        for(UINT j=0; j<numInputDimensions; j++){
+            file << components[k*numInputDimensions+j];
+            if( j != numInputDimensions-1 ) file << "\t";
+            else file << endl;
+        }
+    }
+    
+    return true;
+}
+
+bool IncrementalPCA::loadSettingsFromFile(fstream &file){
+    
+    initialized = false;
+    modelTrained = false;
+    
+    if( !file.is_open() ){
+        errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
+        return false;
+    }
+    
+    string word;
+    
+    //Read and validate the header
+    file >> word;
+    if( word != "INCREMENTAL_PCA_FILE_V1.0" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
+        return false;
+    }
+    
+    if( !loadBaseSettingsFromFile( file ) ){
+        errorLog << "loadBaseSettingsFromFile(fstream &file) - Failed to load base feature extraction settings from file!" << endl;
+        return false;
+    }
+    
+    UINT numComponents = 0;
+    file >> word;
+    if( word != "NumPrincipalComponents:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to load NumPrincipalComponents!" << endl;
+        return false;
+    }
+    file >> numComponents;
+    
+    double amnesic = 0;
+    file >> word;
+    if( word != "AmnesicFactor:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to load AmnesicFactor!" << endl;
+        return false;
+    }
+    file >> amnesic;
+    
+    file >> word;
+    if( word != "UpdateWhileProcessing:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to load UpdateWhileProcessing!" << endl;
+        return false;
+    }
+    file >> updateWhileProcessing;
+    
+    UINT numSamplesLearnt = 0;
+    file >> word;
+    if( word != "NumSamples:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to load NumSamples!" << endl;
+        return false;
+    }
+    file >> numSamplesLearnt;
+    
+    //Setup the buffers and then load the model
+    if( !init( numInputDimensions, numComponents, amnesic ) ){
+        return false;
+    }
+    initialized = false;
+    numSamples = numSamplesLearnt;
+    
+    file >> word;
+    if( word != "Mean:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to load Mean!" << endl;
+        return false;
+    }
+    for(UINT j=0; j<numInputDimensions; j++){
+        file >> mean[j];
+    }
+    
+    file >> word;
+    if( word != "Components:" ){
+        errorLog << "loadSettingsFromFile(fstream &file) - Failed to load Components!" << endl;
+        return false;
+    }
+    for(UINT k=0; k<numPrincipalComponents; k++){
+        for(UINT j=0; j<numInputDimensions; j++){
+            file >> components[k*numInputDimensions+j];
+        }
+    }
+    
+    updateProjection();
+    initialized = true;
+    
+    return true;
+}
+    
+bool IncrementalPCA::init(UINT numDimensions,UINT numPrincipalComponents,double amnesicFactor){
+    
+    initialized = false;
+    modelTrained = false;
+    featureDataReady = false;
+    featureVector.clear();
+    
+    if( numDimensions == 0 ){
+        errorLog << "init(UINT numDimensions,UINT numPrincipalComponents,double amnesicFactor) - The number of dimensions must be greater than zero!" << endl;
+        return false;
+    }
+    
+    if( numPrincipalComponents == 0 || numPrincipalComponents > numDimensions ){
+        errorLog << "init(UINT numDimensions,UINT numPrincipalComponents,double amnesicFactor) - The number of principal components must be greater than zero and not larger than the number of dimensions!" << endl;
+        return false;
+    }
+    
+    if( amnesicFactor < 0 ){
+        errorLog << "init(UINT numDimensions,UINT numPrincipalComponents,double amnesicFactor) - The amnesicFactor must not be negative!" << endl;
+        return false;
+    }
+    
+    this->numPrincipalComponents = numPrincipalComponents;
+    this->amnesicFactor = amnesicFactor;
+    numInputDimensions = numDimensions;
+    numOutputDimensions = numPrincipalComponents;
+    numSamples = 0;
+    
+    //Setup the model, nothing else is allocated when the model is updated or used
+    mean.clear();
+    mean.resize(numInputDimensions,0);
+    components.clear();
+    components.resize(numPrincipalComponents*numInputDimensions,0);
+    projection.clear();
+    projection.resize(numPrincipalComponents*numInputDimensions,0);
+    projectionOffsets.clear();
+    projectionOffsets.resize(numPrincipalComponents,0);
+    residual.clear();
+    residual.resize(numInputDimensions,0);
+    featureVector.resize(numOutputDimensions,0);
+    
+    //Flag that the feature extraction has been initialized
+    initialized = true;
+    
+    return true;
+}
+    
+bool IncrementalPCA::train(LabelledClassificationData &trainingData){
+    MatrixDouble data = trainingData.getDataAsMatrixDouble();
+    return train( data );
+}
+    
+bool IncrementalPCA::train(LabelledTimeSeriesClassificationData &trainingData){
+    MatrixDouble data = trainingData.getDataAsMatrixDouble();
+    return train( data );
+}
+   
+bool IncrementalPCA::train(LabelledContinuousTimeSeriesClassificationData &trainingData){
+    MatrixDouble data = trainingData.getDataAsMatrixDouble();
+    return train( data );
+}
+
+bool IncrementalPCA::train(UnlabelledClassificationData &trainingData){
+	MatrixDouble data = trainingData.getDataAsMatrixDouble();
+    return train( data );
+}
+    
+bool IncrementalPCA::train(MatrixDouble &trainingData){
+    
+    if( !initialized ){
+        errorLog << "train(MatrixDouble &trainingData) - The IncrementalPCA has not been initialized!" << endl;
+        return false;
+    }
+    
+    if( trainingData.getNumCols() != numInputDimensions ){
+        errorLog << "train(MatrixDouble &trainingData) - The number of columns in the training data (" << trainingData.getNumCols() << ") does not match the number of input dimensions (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    //Clear any previous model
+    if( !init( numInputDimensions, numPrincipalComponents, amnesicFactor ) ){
+        return false;
+    }
+    
+    //Learn from each sample in turn, the projection only needs to be computed once all the samples have been added
+    const UINT M = trainingData.getNumRows();
+    for(UINT i=0; i<M; i++){
+        updateModel( trainingData[i] );
+    }
+    updateProjection();
+    
+    if( !modelTrained ){
+        errorLog << "train(MatrixDouble &trainingData) - There was not enough variation in the training data to learn " << numPrincipalComponents << " principal components!" << endl;
+        return false;
+    }
+    
+    return true;
+}
+    
+bool IncrementalPCA::update(const VectorDouble &inputVector){
+    
+    if( !initialized ){
+        errorLog << "update(const VectorDouble &inputVector) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( inputVector.size() != numInputDimensions ){
+        errorLog << "update(const VectorDouble &inputVector) - The size of the inputVector (" << inputVector.size() << ") does not match that of the module (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    updateModel( &inputVector[0] );
+    updateProjection();
+    
+    return true;
+}
+    
+bool IncrementalPCA::project(const VectorDouble &inputVector){
+    
+#ifdef GRT_SAFE_CHECKING
+    if( !initialized ){
+        errorLog << "project(const VectorDouble &inputVector) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( inputVector.size() != numInputDimensions ){
+        errorLog << "project(const VectorDouble &inputVector) - The size of the inputVector (" << inputVector.size() << ") does not match that of the module (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+#endif
+    
+    if( !modelTrained ){
+        errorLog << "project(const VectorDouble &inputVector) - The model has not been trained!" << endl;
+        return false;
+    }
+    
+    //Project the mean subtracted input onto each principal component, the projection of the mean is precomputed
+    const double *x = &inputVector[0];
+    for(UINT k=0; k<numPrincipalComponents; k++){
+        featureVector[k] = SIMD::dot( &projection[k*numInputDimensions], x, numInputDimensions ) - projectionOffsets[k];
+    }
+    featureDataReady = true;
+    
+    return true;
+}
+    
+bool IncrementalPCA::setAmnesicFactor(double amnesicFactor){
+    if( amnesicFactor >= 0 ){
+        this->amnesicFactor = amnesicFactor;
+        return true;
+    }
+    errorLog << "setAmnesicFactor(double amnesicFactor) - The amnesicFactor must not be negative!" << endl;
+    return false;
+}
+    
+bool IncrementalPCA::setUpdateWhileProcessing(bool updateWhileProcessing){
+    this->updateWhileProcessing = updateWhileProcessing;
+    return true;
+}
+    
+VectorDouble IncrementalPCA::getEigenvalues() const{
+    VectorDouble eigenvalues(numPrincipalComponents,0);
+    for(UINT k=0; k<numPrincipalComponents; k++){
+        const double *v = &components[k*numInputDimensions];
+        eigenvalues[k] = sqrt( SIMD::dot( v, v, numInputDimensions ) );
+    }
+    return eigenvalues;
+}
+    
+MatrixDouble IncrementalPCA::getEigenvectors() const{
+    MatrixDouble eigenvectors(numPrincipalComponents,numInputDimensions);
+    for(UINT k=0; k<numPrincipalComponents; k++){
+        for(UINT j=0; j<numInputDimensions; j++){
+            eigenvectors[k][j] = projection[k*numInputDimensions+j];
+        }
+    }
+    return eigenvectors;
+}
+    
+void IncrementalPCA::updateModel(const double *x){
+    
+    const UINT N = numInputDimensions;
+    numSamples++;
+    const double n = numSamples;
+    
+    //Update the mean and subtract it from the sample
+    for(UINT j=0; j<N; j++){
+        mean[j] += (x[j]-mean[j]) / n;
+        residual[j] = x[j] - mean[j];
+    }
+    
+    //The amnesic factor is limited while there are only a few samples, so the old estimate always has a positive weight
+    const double l = n >= 2 ? (amnesicFactor < n-2 ? amnesicFactor : n-2) : 0;
+    const double oldWeight = (n-1-l) / n;
+    const double newWeight = (1+l) / n;
+    
+    double *u = &residual[0];
+    for(UINT k=0; k<numPrincipalComponents; k++){
+        double *v = &components[k*N];
+        const double vv = SIMD::dot( v, v, N );
+        
+        //If the component has not been set yet then start it from what is left of the sample, nothing is then left for the next component
+        if( vv == 0 ){
+            for(UINT j=0; j<N; j++) v[j] = u[j];
+            break;
+        }
+        
+        //Move the component towards the sample, weighted by how far the sample is along the component
+        const double a = newWeight * SIMD::dot( u, v, N ) / sqrt( vv );
+        for(UINT j=0; j<N; j++) v[j] *= oldWeight;
+        SIMD::multiplyAdd( a, u, v, N );
+        
+        //Remove the component from the sample, so the next component is learnt from the remaining variance
+        const double newVV = SIMD::dot( v, v, N );
+        if( newVV > 0 ){
+            SIMD::multiplyAdd( -SIMD::dot( u, v, N ) / newVV, v, u, N );
+        }
+    }
+}
+    
+void IncrementalPCA::updateProjection(){
+    
+    const UINT N = numInputDimensions;
+    modelTrained = true;
+    
+    for(UINT k=0; k<numPrincipalComponents; k++){
+        const double *v = &components[k*N];
+        double *w = &projection[k*N];
+        const double norm = sqrt( SIMD::dot( v, v, N ) );
+        
+        if( norm > 0 ){
+            for(UINT j=0; j<N; j++) w[j] = v[j] / norm;
+        }else{
+            for(UINT j=0; j<N; j++) w[j] = 0;
+            modelTrained = false;
+        }
+        projectionOffsets[k] = SIMD::dot( w, &mean[0], N );
+    }
+}
+    
+}//End of namespace GRT
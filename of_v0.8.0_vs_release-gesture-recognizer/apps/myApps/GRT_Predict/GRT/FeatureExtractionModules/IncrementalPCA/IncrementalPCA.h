@@ -0,0 +1,322 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+ 
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ and associated documentation files (the "Software"), to deal in the Software without restriction, 
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial 
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT 
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ 
+ @section DESCRIPTION
+ The IncrementalPCA module projects the N-dimensional input vector onto its first K principal components, where K is normally
+ much less than N. Unlike the PrincipalComponentAnalysis class, which computes the principal components from a complete dataset,
+ the IncrementalPCA learns the principal components one sample at a time using the Candid Covariance-free Incremental PCA
+ (CCIPCA) algorithm (Weng, Zhang and Hwang, 2003). Each update costs O(K*N), no covariance matrix or eigen decomposition is
+ needed, so the model can be trained offline from any of the following formats:
+ - LabelledClassificationData
+ - LabelledTimeSeriesClassificationData
+ - LabelledContinuousTimeSeriesClassificationData
+ - UnlabelledClassificationData
+ - MatrixDouble
+ or updated with each new input vector by using the update function, or by enabling updateWhileProcessing so the model is also
+ updated each time the pipeline computes the features.
+ 
+ The amnesicFactor sets how much more weight is given to new samples than old samples, a value of 0 weights all the samples
+ equally, while values of 2 to 4 let the model follow slow changes in the data. Each component is learnt from what is left of the
+ sample once the previous components have been removed from it, so the first component has the largest variance.
+ 
+ The input is mean subtracted (using the mean learnt with the components) and then projected with a single [K N] matrix-vector
+ product. The IncrementalPCA is normally used to reduce the dimensionality of large feature vectors, such as the output of the FFT
+ or TimeDomainFeatures, before they are given to a classifier.
+ */
+
+#ifndef GRT_INCREMENTAL_PCA_HEADER
+#define GRT_INCREMENTAL_PCA_HEADER
+
+#include "../../GestureRecognitionPipeline/FeatureExtraction.h"
+#include "../../DataStructures/LabelledTimeSeriesClassificationData.h"
+#include "../../DataStructures/LabelledContinuousTimeSeriesClassificationData.h"
+#include "../../DataStructures/UnlabelledClassificationData.h"
+
+namespace GRT{
+    
+class IncrementalPCA : public FeatureExtraction{
+public:
+    /**
+     Default constructor. Initalizes the IncrementalPCA, setting the number of input dimensions and the number of principal components.
+	
+     @param UINT numDimensions: the number of dimensions in the input data. Default value = 1
+     @param UINT numPrincipalComponents: the number of principal components, this must not be larger than numDimensions. Default value = 1
+     @param double amnesicFactor: sets how much more weight is given to new samples than old samples, must not be negative. Default value = 2.0
+     @param bool updateWhileProcessing: if true, the model is updated with each input vector given to the computeFeatures function. Default value = false
+     */
+    IncrementalPCA(UINT numDimensions=1,UINT numPrincipalComponents=1,double amnesicFactor=2.0,bool updateWhileProcessing=false);
+	
+    /**
+     Copy constructor, copies the IncrementalPCA from the rhs instance to this instance.
+     
+     @param const IncrementalPCA &rhs: another instance of this class from which the data will be copied to this instance
+     */
+    IncrementalPCA(const IncrementalPCA &rhs);
+    
+    /**
+     Default Destructor
+     */
+    virtual ~IncrementalPCA();
+    
+    /**
+     Sets the equals operator, copies the data from the rhs instance to this instance.
+     
+     @param const IncrementalPCA &rhs: another instance of this class from which the data will be copied to this instance
+     @return a reference to this instance
+     */
+    IncrementalPCA& operator=(const IncrementalPCA &rhs);
+
+    /**
+     Sets the FeatureExtraction clone function, overwriting the base FeatureExtraction function.
+     This function is used to clone the values from the input pointer to this instance of the FeatureExtraction module.
+     This function is called by the GestureRecognitionPipeline when the user adds a new FeatureExtraction module to the pipeline.
+     
+     @param const FeatureExtraction *featureExtraction: a pointer to another instance of an IncrementalPCA, the values of that instance will be cloned to this instance
+     @return returns true if the clone was successful, false otherwise
+     */
+    virtual bool clone(const FeatureExtraction *featureExtraction);
+    
+    /**
+     Sets the FeatureExtraction computeFeatures function, overwriting the base FeatureExtraction function.
+     This function is called by the GestureRecognitionPipeline when any new input data needs to be processed (during the prediction phase for example).
+     This function projects the input onto the principal subspace, updating the model first if updateWhileProcessing is enabled.
+     
+     @param const VectorDouble &inputVector: the inputVector that should be processed.  Must have the same dimensionality as the FeatureExtraction module
+     @return returns true if the data was processed, false otherwise
+     */
+    virtual bool computeFeatures(const VectorDouble &inputVector);
+    
+    /**
+     Sets the FeatureExtraction reset function, overwriting the base FeatureExtraction function.
+     This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
+     The learnt principal components are not changed by this function.
+     
+     @return true if the instance was reset, false otherwise
+     */
+    virtual bool reset();
+    
+    /**
+     This saves the feature extraction settings (and the learnt principal components) to a file.
+     This overrides the saveSettingsToFile function in the FeatureExtraction base class.
+     
+     @param string filename: the name of the file to save the settings to
+     @return returns true if the settings were saved successfully, false otherwise
+     */
+    virtual bool saveSettingsToFile(string filename);
+    
+    /**
+     This loads the feature extraction settings (and the learnt principal components) from a file.
+     This overrides the loadSettingsFromFile function in the FeatureExtraction base class.
+     
+     @param string filename: the name of the file to load the settings from
+     @return returns true if the settings were loaded successfully, false otherwise
+     */
+    virtual bool loadSettingsFromFile(string filename);
+    
+    /**
+     This saves the feature extraction settings (and the learnt principal components) to a file.
+     This overrides the saveSettingsToFile function in the FeatureExtraction base class.
+     
+     @param fstream &file: a reference to the file to save the settings to
+     @return returns true if the settings were saved successfully, false otherwise
+     */
+    virtual bool saveSettingsToFile(fstream &file);
+    
+    /**
+     This loads the feature extraction settings (and the learnt principal components) from a file.
+     This overrides the loadSettingsFromFile function in the FeatureExtraction base class.
+     
+     @param fstream &file: a reference to the file to load the settings from
+     @return returns true if the settings were loaded successfully, false otherwise
+     */
+    virtual bool loadSettingsFromFile(fstream &file);
+
+    /**
+     Initializes the IncrementalPCA, any previous model will be cleared.
+     
+     @param UINT numDimensions: the number of dimensions in the input data
+     @param UINT numPrincipalComponents: the number of principal components, this must be greater than zero and not larger than numDimensions
+     @param double amnesicFactor: sets how much more weight is given to new samples than old samples, must not be negative. Default value = 2.0
+     @return returns true if the instance was initialized, false otherwise
+     */
+    bool init(UINT numDimensions,UINT numPrincipalComponents,double amnesicFactor=2.0);
+    
+    /**
+     Trains a new model using the training dataset, any previous model will be cleared.
+     
+     @param LabelledClassificationData &trainingData: the training dataset that will be used to train the model
+     @return returns true if the model was trained successfully, false otherwise
+     */
+    bool train(LabelledClassificationData &trainingData);
+    
+    /**
+     Trains a new model using the training dataset, any previous model will be cleared.
+     
+     @param LabelledTimeSeriesClassificationData &trainingData: the training dataset that will be used to train the model
+     @return returns true if the model was trained successfully, false otherwise
+     */
+    bool train(LabelledTimeSeriesClassificationData &trainingData);
+    
+    /**
+     Trains a new model using the training dataset, any previous model will be cleared.
+     
+     @param LabelledContinuousTimeSeriesClassificationData &trainingData: the training dataset that will be used to train the model
+     @return returns true if the model was trained successfully, false otherwise
+     */
+    bool train(LabelledContinuousTimeSeriesClassificationData &trainingData);
+    
+    /**
+     Trains a new model using the training dataset, any previous model will be cleared.
+     
+     @param UnlabelledClassificationData &trainingData: the training dataset that will be used to train the model
+     @return returns true if the model was trained successfully, false otherwise
+     */
+    bool train(UnlabelledClassificationData &trainingData);
+    
+    /**
+     Trains a new model using the training dataset, any previous model will be cleared.
+     
+     @param MatrixDouble &trainingData: the training dataset that will be used to train the model, each row should be one sample
+     @return returns true if the model was trained successfully, false otherwise
+     */
+    bool train(MatrixDouble &trainingData);
+    
+    /**
+     Updates the model with one new sample, without clearing the model.
+     
+     @param const VectorDouble &inputVector: the new sample, must have numInputDimensions elements
+     @return returns true if the model was updated, false otherwise
+     */
+    bool update(const VectorDouble &inputVector);
+    
+    /**
+     Projects the input onto the principal subspace, without updating the model. The result is stored in the feature vector.
+     
+     @param const VectorDouble &inputVector: the vector you want to project, must have numInputDimensions elements
+     @return returns true if the input was projected, false otherwise
+     */
+    bool project(const VectorDouble &inputVector);
+    
+    /**
+     Sets the amnesicFactor, this controls how much more weight is given to new samples than old samples.
+     
+     @param double amnesicFactor: the new amnesicFactor, must not be negative
+     @return returns true if the amnesicFactor was updated, false otherwise
+     */
+    bool setAmnesicFactor(double amnesicFactor);
+    
+    /**
+     Sets if the model should be updated with each input vector given to the computeFeatures function.
+     
+     @param bool updateWhileProcessing: true if the model should be updated, false otherwise
+     @return returns true if the value was updated
+     */
+    bool setUpdateWhileProcessing(bool updateWhileProcessing);
+    
+    /**
+     Gets if the model has been trained, this is true once the model has learnt from more samples than there are principal components.
+     
+     @return returns true if the model has been trained, false otherwise
+     */
+    bool getModelTrained() const { return modelTrained; }
+    
+    /**
+     Gets if the model is updated with each input vector given to the computeFeatures function.
+     
+     @return returns true if updateWhileProcessing is enabled, false otherwise
+     */
+    bool getUpdateWhileProcessing() const { return updateWhileProcessing; }
+    
+    /**
+     Gets the number of principal components.
+     
+     @return returns the number of principal components
+     */
+    UINT getNumPrincipalComponents() const { return numPrincipalComponents; }
+    
+    /**
+     Gets the number of samples the model has learnt from.
+     
+     @return returns the number of samples the model has learnt from
+     */
+    UINT getNumSamples() const { return numSamples; }
+    
+    /**
+     Gets the amnesicFactor.
+     
+     @return returns the amnesicFactor
+     */
+    double getAmnesicFactor() const { return amnesicFactor; }
+    
+    /**
+     Gets the mean of the samples the model has learnt from, this is subtracted from the input before it is projected.
+     
+     @return returns the mean vector
+     */
+    VectorDouble getMeanVector() const { return mean; }
+    
+    /**
+     Gets the estimated variance of each principal component.
+     
+     @return returns a vector containing the eigenvalue of each principal component
+     */
+    VectorDouble getEigenvalues() const;
+    
+    /**
+     Gets the principal components. This will be a [K N] matrix, where each row is a unit length principal component.
+     
+     @return returns a MatrixDouble containing the principal components
+     */
+    MatrixDouble getEigenvectors() const;
+    
+protected:
+    /**
+     Updates the mean and the principal components with one new sample.
+     
+     @param const double *x: the new sample, this must point to numInputDimensions values
+     */
+    void updateModel(const double *x);
+    
+    /**
+     Normalizes the principal components into the projection matrix and projects the mean onto them.
+     */
+    void updateProjection();
+    
+    bool modelTrained;
+    bool updateWhileProcessing;
+    UINT numPrincipalComponents;
+    UINT numSamples;
+    double amnesicFactor;
+    VectorDouble mean;                              ///< The mean of the samples the model has learnt from
+    VectorDouble components;                        ///< The [K N] CCIPCA estimates of the principal components, the length of each is its eigenvalue
+    VectorDouble projection;                        ///< The [K N] unit length principal components, used to project the input
+    VectorDouble projectionOffsets;                 ///< The projection of the mean onto each principal component
+    VectorDouble residual;                          ///< Holds the mean subtracted sample while the model is updated
+    
+    static RegisterFeatureExtractionModule< IncrementalPCA > registerModule;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_INCREMENTAL_PCA_HEADER
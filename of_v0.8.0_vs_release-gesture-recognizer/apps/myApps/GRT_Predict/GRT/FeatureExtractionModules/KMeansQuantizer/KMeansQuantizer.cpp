@@ -31,6 +31,9 @@ KMeansQuantizer::KMeansQuantizer(UINT numDimensions,UINT numClusters){
     errorLog.setProceedingText("[ERROR KMeansQuantizer]");
     warningLog.setProceedingText("[WARNING KMeansQuantizer]");
     
+    useLookupTable = true;
+    lookupTableResolution = 0;
+    
     init(numDimensions,numClusters);
 }
     
@@ -49,6 +52,21 @@ KMeansQuantizer& KMeansQuantizer::operator=(const KMeansQuantizer &rhs){
         this->quantizerTrained = rhs.quantizerTrained;
         this->numClusters = rhs.numClusters;
         this->clusters = rhs.clusters;
+        this->quantizationDistances = rhs.quantizationDistances;
+        this->quantizationDistancesComputed = rhs.quantizationDistancesComputed;
+        this->lastInputVector = rhs.lastInputVector;
+        this->codebook = rhs.codebook;
+        this->useLookupTable = rhs.useLookupTable;
+        this->lookupTableBuilt = rhs.lookupTableBuilt;
+        this->lookupTableResolution = rhs.lookupTableResolution;
+        this->lookupTableMinRange = rhs.lookupTableMinRange;
+        this->lookupTableMaxRange = rhs.lookupTableMaxRange;
+        this->lookupTableCellsPerDimension = rhs.lookupTableCellsPerDimension;
+        this->lookupTableMin = rhs.lookupTableMin;
+        this->lookupTableMax = rhs.lookupTableMax;
+        this->lookupTableInvCellSize = rhs.lookupTableInvCellSize;
+        this->lookupTableCellOffsets = rhs.lookupTableCellOffsets;
+        this->lookupTableCandidates = rhs.lookupTableCandidates;
         
         //Copy the base variables
         copyBaseVariables( (FeatureExtraction*)&rhs );
@@ -130,7 +148,7 @@ bool KMeansQuantizer::saveSettingsToFile(fstream &file){
     }
     
     //First, you should add a header (with no spaces) e.g.
-    file << "KMEANS_QUANTIZER_FILE_V1.0" << endl;
+    file << "KMEANS_QUANTIZER_FILE_V2.0" << endl;
 	
     //Second, you should save the base feature extraction settings to the file
     if( !saveBaseSettingsToFile( file ) ){
@@ -140,6 +158,17 @@ bool KMeansQuantizer::saveSettingsToFile(fstream &file){
     
     file << "QuantizerTrained: " << quantizerTrained << endl;
     file << "NumClusters: " << numClusters << endl;
+    file << "UseLookupTable: " << useLookupTable << endl;
+    file << "LookupTableResolution: " << lookupTableResolution << endl;
+    file << "LookupTableRangeSet: " << (lookupTableMinRange.size() > 0) << endl;
+    if( lookupTableMinRange.size() > 0 ){
+        file << "LookupTableMinRange: ";
+        for(UINT j=0; j<numInputDimensions; j++) file << lookupTableMinRange[j] << "\t";
+        file << endl;
+        file << "LookupTableMaxRange: ";
+        for(UINT j=0; j<numInputDimensions; j++) file << lookupTableMaxRange[j] << "\t";
+        file << endl;
+    }
     
     if( quantizerTrained ){
         file << "Clusters: \n";
@@ -161,6 +190,8 @@ bool KMeansQuantizer::loadSettingsFromFile(fstream &file){
     numClusters = 0;
     clusters.clear();
     quantizationDistances.clear();
+    lookupTableMinRange.clear();
+    lookupTableMaxRange.clear();
     
     if( !file.is_open() ){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
@@ -170,8 +201,11 @@ bool KMeansQuantizer::loadSettingsFromFile(fstream &file){
     string word;
     
     //First, you should read and validate the header
+    //The V1.0 format does not contain the lookup table settings, so the default settings are used
     file >> word;
-    if( word != "KMEANS_QUANTIZER_FILE_V1.0" ){
+    bool hasLookupTableSettings = false;
+    if( word == "KMEANS_QUANTIZER_FILE_V2.0" ) hasLookupTableSettings = true;
+    else if( word != "KMEANS_QUANTIZER_FILE_V1.0" ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;
     }
@@ -196,6 +230,50 @@ bool KMeansQuantizer::loadSettingsFromFile(fstream &file){
     }
     file >> numClusters;
     
+    useLookupTable = true;
+    lookupTableResolution = 0;
+    if( hasLookupTableSettings ){
+        file >> word;
+        if( word != "UseLookupTable:" ){
+            errorLog << "loadSettingsFromFile(fstream &file) - Failed to load UseLookupTable!" << endl;
+            return false;
+        }
+        file >> useLookupTable;
+        
+        file >> word;
+        if( word != "LookupTableResolution:" ){
+            errorLog << "loadSettingsFromFile(fstream &file) - Failed to load LookupTableResolution!" << endl;
+            return false;
+        }
+        file >> lookupTableResolution;
+        
+        bool rangeSet = false;
+        file >> word;
+        if( word != "LookupTableRangeSet:" ){
+            errorLog << "loadSettingsFromFile(fstream &file) - Failed to load LookupTableRangeSet!" << endl;
+            return false;
+        }
+        file >> rangeSet;
+        
+        if( rangeSet ){
+            lookupTableMinRange.resize(numInputDimensions);
+            lookupTableMaxRange.resize(numInputDimensions);
+            file >> word;
+            if( word != "LookupTableMinRange:" ){
+                errorLog << "loadSettingsFromFile(fstream &file) - Failed to load LookupTableMinRange!" << endl;
+                return false;
+            }
+            for(UINT j=0; j<numInputDimensions; j++) file >> lookupTableMinRange[j];
+            
+            file >> word;
+            if( word != "LookupTableMaxRange:" ){
+                errorLog << "loadSettingsFromFile(fstream &file) - Failed to load LookupTableMaxRange!" << endl;
+                return false;
+            }
+            for(UINT j=0; j<numInputDimensions; j++) file >> lookupTableMaxRange[j];
+        }
+    }
+    
     if( quantizerTrained ){
         clusters.resize(numClusters, numInputDimensions);
         file >> word;
@@ -214,6 +292,9 @@ bool KMeansQuantizer::loadSettingsFromFile(fstream &file){
     initialized = true;
     featureDataReady = false;
     quantizationDistances.resize(numClusters,0);
+    
+    if( quantizerTrained ) return buildSearchStructures();
+    
     return true;
 }
     
@@ -225,6 +306,12 @@ bool KMeansQuantizer::init(UINT numDimensions,UINT numClusters){
     featureVector.clear();
     clusters.clear();
     quantizationDistances.clear();
+    quantizationDistancesComputed = true;
+    lastInputVector.clear();
+    codebook.clear();
+    lookupTableBuilt = false;
+    lookupTableCellOffsets.clear();
+    lookupTableCandidates.clear();
     
     this->numClusters = numClusters;
     numInputDimensions = numDimensions;
@@ -269,6 +356,8 @@ bool KMeansQuantizer::train(MatrixDouble &trainingData){
     featureDataReady = false;
     clusters.clear();
     quantizationDistances.clear();
+    codebook.clear();
+    lookupTableBuilt = false;
     
     //Train the KMeans model
     KMeans kmeans;
@@ -287,7 +376,7 @@ bool KMeansQuantizer::train(MatrixDouble &trainingData){
     quantizationDistances.resize(numClusters,0);
     quantizerTrained = true;
     
-    return true;
+    return buildSearchStructures();
 }
 
 UINT KMeansQuantizer::quantize(double inputValue){
@@ -313,26 +402,229 @@ UINT KMeansQuantizer::quantize(const VectorDouble &inputVector){
 	    }
 	#endif
 	
-	//Find the minimum cluster
+    UINT quantizedValue = findNearestCluster( &inputVector[0] );
+    
+    featureVector[0] = quantizedValue;
+    featureDataReady = true;
+	
+	return quantizedValue;
+}
+    
+VectorDouble KMeansQuantizer::getQuantizationDistances(){
+    //If the last vector was quantized with the lookup table, only the distances to the clusters in its cell were computed
+    if( !quantizationDistancesComputed ){
+        for(UINT k=0; k<numClusters; k++){
+            quantizationDistances[k] = SIMD::squaredDistance(&lastInputVector[0],&codebook[k*numInputDimensions],numInputDimensions);
+        }
+        quantizationDistancesComputed = true;
+    }
+    return quantizationDistances;
+}
+    
+bool KMeansQuantizer::setUseLookupTable(bool useLookupTable){
+    this->useLookupTable = useLookupTable;
+    if( quantizerTrained ) return buildSearchStructures();
+    return true;
+}
+    
+bool KMeansQuantizer::setLookupTableResolution(UINT lookupTableResolution){
+    this->lookupTableResolution = lookupTableResolution;
+    if( quantizerTrained ) return buildSearchStructures();
+    return true;
+}
+    
+bool KMeansQuantizer::setLookupTableRange(const VectorDouble &minRange,const VectorDouble &maxRange){
+    
+    if( minRange.size() != maxRange.size() || (minRange.size() != 0 && minRange.size() != numInputDimensions) ){
+        errorLog << "setLookupTableRange(const VectorDouble &minRange,const VectorDouble &maxRange) - The size of the range vectors must match the number of input dimensions!" << endl;
+        return false;
+    }
+    
+    for(UINT j=0; j<minRange.size(); j++){
+        if( !(minRange[j] < maxRange[j]) ){
+            errorLog << "setLookupTableRange(const VectorDouble &minRange,const VectorDouble &maxRange) - The minimum range must be less than the maximum range!" << endl;
+            return false;
+        }
+    }
+    
+    lookupTableMinRange = minRange;
+    lookupTableMaxRange = maxRange;
+    if( quantizerTrained ) return buildSearchStructures();
+    return true;
+}
+    
+double KMeansQuantizer::getAverageNumCandidatesPerCell() const{
+    if( !lookupTableBuilt ) return 0;
+    return lookupTableCandidates.size() / double( lookupTableCellOffsets.size()-1 );
+}
+    
+UINT KMeansQuantizer::findNearestCluster(const double *x){
+    
+    const UINT N = numInputDimensions;
+    lastInputVector.assign(x,x+N);
+    
+    //If x falls inside the lookup table, only the clusters stored in its cell can be the nearest cluster
+    if( lookupTableBuilt ){
+        UINT cell = 0;
+        bool insideTable = true;
+        for(int j=int(N)-1; j>=0; j--){
+            if( !(x[j] >= lookupTableMin[j] && x[j] <= lookupTableMax[j]) ){
+                insideTable = false;
+                break;
+            }
+            UINT index = UINT( (x[j]-lookupTableMin[j]) * lookupTableInvCellSize[j] );
+            if( index >= lookupTableCellsPerDimension[j] ) index = lookupTableCellsPerDimension[j]-1;
+            cell = cell*lookupTableCellsPerDimension[j] + index;
+        }
+        
+        if( insideTable ){
+            double minDist = numeric_limits<double>::max();
+            UINT quantizedValue = 0;
+            for(UINT i=lookupTableCellOffsets[cell]; i<lookupTableCellOffsets[cell+1]; i++){
+                const UINT k = lookupTableCandidates[i];
+                const double dist = SIMD::squaredDistance(x,&codebook[k*N],N);
+                if( dist < minDist ){
+                    minDist = dist;
+                    quantizedValue = k;
+                }
+            }
+            quantizationDistancesComputed = false;
+            return quantizedValue;
+        }
+    }
+    
+	//Otherwise search all the clusters
     double minDist = numeric_limits<double>::max();
     UINT quantizedValue = 0;
     
     for(UINT k=0; k<numClusters; k++){
-        //Compute the squared Euclidean distance
-        quantizationDistances[k] = 0;
-        for(UINT i=0; i<numInputDimensions; i++){
-            quantizationDistances[k] += SQR( inputVector[i]-clusters[k][i] );
-        }
+        quantizationDistances[k] = SIMD::squaredDistance(x,&codebook[k*N],N);
         if( quantizationDistances[k] < minDist ){
             minDist = quantizationDistances[k];
             quantizedValue = k;
         }
     }
+    quantizationDistancesComputed = true;
     
-    featureVector[0] = quantizedValue;
-    featureDataReady = true;
-	
-	return quantizedValue;
+    return quantizedValue;
+}
+    
+bool KMeansQuantizer::buildSearchStructures(){
+    
+    if( clusters.getNumRows() != numClusters || clusters.getNumCols() != numInputDimensions ){
+        errorLog << "buildSearchStructures() - The size of the quantization model does not match the number of clusters and input dimensions!" << endl;
+        return false;
+    }
+    
+    codebook.resize(numClusters*numInputDimensions);
+    for(UINT k=0; k<numClusters; k++){
+        for(UINT j=0; j<numInputDimensions; j++){
+            codebook[k*numInputDimensions+j] = clusters[k][j];
+        }
+    }
+    quantizationDistances.resize(numClusters,0);
+    quantizationDistancesComputed = true;
+    
+    lookupTableBuilt = false;
+    lookupTableCellOffsets.clear();
+    lookupTableCandidates.clear();
+    
+    if( !useLookupTable || numInputDimensions > MAX_LOOKUP_TABLE_DIMENSIONS ) return true;
+    
+    return buildLookupTable();
+}
+    
+bool KMeansQuantizer::buildLookupTable(){
+    
+    const UINT N = numInputDimensions;
+    
+    //Set the range of the table, either from the range set by the user or from the clusters plus a margin
+    lookupTableMin.resize(N);
+    lookupTableMax.resize(N);
+    if( lookupTableMinRange.size() == N ){
+        lookupTableMin = lookupTableMinRange;
+        lookupTableMax = lookupTableMaxRange;
+    }else{
+        for(UINT j=0; j<N; j++){
+            double minValue = numeric_limits<double>::max();
+            double maxValue = -numeric_limits<double>::max();
+            for(UINT k=0; k<numClusters; k++){
+                minValue = min( minValue, codebook[k*N+j] );
+                maxValue = max( maxValue, codebook[k*N+j] );
+            }
+            const double margin = maxValue > minValue ? 0.25 * (maxValue-minValue) : 1.0;
+            lookupTableMin[j] = minValue - margin;
+            lookupTableMax[j] = maxValue + margin;
+        }
+    }
+    
+    //Set the number of cells, by default there are roughly 64 cells per cluster
+    UINT resolution = lookupTableResolution;
+    if( resolution == 0 ){
+        resolution = UINT( floor( pow( 64.0*numClusters, 1.0/N ) ) );
+        resolution = max( resolution, UINT(2) );
+    }
+    UINT numCells = 1;
+    for(UINT j=0; j<N; j++){
+        if( numCells * resolution > MAX_LOOKUP_TABLE_SIZE ){
+            warningLog << "buildLookupTable() - The lookup table would have more than " << MAX_LOOKUP_TABLE_SIZE << " cells, the table will not be used!" << endl;
+            return true;
+        }
+        numCells *= resolution;
+    }
+    
+    lookupTableCellsPerDimension.assign(N,resolution);
+    lookupTableInvCellSize.resize(N);
+    VectorDouble cellSize(N);
+    for(UINT j=0; j<N; j++){
+        cellSize[j] = (lookupTableMax[j]-lookupTableMin[j]) / resolution;
+        lookupTableInvCellSize[j] = 1.0 / cellSize[j];
+    }
+    
+    //For each cell, keep the clusters whose minimum distance to the cell is not greater than the smallest maximum distance of
+    //any cluster to the cell, as any point in the cell is at most that far from its nearest cluster
+    VectorDouble minDist(numClusters);
+    vector< UINT > index(N,0);
+    lookupTableCellOffsets.resize(numCells+1);
+    lookupTableCandidates.clear();
+    lookupTableCandidates.reserve(numCells*2);
+    
+    for(UINT cell=0; cell<numCells; cell++){
+        //Cells are indexed with the first dimension changing fastest
+        UINT c = cell;
+        for(UINT j=0; j<N; j++){
+            index[j] = c % resolution;
+            c /= resolution;
+        }
+        
+        double bestMaxDist = numeric_limits<double>::max();
+        for(UINT k=0; k<numClusters; k++){
+            double dMin = 0;
+            double dMax = 0;
+            for(UINT j=0; j<N; j++){
+                //The cell is padded slightly, so rounding in the cell index of a point on the edge of the cell can not matter
+                const double lower = lookupTableMin[j] + index[j]*cellSize[j] - 1.0e-9*cellSize[j];
+                const double upper = lookupTableMin[j] + (index[j]+1)*cellSize[j] + 1.0e-9*cellSize[j];
+                const double x = codebook[k*N+j];
+                const double below = lower - x;
+                const double above = x - upper;
+                if( below > 0 ) dMin += below*below;
+                else if( above > 0 ) dMin += above*above;
+                dMax += SQR( max( fabs(x-lower), fabs(x-upper) ) );
+            }
+            minDist[k] = dMin;
+            if( dMax < bestMaxDist ) bestMaxDist = dMax;
+        }
+        
+        lookupTableCellOffsets[cell] = (UINT)lookupTableCandidates.size();
+        for(UINT k=0; k<numClusters; k++){
+            if( minDist[k] <= bestMaxDist ) lookupTableCandidates.push_back( k );
+        }
+    }
+    lookupTableCellOffsets[numCells] = (UINT)lookupTableCandidates.size();
+    lookupTableBuilt = true;
+    
+    return true;
 }
     
 }//End of namespace GRT
\ No newline at end of file
@@ -32,6 +32,15 @@
  - LabelledContinuousTimeSeriesClassificationData
  - UnlabelledClassificationData
  - MatrixDouble
+
+ Once trained, the clusters are stored contiguously so the nearest cluster can be found with the SIMD distance kernels.
+ For low dimensional input (up to 3 dimensions, such as hand coordinates), the quantizer also builds a lookup table: the
+ input range is split into a grid of cells and each cell stores the clusters that can be the nearest cluster for at least one
+ point in that cell (a cluster is kept if its minimum distance to the cell is not greater than the smallest maximum distance
+ of any cluster to the cell). Quantizing a vector then only needs the distances to the few clusters of its cell, and gives
+ exactly the same result as searching all the clusters. Input that falls outside the range of the table is quantized by
+ searching all the clusters. By default the range of the table covers the clusters (plus a margin), but a fixed range (for
+ example the bounds of the tracking volume) and resolution can also be set.
  */
 
 #ifndef GRT_KMEANS_QUANTIZER_HEADER
@@ -226,9 +235,7 @@ public:
      
      @return returns a VectorDouble containing the quantization distances from the most recent quantization
      */
-	VectorDouble getQuantizationDistances(){
-		return quantizationDistances;
-	}
+	VectorDouble getQuantizationDistances();
 	
 	/**
      Gets the quantization model. This will be a [K N] matrix containing the quantization clusters, where K is the
@@ -239,12 +246,85 @@ public:
 	MatrixDouble getQuantizationModel(){
 		return clusters;
 	}
+
+    /**
+     Sets if the quantizer should use a lookup table to find the nearest cluster. The lookup table is only built if the
+     input data has at most MAX_LOOKUP_TABLE_DIMENSIONS dimensions. If the quantizer has already been trained, the table
+     will be rebuilt.
+
+     @param bool useLookupTable: true if the lookup table should be used, false if all the clusters should be searched
+     @return returns true if the value was updated, false otherwise
+     */
+    bool setUseLookupTable(bool useLookupTable);
+
+    /**
+     Sets the number of cells along each dimension of the lookup table. If this is zero, the resolution is set automatically
+     from the number of clusters. If the quantizer has already been trained, the table will be rebuilt.
+
+     @param UINT lookupTableResolution: the number of cells along each dimension, zero for an automatic resolution
+     @return returns true if the value was updated, false otherwise
+     */
+    bool setLookupTableResolution(UINT lookupTableResolution);
+
+    /**
+     Sets a fixed input range for the lookup table, such as the bounds of the volume a hand can be tracked in. If both
+     vectors are empty, the range will be set from the clusters. If the quantizer has already been trained, the table will
+     be rebuilt.
+
+     @param const VectorDouble &minRange: the minimum value of each input dimension
+     @param const VectorDouble &maxRange: the maximum value of each input dimension
+     @return returns true if the range was updated, false otherwise
+     */
+    bool setLookupTableRange(const VectorDouble &minRange,const VectorDouble &maxRange);
+
+    /**
+     Gets if the lookup table has been built and is used to quantize the input.
+
+     @return returns true if the lookup table is used, false otherwise
+     */
+    bool getLookupTableBuilt() const { return lookupTableBuilt; }
+
+    /**
+     Gets the average number of clusters stored in each cell of the lookup table, this is the average number of distances
+     that need to be computed to quantize a vector that falls inside the table.
+
+     @return returns the average number of clusters per cell, or zero if the lookup table has not been built
+     */
+    double getAverageNumCandidatesPerCell() const;
+
+    enum{ MAX_LOOKUP_TABLE_DIMENSIONS=3, MAX_LOOKUP_TABLE_SIZE=262144 };
     
 protected:
+    /**
+     Finds the nearest cluster to x, using the lookup table if x falls inside it.
+     */
+    UINT findNearestCluster(const double *x);
+
+    /**
+     Copies the clusters into the contiguous codebook and builds the lookup table.
+     */
+    bool buildSearchStructures();
+    bool buildLookupTable();
+
     bool quantizerTrained;
     UINT numClusters;
     MatrixDouble clusters;
     VectorDouble quantizationDistances;
+    bool quantizationDistancesComputed;                 ///< False if the last vector was quantized with the lookup table and the distances to all the clusters have not been computed yet
+    VectorDouble lastInputVector;                       ///< The last vector that was quantized, used to compute the quantization distances on request
+    VectorDouble codebook;                              ///< The clusters, stored contiguously as [K N]
+
+    bool useLookupTable;
+    bool lookupTableBuilt;
+    UINT lookupTableResolution;                         ///< The number of cells along each dimension set by the user, zero for automatic
+    VectorDouble lookupTableMinRange;                   ///< The fixed range set by the user, empty if the range should be set from the clusters
+    VectorDouble lookupTableMaxRange;
+    vector< UINT > lookupTableCellsPerDimension;
+    VectorDouble lookupTableMin;                        ///< The range covered by the table that was built
+    VectorDouble lookupTableMax;
+    VectorDouble lookupTableInvCellSize;
+    vector< UINT > lookupTableCellOffsets;              ///< The candidates of cell c are lookupTableCandidates[ lookupTableCellOffsets[c] .. lookupTableCellOffsets[c+1] )
+    vector< UINT > lookupTableCandidates;
     
     static RegisterFeatureExtractionModule< KMeansQuantizer > registerModule;
 };
@@ -82,7 +82,7 @@ bool MovementIndex::computeFeatures(const vector< double > &inputVector){
     }
 #endif
     
-    featureVector = update( inputVector );
+    updateFeatures( inputVector );
     
     return true;
 }
@@ -209,7 +209,10 @@ bool MovementIndex::init(UINT bufferLength,UINT numDimensions){
     featureVector.resize(numInputDimensions);
     
     //Resize the raw trajectory data buffer
-    dataBuffer.resize( bufferLength, vector< double >(numInputDimensions,0) );
+    if( !dataBuffer.init( bufferLength, numInputDimensions ) ){
+        errorLog << "init(...) - Failed to initialize the data buffer!" << endl;
+        return false;
+    }
 
     //Flag that the zero crossing counter has been initialized
     initialized = true;
@@ -236,7 +239,14 @@ vector< double > MovementIndex::update(const vector< double > &x){
     }
 #endif
     
-    //Add the new data to the trajectory data buffer
+    updateFeatures( x );
+    
+    return featureVector;
+}
+    
+void MovementIndex::updateFeatures(const VectorDouble &x){
+    
+    //Add the new data to the trajectory data buffer, this also updates the running sums of each dimension
     dataBuffer.push_back( x );
     
     //Only flag that the feature data is ready if the trajectory data is full
@@ -245,34 +255,18 @@ vector< double > MovementIndex::update(const vector< double > &x){
         for(UINT i=0; i<featureVector.size(); i++){
             featureVector[i] = 0;
         }
-        return featureVector;
+        return;
     }else featureDataReady = true;
     
-    //Compute the movement index (which is the RMS error)
-    vector< double > mu(numInputDimensions,0);
-    
-    //Compute mu
+    //Compute the movement index (which is the RMS error around the mean of the buffer)
     for(UINT j=0; j<numInputDimensions; j++){
-        for(UINT i=0; i<dataBuffer.getSize(); i++){
-            mu[j] += dataBuffer[i][j];
-        }
-        mu[j] /= double(dataBuffer.getSize());
+        featureVector[j] = sqrt( dataBuffer.getVariance(j) );
     }
-    
-    for(UINT j=0; j<numInputDimensions; j++){
-        featureVector[j] = 0;
-        for(UINT i=0; i<dataBuffer.getSize(); i++){
-            featureVector[j] += SQR( dataBuffer[i][j] - mu[j] );
-        }
-        featureVector[j] = sqrt( featureVector[j]/double(dataBuffer.getSize()) );
-    }
-    
-    return featureVector;
 }
     
 CircularBuffer< vector< double > > MovementIndex::getData(){
     if( initialized ){
-        return dataBuffer;
+        return dataBuffer.getBuffer();
     }
     return CircularBuffer< vector<double > >();
 }
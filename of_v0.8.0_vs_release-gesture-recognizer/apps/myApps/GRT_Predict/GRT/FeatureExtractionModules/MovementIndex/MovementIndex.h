@@ -154,8 +154,10 @@ public:
     CircularBuffer< VectorDouble > getData();
 
 protected:
+    void updateFeatures(const VectorDouble &x);
+    
     UINT bufferLength;
-    CircularBuffer< vector< double > > dataBuffer;
+    SlidingWindowStatistics dataBuffer;
     
     static RegisterFeatureExtractionModule< MovementIndex > registerModule;
 };
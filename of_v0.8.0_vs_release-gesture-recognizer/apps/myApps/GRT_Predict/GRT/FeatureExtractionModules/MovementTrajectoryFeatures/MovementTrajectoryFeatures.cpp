@@ -89,9 +89,7 @@ bool MovementTrajectoryFeatures::computeFeatures(const VectorDouble &inputVector
     }
 #endif
     
-    featureVector = update( inputVector );
-    
-    return true;
+    return updateFeatures( inputVector );
 }
 
 bool MovementTrajectoryFeatures::reset(){
@@ -307,8 +305,11 @@ bool MovementTrajectoryFeatures::init(UINT trajectoryLength,UINT numCentroids,UI
     //Resize the feature vector
     featureVector.resize(numOutputDimensions);
     
-    //Resize the raw trajectory data buffer
-    trajectoryDataBuffer.resize( trajectoryLength, VectorDouble(numInputDimensions,0) );
+    //Setup the raw trajectory data buffer, the sum of each centroid's section of the buffer is kept as the data is added
+    if( !trajectoryDataBuffer.init( trajectoryLength, numInputDimensions, numCentroids ) ){
+        errorLog << "init(...) - Failed to initialize the trajectory data buffer!" << endl;
+        return false;
+    }
     
     //Resize the centroids buffer
     centroids.resize(numCentroids,numInputDimensions);
@@ -337,34 +338,32 @@ VectorDouble MovementTrajectoryFeatures::update(const VectorDouble &x){
     }
 #endif
     
+    if( !updateFeatures( x ) ){
+        return vector<double>();
+    }
+    
+    return featureVector;
+}
+
+bool MovementTrajectoryFeatures::updateFeatures(const VectorDouble &x){
+    
     //Add the new data to the trajectory data buffer
-    trajectoryDataBuffer.push_back( x );
+    trajectoryDataBuffer.push_back( &x[0] );
     
     //Only flag that the feature data is ready if the trajectory data is full
     if( trajectoryDataBuffer.getBufferFilled() ){
         featureDataReady = true;
     }else featureDataReady = false;
     
-    //Compute the centroids
-    centroids.setAllValues(0);
-    
-    UINT dataBufferIndex = 0;
-    UINT numValuesPerCentroid = (UINT)floor(double(trajectoryLength/numCentroids));
-    for(UINT n=0; n<numInputDimensions; n++){
-        dataBufferIndex = 0;
-        for(UINT i=0; i<numCentroids; i++){
-            for(UINT j=0; j<numValuesPerCentroid; j++){
-                centroids[i][n] += trajectoryDataBuffer[dataBufferIndex++][n];
-            }
-            centroids[i][n] /= double(numValuesPerCentroid);
+    //Get the centroids from the running sums of each section of the buffer
+    for(UINT i=0; i<numCentroids; i++){
+        for(UINT n=0; n<numInputDimensions; n++){
+            centroids[i][n] = trajectoryDataBuffer.getSegmentMean(i,n);
         }
     }
     
     //Copmute the features
     UINT featureIndex = 0;
-    vector< MinMax > centroidNormValues(numInputDimensions);
-    VectorDouble histSumValues;
-    vector< vector< AngleMagnitude > >  angleMagnitudeValues;
     switch( featureMode ){
         case CENTROID_VALUE:
             //Simply set the feature vector as the list of centroids
@@ -378,14 +377,15 @@ VectorDouble MovementTrajectoryFeatures::update(const VectorDouble &x){
             for(UINT n=0; n<numInputDimensions; n++){
                 
                 //Find the min and max values
+                MinMax centroidNormValues;
                 for(UINT i=0; i<numCentroids; i++){
-                    centroidNormValues[n].updateMinMax( centroids[i][n] );
+                    centroidNormValues.updateMinMax( centroids[i][n] );
                 }
                 
                 //Use the normalized centroids as the features
                 for(UINT i=0; i<numCentroids; i++){
-                    if( centroidNormValues[n].maxValue != centroidNormValues[n].minValue ){
-                        featureVector[ featureIndex++ ] = Util::scale(centroids[i][n],centroidNormValues[n].minValue,centroidNormValues[n].maxValue,0,1);
+                    if( centroidNormValues.maxValue != centroidNormValues.minValue ){
+                        featureVector[ featureIndex++ ] = Util::scale(centroids[i][n],centroidNormValues.minValue,centroidNormValues.maxValue,0,1);
                     }else featureVector[ featureIndex++ ] = 0;
                 }
                 
@@ -412,68 +412,52 @@ VectorDouble MovementTrajectoryFeatures::update(const VectorDouble &x){
             }
             break;
         case CENTROID_ANGLE_2D:
-            histSumValues.resize( numInputDimensions/2, 0);
-            angleMagnitudeValues.resize( numInputDimensions/2 );
-            
             //Zero the feature vector
             fill(featureVector.begin(),featureVector.end(),0);
             
             //Compute the angle and magnitude betweem each of the centroids, do this for each pair of points
             for(UINT n=0; n<numInputDimensions/2; n++){
-                //Resize the nth buffer to hold the values for each centroid
-                angleMagnitudeValues[n].resize(numCentroids-1);
-                for(UINT i=0; i<numCentroids-1; i++){
-                    Util::cartToPolar(centroids[i+1][n*2]-centroids[i][n*2], centroids[i+1][n*2+1]-centroids[i][n*2+1], angleMagnitudeValues[n][i].magnitude, angleMagnitudeValues[n][i].angle);
-                }
+                const double degreesPerBin = 360.0/numHistogramBins;
+                double histSumValue = 0;
                 
-                //Add the angles to the histogram
                 for(UINT i=0; i<numCentroids-1; i++){
-                    UINT histBin = 0;
-                    double degreesPerBin = 360.0/numHistogramBins;
-                    double binStartValue = 0;
-                    double binEndValue = degreesPerBin;
+                    AngleMagnitude angleMagnitude;
+                    Util::cartToPolar(centroids[i+1][n*2]-centroids[i][n*2], centroids[i+1][n*2+1]-centroids[i][n*2+1], angleMagnitude.magnitude, angleMagnitude.angle);
                     
-                    if( angleMagnitudeValues[n][i].angle < 0 || angleMagnitudeValues[n][i].angle  > 360.0 ){
-                        warningLog << "The angle of a point is not between [0 360]. Angle: " << angleMagnitudeValues[n][i].angle << endl;
-                        return vector<double>();
+                    if( angleMagnitude.angle < 0 || angleMagnitude.angle > 360.0 ){
+                        warningLog << "The angle of a point is not between [0 360]. Angle: " << angleMagnitude.angle << endl;
+                        return false;
                     }
                     
-                    //Find which hist bin the current angle is in
-                    while( true ){
-                        if( angleMagnitudeValues[n][i].angle >= binStartValue && angleMagnitudeValues[n][i].angle  < binEndValue ){
-                            break;
-                        }
-                        histBin++;
-                        binStartValue += degreesPerBin;
-                        binEndValue += degreesPerBin;
-                    }
+                    //Find which hist bin the current angle is in, an angle of exactly 360 is added to the last bin
+                    UINT histBin = (UINT)floor( angleMagnitude.angle / degreesPerBin );
+                    if( histBin >= numHistogramBins ) histBin = numHistogramBins-1;
                     
-                    histSumValues[ n ] += useWeightedMagnitudeValues ? angleMagnitudeValues[n][i].magnitude : 1;
-                    featureVector[ n*numHistogramBins + histBin ] +=  useWeightedMagnitudeValues ? angleMagnitudeValues[n][i].magnitude : 1;
+                    const double value = useWeightedMagnitudeValues ? angleMagnitude.magnitude : 1;
+                    histSumValue += value;
+                    featureVector[ n*numHistogramBins + histBin ] += value;
                 }
                 
                 //Normalize the hist bins
-                for(UINT n=0; n<numInputDimensions/2; n++){
-                    if( histSumValues[ n ] > 0 ){
-                        for(UINT i=0; i<numHistogramBins; i++){
-                            featureVector[ n*numHistogramBins + i  ] /=  histSumValues[ n ];
-                        }
+                if( histSumValue > 0 ){
+                    for(UINT i=0; i<numHistogramBins; i++){
+                        featureVector[ n*numHistogramBins + i ] /= histSumValue;
                     }
                 }
             }
             break;
         default:
-            errorLog << "update(vector< double > x)- Unknown featureMode!" << endl;
-            return featureVector;
+            errorLog << "updateFeatures(const VectorDouble &x) - Unknown featureMode!" << endl;
+            return false;
             break;
     }
     
-    return featureVector;
+    return true;
 }
     
 CircularBuffer< VectorDouble > MovementTrajectoryFeatures::getTrajectoryData(){
     if( initialized ){
-        return trajectoryDataBuffer;
+        return trajectoryDataBuffer.getBuffer();
     }
     return CircularBuffer< VectorDouble >();
 }
@@ -23,6 +23,12 @@
  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  
  @section DESCRIPTION
+ The MovementTrajectoryFeatures class splits a buffer of the last trajectoryLength input vectors into numCentroids equal sections and
+ computes features from the centroid (mean) of each section, such as the centroid values, the derivative between the centroids, or a
+ histogram of the angles between the 2D centroids.
+ 
+ The sum of each section is kept in a SlidingWindowStatistics buffer and updated as each new vector is added, so the centroids are not
+ recomputed from the whole trajectory buffer for every input vector.
  */
 
 #ifndef GRT_MOVEMENT_TRAJECTORY_FEATURES_HEADER
@@ -186,7 +192,15 @@ protected:
     UINT numHistogramBins;
     bool useTrajStartAndEndValues;
     bool useWeightedMagnitudeValues;
-    CircularBuffer< VectorDouble > trajectoryDataBuffer;
+    /**
+     Adds the input to the trajectory buffer and updates the centroids and the feature vector.
+     
+     @param const VectorDouble &x: the input, must be the same size as the numInputDimensions
+     @return returns true if the features were computed, false otherwise
+     */
+    bool updateFeatures(const VectorDouble &x);
+    
+    SlidingWindowStatistics trajectoryDataBuffer;
     MatrixDouble centroids;
     
     static RegisterFeatureExtractionModule< MovementTrajectoryFeatures > registerModule;
@@ -89,7 +89,66 @@ bool TimeDomainFeatures::computeFeatures(const VectorDouble &inputVector){
     }
 #endif
     
-    featureVector = update( inputVector );
+    updateFeatures( inputVector );
+    
+    return true;
+}
+
+bool TimeDomainFeatures::computeFeatures(const MatrixDouble &timeSeries,VectorDouble &features){
+    
+    if( !initialized ){
+        errorLog << "computeFeatures(const MatrixDouble &timeSeries,VectorDouble &features) - Not initialized!" << endl;
+        return false;
+    }
+    
+    const UINT numSamples = timeSeries.getNumRows();
+    if( timeSeries.getNumCols() != numInputDimensions ){
+        errorLog << "computeFeatures(const MatrixDouble &timeSeries,VectorDouble &features) - The number of columns in the timeSeries (" << timeSeries.getNumCols() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    if( numSamples < numFrames ){
+        errorLog << "computeFeatures(const MatrixDouble &timeSeries,VectorDouble &features) - The timeSeries has fewer samples (" << numSamples << ") than the number of frames (" << numFrames << ")!" << endl;
+        return false;
+    }
+    
+    //The features are computed in the same order, and with the same offset, as the realtime features
+    features.resize( numOutputDimensions );
+    UINT index = 0;
+    for(UINT n=0; n<numInputDimensions; n++){
+        const double offset = offsetInput ? timeSeries[0][n] : 0;
+        for(UINT j=0; j<numFrames; j++){
+            const UINT startIndex = (j*numSamples)/numFrames;
+            const UINT endIndex = ((j+1)*numSamples)/numFrames;
+            const UINT frameSize = endIndex - startIndex;
+            
+            double sum = 0;
+            double sumSquares = 0;
+            for(UINT i=startIndex; i<endIndex; i++){
+                const double x = i == 0 ? timeSeries[i][n] : timeSeries[i][n] - offset;
+                sum += x;
+                sumSquares += x*x;
+            }
+            const double mean = sum / frameSize;
+            double squaredError = 0;
+            for(UINT i=startIndex; i<endIndex; i++){
+                const double x = i == 0 ? timeSeries[i][n] : timeSeries[i][n] - offset;
+                squaredError += (x-mean)*(x-mean);
+            }
+            
+            if( useMean ){
+                features[index++] = mean;
+            }
+            if( useStdDev ){
+                features[index++] = sqrt( squaredError/(frameSize>1 ? frameSize-1 : 1) );
+            }
+            if( useEuclideanNorm ){
+                features[index++] = sqrt( sumSquares );
+            }
+            if( useRMS ){
+                features[index++] = sqrt( sumSquares / frameSize );
+            }
+        }
+    }
     
     return true;
 }
@@ -292,8 +351,11 @@ bool TimeDomainFeatures::init(UINT bufferLength,UINT numFrames,UINT numDimension
     //Resize the feature vector
     featureVector.resize(numOutputDimensions);
     
-    //Resize the raw data buffer
-    dataBuffer.resize( bufferLength, VectorDouble(numInputDimensions,0) );
+    //Resize the raw data buffer, the running sums are kept for each frame
+    if( !dataBuffer.init( bufferLength, numInputDimensions, numFrames ) ){
+        errorLog << "init(...) - Failed to initialize the data buffer!" << endl;
+        return false;
+    }
 
     //Flag that the time domain features has been initialized
     initialized = true;
@@ -320,7 +382,14 @@ VectorDouble TimeDomainFeatures::update(const VectorDouble &x){
     }
 #endif
     
-    //Add the new data to the data buffer
+    updateFeatures( x );
+    
+    return featureVector;
+}
+    
+void TimeDomainFeatures::updateFeatures(const VectorDouble &x){
+    
+    //Add the new data to the data buffer, this also updates the running sums of each frame
     dataBuffer.push_back( x );
     
     //Only flag that the feature data is ready if the data is full
@@ -328,118 +397,55 @@ VectorDouble TimeDomainFeatures::update(const VectorDouble &x){
         featureDataReady = true;
     }else featureDataReady = false;
     
-    MatrixDouble meanFeatures(numInputDimensions,numFrames);
-    MatrixDouble stdDevFeatures(numInputDimensions,numFrames);
-    MatrixDouble normFeatures(numInputDimensions,numFrames);
-    MatrixDouble rmsFeatures(numInputDimensions,numFrames);
-    MatrixDouble data(bufferLength,numInputDimensions);
-    
-    if( offsetInput ){
-        for(UINT n=0; n<numInputDimensions; n++){
-            data[0][n] = dataBuffer[0][n];
-            for(UINT i=1; i<bufferLength; i++){
-                data[i][n] = dataBuffer[i][n]-dataBuffer[0][n];
-            }
-        }
-    }else{
-        for(UINT n=0; n<numInputDimensions; n++){
-            for(UINT i=0; i<bufferLength; i++){
-                data[i][n] = dataBuffer[i][n];
-            }
-        }
-    }
-    
-    if( useMean || useStdDev ){ meanFeatures.setAllValues(0); stdDevFeatures.setAllValues(0); }
-    if( useEuclideanNorm ) normFeatures.setAllValues(0);
-    if( useRMS ) rmsFeatures.setAllValues(0);
-    
-    UINT frameSize = bufferLength / numFrames;
-    UINT frame = 0;
+    //The features of each frame are computed from the running sums of the frame. If offsetInput is true, every value apart
+    //from the first value in the buffer is offset by the first value in the buffer
+    const UINT frameSize = bufferLength / numFrames;
+    const double stdDevNorm = frameSize>1 ? frameSize-1 : 1;
     UINT index = 0;
     for(UINT n=0; n<numInputDimensions; n++){
-        frame = 0;
-        index = 0;
-        for(UINT i=0; i<bufferLength; i++){
-            //Update the mean
-            meanFeatures[n][frame] += data[i][n];
-            
-            //Update the norm features
-            if( useEuclideanNorm )
-                normFeatures[n][frame] += data[i][n]*data[i][n];
-            
-            //Update the rms features
-            if( useRMS )
-                rmsFeatures[n][frame] += data[i][n]*data[i][n];
-            
-            if( ++index == frameSize ){
-                frame++;
-                index = 0;
-            }
-        }
-        
-        //Update the mean
+        const double offset = offsetInput ? dataBuffer[0][n] : 0;
         for(UINT j=0; j<numFrames; j++){
-            meanFeatures[n][j] /= frameSize;
-        }
-        
-        //Update the std dev if needed
-        if( useStdDev ){
-            frame = 0;
-            index = 0;
-            for(UINT i=0; i<bufferLength; i++){
-                stdDevFeatures[n][frame] += (data[i][n]-meanFeatures[n][frame]) * (data[i][n]-meanFeatures[n][frame]);
-                if( ++index == frameSize ){
-                    frame++;
-                    index = 0;
+            double sum = 0;
+            double sumSquares = 0;
+            double squaredError = 0;
+            dataBuffer.getMoments(j,n,offset,sum,sumSquares);
+
+            if( offsetInput && j == 0 ){
+                //The first value in the buffer is not offset, so its offset value (zero) is replaced by the value itself. The
+                //squared error of the other values is combined with the first value using the parallel variance formula, as
+                //adding the large first value into the sum of squares would lose the precision of the small offset values
+                if( frameSize > 1 ){
+                    const double otherMean = sum / (frameSize-1);
+                    const double delta = offset - otherMean;
+                    squaredError = (sumSquares - sum*otherMean) + delta*delta*(frameSize-1)/frameSize;
                 }
+                sum += offset;
+                sumSquares += offset*offset;
+            }else{
+                squaredError = sumSquares - sum*(sum / frameSize);
             }
-            double norm = frameSize>1 ? frameSize-1 : 1;
-            for(UINT j=0; j<numFrames; j++){
-                stdDevFeatures[n][j] = sqrt( stdDevFeatures[n][j]/norm );
-            }
-        }
-        
-        //Update the euclidean norm if needed
-        if( useEuclideanNorm ){
-            for(UINT j=0; j<numFrames; j++){
-                normFeatures[n][j] = sqrt( normFeatures[n][j] );
-            }
-        }
-        
-        //Update the rms if needed
-        if( useRMS ){
-            for(UINT j=0; j<numFrames; j++){
-                rmsFeatures[n][j] = sqrt( rmsFeatures[n][j] / frameSize );
-            }
-        }
-    }
-    
-    //Update the features
-    index = 0;
-    frame = 0;
-    for(UINT n=0; n<numInputDimensions; n++){
-        for(UINT j=0; j<numFrames; j++){
+
+            const double mean = sum / frameSize;
+
             if( useMean ){
-                featureVector[index++] = meanFeatures[n][j];
+                featureVector[index++] = mean;
             }
             if( useStdDev ){
-                featureVector[index++] = stdDevFeatures[n][j];
+                featureVector[index++] = squaredError > 0 ? sqrt( squaredError/stdDevNorm ) : 0;
             }
             if( useEuclideanNorm ){
-                featureVector[index++] = normFeatures[n][j];
+                featureVector[index++] = sqrt( sumSquares );
             }
             if( useRMS ){
-                featureVector[index++] = rmsFeatures[n][j];
+                featureVector[index++] = sqrt( sumSquares / frameSize );
             }
         }
     }
-    
-    return featureVector;
 }
     
 CircularBuffer< VectorDouble > TimeDomainFeatures::getBufferData(){
     if( initialized ){
-        return dataBuffer;
+        return dataBuffer.getBuffer();
     }
     return CircularBuffer< VectorDouble >();
 }
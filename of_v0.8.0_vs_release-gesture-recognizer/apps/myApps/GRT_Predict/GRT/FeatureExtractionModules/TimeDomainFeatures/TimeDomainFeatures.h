@@ -79,6 +79,18 @@ public:
      */
     virtual bool computeFeatures(const VectorDouble &inputVector);
     
+    /**
+     Computes the features of a whole timeseries in one go, rather than from the sliding window of the last bufferLength inputs.
+     The timeseries is split into numFrames frames of (as near as possible) equal length, so timeseries of different lengths give
+     features of the same size. The internal buffer is not used or changed, so this can be called on an instance that is also
+     being used to compute features in realtime.
+     
+     @param const MatrixDouble &timeSeries: the timeseries, each row is one sample and it must have numInputDimensions columns and at least numFrames rows
+     @param VectorDouble &features: returns the features, this will have numOutputDimensions elements
+     @return returns true if the features were computed, false otherwise
+     */
+    bool computeFeatures(const MatrixDouble &timeSeries,VectorDouble &features);
+    
     /**
      Sets the FeatureExtraction reset function, overwriting the base FeatureExtraction function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
@@ -150,6 +162,8 @@ public:
     CircularBuffer< VectorDouble > getBufferData();
 
 protected:
+    void updateFeatures(const VectorDouble &x);
+    
     UINT bufferLength;
     UINT numFrames;
     bool offsetInput;
@@ -157,7 +171,7 @@ protected:
     bool useStdDev;
     bool useEuclideanNorm;
     bool useRMS;
-    CircularBuffer< VectorDouble > dataBuffer;
+    SlidingWindowStatistics dataBuffer;
     
     static RegisterFeatureExtractionModule< TimeDomainFeatures > registerModule;
 };
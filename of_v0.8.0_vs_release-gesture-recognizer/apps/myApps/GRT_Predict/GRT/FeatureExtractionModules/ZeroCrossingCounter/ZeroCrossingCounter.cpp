@@ -51,6 +51,12 @@ ZeroCrossingCounter& ZeroCrossingCounter::operator=(const ZeroCrossingCounter &r
         this->derivative = rhs.derivative;
         this->deadZone = rhs.deadZone;
         this->dataBuffer = rhs.dataBuffer;
+        this->crossingBuffer = rhs.crossingBuffer;
+        this->inputData = rhs.inputData;
+        this->crossingData = rhs.crossingData;
+        this->zeroCrossingCounts = rhs.zeroCrossingCounts;
+        this->zeroCrossingMagnitudes = rhs.zeroCrossingMagnitudes;
+        this->numUpdatesSinceResync = rhs.numUpdatesSinceResync;
         
         copyBaseVariables( (FeatureExtraction*)&rhs );
     }
@@ -86,7 +92,7 @@ bool ZeroCrossingCounter::computeFeatures(const VectorDouble &inputVector){
     }
 #endif
     
-    update( inputVector );
+    updateFeatures( inputVector );
     
     return true;
 }
@@ -239,6 +245,14 @@ bool ZeroCrossingCounter::init(UINT searchWindowSize,double deadZoneThreshold,UI
     derivative.init(Derivative::FIRST_DERIVATIVE, 1.0, numInputDimensions, true, 5);
     deadZone.init(-deadZoneThreshold,deadZoneThreshold,numInputDimensions);
     dataBuffer.resize( searchWindowSize, vector< double >(numInputDimensions,NAN) );
+    crossingBuffer.resize( searchWindowSize, vector< double >(numInputDimensions*2,0) );
+    inputData.resize( numInputDimensions, 0 );
+    crossingData.resize( numInputDimensions*2, 0 );
+    zeroCrossingCounts.clear();
+    zeroCrossingCounts.resize( numInputDimensions, 0 );
+    zeroCrossingMagnitudes.clear();
+    zeroCrossingMagnitudes.resize( numInputDimensions, 0 );
+    numUpdatesSinceResync = 0;
     featureVector.resize(numOutputDimensions,0);
     
     //Flag that the zero crossing counter has been initialized
@@ -266,43 +280,101 @@ VectorDouble ZeroCrossingCounter::update(const VectorDouble &x){
     }
 #endif
     
-    //Clear the feature vector
-    std::fill(featureVector.begin(),featureVector.end(),0);
+    updateFeatures( x );
     
-    //Update the derivative data and 
-    derivative.computeDerivative( x );
+    return featureVector;
+}
+
+void ZeroCrossingCounter::updateFeatures(const VectorDouble &x){
     
-    //Dead zone the derivative data
-    deadZone.filter( derivative.getProcessedData() );
+    //Compute the derivative of the input and dead zone it
+    derivative.processBlock( &x[0], &inputData[0], 1 );
+    deadZone.processBlock( &inputData[0], &inputData[0], 1 );
     
-    //Add the deadzone data to the buffer
-    dataBuffer.push_back( deadZone.getProcessedData() );
+    //Add the deadzone data to the buffer, if the buffer was full then the oldest value is removed
+    const bool bufferWasFilled = dataBuffer.getBufferFilled();
+    dataBuffer.push_back( inputData );
+    const UINT numValues = dataBuffer.getNumValuesInBuffer();
+    const UINT newIndex = numValues-1;
     
-    //Search the buffer for the zero crossing features
+    //Check if the new value ends a zero crossing and, if so, find its magnitude, which is the max of the last 5 values
+    //(or the values back to the second value in the buffer if the crossing is at the start of the buffer)
+    const UINT searchSize = newIndex > MAGNITUDE_SEARCH_SIZE ? MAGNITUDE_SEARCH_SIZE : newIndex;
     for(UINT j=0; j<numInputDimensions; j++){
-        UINT colIndex = (featureMode == INDEPENDANT_FEATURE_MODE ? (TOTAL_NUM_ZERO_CROSSING_FEATURES*j) : 0);
-        for(UINT i=1; i<dataBuffer.getSize(); i++){
-            //Search for a zero crossing
-            if( (dataBuffer[i][j] > 0 && dataBuffer[i-1][j] <= 0) || (dataBuffer[i][j] < 0 && dataBuffer[i-1][j] >= 0) ){
-                //Update the zero crossing count
-                featureVector[ NUM_ZERO_CROSSINGS_COUNTED + colIndex ]++;
-                
-                //Update the magnitude, search the last 5 values around the zero crossing to make sure we get the maxima of the peak
+        crossingData[j] = 0;
+        crossingData[numInputDimensions+j] = 0;
+        if( newIndex > 0 ){
+            const double value = dataBuffer[newIndex][j];
+            const double lastValue = dataBuffer[newIndex-1][j];
+            if( (value > 0 && lastValue <= 0) || (value < 0 && lastValue >= 0) ){
                 double maxValue = 0;
-                UINT searchSize = i > 5 ? 5 : i;
                 for(UINT n=0; n<searchSize; n++){
-                    double value = fabs( dataBuffer[ i-n ][j] );
-                    if( value > maxValue ) maxValue = value;
+                    const double v = fabs( dataBuffer[ newIndex-n ][j] );
+                    if( v > maxValue ) maxValue = v;
                 }
-                featureVector[ ZERO_CROSSING_MAGNITUDE + colIndex ] += maxValue;
+                crossingData[j] = 1;
+                crossingData[numInputDimensions+j] = maxValue;
             }
         }
     }
+    crossingBuffer.push_back( crossingData );
+    
+    //Update the running counts. A crossing is counted while it ends at index 1 or later, and its full magnitude is used while it ends at
+    //index 5 or later, the magnitudes of the crossings ending at indices 1 to 4 are recomputed below as their search is cut short
+    if( ++numUpdatesSinceResync >= searchWindowSize ){
+        //Recompute the counts from the buffer every so often, so the magnitude sums do not drift
+        numUpdatesSinceResync = 0;
+        for(UINT j=0; j<numInputDimensions; j++){
+            zeroCrossingCounts[j] = 0;
+            zeroCrossingMagnitudes[j] = 0;
+        }
+        for(UINT i=1; i<numValues; i++){
+            const VectorDouble &crossing = crossingBuffer[i];
+            for(UINT j=0; j<numInputDimensions; j++){
+                zeroCrossingCounts[j] += crossing[j];
+                if( i >= MAGNITUDE_SEARCH_SIZE ) zeroCrossingMagnitudes[j] += crossing[numInputDimensions+j];
+            }
+        }
+    }else{
+        for(UINT j=0; j<numInputDimensions; j++){
+            if( newIndex >= 1 ) zeroCrossingCounts[j] += crossingData[j];
+            if( newIndex >= MAGNITUDE_SEARCH_SIZE ) zeroCrossingMagnitudes[j] += crossingData[numInputDimensions+j];
+        }
+        if( bufferWasFilled ){
+            //Every value has moved back one index, so remove the crossing that has moved to index 0 and the magnitude that has moved to index 4
+            for(UINT j=0; j<numInputDimensions; j++){
+                zeroCrossingCounts[j] -= crossingBuffer[0][j];
+            }
+            if( numValues > MAGNITUDE_SEARCH_SIZE ){
+                for(UINT j=0; j<numInputDimensions; j++){
+                    zeroCrossingMagnitudes[j] -= crossingBuffer[MAGNITUDE_SEARCH_SIZE-1][numInputDimensions+j];
+                }
+            }
+        }
+    }
+    
+    //Set the features, adding the magnitudes of any crossings at the start of the buffer
+    std::fill(featureVector.begin(),featureVector.end(),0);
+    const UINT numHeadValues = numValues < MAGNITUDE_SEARCH_SIZE ? numValues : MAGNITUDE_SEARCH_SIZE;
+    for(UINT j=0; j<numInputDimensions; j++){
+        UINT colIndex = (featureMode == INDEPENDANT_FEATURE_MODE ? (TOTAL_NUM_ZERO_CROSSING_FEATURES*j) : 0);
+        double magnitude = zeroCrossingMagnitudes[j];
+        for(UINT i=1; i<numHeadValues; i++){
+            if( crossingBuffer[i][j] > 0 ){
+                double maxValue = 0;
+                for(UINT n=0; n<i; n++){
+                    const double v = fabs( dataBuffer[ i-n ][j] );
+                    if( v > maxValue ) maxValue = v;
+                }
+                magnitude += maxValue;
+            }
+        }
+        featureVector[ NUM_ZERO_CROSSINGS_COUNTED + colIndex ] += zeroCrossingCounts[j];
+        featureVector[ ZERO_CROSSING_MAGNITUDE + colIndex ] += magnitude;
+    }
     
     //Flag that the feature data has been computed
     featureDataReady = true;
-
-    return featureVector;
 }
     
 bool ZeroCrossingCounter::setSearchWindowSize(UINT searchWindowSize){
@@ -35,6 +35,10 @@
  In COMBINED_FEATURE_MODE the zero-crossing count and zero-crossing magnitude features will be integrated across all of the N dimensions in the input signal.
  This means that if the ZeroCrossingCounter is set to INDEPENDANT_FEATURE_MODE, the size of the output feature vector will be 2 * N, where 2 is the two features (zero-crossing count and zero-crossing magnitude) and N is the number of dimensions in the input signal. Alternatively in COMBINED_FEATURE_MODE the size of the output vector will simply be 2, where 2 is the two features (zero-crossing count and zero-crossing magnitude). The feature modes can be set either in the ZeroCrossingCounter constructor or by using the setFeatureMode(UINT featureMode) function.
  
+ The features are updated incrementally: when a new value is added to the buffer only the zero crossing it creates, and the one that
+ leaves the start of the buffer, are added to or removed from the running counts, so the cost of each update does not depend on the size
+ of the search window.
+ 
  The ZeroCrossingCounter class is part of the Feature Extraction Modules.
  */
 
@@ -239,15 +243,31 @@ public:
     CircularBuffer< VectorDouble > getDataBuffer(){ if( initialized ){ return dataBuffer; } return CircularBuffer< VectorDouble >(); }
     
 protected:
+    /**
+     Adds the input to the buffers and updates the feature vector.
+     
+     @param const VectorDouble &x: the input, must be the same size as the numInputDimensions
+     */
+    void updateFeatures(const VectorDouble &x);
+    
     UINT searchWindowSize;                                  ///< The size of the search window, i.e. the amount of previous data stored and searched
     UINT featureMode;                                       ///< The featureMode controls how the features are added to the feature vector
     double deadZoneThreshold;                               ///< The threshold value used for the dead zone filter
     Derivative derivative;                                  ///< Used to compute the derivative of the input signal
     DeadZone deadZone;                                      ///< Used to remove small amounts of noise from the data
     CircularBuffer< VectorDouble > dataBuffer;              ///< A buffer used to store the previous derivative data
+    CircularBuffer< VectorDouble > crossingBuffer;          ///< Stores, for each value in the dataBuffer, if a zero crossing ended at that value (the first N elements) and its magnitude (the last N elements)
+    VectorDouble inputData;                                 ///< Holds the derivative of the current input, before it is added to the dataBuffer
+    VectorDouble crossingData;                              ///< Holds the zero crossing values of the current input, before they are added to the crossingBuffer
+    VectorDouble zeroCrossingCounts;                        ///< The number of zero crossings in the dataBuffer, for each dimension
+    VectorDouble zeroCrossingMagnitudes;                    ///< The sum of the magnitudes of the zero crossings that are at least 5 values into the dataBuffer, for each dimension
+    UINT numUpdatesSinceResync;                             ///< The number of updates since the running counts were last recomputed from the buffers
     
     static RegisterFeatureExtractionModule< ZeroCrossingCounter > registerModule;
     
+    //The magnitude of a zero crossing is the max value over this many values, up to and including the value the crossing ended at
+    static const UINT MAGNITUDE_SEARCH_SIZE = 5;
+    
 public:
     enum ZeroCrossingFeatureIDs{NUM_ZERO_CROSSINGS_COUNTED=0,ZERO_CROSSING_MAGNITUDE,TOTAL_NUM_ZERO_CROSSING_FEATURES};
     enum FeatureModes{INDEPENDANT_FEATURE_MODE=0,COMBINED_FEATURE_MODE};
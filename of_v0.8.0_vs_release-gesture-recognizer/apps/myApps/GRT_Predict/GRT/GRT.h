@@ -53,6 +53,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Util/EigenvalueDecomposition.h"
 #include "Util/TestResult.h"
 #include "Util/ClassificationResult.h"
+#include "Util/PrototypeSelection.h"
 
 //Include the data structures
 #include "DataStructures/LabelledClassificationData.h"
@@ -80,6 +81,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "FeatureExtractionModules/TimeDomainFeatures/TimeDomainFeatures.h"
 #include "FeatureExtractionModules/PCA/PrincipalComponentAnalysis.h"
 #include "FeatureExtractionModules/KMeansQuantizer/KMeansQuantizer.h"
+#include "FeatureExtractionModules/IncrementalPCA/IncrementalPCA.h"
 #include "FeatureExtractionModules/TimeseriesBuffer/TimeseriesBuffer.h"
 
 //Include the PostProcessing Modules
@@ -92,11 +94,13 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ClassificationModules/ANBC/ANBC.h"
 #include "ClassificationModules/BAG/BAG.h"
 #include "ClassificationModules/DTW/DTW.h"
+#include "ClassificationModules/CascadeDTW/CascadeDTW.h"
 #include "ClassificationModules/GMM/GMM.h"
 #include "ClassificationModules/HMM/HMM.h"
 #include "ClassificationModules/KNN/KNN.h"
 #include "ClassificationModules/LDA/LDA.h"
 #include "ClassificationModules/MinDist/MinDist.h"
+#include "ClassificationModules/RandomForest/RandomForest.h"
 #include "ClassificationModules/Softmax/Softmax.h"
 #include "ClassificationModules/SVM/SVM.h"
 
@@ -111,6 +115,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //Include the Context Modules
 #include "ContextModules/Gate.h"
+#include "ContextModules/MotionSegmentation.h"
 
 //Include the Recognition Pipeline
 #include "GestureRecognitionPipeline/GestureRecognitionPipeline.h"
@@ -22,7 +22,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace GRT{
     
 Classifier::StringClassifierMap* Classifier::stringClassifierMap = NULL;
-UINT Classifier::numClassifierInstances = 0;
+//The instance counter is a function static so it is ready before the first module is registered, and it is atomic as
+//instances can be created and deleted by several training threads at the same time
+std::atomic< UINT >& Classifier::getNumClassifierInstances(){
+    static std::atomic< UINT > numClassifierInstances( 0 );
+    return numClassifierInstances;
+}
     
 Classifier* Classifier::createInstanceFromString(string const &classifierType){
     
@@ -58,11 +63,11 @@ Classifier::Classifier(void){
     maxLikelihood = 0;
     bestDistance = 0;
     nullRejectionCoeff = 5;
-    numClassifierInstances++;
+    getNumClassifierInstances()++;
 }
     
 Classifier::~Classifier(void){
-    if( --numClassifierInstances == 0 ){
+    if( --getNumClassifierInstances() == 0 ){
         delete stringClassifierMap;
         stringClassifierMap = NULL;
     }
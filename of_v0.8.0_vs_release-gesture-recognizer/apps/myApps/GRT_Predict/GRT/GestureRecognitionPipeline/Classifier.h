@@ -77,6 +77,16 @@ public:
      */
     virtual bool reset();
 
+    /**
+     Adds the input vector to the buffer of recent inputs of the classifier, without running a prediction. This is called by the
+     GestureRecognitionPipeline for the samples it does not classify in its multi-rate mode, so a timeseries classifier still sees
+     every sample. Classifiers that do not keep a history of their inputs do not need to override this function.
+     
+     @param const VectorDouble &inputVector: the input vector to add to the buffer
+     @return returns true if the input vector was buffered, false otherwise
+     */
+    virtual bool bufferInputVector(const VectorDouble &inputVector){ return true; }
+
     /**
      Returns the classifeir type as a string.
      
@@ -280,7 +290,7 @@ protected:
     
 private:
     static StringClassifierMap *stringClassifierMap;
-    static UINT numClassifierInstances;
+    static std::atomic< UINT >& getNumClassifierInstances();
     
 };
     
@@ -71,18 +71,28 @@ public:
         return true;
     }
 
-    virtual bool process(VectorDouble inputVector){ return false; }
+    virtual bool process(const VectorDouble &inputVector){ return false; }
     virtual bool reset(){ return false; }
     
     virtual bool updateContext(bool value){ return false; }
     
+    /**
+     Gets a complete segment of input data from the context module. A context module that segments the input (such as the
+     MotionSegmentation module) keeps the pipeline closed while it collects a segment, and when the segment ends the pipeline
+     passes the segment to the classifier as a timeseries.
+     
+     @param MatrixDouble &segment: returns the segment, as a [M N] matrix where M is the length of the segment
+     @return returns true if a segment ended with the most recent input vector, false otherwise (the base class always returns false)
+     */
+    virtual bool getSegment(MatrixDouble &segment) const{ return false; }
+    
     //Getters
 	string getContextType() const { return contextType; }
 	UINT getNumInputDimensions() const { return numInputDimensions; }
 	UINT getNumOutputDimensions() const { return numOutputDimensions; }
 	bool getInitialized() const { return initialized; }
 	bool getOK() const { return okToContinue; }
-	VectorDouble getProcessedData() const { return data; }
+	const VectorDouble& getProcessedData() const { return data; }
     
     /**
      Defines a map between a string (which will contain the name of the context module, such as Gate) and a function returns a new instance of that context
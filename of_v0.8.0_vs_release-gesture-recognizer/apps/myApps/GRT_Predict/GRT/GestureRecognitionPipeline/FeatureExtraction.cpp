@@ -145,7 +145,7 @@ bool FeatureExtraction::getFeatureDataReady() const{
     return featureDataReady;
 }
 
-VectorDouble FeatureExtraction::getFeatureVector() const{ 
+const VectorDouble& FeatureExtraction::getFeatureVector() const{ 
     return featureVector; 
 }
     
@@ -155,9 +155,9 @@ public:
     /**
      Returns the current feature vector.
      
-     @return returns the current feature vector, this vector will be empty if the module has not been initialized
+     @return returns a reference to the current feature vector, this vector will be empty if the module has not been initialized
      */
-    VectorDouble getFeatureVector() const;
+    const VectorDouble& getFeatureVector() const;
     
     /**
      Creates a new feature extraction instance based on the current featureExtractionType string value.
@@ -43,6 +43,12 @@ GestureRecognitionPipeline::GestureRecognitionPipeline(void)
     classifier = NULL;
     regressifier = NULL;
     contextModules.resize( NUM_CONTEXT_LEVELS );
+    classificationInterval = 1;
+    classificationTimeInterval = 0;
+    numInputsSinceClassification = 0;
+    heldPredictedClassLabel = 0;
+    heldMaximumLikelihood = 0;
+    classifierUpdated = false;
     
     warningMessage = "";
     errorMessage = "";
@@ -73,6 +79,12 @@ GestureRecognitionPipeline::GestureRecognitionPipeline(const GestureRecognitionP
     classifier = NULL;
     regressifier = NULL;
     contextModules.resize( NUM_CONTEXT_LEVELS );
+    classificationInterval = 1;
+    classificationTimeInterval = 0;
+    numInputsSinceClassification = 0;
+    heldPredictedClassLabel = 0;
+    heldMaximumLikelihood = 0;
+    classifierUpdated = false;
     
     warningMessage = "";
     errorMessage = "";
@@ -114,6 +126,14 @@ GestureRecognitionPipeline& GestureRecognitionPipeline::operator=(const GestureR
 	    this->testClassificationResults = rhs.testClassificationResults;
         this->warningMessage = rhs.warningMessage;
         this->errorMessage = rhs.errorMessage;
+        this->classificationInterval = rhs.classificationInterval;
+        this->classificationTimeInterval = rhs.classificationTimeInterval;
+        this->numInputsSinceClassification = 0;
+        this->heldPredictedClassLabel = 0;
+        this->heldMaximumLikelihood = 0;
+        this->heldClassLikelihoods.clear();
+        this->heldClassDistances.clear();
+        this->classifierUpdated = false;
 	
 		for(unsigned int i=0; i<rhs.preProcessingModules.size(); i++){
 			this->addPreProcessingModule( *(rhs.preProcessingModules[i]) );
@@ -140,6 +160,8 @@ GestureRecognitionPipeline& GestureRecognitionPipeline::operator=(const GestureR
 				this->addContextModule( *(rhs.contextModules[k][i]), k );
 			}
 		}
+		
+		if( getIsMultiRateModeEnabled() ) holdClassifierOutput();
 	}
 	
 	return *this;
@@ -871,6 +893,9 @@ bool GestureRecognitionPipeline::test(LabelledClassificationData testData){
     
     testTime = timer.getMilliSeconds();
     
+    //Log the accuracy with the prediction time, so the trade-off between models trained on different datasets (such as a condensed dataset) can be compared
+    testingLog << "Test complete. Accuracy: " << testAccuracy << "% Number of training samples: " << numTrainingSamples << " Total testing time: " << testTime << "ms Average prediction time: " << (numTestSamples > 0 ? testTime/numTestSamples : 0) << "ms" << endl;
+    
     return true;
 }
     
@@ -956,6 +981,8 @@ bool GestureRecognitionPipeline::test(LabelledTimeSeriesClassificationData testD
     
     testTime = timer.getMilliSeconds();
     
+    testingLog << "Test complete. Accuracy: " << testAccuracy << "% Number of training samples: " << numTrainingSamples << " Total testing time: " << testTime << "ms Average prediction time: " << (numTestSamples > 0 ? testTime/numTestSamples : 0) << "ms" << endl;
+    
     return true;
 }
     
@@ -1142,7 +1169,7 @@ bool GestureRecognitionPipeline::test(LabelledRegressionData testData){
     return true;
 }
 
-bool GestureRecognitionPipeline::predict(VectorDouble inputVector){
+bool GestureRecognitionPipeline::predict(const VectorDouble &inputVector){
 	
 	//Make sure the classification model has been trained
     if( !trained ){
@@ -1158,12 +1185,15 @@ bool GestureRecognitionPipeline::predict(VectorDouble inputVector){
         return false;
     }
 
+    //Copy the input into the pipeline buffer, this only allocates memory the first time the pipeline is used
+    pipelineInputVector = inputVector;
+
 	if( getIsClassifierSet() ){
-        return predict_classifier( inputVector );
+        return predict_classifier( pipelineInputVector );
     }
 
 	if( getIsRegressifierSet() ){
-        return predict_regressifier( inputVector );
+        return predict_regressifier( pipelineInputVector );
     }
 
     errorMessage = "predict(VectorDouble inputVector) - Neither a classifier or regressifer is not set";
@@ -1327,6 +1357,7 @@ bool GestureRecognitionPipeline::map(VectorDouble inputVector){
 bool GestureRecognitionPipeline::predict_classifier(VectorDouble &inputVector){
     
     predictedClassLabel = 0;
+    classifierUpdated = false;
     
     //Update the context module
     predictionModuleIndex = START_OF_PIPELINE;
@@ -1338,6 +1369,10 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble &inputVector){
                 return false;
             }
             if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->getOK() ){
+                //A segmentation module keeps the pipeline closed while it collects a segment, once the segment ends it is classified as a timeseries
+                if( contextModules[ START_OF_PIPELINE ][moduleIndex]->getSegment( segmentData ) ){
+                    return predict( segmentData );
+                }
                 return true;
             }
             inputVector = contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
@@ -1345,14 +1380,32 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble &inputVector){
     }
     
     //Perform any pre-processing
+    VectorDouble *preProcessedData = &inputVector;
     if( getIsPreProcessingSet() ){
+        if( preProcessingBuffers.size() != preProcessingModules.size() ) preProcessingBuffers.resize( preProcessingModules.size() );
         for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
-            if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
+            PreProcessing *module = preProcessingModules[moduleIndex];
+            
+            //If the module does not change the size of the data then it filters the data in place, otherwise it writes to its own buffer
+            bool result = false;
+            const UINT N = (UINT)preProcessedData->size();
+            const UINT M = module->getNumOutputDimensions();
+            if( N > 0 && M > 0 && module->getNumInputDimensions() == N ){
+                if( M == N ){
+                    result = module->processBlock( &(*preProcessedData)[0], &(*preProcessedData)[0], 1 );
+                }else{
+                    VectorDouble &buffer = preProcessingBuffers[ moduleIndex ];
+                    if( buffer.size() != M ) buffer.resize( M );
+                    result = module->processBlock( &(*preProcessedData)[0], &buffer[0], 1 );
+                    preProcessedData = &buffer;
+                }
+            }
+            
+            if( !result ){
                 errorMessage = "predict_classifier(VectorDouble inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " + Util::toString(moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
             }
-            inputVector = preProcessingModules[moduleIndex]->getProcessedData();
         }
     }
     
@@ -1360,7 +1413,7 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble &inputVector){
     predictionModuleIndex = AFTER_PREPROCESSING;
     if( contextModules[ AFTER_PREPROCESSING ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
+            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( *preProcessedData ) ){
                 errorMessage = "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " + Util::toString(moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
@@ -1370,18 +1423,20 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble &inputVector){
                 return false;
             }
             inputVector = contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
+            preProcessedData = &inputVector;
         }
     }
     
-    //Perform any feature extraction
+    //Perform any feature extraction, the features are read directly from each module rather than being copied into the input vector
+    const VectorDouble *featureData = preProcessedData;
     if( getIsFeatureExtractionSet() ){
         for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
-            if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
+            if( !featureExtractionModules[moduleIndex]->computeFeatures( *featureData ) ){
                 errorMessage =  "predict_classifier(VectorDouble inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " + Util::toString(moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
             }
-            inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
+            featureData = &featureExtractionModules[moduleIndex]->getFeatureVector();
         }
     }
     
@@ -1389,7 +1444,7 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble &inputVector){
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
     if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
+            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( *featureData ) ){
                 errorMessage = "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " + Util::toString(moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
@@ -1399,21 +1454,45 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble &inputVector){
                 return false;
             }
             inputVector = contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
+            featureData = &inputVector;
         }
     }
     
-    //Perform the classification
-    if( !classifier->predict(inputVector) ){
-        errorMessage = "predict_classifier(VectorDouble inputVector) - Prediction Failed! " + classifier->getLastErrorMessage();
-        errorLog << errorMessage << endl;
-        return false;
+    //In the multi-rate mode the classifier only runs once every classificationInterval inputs, and at most once every
+    //classificationTimeInterval milliseconds. In between, the classifier only buffers the input and the predicted class label of
+    //the last classifier run is held, the context modules after the classifier and the event and time based post processing
+    //modules still process every input
+    numInputsSinceClassification++;
+    if( numInputsSinceClassification < classificationInterval || (classificationTimeInterval > 0 && classificationTimer.running() && classificationTimer.getMilliSeconds() < classificationTimeInterval) ){
+        if( !classifier->bufferInputVector( *featureData ) ){
+            errorMessage = "predict_classifier(VectorDouble inputVector) - Failed to buffer the input vector! " + classifier->getLastErrorMessage();
+            errorLog << errorMessage << endl;
+            return false;
+        }
+    }else{
+        numInputsSinceClassification = 0;
+        if( classificationTimeInterval > 0 ) classificationTimer.start();
+        classifierUpdated = true;
+        
+        //Perform the classification, the features are copied into a buffer the classifier can modify, which only allocates memory the first time
+        predictionInputVector = *featureData;
+        if( !classifier->predict_( predictionInputVector ) ){
+            errorMessage = "predict_classifier(VectorDouble inputVector) - Prediction Failed! " + classifier->getLastErrorMessage();
+            errorLog << errorMessage << endl;
+            return false;
+        }
+        
+        //In the multi-rate mode the outputs of the classifier are held until the next classifier run
+        if( getIsMultiRateModeEnabled() ) holdClassifierOutput();
     }
-    predictedClassLabel = classifier->getPredictedClassLabel();
+    predictedClassLabel = getUnProcessedPredictedClassLabel();
     
     //Update the context module
     if( contextModules[ AFTER_CLASSIFIER ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( vector<double>(1,predictedClassLabel) ) ){
+            classLabelVector.resize( 1 );
+            classLabelVector[0] = predictedClassLabel;
+            if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( classLabelVector ) ){
                 errorMessage = "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " + Util::toString(moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
@@ -1436,37 +1515,34 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble &inputVector){
             return false;
         }
         
-        VectorDouble data;
         for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
             
-            //Select which input we should give the postprocessing module
-            if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
+            //Select which input we should give the postprocessing module, in the multi-rate mode a module that counts the classifier
+            //outputs (such as the ClassLabelFilter) is only given new classifier outputs and its output is held between classifier runs
+            if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() && (classifierUpdated || postProcessingModules[moduleIndex]->getProcessEveryInput()) ){
                 //Set the input
-                data.resize(1);
-                data[0] = predictedClassLabel;
+                classLabelVector.resize(1);
+                classLabelVector[0] = predictedClassLabel;
                 
                 //Verify that the input size is OK
-                if( data.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
-                    errorMessage = "predict_classifier(VectorDouble inputVector) - The size of the data vector (" + Util::toString((int)data.size()) + ") does not match that of the postProcessingModule (" + Util::toString(postProcessingModules[moduleIndex]->getNumInputDimensions()) + ") at the moduleIndex: " + Util::toString(moduleIndex);
+                if( classLabelVector.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
+                    errorMessage = "predict_classifier(VectorDouble inputVector) - The size of the data vector (" + Util::toString((int)classLabelVector.size()) + ") does not match that of the postProcessingModule (" + Util::toString(postProcessingModules[moduleIndex]->getNumInputDimensions()) + ") at the moduleIndex: " + Util::toString(moduleIndex);
                     errorLog << errorMessage <<endl;
                     return false;
                 }
                 
                 //Postprocess the data
-                if( !postProcessingModules[moduleIndex]->process( data ) ){
+                if( !postProcessingModules[moduleIndex]->process( classLabelVector ) ){
                     errorMessage = "predict_classifier(VectorDouble inputVector) - Failed to post process data. PostProcessing moduleIndex: " + Util::toString(moduleIndex);
                     errorLog << errorMessage <<endl;
                     return false;
                 }
-                
-                //Select which output we should update
-                data = postProcessingModules[moduleIndex]->getProcessedData();  
             }
             
             //Select which output we should update
             if( postProcessingModules[moduleIndex]->getIsPostProcessingOutputModePredictedClassLabel() ){
                 //Get the processed predicted class label
-                data = postProcessingModules[moduleIndex]->getProcessedData(); 
+                const VectorDouble &data = postProcessingModules[moduleIndex]->getProcessedData(); 
                 
                 //Verify that the output size is OK
                 if( data.size() != 1 ){
@@ -1486,7 +1562,9 @@ bool GestureRecognitionPipeline::predict_classifier(VectorDouble &inputVector){
     predictionModuleIndex = END_OF_PIPELINE;
     if( contextModules[ END_OF_PIPELINE ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( vector<double>(1,predictedClassLabel) ) ){
+            classLabelVector.resize( 1 );
+            classLabelVector[0] = predictedClassLabel;
+            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( classLabelVector ) ){
                 errorMessage = "predict_classifier(VectorDouble inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " + Util::toString( moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
@@ -1521,14 +1599,32 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble &inputVector)
     }
     
     //Perform any pre-processing
+    VectorDouble *preProcessedData = &inputVector;
     if( getIsPreProcessingSet() ){
+        if( preProcessingBuffers.size() != preProcessingModules.size() ) preProcessingBuffers.resize( preProcessingModules.size() );
         for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
-            if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
+            PreProcessing *module = preProcessingModules[moduleIndex];
+            
+            //If the module does not change the size of the data then it filters the data in place, otherwise it writes to its own buffer
+            bool result = false;
+            const UINT N = (UINT)preProcessedData->size();
+            const UINT M = module->getNumOutputDimensions();
+            if( N > 0 && M > 0 && module->getNumInputDimensions() == N ){
+                if( M == N ){
+                    result = module->processBlock( &(*preProcessedData)[0], &(*preProcessedData)[0], 1 );
+                }else{
+                    VectorDouble &buffer = preProcessingBuffers[ moduleIndex ];
+                    if( buffer.size() != M ) buffer.resize( M );
+                    result = module->processBlock( &(*preProcessedData)[0], &buffer[0], 1 );
+                    preProcessedData = &buffer;
+                }
+            }
+            
+            if( !result ){
                 errorMessage = "predict_regressifier(VectorDouble inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " + Util::toString(moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
             }
-            inputVector = preProcessingModules[moduleIndex]->getProcessedData();
         }
     }
     
@@ -1536,7 +1632,7 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble &inputVector)
     predictionModuleIndex = AFTER_PREPROCESSING;
     if( contextModules[ AFTER_PREPROCESSING ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
+            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( *preProcessedData ) ){
                 errorMessage = "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " + Util::toString(moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
@@ -1546,18 +1642,20 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble &inputVector)
                 return false;
             }
             inputVector = contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
+            preProcessedData = &inputVector;
         }
     }
     
-    //Perform any feature extraction
+    //Perform any feature extraction, the features are read directly from each module rather than being copied into the input vector
+    const VectorDouble *featureData = preProcessedData;
     if( getIsFeatureExtractionSet() ){
         for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
-            if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
+            if( !featureExtractionModules[moduleIndex]->computeFeatures( *featureData ) ){
                 errorMessage =  "predict_regressifier(VectorDouble inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " + Util::toString(moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
             }
-            inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
+            featureData = &featureExtractionModules[moduleIndex]->getFeatureVector();
         }
     }
     
@@ -1565,7 +1663,7 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble &inputVector)
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
     if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
+            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( *featureData ) ){
                 errorMessage =  "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " + Util::toString(moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
@@ -1575,11 +1673,13 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble &inputVector)
                 return false;
             }
             inputVector = contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
+            featureData = &inputVector;
         }
     }
     
-    //Perform the regression
-    if( !regressifier->predict(inputVector) ){
+    //Perform the regression, the features are copied into a buffer the regressifier can modify, which only allocates memory the first time
+    predictionInputVector = *featureData;
+    if( !regressifier->predict_( predictionInputVector ) ){
         errorMessage = "predict_regressifier(VectorDouble inputVector) - Prediction Failed! " + regressifier->getLastErrorMessage();
         errorLog << errorMessage << endl;
         return false;
@@ -1633,7 +1733,7 @@ bool GestureRecognitionPipeline::predict_regressifier(VectorDouble &inputVector)
     predictionModuleIndex = END_OF_PIPELINE;
     if( contextModules[ END_OF_PIPELINE ].size() ){
         for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
+            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( *featureData ) ){
                 errorMessage = "predict_regressifier(VectorDouble inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " + Util::toString( moduleIndex);
                 errorLog << errorMessage << endl;
                 return false;
@@ -1702,6 +1802,16 @@ bool GestureRecognitionPipeline::reset(){
         }
     } 
     
+    //Reset the multi-rate state
+    numInputsSinceClassification = 0;
+    heldPredictedClassLabel = 0;
+    heldMaximumLikelihood = 0;
+    heldClassLikelihoods.clear();
+    heldClassDistances.clear();
+    classifierUpdated = false;
+    classificationTimer.stop();
+    if( getIsMultiRateModeEnabled() ) holdClassifierOutput();
+    
     return true;
 }
     
@@ -2250,11 +2360,13 @@ UINT GestureRecognitionPipeline::getPredictedClassLabel() const{
 }
     
 UINT GestureRecognitionPipeline::getUnProcessedPredictedClassLabel() const{ 
-    return (getIsClassifierSet() ? classifier->getPredictedClassLabel() : 0); 
+    if( !getIsClassifierSet() ) return 0;
+    return (getIsMultiRateModeEnabled() ? heldPredictedClassLabel : classifier->getPredictedClassLabel()); 
 }
 
 double GestureRecognitionPipeline::getMaximumLikelihood() const{ 
-    return (getIsClassifierSet() ? classifier->getMaximumLikelihood() : 0); 
+    if( !getIsClassifierSet() ) return 0;
+    return (getIsMultiRateModeEnabled() ? heldMaximumLikelihood : classifier->getMaximumLikelihood()); 
 }
     
 double GestureRecognitionPipeline::getCrossValidationAccuracy() const{ 
@@ -2359,12 +2471,12 @@ VectorDouble GestureRecognitionPipeline::getTestFMeasure() const{
 }
 
 VectorDouble GestureRecognitionPipeline::getClassLikelihoods() const{ 
-    if( getIsClassifierSet() ){ return classifier->getClassLikelihoods(); }
+    if( getIsClassifierSet() ){ return (getIsMultiRateModeEnabled() ? heldClassLikelihoods : classifier->getClassLikelihoods()); }
     else{ return VectorDouble(); } 
 }
 
 VectorDouble GestureRecognitionPipeline::getClassDistances() const{ 
-    if( getIsClassifierSet() ){ return classifier->getClassDistances(); }
+    if( getIsClassifierSet() ){ return (getIsMultiRateModeEnabled() ? heldClassDistances : classifier->getClassDistances()); }
     else{ return VectorDouble(); } 
 }
 
@@ -2658,6 +2770,39 @@ bool GestureRecognitionPipeline::setPostProcessingModule(const PostProcessing &p
 	return addPostProcessingModule( postProcessingModule );
 }
 
+bool GestureRecognitionPipeline::setClassificationInterval(UINT classificationInterval){
+    if( classificationInterval == 0 ){
+        errorMessage = "setClassificationInterval(UINT classificationInterval) - The classificationInterval must be greater than zero!";
+        errorLog << errorMessage << endl;
+        return false;
+    }
+    this->classificationInterval = classificationInterval;
+    numInputsSinceClassification = 0;
+    if( getIsMultiRateModeEnabled() ) holdClassifierOutput();
+    return true;
+}
+
+bool GestureRecognitionPipeline::setClassificationTimeInterval(double classificationTimeInterval){
+    if( classificationTimeInterval < 0 ){
+        errorMessage = "setClassificationTimeInterval(double classificationTimeInterval) - The classificationTimeInterval must not be negative!";
+        errorLog << errorMessage << endl;
+        return false;
+    }
+    this->classificationTimeInterval = classificationTimeInterval;
+    classificationTimer.stop();
+    if( getIsMultiRateModeEnabled() ) holdClassifierOutput();
+    return true;
+}
+
+bool GestureRecognitionPipeline::holdClassifierOutput(){
+    if( !getIsClassifierSet() ) return false;
+    heldPredictedClassLabel = classifier->getPredictedClassLabel();
+    heldMaximumLikelihood = classifier->getMaximumLikelihood();
+    heldClassLikelihoods = classifier->getClassLikelihoods();
+    heldClassDistances = classifier->getClassDistances();
+    return true;
+}
+
 bool GestureRecognitionPipeline::addContextModule(const Context &contextModule,UINT contextLevel,UINT insertIndex){
 	
 	//Validate the contextLevel is valid
@@ -40,6 +40,7 @@
 #include "../DataStructures/LabelledContinuousTimeSeriesClassificationData.h"
 #include "../Util/ClassificationResult.h"
 #include "../Util/TestResult.h"
+#include "../Util/Timer.h"
 
 namespace GRT{
     
@@ -186,10 +187,13 @@ public:
      This function is the main interface for all predictions using the gesture recognition pipeline.  You can use this function for both classification
      and regression.  You should only call this function if you  have trained the pipeline.  The input vector should be the same size as your training data.
 
-     @param VectorDouble inputVector: the input data that will be passed through the pipeline for classification or regression
+     The input is copied into a buffer owned by the pipeline, which the preprocessing modules then filter in place, so no
+     memory is allocated for the intermediate results once the pipeline has processed the first input vector.
+
+     @param const VectorDouble &inputVector: the input data that will be passed through the pipeline for classification or regression
      @return bool returns true if the prediction was successful, false otherwise
 	*/
-    bool predict(VectorDouble inputVector);
+    bool predict(const VectorDouble &inputVector);
     
     /**
      This function is an interface for predictions using timeseries or Matrix data.
@@ -411,6 +415,36 @@ public:
 	*/
     double getMaximumLikelihood() const;
 
+    /**
+	 This function returns the number of inputs between each classifier run in the multi-rate mode.
+	
+	@return UINT representing the classification interval
+	*/
+    UINT getClassificationInterval() const{ return classificationInterval; }
+
+    /**
+	 This function returns the minimum time (in milliseconds) between classifier runs in the multi-rate mode, zero means there is no time limit.
+	
+	@return double representing the classification time interval
+	*/
+    double getClassificationTimeInterval() const{ return classificationTimeInterval; }
+
+    /**
+	 This function returns true if the multi-rate mode is enabled, which is the case if the classification interval is greater than one
+	 or the classification time interval is greater than zero.
+	
+	@return bool returns true if the multi-rate mode is enabled, false otherwise
+	*/
+    bool getIsMultiRateModeEnabled() const{ return classificationInterval > 1 || classificationTimeInterval > 0; }
+
+    /**
+	 This function returns true if the classifier ran for the most recent input vector. In the multi-rate mode the output of the
+	 classifier is held between classifier runs, so this can be used to only act on new predictions.
+	
+	@return bool returns true if the classifier ran for the most recent input vector, false otherwise
+	*/
+    bool getClassifierUpdated() const{ return classifierUpdated; }
+
     /**
 	 This function returns the cross validation value from the most recent cross validation test.  If the pipeline is in prediction mode, then the cross
      validation accuracy will be the average accuracy across each fold of testing. If the pipeline is in regression mode, then the cross validation 
@@ -838,6 +872,36 @@ public:
      @return returns true if the post processing module was added successfully, false otherwise
      */
     bool setPostProcessingModule(const PostProcessing &postProcessingModule);
+
+    /**
+     Sets how often the classifier is run by the predict function, this is the multi-rate mode of the pipeline. The preprocessing,
+     feature extraction and START_OF_PIPELINE, AFTER_PREPROCESSING and AFTER_FEATURE_EXTRACTION context modules still process every
+     input, but the classifier only runs once every classificationInterval inputs. For the inputs in between, the pipeline holds the
+     outputs of the last classifier run (the unprocessed predicted class label, the maximum likelihood, the class likelihoods and
+     the class distances), and a timeseries classifier (such as DTW) only adds the input to its buffer. A post processing module that
+     counts the classifier outputs (such as the ClassLabelFilter) only processes the output of each classifier run, so it counts
+     classifier runs and its output is held in between. The event and time based post processing modules (the ClassLabelChangeFilter
+     and the ClassLabelTimeoutFilter) and the AFTER_CLASSIFIER and END_OF_PIPELINE context modules process every input, using the held
+     class label, so an event is only output once. The HMM has to run a full prediction to buffer an input, so it gets no speedup
+     from this mode.
+     
+     The default interval of 1 runs the classifier for every input. This only applies to the realtime classification of input vectors.
+     
+     @param UINT classificationInterval: the number of inputs between each classifier run, must be greater than zero
+     @return returns true if the classification interval was updated, false otherwise
+     */
+    bool setClassificationInterval(UINT classificationInterval);
+
+    /**
+     Sets the minimum time between classifier runs in the multi-rate mode of the pipeline. If this is greater than zero then the
+     classifier only runs once this many milliseconds have passed since it last ran (as well as classificationInterval inputs),
+     which keeps the cost of the classifier at a fixed rate regardless of the rate of the input. The time is measured by the Timer
+     class, which has a resolution of one millisecond. The default value of zero disables the time limit.
+     
+     @param double classificationTimeInterval: the minimum time between classifier runs in milliseconds, must not be negative
+     @return returns true if the classification time interval was updated, false otherwise
+     */
+    bool setClassificationTimeInterval(double classificationTimeInterval);
     
 	/**
 	 Adds a new context module to the pipeline.  The user can specify the position at which the new module should be inserted into the list of context modules.  
@@ -953,6 +1017,7 @@ public:
 protected:
 	bool predict_classifier(VectorDouble &inputVector);
 	bool predict_regressifier(VectorDouble &inputVector);
+    bool holdClassifierOutput();
     void deleteAllPreProcessingModules();
     void deleteAllFeatureExtractionModules();
     void deleteClassifier();
@@ -981,6 +1046,20 @@ protected:
     VectorDouble testPrecision;
     VectorDouble testRecall;
     VectorDouble regressionData;
+    VectorDouble pipelineInputVector;
+    vector< VectorDouble > preProcessingBuffers;   //The output buffer of each preprocessing module that changes the size of the data
+    VectorDouble predictionInputVector;         //The input given to the classifier or regressifier, which they can use as a working buffer
+    VectorDouble classLabelVector;              //The predicted class label given to the context and post processing modules
+    MatrixDouble segmentData;
+    UINT classificationInterval;                //The classifier runs once every classificationInterval inputs
+    double classificationTimeInterval;          //The minimum time between classifier runs (in milliseconds), zero means no limit
+    UINT numInputsSinceClassification;          //The number of inputs since the classifier last ran
+    UINT heldPredictedClassLabel;               //The predicted class label of the last classifier run, held until the next run in the multi-rate mode
+    double heldMaximumLikelihood;               //The maximum likelihood of the last classifier run, held until the next run in the multi-rate mode
+    VectorDouble heldClassLikelihoods;          //The class likelihoods of the last classifier run, held until the next run in the multi-rate mode
+    VectorDouble heldClassDistances;            //The class distances of the last classifier run, held until the next run in the multi-rate mode
+    bool classifierUpdated;                     //True if the classifier ran for the last input
+    Timer classificationTimer;                  //Measures the time since the classifier last ran
     double testRejectionPrecision;
     double testRejectionRecall;
     MatrixDouble testConfusionMatrix;
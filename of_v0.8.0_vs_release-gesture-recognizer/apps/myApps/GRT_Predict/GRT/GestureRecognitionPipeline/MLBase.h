@@ -124,12 +124,41 @@ public:
     virtual bool train(UnlabelledClassificationData &trainingData){ return false; }
 
     /**
-     This is the main prediction interface for all the GRT machine learning algorithms. This should be overwritten by the derived class.
+     This is the incremental training interface for LabelledClassificationSample. This should be overwritten by the derived class.
+     The model must already be trained, the new sample is then folded into the existing model without retraining it from scratch.
+
+     @param LabelledClassificationSample &sample: a reference to the new training sample
+     @return returns true if the model was updated with the new sample, false otherwise (the base class always returns false)
+     */
+    virtual bool update(LabelledClassificationSample &sample){ return false; }
+
+    /**
+     This is the incremental training interface for LabelledTimeSeriesClassificationSample. This should be overwritten by the derived class.
+     The model must already be trained, the new sample is then folded into the existing model without retraining it from scratch.
+
+     @param LabelledTimeSeriesClassificationSample &sample: a reference to the new training sample
+     @return returns true if the model was updated with the new sample, false otherwise (the base class always returns false)
+     */
+    virtual bool update(LabelledTimeSeriesClassificationSample &sample){ return false; }
+
+    /**
+     This is the main prediction interface for all the GRT machine learning algorithms. The base class copies the inputVector and
+     passes it to the predict_ function, so a derived class should overwrite predict_ rather than this function.
      
      @param VectorDouble inputVector: the new input vector for prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    virtual bool predict(VectorDouble inputVector){ return predict_( inputVector ); }
+    
+    /**
+     This is the prediction function that should be overwritten by the derived class. The inputVector is passed by reference, so
+     the derived class can use it as a working buffer (to scale it for example) without it being copied first. This is called
+     directly by the GestureRecognitionPipeline, with a buffer owned by the pipeline, so a prediction does not allocate any memory.
+     
+     @param VectorDouble &inputVector: the new input vector for prediction, this may be modified by the prediction
      @return returns true if the prediction was completed succesfully, false otherwise (the base class always returns false)
      */
-    virtual bool predict(VectorDouble inputVector){ return false; }
+    virtual bool predict_(VectorDouble &inputVector){ return false; }
     
     /**
      This is the prediction interface for time series data. This should be overwritten by the derived class.
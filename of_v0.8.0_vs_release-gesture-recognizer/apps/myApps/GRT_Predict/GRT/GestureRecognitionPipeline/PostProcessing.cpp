@@ -40,6 +40,7 @@ PostProcessing::PostProcessing(void){
     initialized = false; 
     numInputDimensions = 0;
     numOutputDimensions = 0;
+    processEveryInput = false;
     numPostProcessingInstances++;
 }
     
@@ -69,6 +70,7 @@ bool PostProcessing::copyBaseVariables(const PostProcessing *postProcessingModul
     this->numInputDimensions = postProcessingModule->numInputDimensions;
     this->numOutputDimensions = postProcessingModule->numOutputDimensions;
     this->processedData = postProcessingModule->processedData;
+    this->processEveryInput = postProcessingModule->processEveryInput;
     this->debugLog = postProcessingModule->debugLog;
     this->errorLog = postProcessingModule->errorLog;
     this->warningLog = postProcessingModule->warningLog;
@@ -119,9 +121,13 @@ bool PostProcessing::getIsPostProcessingOutputModeClassLikelihoods() const{
     return postProcessingOutputMode==OUTPUT_MODE_CLASS_LIKELIHOODS; 
 }
     
-vector< double > PostProcessing::getProcessedData() const{ 
+const vector< double >& PostProcessing::getProcessedData() const{ 
     return processedData; 
 }
 
+bool PostProcessing::getProcessEveryInput() const{
+    return processEveryInput;
+}
+
 } //End of namespace GRT
 
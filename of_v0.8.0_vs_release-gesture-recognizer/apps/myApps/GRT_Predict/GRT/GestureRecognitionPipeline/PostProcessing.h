@@ -57,7 +57,8 @@ public:
 	bool getIsPostProcessingInputModeClassLikelihoods() const;
 	bool getIsPostProcessingOutputModePredictedClassLabel() const;
 	bool getIsPostProcessingOutputModeClassLikelihoods() const;
-	vector< double > getProcessedData() const;
+	const vector< double >& getProcessedData() const;
+	bool getProcessEveryInput() const;
     
     //Setters
     
@@ -73,6 +74,7 @@ protected:
     UINT postProcessingInputMode;
     UINT postProcessingOutputMode;
     vector< double > processedData;
+    bool processEveryInput;             //If true the module processes every input in the multi-rate mode of the pipeline (for event and time based filters), otherwise it only processes the classifier outputs and its output is held in between
     
     enum PostprocessingInputModes{INPUT_MODE_NOT_SET=0,INPUT_MODE_PREDICTED_CLASS_LABEL,INPUT_MODE_CLASS_LIKELIHOODS};
     enum PostprocessingOutputModes{OUTPUT_MODE_NOT_SET=0,OUTPUT_MODE_PREDICTED_CLASS_LABEL,OUTPUT_MODE_CLASS_LIKELIHOODS};
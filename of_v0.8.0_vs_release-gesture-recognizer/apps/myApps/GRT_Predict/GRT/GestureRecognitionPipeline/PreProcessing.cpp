@@ -77,6 +77,30 @@ PreProcessing* PreProcessing::createNewInstance() const{
     return createInstanceFromString(preProcessingType);
 }
     
+bool PreProcessing::processBlock(const double *inputData,double *outputData,const UINT numSamples){
+    
+    if( inputData == NULL || outputData == NULL ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - The input and output buffers can not be NULL!" << endl;
+        return false;
+    }
+    
+    //The input sample is copied before it is processed, so the input and output buffers can be the same
+    if( blockInputVector.size() != numInputDimensions ) blockInputVector.resize( numInputDimensions );
+    for(UINT i=0; i<numSamples; i++){
+        for(UINT j=0; j<numInputDimensions; j++){
+            blockInputVector[j] = inputData[ i*numInputDimensions + j ];
+        }
+        if( !process( blockInputVector ) ){
+            return false;
+        }
+        for(UINT j=0; j<numOutputDimensions; j++){
+            outputData[ i*numOutputDimensions + j ] = processedData[j];
+        }
+    }
+    
+    return true;
+}
+    
 string PreProcessing::getPreProcessingType() const{ 
     return preProcessingType; 
 }
@@ -93,7 +117,7 @@ bool PreProcessing::getInitialized() const{
     return initialized; 
 }
     
-VectorDouble PreProcessing::getProcessedData() const{ 
+const VectorDouble& PreProcessing::getProcessedData() const{ 
     return processedData; 
 }
 
@@ -39,6 +39,19 @@ public:
 
     //Training methods
     virtual bool process(const VectorDouble &inputVector){ return false; }
+    
+    /**
+     Processes a block of samples, reading the input from and writing the output to buffers supplied by the caller. The samples
+     are stored one after the other, so the input is numSamples*numInputDimensions values and the output is numSamples*numOutputDimensions
+     values. After the block has been processed, the processedData holds the output of the last sample.
+     The default implementation calls process for each sample, modules that can filter directly on the buffers override this.
+     
+     @param const double *inputData: the input samples
+     @param double *outputData: returns the processed samples
+     @param const UINT numSamples: the number of samples in the block. Default value = 1
+     @return returns true if the samples were processed, false otherwise
+     */
+    virtual bool processBlock(const double *inputData,double *outputData,const UINT numSamples = 1);
     virtual bool reset(){ return true; }
     
     virtual bool saveSettingsToFile(string filename){ return false; }
@@ -51,7 +64,7 @@ public:
 	UINT getNumInputDimensions() const;
 	UINT getNumOutputDimensions() const;
 	bool getInitialized() const;
-	VectorDouble getProcessedData() const;
+	const VectorDouble& getProcessedData() const;
     
     //Setters
 
@@ -65,6 +78,7 @@ protected:
     UINT numInputDimensions;
     UINT numOutputDimensions;
     VectorDouble processedData;
+    VectorDouble blockInputVector;
 
 	static StringPreProcessingMap *getMap() {
         if( !stringPreProcessingMap ){ stringPreProcessingMap = new StringPreProcessingMap; } 
@@ -29,6 +29,7 @@ ClassLabelChangeFilter::ClassLabelChangeFilter(){
     postProcessingType = "ClassLabelChangeFilter";
     postProcessingInputMode = INPUT_MODE_PREDICTED_CLASS_LABEL;
     postProcessingOutputMode = OUTPUT_MODE_PREDICTED_CLASS_LABEL;
+    processEveryInput = true;
     debugLog.setProceedingText("[DEBUG ClassLabelChangeFilter]");
     errorLog.setProceedingText("[ERROR ClassLabelChangeFilter]");
     warningLog.setProceedingText("[WARNING ClassLabelChangeFilter]");
@@ -160,7 +160,8 @@ UINT ClassLabelFilter::filter(UINT predictedClassLabel){
     buffer.push_back( predictedClassLabel );
     
     //Count the class values in the buffer, automatically start with the first value in the buffer
-    vector< ClassTracker > classTracker( 1, ClassTracker( buffer[0], 1 ) );
+    classTracker.clear();
+    classTracker.push_back( ClassTracker( buffer[0], 1 ) );
     
     UINT maxCount = classTracker[0].counter;
     UINT maxClass = classTracker[0].classLabel;
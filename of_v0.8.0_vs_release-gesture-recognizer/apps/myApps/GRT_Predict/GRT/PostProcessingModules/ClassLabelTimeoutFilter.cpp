@@ -29,6 +29,7 @@ ClassLabelTimeoutFilter::ClassLabelTimeoutFilter(double timeoutDuration,UINT fil
     postProcessingType = "ClassLabelTimeoutFilter";
     postProcessingInputMode = INPUT_MODE_PREDICTED_CLASS_LABEL;
     postProcessingOutputMode = OUTPUT_MODE_PREDICTED_CLASS_LABEL;
+    processEveryInput = true;
     debugLog.setProceedingText("[DEBUG ClassLabelTimeoutFilter]");
     errorLog.setProceedingText("[ERROR ClassLabelTimeoutFilter]");
     warningLog.setProceedingText("[WARNING ClassLabelTimeoutFilter]");
@@ -86,7 +86,7 @@ bool DeadZone::process(const vector< double > &inputVector){
     }
 #endif
     
-    filter( inputVector );
+    if( !processBlock( &inputVector[0], &processedData[0], 1 ) ) return false;
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -248,15 +248,41 @@ vector< double > DeadZone::filter(const vector< double > &x){
     }
 #endif
     
-    for(UINT n=0; n<numInputDimensions; n++){
-        if( x[n] > lowerLimit && x[n] < upperLimit ){
-            processedData[n] = 0;
+    if( !processBlock( &x[0], &processedData[0], 1 ) ) return vector<double>();
+    
+    return processedData;
+}
+    
+bool DeadZone::processBlock(const double *inputData,double *outputData,const UINT numSamples){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( inputData == NULL || outputData == NULL ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - The input and output buffers can not be NULL!" << endl;
+        return false;
+    }
+    
+    const UINT numValues = numSamples * numInputDimensions;
+    for(UINT n=0; n<numValues; n++){
+        const double x = inputData[n];
+        if( x > lowerLimit && x < upperLimit ){
+            outputData[n] = 0;
         }else{
-            if( x[n] >= upperLimit ) processedData[n] = x[n] - upperLimit;
-            else processedData[n] = x[n] - lowerLimit;
+            if( x >= upperLimit ) outputData[n] = x - upperLimit;
+            else outputData[n] = x - lowerLimit;
         }
     }
-    return processedData;
+    
+    //Keep the output of the last sample as the processed data
+    if( numSamples > 0 && outputData != &processedData[0] ){
+        const double *y = outputData + (numSamples-1)*numOutputDimensions;
+        for(UINT j=0; j<numOutputDimensions; j++) processedData[j] = y[j];
+    }
+    
+    return true;
 }
 
 bool DeadZone::setLowerLimit(double lowerLimit){ 
@@ -85,6 +85,17 @@ public:
      */
     virtual bool process(const vector< double > &inputVector);
     
+    /**
+     Sets the PreProcessing processBlock function, overwriting the base PreProcessing function.
+     Applies the dead zone to a block of samples directly from the input buffer into the output buffer, without any temporary vectors.
+     
+     @param const double *inputData: the input samples, numSamples*numInputDimensions values
+     @param double *outputData: returns the processed samples, numSamples*numOutputDimensions values (this can be the input buffer)
+     @param const UINT numSamples: the number of samples in the block
+     @return true if the data was processed, false otherwise
+     */
+    virtual bool processBlock(const double *inputData,double *outputData,const UINT numSamples = 1);
+    
     /**
      Sets the PreProcessing reset function, overwriting the base PreProcessing function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
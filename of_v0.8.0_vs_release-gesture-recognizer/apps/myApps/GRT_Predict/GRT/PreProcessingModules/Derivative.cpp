@@ -103,7 +103,7 @@ bool Derivative::process(const vector< double > &inputVector){
     }
 #endif
     
-    computeDerivative( inputVector );
+    if( !processBlock( &inputVector[0], &processedData[0], 1 ) ) return false;
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -311,25 +311,59 @@ vector< double > Derivative::computeDerivative(vector< double > x){
     }
 #endif
     
-    if( filterData ){
-        x = filter.filter( x );
+    if( !processBlock( &x[0], &processedData[0], 1 ) ) return vector<double>();
+    
+    return processedData;
+}
+    
+bool Derivative::processBlock(const double *inputData,double *outputData,const UINT numSamples){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - Not initialized!" << endl;
+        return false;
     }
     
-    for(UINT n=0; n<numInputDimensions; n++){
-        processedData[n] = (x[n]-yy[n])/delta;
-        yy[n] = x[n];
+    if( inputData == NULL || outputData == NULL ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - The input and output buffers can not be NULL!" << endl;
+        return false;
     }
     
-    if( derivativeOrder == SECOND_DERIVATIVE ){
-        double tmp = 0;
+    for(UINT i=0; i<numSamples; i++){
+        const double *x = inputData + i*numInputDimensions;
+        double *y = outputData + i*numOutputDimensions;
+        
+        //The filtered input is written to the output buffer, the derivative is then computed in place
+        if( filterData ){
+            if( !filter.processBlock( x, y, 1 ) ){
+                errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - Failed to filter data!" << endl;
+                return false;
+            }
+            x = y;
+        }
+        
         for(UINT n=0; n<numInputDimensions; n++){
-            tmp = processedData[n];
-            processedData[n] = (processedData[n]-yyy[n])/delta;
-            yyy[n] = tmp;
+            const double value = x[n];
+            y[n] = (value-yy[n])/delta;
+            yy[n] = value;
+        }
+        
+        if( derivativeOrder == SECOND_DERIVATIVE ){
+            double tmp = 0;
+            for(UINT n=0; n<numInputDimensions; n++){
+                tmp = y[n];
+                y[n] = (y[n]-yyy[n])/delta;
+                yyy[n] = tmp;
+            }
         }
     }
     
-    return processedData;
+    //Keep the output of the last sample as the processed data
+    if( numSamples > 0 && outputData != &processedData[0] ){
+        const double *y = outputData + (numSamples-1)*numOutputDimensions;
+        for(UINT j=0; j<numOutputDimensions; j++) processedData[j] = y[j];
+    }
+    
+    return true;
 }
     
 bool Derivative::setDerivativeOrder(UINT derivativeOrder){
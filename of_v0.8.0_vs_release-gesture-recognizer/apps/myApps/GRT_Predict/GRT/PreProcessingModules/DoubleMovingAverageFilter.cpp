@@ -46,6 +46,7 @@ DoubleMovingAverageFilter::DoubleMovingAverageFilter(const DoubleMovingAverageFi
     this->filterSize = rhs.filterSize;
     this->filter1 = rhs.filter1;
     this->filter2 = rhs.filter2;
+    this->filter1Output = rhs.filter1Output;
     
     //Copy the base variables
     copyBaseVariables( (PreProcessing*)&rhs );
@@ -60,6 +61,7 @@ DoubleMovingAverageFilter& DoubleMovingAverageFilter::operator=(const DoubleMovi
         this->filterSize = rhs.filterSize;
         this->filter1 = rhs.filter1;
         this->filter2 = rhs.filter2;
+        this->filter1Output = rhs.filter1Output;
         
         //Copy the base variables
         copyBaseVariables( (PreProcessing*)&rhs );
@@ -78,6 +80,7 @@ bool DoubleMovingAverageFilter::clone(const PreProcessing *preProcessing){
         this->filterSize = ptr->filterSize;
         this->filter1 = ptr->filter1;
         this->filter2 = ptr->filter2;
+        this->filter1Output = ptr->filter1Output;
         
         //Clone the preprocessing base variables
         return copyBaseVariables( preProcessing );
@@ -103,7 +106,7 @@ bool DoubleMovingAverageFilter::process(const vector< double > &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    updateFilter( inputVector );
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -232,6 +235,8 @@ bool DoubleMovingAverageFilter::init(UINT filterSize,UINT numDimensions){
     numOutputDimensions = numDimensions;
     processedData.clear();
     processedData.resize(numDimensions,0 );
+    filter1Output.clear();
+    filter1Output.resize(numDimensions,0);
     
     if( !filter1.init(filterSize, numDimensions) ){
         errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to initialize filter 1!" << endl;
@@ -239,7 +244,7 @@ bool DoubleMovingAverageFilter::init(UINT filterSize,UINT numDimensions){
     }
     
     if( !filter2.init(filterSize, numDimensions) ){
-        errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to initialize filter 1!" << endl;
+        errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to initialize filter 2!" << endl;
         return false;
     }
     
@@ -280,23 +285,30 @@ vector< double > DoubleMovingAverageFilter::filter(const vector< double > &x){
     }
 #endif
     
-    //Perform the first filter
-    vector< double > y = filter1.filter( x );
+    updateFilter( x );
     
-    if( y.size() == 0 ) return y;
+    return processedData;
+}
     
-    //Perform the second filter
-    vector< double > yy = filter2.filter( y );
+void DoubleMovingAverageFilter::updateFilter(const VectorDouble &x){
     
-    if( yy.size() == 0 ) return y;
+    //Perform the first filter, until the buffer is full the average is taken over the values that have been added so far
+    filter1.push_back( x );
+    const double numValues1 = filter1.getNumValuesInWindow();
+    for(UINT i=0; i<numInputDimensions; i++){
+        filter1Output[i] = filter1.getSum(i) / numValues1;
+    }
+    
+    //Perform the second filter on the output of the first filter
+    filter2.push_back( filter1Output );
+    const double numValues2 = filter2.getNumValuesInWindow();
     
     //Account for the filter lag
-    for(UINT i=0; i<y.size(); i++){
-        yy[i] = y[i] + (y[i] - yy[i]); 
-        processedData[i] = yy[i];
+    for(UINT i=0; i<numInputDimensions; i++){
+        const double y = filter1Output[i];
+        const double yy = filter2.getSum(i) / numValues2;
+        processedData[i] = y + (y - yy);
     }
-    
-    return yy;
 }
 
 }//End of namespace GRT
\ No newline at end of file
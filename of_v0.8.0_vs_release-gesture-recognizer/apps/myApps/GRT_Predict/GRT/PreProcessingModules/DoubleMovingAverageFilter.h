@@ -164,9 +164,12 @@ public:
     vector< double > getFilteredData(){ return processedData; }    
     
 protected:
+    void updateFilter(const VectorDouble &x);
+    
     UINT filterSize;                    ///< The size of the filter
-    MovingAverageFilter filter1;        ///< The first moving average filter
-    MovingAverageFilter filter2;        ///< The second moving average filter
+    SlidingWindowStatistics filter1;    ///< The buffer (and running sums) of the first moving average filter
+    SlidingWindowStatistics filter2;    ///< The buffer (and running sums) of the second moving average filter
+    VectorDouble filter1Output;         ///< The output of the first moving average filter
     
     static RegisterPreProcessingModule< DoubleMovingAverageFilter > registerModule;
     
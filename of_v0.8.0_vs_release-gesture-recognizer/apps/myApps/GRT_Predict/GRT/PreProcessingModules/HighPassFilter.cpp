@@ -40,8 +40,7 @@ HighPassFilter::HighPassFilter(double filterFactor,double gain,UINT numDimension
 HighPassFilter::HighPassFilter(const HighPassFilter &rhs){
     this->filterFactor = rhs.filterFactor;
     this->gain = rhs.gain;
-	this->xx = rhs.xx;
-    this->yy = rhs.yy;
+    this->filterBank = rhs.filterBank;
     copyBaseVariables( (PreProcessing*)&rhs );
 }
 
@@ -53,8 +52,7 @@ HighPassFilter& HighPassFilter::operator=(const HighPassFilter &rhs){
     if(this!=&rhs){
         this->filterFactor = rhs.filterFactor;
         this->gain = rhs.gain;
-        this->xx = rhs.xx;
-        this->yy = rhs.yy;
+        this->filterBank = rhs.filterBank;
         copyBaseVariables( (PreProcessing*)&rhs );
     }
     return *this;
@@ -70,8 +68,7 @@ bool HighPassFilter::clone(const PreProcessing *preProcessing){
         //Clone the HighPassFilter values 
         this->filterFactor = ptr->filterFactor;
         this->gain = ptr->gain;
-        this->xx = ptr->xx;
-        this->yy = ptr->yy;
+        this->filterBank = ptr->filterBank;
         
         //Clone the base class variables
         return copyBaseVariables( preProcessing );
@@ -96,7 +93,7 @@ bool HighPassFilter::process(const vector< double > &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    if( !processBlock( &inputVector[0], &processedData[0], 1 ) ) return false;
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -239,10 +236,14 @@ bool HighPassFilter::init(double filterFactor,double gain,UINT numDimensions){
     this->gain = gain;
     this->numInputDimensions = numDimensions;
     this->numOutputDimensions = numDimensions;
-    xx.clear();
-    xx.resize(numDimensions,0);
-    yy.clear();
-    yy.resize(numDimensions,0);
+    
+    VectorDouble b,a;
+    getFilterCoefficients(b,a);
+    if( !filterBank.init(b,a,numDimensions) ){
+        errorLog << "init(double filterFactor,double gain,UINT numDimensions) - Failed to initialize filter bank!" << endl;
+        return false;
+    }
+    
     processedData.clear();
     processedData.resize(numDimensions,0);
     initialized = true;
@@ -281,22 +282,40 @@ vector< double > HighPassFilter::filter(const vector< double > &x){
     }
 #endif
     
-    for(UINT n=0; n<numInputDimensions; n++){
-        //Compute the new output
-        processedData[n] = filterFactor * (yy[n] + x[n] - xx[n]) * gain;
-        
-        //Store the current input
-        xx[n] = x[n];
-        
-        //Store the current output
-        yy[n] = processedData[n];
-    }
+    if( !processBlock( &x[0], &processedData[0], 1 ) ) return vector<double>();
+    
     return processedData;
 }
     
+bool HighPassFilter::processBlock(const double *inputData,double *outputData,const UINT numSamples){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( !filterBank.filter( inputData, outputData, numSamples ) ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - Failed to filter data!" << endl;
+        return false;
+    }
+    
+    //Keep the output of the last sample as the processed data
+    if( numSamples > 0 && outputData != &processedData[0] ){
+        const double *y = outputData + (numSamples-1)*numOutputDimensions;
+        for(UINT j=0; j<numOutputDimensions; j++) processedData[j] = y[j];
+    }
+    
+    return true;
+}
+    
 bool HighPassFilter::setGain(double gain){
     if( gain > 0 ){
         this->gain = gain;
+        if( initialized ){
+            VectorDouble b,a;
+            getFilterCoefficients(b,a);
+            filterBank.setCoefficients(b,a);
+        }
         return true;
     }
     errorLog << "setGain(double gain) - Gain value must be greater than 0!" << endl;
@@ -306,6 +325,11 @@ bool HighPassFilter::setGain(double gain){
 bool HighPassFilter::setFilterFactor(double filterFactor){
     if( filterFactor > 0 ){
         this->filterFactor = filterFactor;
+        if( initialized ){
+            VectorDouble b,a;
+            getFilterCoefficients(b,a);
+            filterBank.setCoefficients(b,a);
+        }
         return true;
     }
     errorLog << "setFilterFactor(double filterFactor) - FilterFactor value must be greater than 0!" << endl;
@@ -316,9 +340,25 @@ bool HighPassFilter::setCutoffFrequency(double cutoffFrequency,double delta){
     if( cutoffFrequency > 0 && delta > 0 ){
         double RC = (1.0/TWO_PI) / cutoffFrequency;
         filterFactor = RC / (RC+delta);
+        if( initialized ){
+            VectorDouble b,a;
+            getFilterCoefficients(b,a);
+            filterBank.setCoefficients(b,a);
+        }
         return true;
     }
     return false;
 }
 
+void HighPassFilter::getFilterCoefficients(VectorDouble &b,VectorDouble &a) const{
+    //y[n] = filterFactor * gain * ( y[n-1] + x[n] - x[n-1] )
+    const double k = filterFactor * gain;
+    b.resize(2);
+    b[0] = k;
+    b[1] = -k;
+    a.resize(2);
+    a[0] = 1;
+    a[1] = -k;
+}
+
 }//End of namespace GRT
\ No newline at end of file
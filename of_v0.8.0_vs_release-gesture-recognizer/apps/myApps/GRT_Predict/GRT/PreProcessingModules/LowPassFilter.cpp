@@ -53,7 +53,7 @@ LowPassFilter& LowPassFilter::operator=(const LowPassFilter &rhs){
 	if(this!=&rhs){
         this->filterFactor = rhs.filterFactor;
         this->gain = rhs.gain;
-		this->yy = rhs.yy;
+        this->filterBank = rhs.filterBank;
         copyBaseVariables( (PreProcessing*)&rhs );
 	}
 	return *this;
@@ -88,7 +88,7 @@ bool LowPassFilter::process(const vector< double > &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    if( !processBlock( &inputVector[0], &processedData[0], 1 ) ) return false;
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -231,8 +231,16 @@ bool LowPassFilter::init(double filterFactor,double gain,UINT numDimensions){
     this->gain = gain;
     this->numInputDimensions = numDimensions;
     this->numOutputDimensions = numDimensions;
-    yy.clear();
-    yy.resize(numDimensions,0);
+    
+    //y[n] = filterFactor * x[n] + (1-filterFactor) * gain * y[n-1]
+    VectorDouble b(1,filterFactor);
+    VectorDouble a(2,1);
+    a[1] = -(1.0 - filterFactor) * gain;
+    if( !filterBank.init(b,a,numDimensions) ){
+        errorLog << "init(double filterFactor,double gain,UINT numDimensions) - Failed to initialize filter bank!" << endl;
+        return false;
+    }
+    
     processedData.clear();
     processedData.resize(numDimensions,0);
     initialized = true;
@@ -271,13 +279,32 @@ vector< double > LowPassFilter::filter(const VectorDouble &x){
     }
 #endif
     
-    for(UINT n=0; n<numInputDimensions; n++){
-        processedData[n] = (x[n] * filterFactor) + (yy[n] * (1.0 - filterFactor)) * gain;
-        yy[n] = processedData[n];
-    }
+    if( !processBlock( &x[0], &processedData[0], 1 ) ) return vector<double>();
+    
     return processedData;
 }
     
+bool LowPassFilter::processBlock(const double *inputData,double *outputData,const UINT numSamples){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( !filterBank.filter( inputData, outputData, numSamples ) ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - Failed to filter data!" << endl;
+        return false;
+    }
+    
+    //Keep the output of the last sample as the processed data
+    if( numSamples > 0 && outputData != &processedData[0] ){
+        const double *y = outputData + (numSamples-1)*numOutputDimensions;
+        for(UINT j=0; j<numOutputDimensions; j++) processedData[j] = y[j];
+    }
+    
+    return true;
+}
+    
 bool LowPassFilter::setGain(double gain){
     if( gain > 0 ){
         this->gain = gain;
@@ -82,6 +82,18 @@ public:
      */
     virtual bool process(const vector< double > &inputVector);
     
+    /**
+     Sets the PreProcessing processBlock function, overwriting the base PreProcessing function.
+     Filters a block of samples directly from the input buffer into the output buffer, all the dimensions of each sample are
+     filtered together by the filter bank.
+     
+     @param const double *inputData: the input samples, numSamples*numInputDimensions values
+     @param double *outputData: returns the filtered samples, numSamples*numOutputDimensions values (this can be the input buffer)
+     @param const UINT numSamples: the number of samples in the block
+     @return true if the data was processed, false otherwise
+     */
+    virtual bool processBlock(const double *inputData,double *outputData,const UINT numSamples = 1);
+    
     /**
      Sets the PreProcessing reset function, overwriting the base PreProcessing function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
@@ -202,12 +214,12 @@ public:
      
 	 @return the filtered values.  An empty vector will be returned if the values were not filtered
      */
-    vector< double > getFilteredValues(){ if( initialized ){ return yy; } return vector< double >(); }
+    vector< double > getFilteredValues(){ if( initialized ){ return processedData; } return vector< double >(); }
 
 protected:
     double filterFactor;                ///< The filter factor (alpha) of the filter
     double gain;                        ///< The gain factor of the filter
-	vector< double > yy;                ///< The previous output value(s)
+    FilterBank filterBank;              ///< The filter bank that holds the previous output value(s)
     
     static RegisterPreProcessingModule< LowPassFilter > registerModule;
 };
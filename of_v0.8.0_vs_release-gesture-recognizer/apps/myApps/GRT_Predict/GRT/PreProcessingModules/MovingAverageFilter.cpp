@@ -41,7 +41,6 @@ MovingAverageFilter::MovingAverageFilter(const MovingAverageFilter &rhs){
     
     //Zero this instance
     this->filterSize = 0;
-    this->inputSampleCounter = 0;
     
 	//Copy the settings from the rhs instance
 	*this = rhs;
@@ -55,8 +54,6 @@ MovingAverageFilter& MovingAverageFilter::operator=(const MovingAverageFilter &r
     if(this!=&rhs){
         //Clear this instance
         this->filterSize = 0;
-        this->inputSampleCounter = 0;
-        this->dataBuffer.clear();
         
         //Copy from the rhs instance
         if( rhs.initialized ){
@@ -100,7 +97,7 @@ bool MovingAverageFilter::process(const VectorDouble &inputVector){
     }
 #endif
     
-    filter( inputVector );
+    if( !processBlock( &inputVector[0], &processedData[0], 1 ) ) return false;
     
     if( processedData.size() == numOutputDimensions ) return true;
 
@@ -213,7 +210,6 @@ bool MovingAverageFilter::init(UINT filterSize,UINT numDimensions){
     
     //Cleanup the old memory
     initialized = false;
-    inputSampleCounter = 0;
     
     if( filterSize == 0 ){
         errorLog << "init(UINT filterSize,UINT numDimensions) - Filter size can not be zero!" << endl;
@@ -231,7 +227,7 @@ bool MovingAverageFilter::init(UINT filterSize,UINT numDimensions){
     this->numOutputDimensions = numDimensions;
     processedData.clear();
     processedData.resize(numDimensions,0);
-    initialized = dataBuffer.resize( filterSize, VectorDouble(numInputDimensions,0) );
+    initialized = dataBuffer.init( filterSize, numInputDimensions );
     
     if( !initialized ){
         errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to resize dataBuffer!" << endl;
@@ -271,20 +267,44 @@ VectorDouble MovingAverageFilter::filter(const VectorDouble &x){
     }
 #endif
     
-    if( ++inputSampleCounter > filterSize ) inputSampleCounter = filterSize;
+    if( !processBlock( &x[0], &processedData[0], 1 ) ) return vector<double>();
     
-    //Add the new value to the buffer
-    dataBuffer.push_back( x );
+    return processedData;
+}
+    
+bool MovingAverageFilter::processBlock(const double *inputData,double *outputData,const UINT numSamples){
+    
+    if( !initialized ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - The filter has not been initialized!" << endl;
+        return false;
+    }
+    
+    if( inputData == NULL || outputData == NULL ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - The input and output buffers can not be NULL!" << endl;
+        return false;
+    }
     
-    for(unsigned int j=0; j<numInputDimensions; j++){
-        processedData[j] = 0;
-        for(unsigned int i=0; i<inputSampleCounter; i++) {
-            processedData[j] += dataBuffer[i][j];
+    for(UINT i=0; i<numSamples; i++){
+        const double *x = inputData + i*numInputDimensions;
+        double *y = outputData + i*numOutputDimensions;
+        
+        //Add the new value to the buffer, this also updates the running sum of each dimension
+        dataBuffer.push_back( x );
+        
+        //Until the buffer is full, the average is taken over the values that have been added so far
+        const double numValues = dataBuffer.getNumValuesInWindow();
+        for(UINT j=0; j<numInputDimensions; j++){
+            y[j] = dataBuffer.getSum(j) / numValues;
         }
-        processedData[j] /= double(inputSampleCounter);
     }
     
-    return processedData;
+    //Keep the output of the last sample as the processed data
+    if( numSamples > 0 && outputData != &processedData[0] ){
+        const double *y = outputData + (numSamples-1)*numOutputDimensions;
+        for(UINT j=0; j<numOutputDimensions; j++) processedData[j] = y[j];
+    }
+    
+    return true;
 }
 
 }//End of namespace GRT
@@ -83,6 +83,17 @@ public:
      */
     virtual bool process(const VectorDouble &inputVector);
     
+    /**
+     Sets the PreProcessing processBlock function, overwriting the base PreProcessing function.
+     Filters a block of samples directly from the input buffer into the output buffer, without any temporary vectors.
+     
+     @param const double *inputData: the input samples, numSamples*numInputDimensions values
+     @param double *outputData: returns the filtered samples, numSamples*numOutputDimensions values
+     @param const UINT numSamples: the number of samples in the block
+     @return true if the data was processed, false otherwise
+     */
+    virtual bool processBlock(const double *inputData,double *outputData,const UINT numSamples = 1);
+    
     /**
      Sets the PreProcessing reset function, overwriting the base PreProcessing function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
@@ -169,8 +180,7 @@ public:
     
 protected:
     UINT filterSize;                                        ///< The size of the filter
-    UINT inputSampleCounter;                                ///< A counter to keep track of the number of input samples
-    CircularBuffer< VectorDouble > dataBuffer;          	///< A buffer to store the previous N values, N = filterSize
+    SlidingWindowStatistics dataBuffer;                     ///< A buffer to store the previous N values (and their running sums), N = filterSize
     
     static RegisterPreProcessingModule< MovingAverageFilter > registerModule;
 };
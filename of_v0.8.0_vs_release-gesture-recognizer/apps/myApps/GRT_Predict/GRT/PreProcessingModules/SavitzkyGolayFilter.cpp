@@ -39,7 +39,7 @@ SavitzkyGolayFilter::SavitzkyGolayFilter(const SavitzkyGolayFilter &rhs){
     this->numRightHandPoints = rhs.numRightHandPoints;
     this->derivativeOrder = rhs.derivativeOrder;
     this->smoothingPolynomialOrder = rhs.smoothingPolynomialOrder;
-    this->data = rhs.data;
+    this->filterBank = rhs.filterBank;
     this->yy = rhs.yy;
     this->coeff = rhs.coeff;
     copyBaseVariables( (PreProcessing*)&rhs );
@@ -56,7 +56,7 @@ SavitzkyGolayFilter& SavitzkyGolayFilter::operator=(const SavitzkyGolayFilter &r
         this->numRightHandPoints = rhs.numRightHandPoints;
         this->derivativeOrder = rhs.derivativeOrder;
         this->smoothingPolynomialOrder = rhs.smoothingPolynomialOrder;
-        this->data = rhs.data;
+        this->filterBank = rhs.filterBank;
         this->yy = rhs.yy;
         this->coeff = rhs.coeff;
         copyBaseVariables( (PreProcessing*)&rhs );
@@ -77,7 +77,7 @@ bool SavitzkyGolayFilter::clone(const PreProcessing *preProcessing){
         this->numRightHandPoints = ptr->numRightHandPoints;
         this->derivativeOrder = ptr->derivativeOrder;
         this->smoothingPolynomialOrder = ptr->smoothingPolynomialOrder;
-        this->data = ptr->data;
+        this->filterBank = ptr->filterBank;
         this->yy = ptr->yy;
         this->coeff = ptr->coeff;
         
@@ -104,7 +104,7 @@ bool SavitzkyGolayFilter::process(const vector< double > &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    if( !processBlock( &inputVector[0], &processedData[0], 1 ) ) return false;
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -113,7 +113,7 @@ bool SavitzkyGolayFilter::process(const vector< double > &inputVector){
 
 bool SavitzkyGolayFilter::reset(){
     if( initialized ){
-        data.setAllValues(vector<double>(numInputDimensions,0));
+        filterBank.reset();
         yy.clear();
         yy.resize(numInputDimensions,0);
         processedData.clear();
@@ -280,13 +280,21 @@ bool SavitzkyGolayFilter::init(UINT numLeftHandPoints,UINT numRightHandPoints,UI
     yy.resize(numDimensions,0);
     processedData.clear();
     processedData.resize(numDimensions,0);
-    data.resize(numPoints,vector<double>(numDimensions,0));
-    
     if( !calCoeff() ){
         errorLog << "init(UINT NL,UINT NR,UINT LD,UINT M,UINT numDimensions) - Failed to compute filter coefficents!" << endl;
         return false;
     }
     
+    //The last coefficient is applied to the newest input, so the coefficients are reversed for the filter bank
+    VectorDouble b(numPoints);
+    for(UINT i=0; i<numPoints; i++){
+        b[i] = coeff[ numPoints-1-i ];
+    }
+    if( !filterBank.init(b,VectorDouble(),numDimensions) ){
+        errorLog << "init(UINT NL,UINT NR,UINT LD,UINT M,UINT numDimensions) - Failed to initialize filter bank!" << endl;
+        return false;
+    }
+    
     initialized = true;
     
     return true;
@@ -313,17 +321,30 @@ vector< double > SavitzkyGolayFilter::filter(const vector< double > &x){
     }
 #endif
     
-    //Add the new input data to the data buffer
-    data.push_back( x );
+    if( !processBlock( &x[0], &processedData[0], 1 ) ) return vector<double>();
+    
+    return processedData;
+}
+    
+bool SavitzkyGolayFilter::processBlock(const double *inputData,double *outputData,const UINT numSamples){
     
-    //Filter the data
-    for(UINT j=0; j<x.size(); j++){
-        processedData[j] = 0;
-        for(UINT i=0; i<numPoints; i++) 
-            processedData[j] += data[i][j] * coeff[i];
+    if( !initialized ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - Not initialized!" << endl;
+        return false;
     }
     
-    return processedData;
+    if( !filterBank.filter( inputData, outputData, numSamples ) ){
+        errorLog << "processBlock(const double *inputData,double *outputData,const UINT numSamples) - Failed to filter data!" << endl;
+        return false;
+    }
+    
+    //Keep the output of the last sample as the processed data
+    if( numSamples > 0 && outputData != &processedData[0] ){
+        const double *y = outputData + (numSamples-1)*numOutputDimensions;
+        for(UINT j=0; j<numOutputDimensions; j++) processedData[j] = y[j];
+    }
+    
+    return true;
 }
     
 bool SavitzkyGolayFilter::calCoeff(){
@@ -81,6 +81,18 @@ public:
      */
     virtual bool process(const vector< double > &inputVector);
     
+    /**
+     Sets the PreProcessing processBlock function, overwriting the base PreProcessing function.
+     Filters a block of samples directly from the input buffer into the output buffer, all the dimensions of each sample are
+     filtered together by the filter bank.
+     
+     @param const double *inputData: the input samples, numSamples*numInputDimensions values
+     @param double *outputData: returns the filtered samples, numSamples*numOutputDimensions values (this can be the input buffer)
+     @param const UINT numSamples: the number of samples in the block
+     @return true if the data was processed, false otherwise
+     */
+    virtual bool processBlock(const double *inputData,double *outputData,const UINT numSamples = 1);
+    
     /**
      Sets the PreProcessing reset function, overwriting the base PreProcessing function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
@@ -167,7 +179,7 @@ protected:
 	UINT numRightHandPoints;                     //Num of rightward (future) points to use
 	UINT derivativeOrder;                        //Order of the derivative desired
 	UINT smoothingPolynomialOrder;               //Order of smoothing polynomial
-    CircularBuffer< vector< double > > data;    //A buffer to hold the input data
+    FilterBank filterBank;                      //The filter bank that holds the previous input data
     vector < double > yy;                       //The filtered values
     vector < double > coeff;                    //Buffer for the filter coefficients
     
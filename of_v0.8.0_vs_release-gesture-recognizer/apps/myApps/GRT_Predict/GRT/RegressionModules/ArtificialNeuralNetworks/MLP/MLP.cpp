@@ -22,6 +22,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace GRT{
     
+//The minimum number of multiply-adds in a batch before the batch is split across several threads
+#define MLP_MIN_PARALLEL_BATCH_WORK 262144
+    
 //Register the MLP module with the Regressifier base class
 RegisterRegressifierModule< MLP > MLP::registerModule("MLP");
 
@@ -43,6 +46,7 @@ MLP::MLP(){
 	useValidationSet = true;
 	randomiseTrainingOrder = false;
     useMultiThreadingTraining = false;
+    batchSize = 1;
 	useScaling = true;
 	trained = false;
     initialized = false;
@@ -81,10 +85,24 @@ MLP& MLP::operator=(const MLP &rhs){
         this->useValidationSet = rhs.useValidationSet;
         this->randomiseTrainingOrder = rhs.randomiseTrainingOrder;
         this->useMultiThreadingTraining = rhs.useMultiThreadingTraining;
+        this->batchSize = rhs.batchSize;
         this->initialized = rhs.initialized;
         this->inputLayer = rhs.inputLayer;
         this->hiddenLayer = rhs.hiddenLayer;
         this->outputLayer = rhs.outputLayer;
+        this->inputWeights = rhs.inputWeights;
+        this->inputBias = rhs.inputBias;
+        this->hiddenWeights = rhs.hiddenWeights;
+        this->hiddenBias = rhs.hiddenBias;
+        this->outputWeights = rhs.outputWeights;
+        this->outputBias = rhs.outputBias;
+        this->hiddenWeightsUpdate = rhs.hiddenWeightsUpdate;
+        this->hiddenBiasUpdate = rhs.hiddenBiasUpdate;
+        this->outputWeightsUpdate = rhs.outputWeightsUpdate;
+        this->outputBiasUpdate = rhs.outputBiasUpdate;
+        this->inputLayerGamma = rhs.inputLayerGamma;
+        this->hiddenLayerGamma = rhs.hiddenLayerGamma;
+        this->outputLayerGamma = rhs.outputLayerGamma;
         this->inputVectorRanges = rhs.inputVectorRanges;
         this->targetVectorRanges = rhs.targetVectorRanges;
         this->trainingErrorLog = rhs.trainingErrorLog;
@@ -153,7 +171,7 @@ bool MLP::train(LabelledClassificationData &trainingData){
 }
     
 //Classifier interface
-bool MLP::predict(VectorDouble inputVector){
+bool MLP::predict_(VectorDouble &inputVector){
     
     if( !trained ){
         errorMessage = "predict(VectorDouble inputVector) - Model not trained!";
@@ -167,10 +185,14 @@ bool MLP::predict(VectorDouble inputVector){
         return false;
     }
     
-    //Set the mapped data as the classLikelihoods
-    regressionData = feedforward(inputVector);
+    //Run the network, this reuses the regressionData and prediction buffers so nothing is allocated once they have been sized
+    regressionData.resize( numOutputNeurons );
+    feedforward(&inputVector[0],&regressionData[0]);
     
     if( classificationModeActive ){
+        //Set the mapped data as the classLikelihoods
+        classLikelihoods = regressionData;
+        
         double bestValue = classLikelihoods[0];
         UINT bestIndex = 0;
         for(UINT i=1; i<classLikelihoods.size(); i++){
@@ -199,9 +221,6 @@ bool MLP::init(UINT numInputNeurons,UINT numHiddenNeurons,UINT numOutputNeurons,
     
     //Clear any previous models
     clear();
-
-	//Initialize the random seed
-	random.setSeed( (UINT)time(NULL) );
     
     if( numInputNeurons == 0 || numHiddenNeurons == 0 || numOutputNeurons == 0 ){
         if( numInputNeurons == 0 ){  errorMessage = "init(...) - The number of input neurons is zero!" ; errorLog << errorMessage << endl; }
@@ -227,27 +246,35 @@ bool MLP::init(UINT numInputNeurons,UINT numHiddenNeurons,UINT numOutputNeurons,
     this->hiddenLayerActivationFunction = hiddenLayerActivationFunction;
     this->outputLayerActivationFunction = outputLayerActivationFunction;
     
-    //Setup the neurons for each of the layers
-    inputLayer.resize(numInputNeurons);
-    hiddenLayer.resize(numHiddenNeurons);
-    outputLayer.resize(numOutputNeurons);
-    
-    //Init the neuron memory for each of the layers
-    for(UINT i=0; i<numInputNeurons; i++){
-        inputLayer[i].init(1,inputLayerActivationFunction);
-        inputLayer[i].weights[0] = 1.0; //The weights for the input layer should always be 1
-		inputLayer[i].bias = 0.0; //The bias for the input layer should always be 0
-		inputLayer[i].gamma = gamma;
-    }
-    
+    //Setup the dense layers, the input layer simply passes the input through so its weights are always 1 and its bias is always 0
+    inputWeights.resize(numInputNeurons,1.0);
+    inputBias.resize(numInputNeurons,0.0);
+    hiddenWeights.resize(numHiddenNeurons*numInputNeurons);
+    hiddenBias.resize(numHiddenNeurons);
+    outputWeights.resize(numOutputNeurons*numHiddenNeurons);
+    outputBias.resize(numOutputNeurons);
+    hiddenWeightsUpdate.resize(numHiddenNeurons*numInputNeurons,0);
+    hiddenBiasUpdate.resize(numHiddenNeurons,0);
+    outputWeightsUpdate.resize(numOutputNeurons*numHiddenNeurons,0);
+    outputBiasUpdate.resize(numOutputNeurons,0);
+    inputLayerGamma = gamma;
+    hiddenLayerGamma = gamma;
+    outputLayerGamma = gamma;
+    
+    //Randomise the weights and bias of each neuron between [-0.1 0.1]
+    //All the neurons share the MLP random generator, so each neuron (and each random training iteration) starts from different values
     for(UINT i=0; i<numHiddenNeurons; i++){
-        hiddenLayer[i].init(numInputNeurons,hiddenLayerActivationFunction);
-		hiddenLayer[i].gamma = gamma;
+        for(UINT j=0; j<numInputNeurons; j++){
+            hiddenWeights[i*numInputNeurons+j] = random.getRandomNumberUniform(-0.1,0.1);
+        }
+        hiddenBias[i] = random.getRandomNumberUniform(-0.1,0.1);
     }
     
     for(UINT i=0; i<numOutputNeurons; i++){
-        outputLayer[i].init(numHiddenNeurons,outputLayerActivationFunction);
-		outputLayer[i].gamma = gamma;
+        for(UINT j=0; j<numHiddenNeurons; j++){
+            outputWeights[i*numHiddenNeurons+j] = random.getRandomNumberUniform(-0.1,0.1);
+        }
+        outputBias[i] = random.getRandomNumberUniform(-0.1,0.1);
     }
     
     initialized = true;
@@ -263,6 +290,16 @@ bool MLP::clear(){
     inputLayer.clear();
     hiddenLayer.clear();
     outputLayer.clear();
+    inputWeights.clear();
+    inputBias.clear();
+    hiddenWeights.clear();
+    hiddenBias.clear();
+    outputWeights.clear();
+    outputBias.clear();
+    hiddenWeightsUpdate.clear();
+    hiddenBiasUpdate.clear();
+    outputWeightsUpdate.clear();
+    outputBiasUpdate.clear();
 	trained = false;
     initialized = false;
     return true;
@@ -335,7 +372,39 @@ bool MLP::train(LabelledRegressionData &trainingData_){
 		}
 	}
     
+    //Copy the training and validation data into contiguous buffers, so each batch can be gathered with a few row copies
+    const UINT numValidationSamples = useValidationSet ? validationData.getNumSamples() : 0;
+    if( useValidationSet && numValidationSamples == 0 ){
+        errorMessage = "train(LabelledRegressionData trainingData) - The validation set is empty, there is not enough training data to use a validation set!";
+        errorLog << errorMessage << endl;
+        return false;
+    }
+    VectorDouble trainingInputs(M*N);
+    VectorDouble trainingTargets(M*T);
+    VectorDouble validationInputs(numValidationSamples*N);
+    VectorDouble validationTargets(numValidationSamples*T);
+    for(UINT i=0; i<M; i++){
+        VectorDouble inputVector = trainingData[i].getInputVector();
+        VectorDouble targetVector = trainingData[i].getTargetVector();
+        std::copy(inputVector.begin(),inputVector.end(),trainingInputs.begin()+i*N);
+        std::copy(targetVector.begin(),targetVector.end(),trainingTargets.begin()+i*T);
+    }
+    for(UINT i=0; i<numValidationSamples; i++){
+        VectorDouble inputVector = validationData[i].getInputVector();
+        VectorDouble targetVector = validationData[i].getTargetVector();
+        std::copy(inputVector.begin(),inputVector.end(),validationInputs.begin()+i*N);
+        std::copy(targetVector.begin(),targetVector.end(),validationTargets.begin()+i*T);
+    }
+    
+    //The buffers for running the validation set (or the training set if there is no validation set) through the network
+    const double *testingInputs = useValidationSet ? &validationInputs[0] : &trainingInputs[0];
+    const double *testingTargets = useValidationSet ? &validationTargets[0] : &trainingTargets[0];
+    VectorDouble testingInputLayerOutputs(numTestingExamples*N);
+    VectorDouble testingHiddenOutputs(numTestingExamples*numHiddenNeurons);
+    VectorDouble testingOutputs(numTestingExamples*T);
+    
     //Setup the training loop
+    const UINT maxBatchSize = batchSize < M ? batchSize : M;
     bool keepTraining = true;
     UINT epoch = 0;
     double alpha = trainingRate;
@@ -359,6 +428,7 @@ bool MLP::train(LabelledRegressionData &trainingData_){
 	trainingErrorLog.clear();
     TrainingResult result;
     trainingResults.reserve(M);
+    resizeBatchBuffers( maxBatchSize );
 
     //Reset the indexList, this is used to randomize the order of the training examples, if needed
 	for(UINT i=0; i<M; i++) indexList[i] = i;
@@ -370,7 +440,7 @@ bool MLP::train(LabelledRegressionData &trainingData_){
 		tempTrainingErrorLog.clear();
         
 		//Randomise the start values of the neurons
-        init(numInputNeurons,numHiddenNeurons,numOutputNeurons);
+        init(numInputNeurons,numHiddenNeurons,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
         
         if( randomiseTrainingOrder ){
             for(UINT i=0; i<M; i++){
@@ -384,44 +454,26 @@ bool MLP::train(LabelledRegressionData &trainingData_){
             accuracy = 0;
             totalSquaredTrainingError = 0;
             
-            for(UINT i=0; i<M; i++){
-                //Get the i'th training and target vectors
-                VectorDouble trainingExample = trainingData[ indexList[i] ].getInputVector();
-                VectorDouble targetVector = trainingData[ indexList[i] ].getTargetVector();
+            for(UINT batchStart=0; batchStart<M; batchStart+=maxBatchSize){
+                const UINT numBatchSamples = batchStart+maxBatchSize < M ? maxBatchSize : M-batchStart;
+                
+                //Gather the training and target vectors of the batch
+                for(UINT i=0; i<numBatchSamples; i++){
+                    const UINT index = indexList[batchStart+i];
+                    std::copy(trainingInputs.begin()+index*N,trainingInputs.begin()+(index+1)*N,batchInputs.begin()+i*N);
+                    std::copy(trainingTargets.begin()+index*T,trainingTargets.begin()+(index+1)*T,batchTargets.begin()+i*T);
+                }
                 
                 //Perform the back propagation
-                double backPropError = back_prop(trainingExample,targetVector,alpha,beta);
+                double backPropError = back_prop_batch(numBatchSamples,alpha,beta);
 
-                //Compute the error for the i'th example
+                //Compute the error for the batch, using the outputs of the network before the update
 				if( classificationModeActive ){
-                    VectorDouble y = feedforward(trainingExample);
-                    
-                    //Get the class label
-                    double bestValue = targetVector[0];
-                    UINT bestIndex = 0;
-                    for(UINT i=1; i<targetVector.size(); i++){
-                        if( targetVector[i] > bestValue ){
-                            bestValue = targetVector[i];
-                            bestIndex = i;
-                        }
-                    }
-                    UINT classLabel = bestIndex + 1;
-                    
-                    //Get the predicted class label
-                    bestValue = y[0];
-                    bestIndex = 0;
-                    for(UINT i=1; i<y.size(); i++){
-                        if( y[i] > bestValue ){
-                            bestValue = y[i];
-                            bestIndex = i;
+                    for(UINT i=0; i<numBatchSamples; i++){
+                        if( getMaxIndex(&batchTargets[i*T],T) == getMaxIndex(&batchOutputs[i*T],T) ){
+                            accuracy++;
                         }
                     }
-                    predictedClassLabel = bestIndex+1;
-                    
-                    if( classLabel == predictedClassLabel ){
-                        accuracy++;
-                    }
-                    
                 }else{
                     totalSquaredTrainingError += backPropError; //The backPropError is already squared
                 }
@@ -436,64 +488,33 @@ bool MLP::train(LabelledRegressionData &trainingData_){
             
             //Compute the error over all the training/validation examples
 			if( useValidationSet ){
-                trainingSetAccuracy = accuracy;
+                trainingSetAccuracy = (accuracy/double(M))*100.0;
                 trainingSetTotalSquaredError = totalSquaredTrainingError;
 				accuracy = 0;
                 totalSquaredTrainingError = 0;
-				//We don't need to scale the validation data as it is already scaled, so make sure scaling is set to off
-				bool tempScalingState = useScaling;
-				useScaling = false;
                 
-                //Iterate over the validation samples
-                UINT numValidationSamples = validationData.getNumSamples();
+                //Run the validation samples through the network, we don't need to scale the validation data as it is already scaled
+                feedforwardBatch(&validationInputs[0],numValidationSamples,&testingInputLayerOutputs[0],&testingHiddenOutputs[0],&testingOutputs[0]);
+                
 				for(UINT i=0; i<numValidationSamples; i++){
-					VectorDouble trainingExample = validationData[i].getInputVector();
-					VectorDouble targetVector = validationData[i].getTargetVector();
-                    
-                    VectorDouble y = feedforward(trainingExample);
-                    
                     if( classificationModeActive ){
-                        //Get the class label
-                        double bestValue = targetVector[0];
-                        UINT bestIndex = 0;
-                        for(UINT i=1; i<targetVector.size(); i++){
-                            if( targetVector[i] > bestValue ){
-                                bestValue = targetVector[i];
-                                bestIndex = i;
-                            }
-                        }
-                        UINT classLabel = bestIndex + 1;
-                        
-                        //Get the predicted class label
-                        bestValue = y[0];
-                        bestIndex = 0;
-                        for(UINT i=1; i<y.size(); i++){
-                            if( y[i] > bestValue ){
-                                bestValue = y[i];
-                                bestIndex = i;
-                            }
-                        }
-                        predictedClassLabel = bestIndex+1;
-                        
-                        if( classLabel == predictedClassLabel ){
+                        if( getMaxIndex(&validationTargets[i*T],T) == getMaxIndex(&testingOutputs[i*T],T) ){
                             accuracy++;
                         }
-                        
                     }else{
                         //Update the total squared error
                         for(UINT j=0; j<T; j++){
-                            totalSquaredTrainingError += SQR( targetVector[j]-y[j] );
+                            totalSquaredTrainingError += SQR( validationTargets[i*T+j]-testingOutputs[i*T+j] );
                         }
                     }
 				}
-                //Reset the scaling flag
-				useScaling = tempScalingState;
                 
-                accuracy = (accuracy/double(numValidationSamples))*double(numValidationSamples);
+                accuracy = (accuracy/double(numValidationSamples))*100.0;
                 rootMeanSquaredTrainingError = sqrt( totalSquaredTrainingError / double(numValidationSamples) );
                 
 			}else{//We are not using a validation set
-                accuracy = (accuracy/double(M))*double(M);
+                accuracy = (accuracy/double(M))*100.0;
+                trainingSetAccuracy = accuracy;
                 rootMeanSquaredTrainingError = sqrt( totalSquaredTrainingError / double(M) );
             }
             
@@ -546,8 +567,8 @@ bool MLP::train(LabelledRegressionData &trainingData_){
             bestTSError = totalSquaredTrainingError;
             bestRMSError = rootMeanSquaredTrainingError;
             bestAccuracy = accuracy;
-            bestNetwork = *this;
 			trainingErrorLog = tempTrainingErrorLog;
+            bestNetwork = *this;
         }
 
     }//End of For( numRandomTrainingIterations )
@@ -571,33 +592,13 @@ bool MLP::train(LabelledRegressionData &trainingData_){
         double averageValue = 0;
         VectorDouble classificationPredictions;
         
+        //Make the predictions, the testing data is already scaled
+        feedforwardBatch(testingInputs,numTestingExamples,&testingInputLayerOutputs[0],&testingHiddenOutputs[0],&testingOutputs[0]);
+        
         for(UINT i=0; i<numTestingExamples; i++){
-            VectorDouble inputVector = useValidationSet ? validationData[i].getInputVector() : trainingData[i].getInputVector();
-            VectorDouble targetVector = useValidationSet ? validationData[i].getTargetVector() : trainingData[i].getTargetVector();
-            
-            //Make the prediction
-            VectorDouble y = feedforward(inputVector);
-            
-            //Get the class label
-            double bestValue = targetVector[0];
-            UINT bestIndex = 0;
-            for(UINT i=1; i<targetVector.size(); i++){
-                if( targetVector[i] > bestValue ){
-                    bestValue = targetVector[i];
-                    bestIndex = i;
-                }
-            }
-            UINT classLabel = bestIndex + 1;
-            
-            //Get the predicted class label
-            bestValue = y[0];
-            bestIndex = 0;
-            for(UINT i=1; i<y.size(); i++){
-                if( y[i] > bestValue ){
-                    bestValue = y[i];
-                    bestIndex = i;
-                }
-            }
+            const UINT classLabel = getMaxIndex(&testingTargets[i*T],T) + 1;
+            const UINT bestIndex = getMaxIndex(&testingOutputs[i*T],T);
+            const double bestValue = testingOutputs[i*T+bestIndex];
             predictedClassLabel = bestIndex+1;
             
             //Only add the max value if the prediction is correct
@@ -625,157 +626,311 @@ bool MLP::train(LabelledRegressionData &trainingData_){
 
 double MLP::back_prop(VectorDouble &trainingExample,VectorDouble &targetVector,double alpha,double beta){
     
-    double update = 0;
-    VectorDouble inputNeuronsOuput;
-    VectorDouble hiddenNeuronsOutput;
-    VectorDouble outputNeuronsOutput;
-    VectorDouble deltaO(numOutputNeurons);
-    VectorDouble deltaH(numHiddenNeurons);
+    //Run the example as a batch of one, this gives the same update as the classic online back propagation
+    resizeBatchBuffers( 1 );
+    std::copy(trainingExample.begin(),trainingExample.begin()+numInputNeurons,batchInputs.begin());
+    std::copy(targetVector.begin(),targetVector.begin()+numOutputNeurons,batchTargets.begin());
+    
+    return back_prop_batch(1,alpha,beta);
+}
+
+double MLP::back_prop_batch(const UINT numSamples,const double alpha,const double beta){
+    
+    const UINT N = numInputNeurons;
+    const UINT H = numHiddenNeurons;
+    const UINT O = numOutputNeurons;
     
     //Forward propagation
-    feedforward(trainingExample,inputNeuronsOuput,hiddenNeuronsOutput,outputNeuronsOutput);
+    feedforwardBatch(&batchInputs[0],numSamples,&batchInputLayerOutputs[0],&batchHiddenOutputs[0],&batchOutputs[0]);
     
     //Compute the error of the output layer: the derivative of the function times the error of the output
-    for(UINT i=0; i<numOutputNeurons; i++){
-		deltaO[i] = outputLayer[i].der(outputNeuronsOutput[i]) * (targetVector[i]-outputNeuronsOutput[i]);
+    double error = 0;
+    for(UINT n=0; n<numSamples; n++){
+        for(UINT i=0; i<O; i++){
+            const double y = batchOutputs[n*O+i];
+            const double e = batchTargets[n*O+i] - y;
+            const double delta = Neuron::derivative(y,outputLayerActivationFunction,outputLayerGamma) * e;
+            batchOutputDeltas[n*O+i] = delta;
+            batchOutputDeltasT[i*numSamples+n] = delta;
+            error += e * e;
+        }
     }
     
-    //Compute the error of the hidden layer
-    for(UINT i=0; i<numHiddenNeurons; i++){
-        double sum = 0;
-        for(UINT j=0; j<numOutputNeurons; j++){
-            sum += outputLayer[j].weights[i] * deltaO[j];
+    //Compute the error of the hidden layer, this uses the output weights before they are updated
+    SIMD::multiply(&batchOutputDeltas[0],numSamples,O,&outputWeights[0],H,&batchHiddenErrors[0]);
+    for(UINT n=0; n<numSamples; n++){
+        for(UINT i=0; i<H; i++){
+            batchHiddenDeltasT[i*numSamples+n] = Neuron::derivative(batchHiddenOutputs[n*H+i],hiddenLayerActivationFunction,hiddenLayerGamma) * batchHiddenErrors[n*H+i];
         }
-		deltaH[i] = hiddenLayer[i].der(hiddenNeuronsOutput[i]) * sum;
     }
     
-    //Update the hidden weights: old hidden weights + (learningRate * inputToTheHiddenNeuron * deltaHidden )
-    for(UINT i=0; i<numHiddenNeurons; i++){
-        for(UINT j=0; j<numInputNeurons; j++){
-			//Compute the update
-            update = alpha * (beta * hiddenLayer[i].previousUpdate[j] + (1.0 - beta) * inputNeuronsOuput[j] * deltaH[i]);
+    //Compute the gradient of each neuron and update its weights and bias: old weights + (learningRate * averageInputToTheNeuron * delta),
+    //with momentum. The gradient of a neuron only depends on its own deltas, so each row is updated as soon as its gradient has been
+    //computed (while it is still in the cache), and the rows of both layers can be split across the workers
+    const double gradientScale = 1.0 / double(numSamples);
+    const UINT numRows = H + O;
+    const UINT numWorkers = getNumBatchWorkers( numSamples );
+    Parallel::forEach(numWorkers,numWorkers,[&](UINT workerIndex,UINT taskIndex){
+        const UINT rowStart = (UINT)( (unsigned long long)taskIndex * numRows / numWorkers );
+        const UINT rowEnd = (UINT)( (unsigned long long)(taskIndex+1) * numRows / numWorkers );
+        
+        for(UINT r=rowStart; r<rowEnd; r++){
+            if( r < H ){
+                const UINT i = r;
+                const double *delta = &batchHiddenDeltasT[i*numSamples];
+                double biasGradient = 0;
+                for(UINT n=0; n<numSamples; n++) biasGradient += delta[n];
+                if( numSamples == 1 ){
+                    //The gradient is just the input scaled by the delta, so there is no need to store it
+                    updateWeights(&hiddenWeights[i*N],&hiddenWeightsUpdate[i*N],&batchInputLayerOutputs[0],N,alpha,beta,delta[0]);
+                }else{
+                    SIMD::multiply(delta,1,numSamples,&batchInputLayerOutputs[0],N,&hiddenWeightsGradient[i*N]);
+                    updateWeights(&hiddenWeights[i*N],&hiddenWeightsUpdate[i*N],&hiddenWeightsGradient[i*N],N,alpha,beta,gradientScale);
+                }
+                updateWeights(&hiddenBias[i],&hiddenBiasUpdate[i],&biasGradient,1,alpha,beta,gradientScale);
+            }else{
+                const UINT i = r-H;
+                const double *delta = &batchOutputDeltasT[i*numSamples];
+                double biasGradient = 0;
+                for(UINT n=0; n<numSamples; n++) biasGradient += delta[n];
+                if( numSamples == 1 ){
+                    //The gradient is just the input scaled by the delta, so there is no need to store it
+                    updateWeights(&outputWeights[i*H],&outputWeightsUpdate[i*H],&batchHiddenOutputs[0],H,alpha,beta,delta[0]);
+                }else{
+                    SIMD::multiply(delta,1,numSamples,&batchHiddenOutputs[0],H,&outputWeightsGradient[i*H]);
+                    updateWeights(&outputWeights[i*H],&outputWeightsUpdate[i*H],&outputWeightsGradient[i*H],H,alpha,beta,gradientScale);
+                }
+                updateWeights(&outputBias[i],&outputBiasUpdate[i],&biasGradient,1,alpha,beta,gradientScale);
+            }
+        }
+    });
 
-			//Update the weights
-			hiddenLayer[i].weights[j] += update;
+    return error;
+}
 
-			//Store the previous update
-			hiddenLayer[i].previousUpdate[j] = update; 
-        }
-    }
+VectorDouble MLP::feedforward(VectorDouble trainingExample){
     
-    //Update the output weights
-    for(UINT i=0; i<numOutputNeurons; i++){
-        for(UINT j=0; j<numHiddenNeurons; j++){
-			//Compute the update
-            update = alpha * (beta * outputLayer[i].previousUpdate[j] + (1.0 - beta) * hiddenNeuronsOutput[j] * deltaO[i]);
-
-			//Update the weights
-			outputLayer[i].weights[j] += update;
+    VectorDouble outputNeuronsOutput(numOutputNeurons,0);
+    
+    feedforward(&trainingExample[0],&outputNeuronsOutput[0]);
+    
+    return outputNeuronsOutput;
+}
 
-			//Store the update
-			outputLayer[i].previousUpdate[j] = update;
+void MLP::feedforward(VectorDouble &trainingExample,VectorDouble &inputNeuronsOuput,
+                      VectorDouble &hiddenNeuronsOutput,VectorDouble &outputNeuronsOutput){
+    
+    inputNeuronsOuput.resize(numInputNeurons,0);
+    hiddenNeuronsOutput.resize(numHiddenNeurons,0);
+    outputNeuronsOutput.resize(numOutputNeurons,0);
+    
+    feedforwardBatch(&trainingExample[0],1,&inputNeuronsOuput[0],&hiddenNeuronsOutput[0],&outputNeuronsOutput[0]);
+}
 
+void MLP::feedforward(const double *inputVector,double *outputVector){
+    
+    //Resize the prediction buffers, this only allocates memory the first time the network is run
+    predictionInputBuffer.resize( numInputNeurons );
+    predictionHiddenBuffer.resize( numHiddenNeurons );
+    
+	//Scale the input vector if required, and run it through the input layer
+    for(UINT i=0; i<numInputNeurons; i++){
+        double x = inputVector[i];
+        if( useScaling ){
+            x = scale(x,inputVectorRanges[i].minValue,inputVectorRanges[i].maxValue,0.0,1.0);
         }
+        predictionInputBuffer[i] = Neuron::activation(inputWeights[i]*x + inputBias[i],inputLayerActivationFunction,inputLayerGamma);
     }
     
-    //Update the hidden bias
-    for(UINT i=0; i<numHiddenNeurons; i++){
-		//Compute the update
-		update = alpha * (beta * hiddenLayer[i].previousBiasUpdate + (1.0 - beta) * deltaH[i]);
+    //Hidden Layer
+    feedforwardLayer(&predictionInputBuffer[0],1,numInputNeurons,&hiddenWeights[0],&hiddenBias[0],numHiddenNeurons,hiddenLayerActivationFunction,hiddenLayerGamma,&predictionHiddenBuffer[0]);
+    
+    //Output Layer
+    feedforwardLayer(&predictionHiddenBuffer[0],1,numHiddenNeurons,&outputWeights[0],&outputBias[0],numOutputNeurons,outputLayerActivationFunction,outputLayerGamma,outputVector);
 
-		//Update the bias
-        hiddenLayer[i].bias += update;
+	//Scale the output vector if required
+	if( useScaling ){
+		for(UINT i=0; i<numOutputNeurons; i++){
+			outputVector[i] = scale(outputVector[i],0.0,1.0,targetVectorRanges[i].minValue,targetVectorRanges[i].maxValue);
+		}
+	}
+}
 
-		//Store the update
-		hiddenLayer[i].previousBiasUpdate = update;
-    }
+void MLP::feedforwardBatch(const double *inputs,const UINT numSamples,double *inputLayerOutputs,double *hiddenLayerOutputs,double *outputLayerOutputs){
     
-    //Update the output bias
-    for(UINT i=0; i<numOutputNeurons; i++){
-		//Compute the update
-		update = alpha * (beta * outputLayer[i].previousBiasUpdate + (1.0 - beta) * deltaO[i]);
-
-		//Update the bias
-        outputLayer[i].bias += update;
-		
-		//Stire the update
-		outputLayer[i].previousBiasUpdate = update;
-    }
+    const UINT N = numInputNeurons;
+    const UINT H = numHiddenNeurons;
+    const UINT O = numOutputNeurons;
     
-    //Compute the error 
-    double error = 0;
-    for(UINT i=0; i<numOutputNeurons; i++){
-        error += (targetVector[i]-outputNeuronsOutput[i]) * (targetVector[i]-outputNeuronsOutput[i]);
+    //Each example is independent, so the examples can be split across the workers
+    const UINT numWorkers = getNumBatchWorkers( numSamples );
+    Parallel::forEach(numWorkers,numWorkers,[&](UINT workerIndex,UINT taskIndex){
+        const UINT start = (UINT)( (unsigned long long)taskIndex * numSamples / numWorkers );
+        const UINT end = (UINT)( (unsigned long long)(taskIndex+1) * numSamples / numWorkers );
+        if( end == start ) return;
+        
+        //Input layer
+        for(UINT n=start; n<end; n++){
+            for(UINT i=0; i<N; i++){
+                inputLayerOutputs[n*N+i] = Neuron::activation(inputWeights[i]*inputs[n*N+i] + inputBias[i],inputLayerActivationFunction,inputLayerGamma);
+            }
+        }
+        
+        //Hidden Layer
+        feedforwardLayer(inputLayerOutputs+start*N,end-start,N,&hiddenWeights[0],&hiddenBias[0],H,hiddenLayerActivationFunction,hiddenLayerGamma,hiddenLayerOutputs+start*H);
+        
+        //Output Layer
+        feedforwardLayer(hiddenLayerOutputs+start*H,end-start,H,&outputWeights[0],&outputBias[0],O,outputLayerActivationFunction,outputLayerGamma,outputLayerOutputs+start*O);
+    });
+}
+
+void MLP::feedforwardLayer(const double *inputs,const UINT numSamples,const UINT numInputs,const double *weights,const double *bias,
+                           const UINT numNeurons,const UINT activationFunction,const double gamma,double *outputs){
+    
+    SIMD::multiplyTransposed(inputs,numSamples,numInputs,weights,numNeurons,outputs);
+    
+    for(UINT n=0; n<numSamples; n++){
+        double *y = outputs + n*numNeurons;
+        for(UINT i=0; i<numNeurons; i++){
+            y[i] = Neuron::activation(y[i] + bias[i],activationFunction,gamma);
+        }
     }
+}
 
-    return error;
+void MLP::updateWeights(double *weights,double *previousUpdate,const double *gradient,const UINT n,const double alpha,const double beta,const double gradientScale){
+    //update = alpha * (beta * previousUpdate + (1-beta) * gradientScale * gradient), then weights += update and previousUpdate = update
+    SIMD::momentumUpdate(alpha*beta,previousUpdate,alpha*(1.0-beta)*gradientScale,gradient,weights,n);
 }
 
-VectorDouble MLP::feedforward(VectorDouble trainingExample){
+UINT MLP::getMaxIndex(const double *x,const UINT n){
+    UINT bestIndex = 0;
+    for(UINT i=1; i<n; i++){
+        if( x[i] > x[bestIndex] ){
+            bestIndex = i;
+        }
+    }
+    return bestIndex;
+}
+
+void MLP::resizeBatchBuffers(const UINT numSamples){
+    batchInputs.resize(numSamples*numInputNeurons);
+    batchTargets.resize(numSamples*numOutputNeurons);
+    batchInputLayerOutputs.resize(numSamples*numInputNeurons);
+    batchHiddenOutputs.resize(numSamples*numHiddenNeurons);
+    batchOutputs.resize(numSamples*numOutputNeurons);
+    batchOutputDeltas.resize(numSamples*numOutputNeurons);
+    batchOutputDeltasT.resize(numSamples*numOutputNeurons);
+    batchHiddenErrors.resize(numSamples*numHiddenNeurons);
+    batchHiddenDeltasT.resize(numSamples*numHiddenNeurons);
+    hiddenWeightsGradient.resize(numHiddenNeurons*numInputNeurons);
+    outputWeightsGradient.resize(numOutputNeurons*numHiddenNeurons);
+}
+
+UINT MLP::getNumBatchWorkers(const UINT numSamples){
+    if( !useMultiThreadingTraining ) return 1;
     
-    VectorDouble inputNeuronsOuput(numInputNeurons,0);
-    VectorDouble hiddenNeuronsOutput(numHiddenNeurons,0);
-    VectorDouble outputNeuronsOutput(numOutputNeurons,0);
+    //Waking up the worker threads costs more than running a small batch, so only split the batch if there is enough work
+    const unsigned long long work = (unsigned long long)numSamples * (numInputNeurons*numHiddenNeurons + numHiddenNeurons*numOutputNeurons);
+    if( work < MLP_MIN_PARALLEL_BATCH_WORK ) return 1;
+    
+    return Parallel::getNumWorkers( numSamples );
+}
 
-	//Scale the input vector if required
-	if( useScaling ){
-		for(UINT i=0; i<numInputNeurons; i++){
-			trainingExample[i] = scale(trainingExample[i],inputVectorRanges[i].minValue,inputVectorRanges[i].maxValue,0.0,1.0);
-		}
-	}
+bool MLP::buildLayerMatrices(){
+    
+    if( inputLayer.size() != numInputNeurons || hiddenLayer.size() != numHiddenNeurons || outputLayer.size() != numOutputNeurons ){
+        errorMessage = "buildLayerMatrices() - The number of neurons does not match the size of the MLP!";
+        errorLog << errorMessage << endl;
+        return false;
+    }
+    
+    inputWeights.resize(numInputNeurons);
+    inputBias.resize(numInputNeurons);
+    hiddenWeights.resize(numHiddenNeurons*numInputNeurons);
+    hiddenBias.resize(numHiddenNeurons);
+    outputWeights.resize(numOutputNeurons*numHiddenNeurons);
+    outputBias.resize(numOutputNeurons);
+    hiddenWeightsUpdate.assign(numHiddenNeurons*numInputNeurons,0);
+    hiddenBiasUpdate.assign(numHiddenNeurons,0);
+    outputWeightsUpdate.assign(numOutputNeurons*numHiddenNeurons,0);
+    outputBiasUpdate.assign(numOutputNeurons,0);
     
-    //Input layer
-	VectorDouble input(1);
     for(UINT i=0; i<numInputNeurons; i++){
-        input[0] = trainingExample[i];
-        inputNeuronsOuput[i] = inputLayer[i].fire(input);
+        if( inputLayer[i].numInputs != 1 ){
+            errorMessage = "buildLayerMatrices() - Input neuron " + Util::toString(i+1) + " should have 1 input!";
+            errorLog << errorMessage << endl;
+            return false;
+        }
+        inputWeights[i] = inputLayer[i].weights[0];
+        inputBias[i] = inputLayer[i].bias;
     }
     
-    //Hidden Layer
     for(UINT i=0; i<numHiddenNeurons; i++){
-        hiddenNeuronsOutput[i] = hiddenLayer[i].fire(inputNeuronsOuput);
+        if( hiddenLayer[i].numInputs != numInputNeurons ){
+            errorMessage = "buildLayerMatrices() - Hidden neuron " + Util::toString(i+1) + " should have " + Util::toString(numInputNeurons) + " inputs!";
+            errorLog << errorMessage << endl;
+            return false;
+        }
+        std::copy(hiddenLayer[i].weights.begin(),hiddenLayer[i].weights.end(),hiddenWeights.begin()+i*numInputNeurons);
+        hiddenBias[i] = hiddenLayer[i].bias;
     }
     
-    //Output Layer
     for(UINT i=0; i<numOutputNeurons; i++){
-        outputNeuronsOutput[i] = outputLayer[i].fire(hiddenNeuronsOutput);
+        if( outputLayer[i].numInputs != numHiddenNeurons ){
+            errorMessage = "buildLayerMatrices() - Output neuron " + Util::toString(i+1) + " should have " + Util::toString(numHiddenNeurons) + " inputs!";
+            errorLog << errorMessage << endl;
+            return false;
+        }
+        std::copy(outputLayer[i].weights.begin(),outputLayer[i].weights.end(),outputWeights.begin()+i*numHiddenNeurons);
+        outputBias[i] = outputLayer[i].bias;
     }
-
-	//Scale the output vector if required
-	if( useScaling ){
-		for(unsigned int i=0; i<numOutputNeurons; i++){
-			outputNeuronsOutput[i] = scale(outputNeuronsOutput[i],0.0,1.0,targetVectorRanges[i].minValue,targetVectorRanges[i].maxValue);
-		}
-	}
     
-    return outputNeuronsOutput;
+    //All the neurons in a layer share the same gamma value
+    inputLayerGamma = numInputNeurons > 0 ? inputLayer[0].gamma : gamma;
+    hiddenLayerGamma = numHiddenNeurons > 0 ? hiddenLayer[0].gamma : gamma;
+    outputLayerGamma = numOutputNeurons > 0 ? outputLayer[0].gamma : gamma;
     
+    return true;
 }
 
-void MLP::feedforward(VectorDouble &trainingExample,VectorDouble &inputNeuronsOuput,
-                      VectorDouble &hiddenNeuronsOutput,VectorDouble &outputNeuronsOutput){
+void MLP::updateNeuronLayers(){
     
-    inputNeuronsOuput.resize(numInputNeurons,0);
-    hiddenNeuronsOutput.resize(numHiddenNeurons,0);
-    outputNeuronsOutput.resize(numOutputNeurons,0);
+    inputLayer.resize(numInputNeurons);
+    hiddenLayer.resize(numHiddenNeurons);
+    outputLayer.resize(numOutputNeurons);
     
-    //Input layer
-	VectorDouble input(1);
     for(UINT i=0; i<numInputNeurons; i++){
-        input[0] = trainingExample[i];
-        inputNeuronsOuput[i] = inputLayer[i].fire(input);
+        Neuron &neuron = inputLayer[i];
+        neuron.numInputs = 1;
+        neuron.activationFunction = inputLayerActivationFunction;
+        neuron.gamma = inputLayerGamma;
+        neuron.weights.assign(1,inputWeights[i]);
+        neuron.previousUpdate.assign(1,0);
+        neuron.bias = inputBias[i];
+        neuron.previousBiasUpdate = 0;
     }
     
-    //Hidden Layer
     for(UINT i=0; i<numHiddenNeurons; i++){
-        hiddenNeuronsOutput[i] = hiddenLayer[i].fire(inputNeuronsOuput);
+        Neuron &neuron = hiddenLayer[i];
+        neuron.numInputs = numInputNeurons;
+        neuron.activationFunction = hiddenLayerActivationFunction;
+        neuron.gamma = hiddenLayerGamma;
+        neuron.weights.assign(hiddenWeights.begin()+i*numInputNeurons,hiddenWeights.begin()+(i+1)*numInputNeurons);
+        neuron.previousUpdate.assign(hiddenWeightsUpdate.begin()+i*numInputNeurons,hiddenWeightsUpdate.begin()+(i+1)*numInputNeurons);
+        neuron.bias = hiddenBias[i];
+        neuron.previousBiasUpdate = hiddenBiasUpdate[i];
     }
     
-    //Output Layer
     for(UINT i=0; i<numOutputNeurons; i++){
-        outputNeuronsOutput[i] = outputLayer[i].fire(hiddenNeuronsOutput);
+        Neuron &neuron = outputLayer[i];
+        neuron.numInputs = numHiddenNeurons;
+        neuron.activationFunction = outputLayerActivationFunction;
+        neuron.gamma = outputLayerGamma;
+        neuron.weights.assign(outputWeights.begin()+i*numHiddenNeurons,outputWeights.begin()+(i+1)*numHiddenNeurons);
+        neuron.previousUpdate.assign(outputWeightsUpdate.begin()+i*numHiddenNeurons,outputWeightsUpdate.begin()+(i+1)*numHiddenNeurons);
+        neuron.bias = outputBias[i];
+        neuron.previousBiasUpdate = outputBiasUpdate[i];
     }
-    
 }
 
 void MLP::printNetwork(){
@@ -786,25 +941,24 @@ void MLP::printNetwork(){
     
     cout<<"InputWeights:\n";
     for(UINT i=0; i<numInputNeurons; i++){
-        cout<<"Neuron: "<<i<<" Bias: " << inputLayer[i].bias << " Weights: ";
-        for(UINT j=0; j<inputLayer[i].weights.size(); j++){
-            cout<<inputLayer[i].weights[j]<<"\t";
-        }cout<<endl;
+        cout<<"Neuron: "<<i<<" Bias: " << inputBias[i] << " Weights: ";
+        cout<<inputWeights[i]<<"\t";
+        cout<<endl;
     }
     
     cout<<"HiddenWeights:\n";
     for(UINT i=0; i<numHiddenNeurons; i++){
-        cout<<"Neuron: "<<i<<" Bias: " << hiddenLayer[i].bias << " Weights: ";
-        for(UINT j=0; j<hiddenLayer[i].weights.size(); j++){
-            cout<<hiddenLayer[i].weights[j]<<"\t";
+        cout<<"Neuron: "<<i<<" Bias: " << hiddenBias[i] << " Weights: ";
+        for(UINT j=0; j<numInputNeurons; j++){
+            cout<<hiddenWeights[i*numInputNeurons+j]<<"\t";
         }cout<<endl;
     }
     
     cout<<"OutputWeights:\n";
     for(UINT i=0; i<numOutputNeurons; i++){
-        cout<<"Neuron: "<<i<<" Bias: " << outputLayer[i].bias << " Weights: ";
-        for(UINT j=0; j<outputLayer[i].weights.size(); j++){
-            cout<<outputLayer[i].weights[j]<<"\t";
+        cout<<"Neuron: "<<i<<" Bias: " << outputBias[i] << " Weights: ";
+        for(UINT j=0; j<numHiddenNeurons; j++){
+            cout<<outputWeights[i*numHiddenNeurons+j]<<"\t";
         }cout<<endl;
     }
     
@@ -812,25 +966,22 @@ void MLP::printNetwork(){
 
 bool MLP::checkForNAN(){
     
-    for(UINT i=0; i<numInputNeurons; i++){
-        if( isNAN(inputLayer[i].bias) ) return true;
-        for(UINT j=0; j<inputLayer[i].weights.size(); j++){
-            if( isNAN(inputLayer[i].weights[j]) ) return true;
-        }
+    for(UINT i=0; i<inputWeights.size(); i++){
+        if( isNAN(inputWeights[i]) || isNAN(inputBias[i]) ) return true;
     }
     
-    for(UINT i=0; i<numHiddenNeurons; i++){
-        if( isNAN(hiddenLayer[i].bias) ) return true;
-        for(UINT j=0; j<hiddenLayer[i].weights.size(); j++){
-            if( isNAN(hiddenLayer[i].weights[j]) ) return true;
-        }
+    for(UINT i=0; i<hiddenWeights.size(); i++){
+        if( isNAN(hiddenWeights[i]) ) return true;
+    }
+    for(UINT i=0; i<hiddenBias.size(); i++){
+        if( isNAN(hiddenBias[i]) ) return true;
     }
     
-    for(UINT i=0; i<numOutputNeurons; i++){
-        if( isNAN(outputLayer[i].bias) ) return true;
-        for(UINT j=0; j<outputLayer[i].weights.size(); j++){
-            if( isNAN(outputLayer[i].weights[j]) ) return true;
-        }
+    for(UINT i=0; i<outputWeights.size(); i++){
+        if( isNAN(outputWeights[i]) ) return true;
+    }
+    for(UINT i=0; i<outputBias.size(); i++){
+        if( isNAN(outputBias[i]) ) return true;
     }
     
     return false;
@@ -887,6 +1038,9 @@ bool MLP::saveModelToFile(fstream &file){
     file << "UseNullRejection: " << useNullRejection << endl;
     file << "RejectionThreshold: " << nullRejectionThreshold << endl;
 	
+	//Make sure the neurons match the dense layers before they are written to the file
+	updateNeuronLayers();
+	
 	file << "InputLayer: \n";
 	for(UINT i=0; i<numInputNeurons; i++){
 		file << "InputNeuron: " << i+1 << endl;
@@ -1418,6 +1572,13 @@ bool MLP::loadModelFromFile(fstream &file){
 			file >> targetVectorRanges[j].maxValue;
 		}
 	}
+    
+    //Copy the neurons into the dense layers that are used for prediction
+    if( !buildLayerMatrices() ){
+        errorMessage = "loadModelFromFile(fstream &file) - Failed to build the layers from the neurons!";
+        errorLog << errorMessage << endl;
+        return false;
+    }
 
     initialized = true;
 	trained = true;
@@ -1491,6 +1652,10 @@ double MLP::getTrainingError(){
     return trainingError;
 }
     
+UINT MLP::getBatchSize(){
+    return batchSize;
+}
+    
 bool MLP::getUseValidationSet(){
     return useValidationSet;
 }
@@ -1508,14 +1673,17 @@ bool MLP::getRegressionModeActive(){
 }
     
 vector< Neuron > MLP::getInputLayer(){
+    updateNeuronLayers();
     return inputLayer;
 }
     
 vector< Neuron > MLP::getHiddenLayer(){
+    updateNeuronLayers();
     return hiddenLayer;
 }
     
 vector< Neuron > MLP::getOutputLayer(){
+    updateNeuronLayers();
     return outputLayer;
 }
     
@@ -1672,6 +1840,14 @@ bool MLP::setValidationSetSize(UINT validationSetSize){
     return false;
 }
     
+bool MLP::setBatchSize(UINT batchSize){
+    if( batchSize > 0 ){
+        this->batchSize = batchSize;
+        return true;
+    }
+    return false;
+}
+    
 bool MLP::setNullRejection(bool useNullRejection){
     this->useNullRejection = useNullRejection;
     return true;
@@ -76,10 +76,10 @@ public:
      This function either predicts the class of the input vector (if the MLP is in Classification Mode), or it performs regression using
      the MLP model.
      
-     @param VectorDouble inputVector: the input vector to classify or perform regression on
+     @param VectorDouble &inputVector: the input vector to classify or perform regression on, this is not copied so it may be modified by the prediction
      @return returns true if the prediction/regression was performed, false otherwise
      */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
     
     /**
      This saves the trained MLP model to a file.
@@ -299,6 +299,14 @@ public:
      */
 	double getTrainingError();
     
+    /**
+     Gets the number of training examples that are used for each weight update. A batch size of 1 updates the weights after every
+     training example (online training), larger batch sizes average the gradient over the batch before each update.
+     
+     @return returns the batch size
+     */
+    UINT getBatchSize();
+    
     /**
      Returns true if a validation set should be used for training. If true, then the training dataset will be partitioned into a smaller training dataset
      and a validation set.  The size of the partition is controlled by the validationSetSize parameter.
@@ -435,6 +443,16 @@ public:
     bool setNumRandomTrainingIterations(UINT numRandomTrainingIterations);
     bool setValidationSetSize(UINT validationSetSize);
     
+    /**
+     Sets the number of training examples that are used for each weight update. A batch size of 1 (the default) updates the weights
+     after every training example. Larger batch sizes let the forward and backward passes for the whole batch run as matrix-matrix
+     products, which is much faster on large networks, but usually need a larger training rate or more epochs to converge.
+     
+     @param UINT batchSize: the new batch size, this must be greater than zero
+     @return returns true if the batch size was updated, false otherwise
+     */
+    bool setBatchSize(UINT batchSize);
+    
     //Classifier Setters
     bool setNullRejection(bool useNullRejection);
     bool setNullRejectionCoeff(double nullRejectionCoeff);
@@ -471,6 +489,80 @@ protected:
      */
     void feedforward(VectorDouble &trainingExample,VectorDouble &inputNeuronsOuput,VectorDouble &hiddenNeuronsOutput,VectorDouble &outputNeuronsOutput);
     
+    /**
+     Performs the feedforward step for a single input vector, scaling the input and output if needed. This uses the prediction
+     buffers so it does not allocate any memory once the buffers have been sized by the first call.
+     
+     @param const double *inputVector: the input vector, this should have numInputNeurons elements
+     @param double *outputVector: the buffer the results will be written to, this should have numOutputNeurons elements
+     */
+    void feedforward(const double *inputVector,double *outputVector);
+    
+    /**
+     Performs the feedforward step for a batch of input vectors, without any scaling.
+     All the buffers are row-major with one row per input vector.
+     
+     @param const double *inputs: the [numSamples numInputNeurons] input vectors
+     @param const UINT numSamples: the number of input vectors
+     @param double *inputLayerOutputs: the [numSamples numInputNeurons] buffer the results of the input layer will be written to
+     @param double *hiddenLayerOutputs: the [numSamples numHiddenNeurons] buffer the results of the hidden layer will be written to
+     @param double *outputLayerOutputs: the [numSamples numOutputNeurons] buffer the results of the output layer will be written to
+     */
+    void feedforwardBatch(const double *inputs,const UINT numSamples,double *inputLayerOutputs,double *hiddenLayerOutputs,double *outputLayerOutputs);
+    
+    /**
+     Performs one round of back propagation using the first numSamples rows of the batchInputs and batchTargets buffers.
+     The gradient is averaged over the batch and applied using the same momentum update as back_prop.
+     The outputs of the network before the update are left in the batchOutputs buffer.
+     
+     @param const UINT numSamples: the number of examples in the batch
+     @param const double alpha: the training rate
+     @param const double beta: the momentum
+     @return returns the total squared error of the batch before the update
+     */
+    double back_prop_batch(const UINT numSamples,const double alpha,const double beta);
+    
+    /**
+     Resizes the training buffers so they can hold a batch of numSamples examples.
+     */
+    void resizeBatchBuffers(const UINT numSamples);
+    
+    /**
+     Gets the number of workers that should be used to process a batch of numSamples examples.
+     This is 1 unless multithreaded training is enabled and the batch is large enough to be worth splitting.
+     */
+    UINT getNumBatchWorkers(const UINT numSamples);
+    
+    /**
+     Copies the weights of the neurons into the dense layer matrices, this is called after a model has been loaded from a file.
+     
+     @return returns true if the neurons are consistent with the size of the MLP, false otherwise
+     */
+    bool buildLayerMatrices();
+    
+    /**
+     Copies the dense layer matrices back into the neurons, so the neurons returned by getInputLayer, getHiddenLayer and
+     getOutputLayer (and the neurons written to the model file) match the network.
+     */
+    void updateNeuronLayers();
+    
+    /**
+     Computes outputs = f(inputs * weights' + bias) for a dense layer, where inputs is [numSamples numInputs],
+     weights is [numNeurons numInputs] and outputs is [numSamples numNeurons].
+     */
+    static void feedforwardLayer(const double *inputs,const UINT numSamples,const UINT numInputs,const double *weights,const double *bias,
+                                 const UINT numNeurons,const UINT activationFunction,const double gamma,double *outputs);
+    
+    /**
+     Applies the momentum update to n weights: update = alpha * (beta * previousUpdate + (1-beta) * gradientScale * gradient).
+     */
+    static void updateWeights(double *weights,double *previousUpdate,const double *gradient,const UINT n,const double alpha,const double beta,const double gradientScale);
+    
+    /**
+     Returns the index of the largest of the n values in x.
+     */
+    static UINT getMaxIndex(const double *x,const UINT n);
+    
     UINT numInputNeurons;
     UINT numHiddenNeurons;
     UINT numOutputNeurons;
@@ -490,11 +582,44 @@ protected:
 	bool useValidationSet;
 	bool randomiseTrainingOrder;
     bool useMultiThreadingTraining;
+    UINT batchSize;
     Random random;
     
     vector< Neuron > inputLayer;
     vector< Neuron > hiddenLayer;
     vector< Neuron > outputLayer;
+    
+    //The dense layers, these are the weights that are used for training and prediction
+    VectorDouble inputWeights;                  //The weight of each input neuron
+    VectorDouble inputBias;                     //The bias of each input neuron
+    VectorDouble hiddenWeights;                 //[numHiddenNeurons numInputNeurons], row i holds the weights of hidden neuron i
+    VectorDouble hiddenBias;
+    VectorDouble outputWeights;                 //[numOutputNeurons numHiddenNeurons], row i holds the weights of output neuron i
+    VectorDouble outputBias;
+    VectorDouble hiddenWeightsUpdate;           //The previous updates of the hidden layer, used for the momentum
+    VectorDouble hiddenBiasUpdate;
+    VectorDouble outputWeightsUpdate;           //The previous updates of the output layer, used for the momentum
+    VectorDouble outputBiasUpdate;
+    double inputLayerGamma;
+    double hiddenLayerGamma;
+    double outputLayerGamma;
+    
+    //The training buffers, each holds one row per example in the batch
+    VectorDouble batchInputs;
+    VectorDouble batchTargets;
+    VectorDouble batchInputLayerOutputs;
+    VectorDouble batchHiddenOutputs;
+    VectorDouble batchOutputs;
+    VectorDouble batchOutputDeltas;             //[numSamples numOutputNeurons]
+    VectorDouble batchOutputDeltasT;            //[numOutputNeurons numSamples], the output deltas stored per neuron
+    VectorDouble batchHiddenErrors;             //[numSamples numHiddenNeurons]
+    VectorDouble batchHiddenDeltasT;            //[numHiddenNeurons numSamples], the hidden deltas stored per neuron
+    VectorDouble hiddenWeightsGradient;
+    VectorDouble outputWeightsGradient;
+    
+    //The prediction buffers
+    VectorDouble predictionInputBuffer;
+    VectorDouble predictionHiddenBuffer;
 	vector< VectorDouble > trainingErrorLog;
     
     //Classifier Variables
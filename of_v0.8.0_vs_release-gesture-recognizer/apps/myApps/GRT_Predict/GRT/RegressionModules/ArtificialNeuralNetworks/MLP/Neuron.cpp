@@ -72,44 +72,11 @@ double Neuron::fire(const VectorDouble &inputs){
     
     y += bias;
     
-    switch( activationFunction ){
-        case(LINEAR):
-            break;
-        case(SIGMOID):
-			//Trick for stopping overflow
-			if( y < -45.0 ){ y = 0; }
-			else if( y > 45.0 ){ y = 1.0; }
-			else{
-				y = 1.0/(1.0+exp(-y));
-			}
-            break;
-        case(BIPOLAR_SIGMOID):
-			if( y < -45.0 ){ y = 0; }
-			else if( y > 45.0 ){ y = 1.0; }
-			else{
-				y = (2 / (1 + exp(-gamma * y))) - 1.0;
-			}
-            break;
-    }
-    return y;
-    
+    return activation(y,activationFunction,gamma);
 }
 
 double Neuron::der(double y){
-
-	double yy = 0;
-	switch( activationFunction ){
-        case(LINEAR):
-			yy = 1.0;
-            break;
-        case(SIGMOID):
-			yy = y * (1.0 - y);
-            break;
-        case(BIPOLAR_SIGMOID):
-			yy = (gamma * (1.0 - (y*y))) / 2.0;
-            break;
-    }
-    return yy;
+	return derivative(y,activationFunction,gamma);
 }
 
 }//End of namespace GRT
\ No newline at end of file
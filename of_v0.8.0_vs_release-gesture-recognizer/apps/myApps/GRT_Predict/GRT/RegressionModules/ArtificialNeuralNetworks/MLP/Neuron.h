@@ -35,6 +35,48 @@ public:
     double fire(const VectorDouble &inputs);
 	double der(double y);
 	bool validateActivationFunction(UINT actvationFunction);
+
+    /**
+     Applies the activation function to the weighted sum y of a neuron's inputs.
+     This is shared by the Neuron and the dense layers of the MLP, so both give the same result.
+     */
+    static inline double activation(double y,const UINT activationFunction,const double gamma){
+        switch( activationFunction ){
+            case(LINEAR):
+                break;
+            case(SIGMOID):
+                //Trick for stopping overflow
+                if( y < -45.0 ){ y = 0; }
+                else if( y > 45.0 ){ y = 1.0; }
+                else{
+                    y = 1.0/(1.0+exp(-y));
+                }
+                break;
+            case(BIPOLAR_SIGMOID):
+                if( y < -45.0 ){ y = 0; }
+                else if( y > 45.0 ){ y = 1.0; }
+                else{
+                    y = (2 / (1 + exp(-gamma * y))) - 1.0;
+                }
+                break;
+        }
+        return y;
+    }
+
+    /**
+     Computes the derivative of the activation function, given the output y of the neuron.
+     */
+    static inline double derivative(const double y,const UINT activationFunction,const double gamma){
+        switch( activationFunction ){
+            case(LINEAR):
+                return 1.0;
+            case(SIGMOID):
+                return y * (1.0 - y);
+            case(BIPOLAR_SIGMOID):
+                return (gamma * (1.0 - (y*y))) / 2.0;
+        }
+        return 0;
+    }
     
 	double gamma;
     double bias;
@@ -31,6 +31,8 @@ LinearRegression::LinearRegression(bool useScaling)
     minChange = 1.0e-10;
     maxNumIterations = 1000;
     learningRate = 0.01;
+    batchSize = 1;
+    validationSetSize = 0;
     regressifierType = "LinearRegression";
     debugLog.setProceedingText("[DEBUG LinearRegression]");
     errorLog.setProceedingText("[ERROR LinearRegression]");
@@ -47,6 +49,8 @@ LinearRegression& LinearRegression::operator=(const LinearRegression &rhs){
         this->learningRate = rhs.learningRate;
         this->minChange = rhs.minChange;
         this->maxNumIterations = rhs.maxNumIterations;
+        this->batchSize = rhs.batchSize;
+        this->validationSetSize = rhs.validationSetSize;
         this->w0 = rhs.w0;
         this->w = rhs.w;
         
@@ -103,6 +107,15 @@ bool LinearRegression::train(LabelledRegressionData &trainingData){
 		trainingData.scale(inputVectorRanges,targetVectorRanges,0.0,1.0);
 	}
     
+    //Copy the training data into one contiguous block for the gradient descent
+    VectorDouble inputs( (size_t)M*N );
+    VectorDouble targets( M );
+    for(UINT i=0; i<M; i++){
+        const VectorDouble &x = trainingData[i].getInputVector();
+        std::copy(x.begin(),x.end(),inputs.begin()+(size_t)i*N);
+        targets[i] = trainingData[i].getTargetVector()[0];
+    }
+    
     //Reset the weights
     Random rand;
     w0 = rand.getRandomNumberUniform(-0.1,0.1);
@@ -110,79 +123,40 @@ bool LinearRegression::train(LabelledRegressionData &trainingData){
     for(UINT j=0; j<N; j++){
         w[j] = rand.getRandomNumberUniform(-0.1,0.1);
     }
-
-    double error = 0;
-    double lastError = 0;
-    double delta = 0;
-    UINT iter = 0;
-    bool keepTraining = true;
-    Random random;
-    vector< UINT > randomTrainingOrder(M);
-    TrainingResult result;
-    trainingResults.reserve(M);
     
-    //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
-    //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
-    //training samples. This random order is then used at each epoch.
-    for(UINT i=0; i<M; i++){
-        randomTrainingOrder[i] = i;
+    //Run the main gradient descent training algorithm
+    MiniBatchGradientDescent gradientDescent;
+    gradientDescent.setLearningRate( learningRate );
+    gradientDescent.setMinChange( minChange );
+    gradientDescent.setMaxNumEpochs( maxNumIterations );
+    gradientDescent.setBatchSize( batchSize );
+    gradientDescent.setValidationSetSize( validationSetSize );
+    
+    if( !gradientDescent.train(inputs,targets,N,MiniBatchGradientDescent::IDENTITY_LINK,w0,w) ){
+        errorMessage = "train(LabelledRegressionData &trainingData) - Training failed! Total squared training error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue.";
+        errorLog << errorMessage << endl;
+        return false;
     }
-    std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
     
-    //Run the main stochastic gradient descent training algorithm
-    while( keepTraining ){
-        
-        //Run one epoch of training using stochastic gradient descent
-        totalSquaredTrainingError = 0;
-        for(UINT m=0; m<M; m++){
-            
-            //Select the random sample
-            UINT i = randomTrainingOrder[m];
-            
-            //Compute the error, given the current weights
-            VectorDouble x = trainingData[i].getInputVector();
-            VectorDouble y = trainingData[i].getTargetVector();
-            double h = w0;
-            for(UINT j=0; j<N; j++){
-                h += x[j] * w[j];
-            }
-            error = y[0] - h;
-            totalSquaredTrainingError += SQR(error);
-            
-            //Update the weights
-            for(UINT j=0; j<N; j++){
-                w[j] += learningRate  * error * x[j];
-            }
-            w0 += learningRate * error;
-        }
-        
-        //Compute the error
-        delta = fabs( totalSquaredTrainingError-lastError );
+    //Store the training results
+    const VectorDouble &trainingErrors = gradientDescent.getTrainingErrors();
+    const UINT numTrainingSamples = gradientDescent.getNumTrainingSamples();
+    TrainingResult result;
+    trainingResults.reserve( trainingErrors.size() );
+    double lastError = 0;
+    for(UINT iter=0; iter<trainingErrors.size(); iter++){
+        totalSquaredTrainingError = trainingErrors[iter];
+        rootMeanSquaredTrainingError = sqrt( totalSquaredTrainingError / double(numTrainingSamples) );
+        const double delta = fabs( totalSquaredTrainingError-lastError );
         lastError = totalSquaredTrainingError;
         
-        //Check to see if we should stop
-        if( delta <= minChange ){
-            keepTraining = false;
-        }
-        
-        if( isinf( totalSquaredTrainingError ) || isnan( totalSquaredTrainingError ) ){
-            errorMessage = "train(LabelledRegressionData &trainingData) - Training failed! Total squared training error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue.";
-            errorLog << errorMessage << endl;
-            return false;
-        }
-        
-        if( ++iter >= maxNumIterations ){
-            keepTraining = false;
-        }
-        
-        //Store the training results
-        result.setRegressionResult(iter,totalSquaredTrainingError,rootMeanSquaredTrainingError);
+        result.setRegressionResult(iter+1,totalSquaredTrainingError,rootMeanSquaredTrainingError);
         trainingResults.push_back( result );
         
         //Notify any observers of the new training data
         trainingResultsObserverManager.notifyObservers( result );
         
-        trainingLog << "Epoch: " << iter << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << endl;
+        trainingLog << "Epoch: " << iter+1 << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << endl;
     }
     
     //Flag that the algorithm has been trained
@@ -191,7 +165,7 @@ bool LinearRegression::train(LabelledRegressionData &trainingData){
     return trained;
 }
 
-bool LinearRegression::predict(VectorDouble inputVector){
+bool LinearRegression::predict_(VectorDouble &inputVector){
     
     if( !trained ){
         errorMessage = "predict(VectorDouble inputVector) - Model Not Trained!";
@@ -428,6 +402,22 @@ bool LinearRegression::setMaxNumIterations(UINT maxNumIterations){
     return false;
 }
     
+bool LinearRegression::setBatchSize(UINT batchSize){
+    if( batchSize > 0 ){
+        this->batchSize = batchSize;
+        return true;
+    }
+    return false;
+}
+
+bool LinearRegression::setValidationSetSize(UINT validationSetSize){
+    if( validationSetSize < 100 ){
+        this->validationSetSize = validationSetSize;
+        return true;
+    }
+    return false;
+}
+    
 double LinearRegression::getLearningRate(){
     return learningRate;
 }
@@ -440,5 +430,13 @@ UINT LinearRegression::getMaxNumIterations(){
     return maxNumIterations;
 }
 
+UINT LinearRegression::getBatchSize(){
+    return batchSize;
+}
+
+UINT LinearRegression::getValidationSetSize(){
+    return validationSetSize;
+}
+
 } //End of namespace GRT
 
@@ -77,12 +77,12 @@ public:
     
     /**
      This performs the regression by mapping the inputVector using the current Logistic Regression model.
-     This overrides the predict function in the Regressifier base class.
+     This overrides the predict_ function in the Regressifier base class.
      
-     @param VectorDouble inputVector: the input vector to classify
+     @param VectorDouble &inputVector: the input vector to classify, this is not copied so it may be modified by the prediction
      @return returns true if the prediction was performed, false otherwise
     */
-    virtual bool predict(VectorDouble inputVector);
+    virtual bool predict_(VectorDouble &inputVector);
     
     /**
      This saves the trained Logistic Regression model to a file.
@@ -147,6 +147,26 @@ public:
      */
     bool setMaxNumIterations(UINT maxNumIterations);
     
+    /**
+     Sets the number of training samples in each batch of the gradient descent. The weights are updated once per batch,
+     using the average gradient of the batch, so a batch size of 1 is stochastic gradient descent. Large batches are split
+     across several threads. The batchSize value must be greater than zero.
+     
+     @param UINT batchSize: the number of samples in each batch, must be greater than zero
+     @return returns true if the value was updated successfully, false otherwise
+     */
+    bool setBatchSize(UINT batchSize);
+    
+    /**
+     Sets the percentage of the training data that is held out to check for convergence. If this is greater than zero then the
+     training stops when the validation error stops changing and the weights with the lowest validation error are kept.
+     The validationSetSize value must be less than 100.
+     
+     @param UINT validationSetSize: the percentage of the training data held out for validation, zero disables the validation
+     @return returns true if the value was updated successfully, false otherwise
+     */
+    bool setValidationSetSize(UINT validationSetSize);
+    
     /**
      Gets the current learningRate value, this is value used to update the weights at each step of the stochastic gradient descent.
      
@@ -169,12 +189,28 @@ public:
      */
     UINT getMaxNumIterations();
 
+    /**
+     Gets the current batchSize value, this is the number of training samples used for each update of the weights.
+     
+     @return returns the batchSize value
+     */
+    UINT getBatchSize();
+    
+    /**
+     Gets the current validationSetSize value, this is the percentage of the training data held out to check for convergence.
+     
+     @return returns the validationSetSize value
+     */
+    UINT getValidationSetSize();
+
 private:
 	inline double sigmoid(double x);
 	
     double learningRate;
     double minChange;
     UINT maxNumIterations;
+    UINT batchSize;
+    UINT validationSetSize;
     double w0;
     VectorDouble w;
     static RegisterRegressifierModule< LogisticRegression > registerModule;
@@ -0,0 +1,263 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ A standalone micro-benchmark for the MatrixDouble multiply and covariance functions, and the LUDecomposition, Cholesky,
+ EigenvalueDecomposition and SVD classes. This is not part of the GRT library (or the GRT_Predict project), it only uses
+ the public interface of these classes, so the same file can be built against the current GRT sources and against an
+ older version of them (for example a git worktree checked out before a change to the linear algebra code).
+
+ Each run times every function on the same fixed random inputs and writes the timings and the results to a file. Running
+ the benchmark with --compare then prints the timings of the two runs side by side, together with the largest difference
+ between their results:
+
+     g++ -std=c++11 -O2 -pthread -I<old GRT> LinearAlgebraBenchmark.cpp <old GRT sources> -o benchmark_old
+     g++ -std=c++11 -O2 -pthread -I<GRT> LinearAlgebraBenchmark.cpp <GRT sources> -o benchmark_new
+     ./benchmark_old old.bin
+     ./benchmark_new new.bin
+     ./benchmark_new --compare old.bin new.bin
+ */
+
+#include "GRT.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+using namespace GRT;
+
+//The number of times each function is run, the reported time is the mean time of one run
+#define NUM_BENCHMARK_REPEATS 5
+
+struct BenchmarkResult{
+    string name;
+    double milliSeconds;
+    VectorDouble values;
+};
+
+static double getSeconds(){
+    return std::chrono::duration< double >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+static MatrixDouble getRandomMatrix(UINT rows,UINT cols,Random &random){
+    MatrixDouble m(rows,cols);
+    for(UINT i=0; i<rows; i++)
+        for(UINT j=0; j<cols; j++)
+            m[i][j] = random.getRandomNumberUniform(-1,1);
+    return m;
+}
+
+static void addValues(VectorDouble &values,Matrix<double> &m){
+    for(UINT i=0; i<m.getNumRows(); i++)
+        for(UINT j=0; j<m.getNumCols(); j++)
+            values.push_back( m[i][j] );
+}
+
+static vector< BenchmarkResult > runBenchmarks(){
+
+    vector< BenchmarkResult > results;
+    Random random( 42 );
+    BenchmarkResult result;
+    double startTime = 0;
+
+    //Multiply
+    {
+        MatrixDouble a = getRandomMatrix(400,300,random);
+        MatrixDouble b = getRandomMatrix(300,350,random);
+        MatrixDouble c;
+        startTime = getSeconds();
+        for(UINT r=0; r<NUM_BENCHMARK_REPEATS; r++) c = a.multiple( b );
+        result.name = "multiply 400x300x350";
+        result.milliSeconds = (getSeconds()-startTime)*1000.0/NUM_BENCHMARK_REPEATS;
+        result.values.clear();
+        addValues(result.values,c);
+        results.push_back( result );
+    }
+
+    //Covariance
+    {
+        MatrixDouble a = getRandomMatrix(20000,64,random);
+        MatrixDouble c;
+        startTime = getSeconds();
+        for(UINT r=0; r<NUM_BENCHMARK_REPEATS; r++) c = a.getCovarianceMatrix();
+        result.name = "covariance 20000x64";
+        result.milliSeconds = (getSeconds()-startTime)*1000.0/NUM_BENCHMARK_REPEATS;
+        result.values.clear();
+        addValues(result.values,c);
+        results.push_back( result );
+    }
+
+    //LU inverse, the diagonal is boosted so the matrix is well conditioned
+    {
+        MatrixDouble a = getRandomMatrix(300,300,random);
+        for(UINT i=0; i<300; i++) a[i][i] += 10;
+        MatrixDouble inv;
+        startTime = getSeconds();
+        for(UINT r=0; r<NUM_BENCHMARK_REPEATS; r++){
+            LUDecomposition lu( a );
+            lu.inverse( inv );
+        }
+        result.name = "LU inverse 300";
+        result.milliSeconds = (getSeconds()-startTime)*1000.0/NUM_BENCHMARK_REPEATS;
+        result.values.clear();
+        addValues(result.values,inv);
+        results.push_back( result );
+    }
+
+    //Cholesky inverse of a*a' + I
+    {
+        MatrixDouble a = getRandomMatrix(300,300,random);
+        MatrixDouble at = a;
+        at.transpose();
+        MatrixDouble s = a.multiple( at );
+        for(UINT i=0; i<300; i++) s[i][i] += 1;
+        Matrix<double> inv;
+        startTime = getSeconds();
+        for(UINT r=0; r<NUM_BENCHMARK_REPEATS; r++){
+            Cholesky cholesky( s );
+            cholesky.inverse( inv );
+        }
+        result.name = "Cholesky inverse 300";
+        result.milliSeconds = (getSeconds()-startTime)*1000.0/NUM_BENCHMARK_REPEATS;
+        result.values.clear();
+        addValues(result.values,inv);
+        results.push_back( result );
+    }
+
+    //Symmetric eigenvalue decomposition of a*a', only the eigenvalues are compared as the sign of each eigenvector is arbitrary
+    {
+        MatrixDouble a = getRandomMatrix(200,200,random);
+        MatrixDouble at = a;
+        at.transpose();
+        MatrixDouble s = a.multiple( at );
+        EigenvalueDecomposition eig;
+        startTime = getSeconds();
+        for(UINT r=0; r<NUM_BENCHMARK_REPEATS; r++) eig.decompose( s );
+        result.name = "symmetric eigen 200";
+        result.milliSeconds = (getSeconds()-startTime)*1000.0/NUM_BENCHMARK_REPEATS;
+        result.values = eig.getRealEigenvalues();
+        results.push_back( result );
+    }
+
+    //SVD, only the singular values are compared as the sign of each singular vector is arbitrary
+    {
+        MatrixDouble a = getRandomMatrix(300,150,random);
+        SVD svd;
+        startTime = getSeconds();
+        for(UINT r=0; r<NUM_BENCHMARK_REPEATS; r++) svd.solve( a );
+        result.name = "SVD 300x150";
+        result.milliSeconds = (getSeconds()-startTime)*1000.0/NUM_BENCHMARK_REPEATS;
+        result.values = svd.getW();
+        results.push_back( result );
+    }
+
+    return results;
+}
+
+static bool saveResults(const vector< BenchmarkResult > &results,const char *filename){
+    FILE *file = fopen(filename,"wb");
+    if( file == NULL ) return false;
+    const UINT numResults = (UINT)results.size();
+    fwrite(&numResults,sizeof(UINT),1,file);
+    for(UINT i=0; i<numResults; i++){
+        const UINT nameLength = (UINT)results[i].name.size();
+        const UINT numValues = (UINT)results[i].values.size();
+        fwrite(&nameLength,sizeof(UINT),1,file);
+        fwrite(results[i].name.c_str(),1,nameLength,file);
+        fwrite(&results[i].milliSeconds,sizeof(double),1,file);
+        fwrite(&numValues,sizeof(UINT),1,file);
+        if( numValues > 0 ) fwrite(&results[i].values[0],sizeof(double),numValues,file);
+    }
+    fclose(file);
+    return true;
+}
+
+static bool loadResults(vector< BenchmarkResult > &results,const char *filename){
+    FILE *file = fopen(filename,"rb");
+    if( file == NULL ) return false;
+    UINT numResults = 0;
+    bool ok = fread(&numResults,sizeof(UINT),1,file) == 1;
+    results.resize( ok ? numResults : 0 );
+    for(UINT i=0; i<results.size() && ok; i++){
+        UINT nameLength = 0;
+        UINT numValues = 0;
+        ok = fread(&nameLength,sizeof(UINT),1,file) == 1;
+        if( ok ){
+            results[i].name.resize( nameLength );
+            ok = nameLength == 0 || fread(&results[i].name[0],1,nameLength,file) == nameLength;
+        }
+        ok = ok && fread(&results[i].milliSeconds,sizeof(double),1,file) == 1;
+        ok = ok && fread(&numValues,sizeof(UINT),1,file) == 1;
+        if( ok ){
+            results[i].values.resize( numValues );
+            ok = numValues == 0 || fread(&results[i].values[0],sizeof(double),numValues,file) == numValues;
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
+static int compareResults(const char *oldFilename,const char *newFilename){
+    vector< BenchmarkResult > oldResults;
+    vector< BenchmarkResult > newResults;
+    if( !loadResults(oldResults,oldFilename) || !loadResults(newResults,newFilename) ){
+        printf("Failed to load the results files!\n");
+        return 1;
+    }
+    if( oldResults.size() != newResults.size() ){
+        printf("The results files contain a different number of benchmarks!\n");
+        return 1;
+    }
+    printf("%-24s %12s %12s %10s %14s\n","benchmark","old (ms)","new (ms)","speedup","max diff");
+    for(UINT i=0; i<newResults.size(); i++){
+        if( oldResults[i].values.size() != newResults[i].values.size() ){
+            printf("%-24s the results have a different size!\n",newResults[i].name.c_str());
+            continue;
+        }
+        double maxDiff = 0;
+        for(UINT j=0; j<newResults[i].values.size(); j++){
+            const double diff = fabs( oldResults[i].values[j] - newResults[i].values[j] );
+            if( diff > maxDiff ) maxDiff = diff;
+        }
+        printf("%-24s %12.2f %12.2f %9.2fx %14.3g\n",newResults[i].name.c_str(),oldResults[i].milliSeconds,newResults[i].milliSeconds,oldResults[i].milliSeconds/newResults[i].milliSeconds,maxDiff);
+    }
+    return 0;
+}
+
+int main(int argc,char **argv){
+
+    if( argc == 4 && strcmp(argv[1],"--compare") == 0 ){
+        return compareResults(argv[2],argv[3]);
+    }
+
+    if( argc != 2 ){
+        printf("usage: %s <results file>\n       %s --compare <old results file> <new results file>\n",argv[0],argv[0]);
+        return 1;
+    }
+
+    vector< BenchmarkResult > results = runBenchmarks();
+    for(UINT i=0; i<results.size(); i++){
+        printf("%-24s %10.2f ms\n",results[i].name.c_str(),results[i].milliSeconds);
+    }
+
+    if( !saveResults(results,argv[1]) ){
+        printf("Failed to save the results to %s!\n",argv[1]);
+        return 1;
+    }
+
+    return 0;
+}
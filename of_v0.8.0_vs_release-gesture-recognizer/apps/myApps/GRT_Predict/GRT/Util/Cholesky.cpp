@@ -25,6 +25,9 @@
 
 namespace GRT{
 
+//The number of rows in each parallel task of the decomposition
+#define GRT_CHOLESKY_TASK_ROWS 16
+
 Cholesky::Cholesky(){
 	debugLog.setProceedingText("[DEBUG LUdcmp]");
     errorLog.setProceedingText("[ERROR LUdcmp]");
@@ -40,7 +43,7 @@ Cholesky::Cholesky(Matrix<double> &a) : N(a.getNumRows()), el(a) {
     warningLog.setProceedingText("[WARNING LUdcmp]");
     success = false;
     
-	int i,j,k; //k has to an int (rather than a UINT)
+	int i,j;
  	VectorDouble tmp;
 	double sum = 0;
 	if( el.getNumCols() != N ){
@@ -50,16 +53,26 @@ Cholesky::Cholesky(Matrix<double> &a) : N(a.getNumRows()), el(a) {
 
 	const int n = int(N);
 	for (i=0;i<n;i++) {
-		for (j=i;j<n;j++) {
-			for (sum=el[i][j],k=i-1;k>=0;k--) sum -= el[i][k]*el[j][k];
-			if (i == j) {
-				if (sum <= 0.0){
-					errorLog << "Sum is <=0.0" << endl;
-                    return;
-				}
-				el[i][i]=sqrt(sum);
-			}else el[j][i]=sum/el[i][i];
+		//The sums over k < i are dot products of the rows of the lower triangle, which are contiguous
+		sum = el[i][i] - SIMD::dot(el[i],el[i],i);
+		if (sum <= 0.0){
+			errorLog << "Sum is <=0.0" << endl;
+			return;
 		}
+		el[i][i]=sqrt(sum);
+		
+		//Each row below the diagonal is independent, so large matrices are split across several threads
+		const UINT numRows = N-i-1;
+		const UINT numTasks = (numRows + GRT_CHOLESKY_TASK_ROWS - 1) / GRT_CHOLESKY_TASK_ROWS;
+		const double work = double(numRows) * double(i);
+		const UINT numWorkers = work >= GRT_MATRIX_MIN_PARALLEL_WORK ? Parallel::getNumWorkers( numTasks ) : 1;
+		Parallel::forEach(numTasks,numWorkers,[&](UINT workerIndex,UINT task){
+			const UINT rowStart = i+1 + task*GRT_CHOLESKY_TASK_ROWS;
+			const UINT rowEnd = rowStart+GRT_CHOLESKY_TASK_ROWS < N ? rowStart+GRT_CHOLESKY_TASK_ROWS : N;
+			for(UINT r=rowStart; r<rowEnd; r++){
+				el[r][i] = (el[i][r] - SIMD::dot(el[i],el[r],i)) / el[i][i];
+			}
+		});
 	}
 	for(i=0; i<n; i++) 
 		for (j=0; j<i; j++) 
@@ -78,7 +91,7 @@ bool Cholesky::solve(VectorDouble &b,VectorDouble &x) {
 		return false;
 	}
 	for(i=0; i<n; i++) {
-		for(sum=b[i],k=i-1;k>=0;k--) sum -= el[i][k]*x[k];
+		sum = b[i] - SIMD::dot(el[i],&x[0],i);
 		x[i]=sum/el[i][i];
 	}
 	for (i=n-1; i>=0; i--) {
@@ -102,7 +115,7 @@ bool Cholesky::elmult(VectorDouble &y,VectorDouble &b){
 }
 
 bool Cholesky::elsolve(VectorDouble &b,VectorDouble &y){
-	UINT i,j;
+	UINT i;
 	double sum = 0;
 	
 	if (b.size() != N || y.size() != N){
@@ -110,7 +123,7 @@ bool Cholesky::elsolve(VectorDouble &b,VectorDouble &y){
 		return false;
 	}
 	for (i=0; i<N; i++) {
-		for (sum=b[i],j=0; j<i; j++) sum -= el[i][j]*y[j];
+		sum = b[i] - SIMD::dot(el[i],&y[0],i);
 		y[i] = sum/el[i][i];
 	}
     return true;
@@ -122,14 +135,16 @@ bool Cholesky::inverse(Matrix<double> &ainv){
 	double sum = 0;
 	ainv.resize(N,N);
 	
+	//Keep a transposed copy of the factor, so the second pass can read the columns of el as contiguous rows
+	Matrix<double> elt(N,N);
+	for(i=0; i<n; i++) for(k=0; k<n; k++) elt[i][k] = el[k][i];
+	
 	for(i=0; i<n; i++) for(j=0; j<=i; j++){
-		sum = (i==j? 1. : 0.);
-		for(k=i-1; k>=j; k--) sum -= el[i][k]*ainv[j][k];
+		sum = (i==j? 1. : 0.) - SIMD::dot(el[i]+j,ainv[j]+j,i-j);
 		ainv[j][i]= sum/el[i][i];
 	}
 	for(i=n-1; i>=0; i--) for(j=0; j<=i; j++){
-		sum = (i<j? 0. : ainv[j][i]);
-		for(k=i+1; k<n; k++) sum -= el[k][i]*ainv[j][k];
+		sum = ainv[j][i] - SIMD::dot(elt[i]+i+1,ainv[j]+i+1,n-i-1);
 		ainv[i][j] = ainv[j][i] = sum/el[i][i];
 	}		
     return true;
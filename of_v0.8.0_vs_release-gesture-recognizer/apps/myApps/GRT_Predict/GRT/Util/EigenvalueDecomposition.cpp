@@ -16,6 +16,7 @@
  */
 
 #include "EigenvalueDecomposition.h"
+#include "SIMD.h"
 
 namespace GRT{
    
@@ -76,6 +77,8 @@ bool EigenvalueDecomposition::decompose(const MatrixDouble &a){
     
 void EigenvalueDecomposition::tred2(){
     
+    VectorDouble work(n);
+    
     for(int j = 0; j < n; j++) {
         realEigenvalues[j] = eigenvectors[n-1][j];
     }
@@ -116,15 +119,15 @@ void EigenvalueDecomposition::tred2(){
             }
             
             // Apply similarity transformation to remaining columns.
+            // This is the product of the symmetric matrix stored in the lower triangle with the Householder vector,
+            // computed a row at a time so the rows of the lower triangle are read contiguously.
             for (int j = 0; j < i; j++) {
-                f = realEigenvalues[j];
-                eigenvectors[j][i] = f;
-                g = complexEigenvalues[j] + eigenvectors[j][j] * f;
-                for (int k = j+1; k <= i-1; k++) {
-                    g += eigenvectors[k][j] * realEigenvalues[k];
-                    complexEigenvalues[k] += eigenvectors[k][j] * f;
-                }
-                complexEigenvalues[j] = g;
+                eigenvectors[j][i] = realEigenvalues[j];
+            }
+            for (int k = 0; k < i; k++) {
+                const double *row = eigenvectors[k];
+                complexEigenvalues[k] += row[k] * realEigenvalues[k] + SIMD::dot(row,&realEigenvalues[0],k);
+                SIMD::multiplyAdd(realEigenvalues[k],row,&complexEigenvalues[0],k);
             }
             f = 0.0;
             for (int j = 0; j < i; j++) {
@@ -135,12 +138,15 @@ void EigenvalueDecomposition::tred2(){
             for (int j = 0; j < i; j++) {
                 complexEigenvalues[j] -= hh * realEigenvalues[j];
             }
-            for (int j = 0; j < i; j++) {
-                f = realEigenvalues[j];
-                g = complexEigenvalues[j];
-                for (int k = j; k <= i-1; k++) {
-                    eigenvectors[k][j] -= (f * complexEigenvalues[k] + g * realEigenvalues[k]);
+            for (int k = 0; k < i; k++) {
+                double *row = eigenvectors[k];
+                const double ek = complexEigenvalues[k];
+                const double dk = realEigenvalues[k];
+                for (int j = 0; j <= k; j++) {
+                    row[j] -= (realEigenvalues[j] * ek + complexEigenvalues[j] * dk);
                 }
+            }
+            for (int j = 0; j < i; j++) {
                 realEigenvalues[j] = eigenvectors[i-1][j];
                 eigenvectors[i][j] = 0.0;
             }
@@ -157,14 +163,13 @@ void EigenvalueDecomposition::tred2(){
             for (int k = 0; k <= i; k++) {
                 realEigenvalues[k] = eigenvectors[k][i+1] / h;
             }
-            for (int j = 0; j <= i; j++) {
-                double g = 0.0;
-                for (int k = 0; k <= i; k++) {
-                    g += eigenvectors[k][i+1] * eigenvectors[k][j];
-                }
-                for (int k = 0; k <= i; k++) {
-                    eigenvectors[k][j] -= g * realEigenvalues[k];
-                }
+            // Compute g[j] for every column j at once, a row at a time, then apply the rank one update to each row
+            std::fill(work.begin(),work.begin()+i+1,0.0);
+            for (int k = 0; k <= i; k++) {
+                SIMD::multiplyAdd(eigenvectors[k][i+1],eigenvectors[k],&work[0],i+1);
+            }
+            for (int k = 0; k <= i; k++) {
+                SIMD::multiplyAdd(-realEigenvalues[k],&work[0],eigenvectors[k],i+1);
             }
         }
         for(int k = 0; k <= i; k++) {
@@ -188,6 +193,10 @@ void EigenvalueDecomposition::tql2(){
     }
     complexEigenvalues[n-1] = 0.0;
     
+    // The transformations are accumulated in the transpose of the eigenvector matrix, so each rotation is applied to two
+    // contiguous rows rather than two columns
+    eigenvectors.transpose();
+    
     double f = 0.0;
     double tst1 = 0.0;
     double eps = pow(2.0,-52.0);
@@ -247,11 +256,7 @@ void EigenvalueDecomposition::tql2(){
                     realEigenvalues[i+1] = h + s * (c * g + s * realEigenvalues[i]);
                     
                     // Accumulate transformation.
-                    for(int k = 0; k < n; k++) {
-                        h = eigenvectors[k][i+1];
-                        eigenvectors[k][i+1] = s * eigenvectors[k][i] + c * h;
-                        eigenvectors[k][i] = c * eigenvectors[k][i] - s * h;
-                    }
+                    SIMD::rotate(c,-s,eigenvectors[i],eigenvectors[i+1],n);
                 }
                 p = -s * s2 * c3 * el1 * complexEigenvalues[l] / dl1;
                 complexEigenvalues[l] = s * p;
@@ -277,13 +282,11 @@ void EigenvalueDecomposition::tql2(){
         if (k != i) {
             realEigenvalues[k] = realEigenvalues[i];
             realEigenvalues[i] = p;
-            for (int j = 0; j < n; j++) {
-                p = eigenvectors[j][i];
-                eigenvectors[j][i] = eigenvectors[j][k];
-                eigenvectors[j][k] = p;
-            }
+            std::swap_ranges(eigenvectors[i],eigenvectors[i]+n,eigenvectors[k]);
         }
     }
+    
+    eigenvectors.transpose();
     return;
 }
 
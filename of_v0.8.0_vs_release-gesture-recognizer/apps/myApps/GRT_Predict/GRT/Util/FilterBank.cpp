@@ -0,0 +1,173 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FilterBank.h"
+#include "SIMD.h"
+
+namespace GRT{
+
+FilterBank::FilterBank(){
+    errorLog.setProceedingText("[ERROR FilterBank]");
+    initialized = false;
+    numChannels = 0;
+    numFeedforwardCoefficients = 0;
+    numFeedbackCoefficients = 0;
+    inputIndex = 0;
+    outputIndex = 0;
+}
+
+FilterBank::~FilterBank(){}
+
+bool FilterBank::init(const VectorDouble &b,const VectorDouble &a,const UINT numChannels){
+
+    initialized = false;
+
+    if( numChannels == 0 ){
+        errorLog << "init(const VectorDouble &b,const VectorDouble &a,const UINT numChannels) - The number of channels must be greater than zero!" << endl;
+        return false;
+    }
+
+    if( b.size() == 0 ){
+        errorLog << "init(const VectorDouble &b,const VectorDouble &a,const UINT numChannels) - There must be at least one feedforward coefficient!" << endl;
+        return false;
+    }
+
+    this->numChannels = numChannels;
+    numFeedforwardCoefficients = (UINT)b.size();
+    numFeedbackCoefficients = a.size() > 0 ? (UINT)a.size()-1 : 0;
+    feedforwardCoefficients.resize( numFeedforwardCoefficients );
+    feedbackCoefficients.resize( numFeedbackCoefficients );
+    initialized = true;
+
+    if( !setCoefficients(b,a) ){
+        initialized = false;
+        return false;
+    }
+
+    return reset();
+}
+
+bool FilterBank::setCoefficients(const VectorDouble &b,const VectorDouble &a){
+
+    if( !initialized ){
+        errorLog << "setCoefficients(const VectorDouble &b,const VectorDouble &a) - Not initialized!" << endl;
+        return false;
+    }
+
+    const UINT numA = a.size() > 0 ? (UINT)a.size()-1 : 0;
+    if( b.size() != numFeedforwardCoefficients || numA != numFeedbackCoefficients ){
+        errorLog << "setCoefficients(const VectorDouble &b,const VectorDouble &a) - The number of coefficients does not match the number of coefficients of the filter!" << endl;
+        return false;
+    }
+
+    const double a0 = a.size() > 0 ? a[0] : 1.0;
+    if( a0 == 0 ){
+        errorLog << "setCoefficients(const VectorDouble &b,const VectorDouble &a) - The first feedback coefficient can not be zero!" << endl;
+        return false;
+    }
+
+    for(UINT i=0; i<numFeedforwardCoefficients; i++){
+        feedforwardCoefficients[i] = b[i] / a0;
+    }
+    for(UINT j=0; j<numFeedbackCoefficients; j++){
+        feedbackCoefficients[j] = -a[j+1] / a0;
+    }
+
+    return true;
+}
+
+bool FilterBank::reset(){
+
+    if( !initialized ) return false;
+
+    inputHistory.clear();
+    inputHistory.resize( 2*numFeedforwardCoefficients*numChannels, 0 );
+    outputHistory.clear();
+    outputHistory.resize( 2*numFeedbackCoefficients*numChannels, 0 );
+    inputIndex = 0;
+    outputIndex = 0;
+
+    return true;
+}
+
+bool FilterBank::filter(const double *x,double *y,const UINT numSamples){
+
+    if( !initialized ){
+        errorLog << "filter(const double *x,double *y,const UINT numSamples) - Not initialized!" << endl;
+        return false;
+    }
+
+    if( x == NULL || y == NULL ){
+        errorLog << "filter(const double *x,double *y,const UINT numSamples) - The input and output buffers can not be NULL!" << endl;
+        return false;
+    }
+
+    const UINT M = numFeedforwardCoefficients;
+    const UINT N = numFeedbackCoefficients;
+    const double *b = &feedforwardCoefficients[0];
+
+    for(UINT n=0; n<numSamples; n++){
+        const double *xn = x + n*numChannels;
+        double *yn = y + n*numChannels;
+
+        //Add the input to the history (before the output is written, in case the output buffer is the input buffer)
+        inputIndex = inputIndex == 0 ? M-1 : inputIndex-1;
+        double *row = &inputHistory[ inputIndex*numChannels ];
+        double *copy = row + M*numChannels;
+        for(UINT c=0; c<numChannels; c++){
+            row[c] = copy[c] = xn[c];
+        }
+
+        //The rows inputIndex ... inputIndex+M-1 now hold x[n], x[n-1], ... x[n-M+1]
+        if( numChannels == 1 ){
+            yn[0] = SIMD::dot( b, row, M );
+        }else{
+            for(UINT c=0; c<numChannels; c++){
+                yn[c] = b[0] * row[c];
+            }
+            for(UINT i=1; i<M; i++){
+                SIMD::multiplyAdd( b[i], row + i*numChannels, yn, numChannels );
+            }
+        }
+
+        if( N > 0 ){
+            //The rows outputIndex ... outputIndex+N-1 hold y[n-1], y[n-2], ... y[n-N]
+            const double *past = &outputHistory[ outputIndex*numChannels ];
+            if( numChannels == 1 ){
+                yn[0] += SIMD::dot( &feedbackCoefficients[0], past, N );
+            }else{
+                for(UINT j=0; j<N; j++){
+                    SIMD::multiplyAdd( feedbackCoefficients[j], past + j*numChannels, yn, numChannels );
+                }
+            }
+
+            outputIndex = outputIndex == 0 ? N-1 : outputIndex-1;
+            row = &outputHistory[ outputIndex*numChannels ];
+            copy = row + N*numChannels;
+            for(UINT c=0; c<numChannels; c++){
+                row[c] = copy[c] = yn[c];
+            }
+        }
+    }
+
+    return true;
+}
+
+} //End of namespace GRT
@@ -0,0 +1,119 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The FilterBank class applies the same linear filter (FIR or IIR) to a number of channels, for example each dimension of a
+ multidimensional signal. The filter is defined by its feedforward (b) and feedback (a) coefficients:
+ 
+ a[0]*y[n] = b[0]*x[n] + b[1]*x[n-1] + ... + b[M]*x[n-M] - a[1]*y[n-1] - ... - a[N]*y[n-N]
+ 
+ The past inputs and outputs of all the channels are stored interleaved (all the channels of one sample next to each other),
+ so each filter tap is a single multiply-add over all the channels, which can be vectorized. Each sample in the history is
+ stored twice in a buffer of twice the filter length, so the taps are always contiguous in memory and no modulo indexing is
+ needed. The filter functions read from and write to buffers supplied by the caller, and can filter a block of samples at once.
+ 
+ The history starts filled with zeros, so the filter behaves as a causal filter that has only seen zeros before the first sample.
+ */
+
+#ifndef GRT_FILTER_BANK_HEADER
+#define GRT_FILTER_BANK_HEADER
+
+#include "GRTTypedefs.h"
+#include "ErrorLog.h"
+using namespace std;
+
+namespace GRT{
+
+class FilterBank{
+public:
+    /**
+     Default Constructor.
+     */
+    FilterBank();
+
+    /**
+     Default Destructor.
+     */
+    ~FilterBank();
+
+    /**
+     Initializes the filter bank, all the past inputs and outputs will be set to zero.
+
+     @param const VectorDouble &b: the feedforward coefficients, b[i] is the coefficient of x[n-i]. Must contain at least one value
+     @param const VectorDouble &a: the feedback coefficients, a[j] is the coefficient of y[n-j]. This can be empty for an FIR filter, otherwise a[0] must not be zero
+     @param const UINT numChannels: the number of channels that should be filtered, must be greater than zero
+     @return returns true if the filter bank was initialized, false otherwise
+     */
+    bool init(const VectorDouble &b,const VectorDouble &a,const UINT numChannels);
+
+    /**
+     Updates the coefficients of the filter without resetting the past inputs and outputs. The number of coefficients must match
+     the number of coefficients the filter bank was initialized with.
+
+     @param const VectorDouble &b: the new feedforward coefficients
+     @param const VectorDouble &a: the new feedback coefficients
+     @return returns true if the coefficients were updated, false otherwise
+     */
+    bool setCoefficients(const VectorDouble &b,const VectorDouble &a);
+
+    /**
+     Sets all the past inputs and outputs back to zero.
+
+     @return returns true if the filter bank was reset, false if the filter bank has not been initialized
+     */
+    bool reset();
+
+    /**
+     Filters a block of samples. The samples are interleaved, so the value of channel c at sample i is x[ i*numChannels + c ].
+     The output can be the same buffer as the input.
+
+     @param const double *x: the input samples, this must contain numSamples*numChannels values
+     @param double *y: returns the filtered samples, this must have space for numSamples*numChannels values
+     @param const UINT numSamples: the number of samples in the block. Default value = 1
+     @return returns true if the samples were filtered, false otherwise
+     */
+    bool filter(const double *x,double *y,const UINT numSamples = 1);
+
+    bool getInitialized() const{ return initialized; }
+    UINT getNumChannels() const{ return numChannels; }
+    UINT getNumFeedforwardCoefficients() const{ return numFeedforwardCoefficients; }
+    UINT getNumFeedbackCoefficients() const{ return numFeedbackCoefficients; }
+
+protected:
+    bool initialized;
+    UINT numChannels;
+    UINT numFeedforwardCoefficients;        //The number of b coefficients (the current input and the past inputs)
+    UINT numFeedbackCoefficients;           //The number of past outputs used by the filter (the size of a minus one)
+    UINT inputIndex;                        //The row of the most recent input in the input history
+    UINT outputIndex;                       //The row of the most recent output in the output history
+    VectorDouble feedforwardCoefficients;   //b / a[0]
+    VectorDouble feedbackCoefficients;      //-a[1...N] / a[0], so each feedback tap is a multiply-add
+    VectorDouble inputHistory;              //2*numFeedforwardCoefficients rows of numChannels values
+    VectorDouble outputHistory;             //2*numFeedbackCoefficients rows of numChannels values
+    ErrorLog errorLog;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_FILTER_BANK_HEADER
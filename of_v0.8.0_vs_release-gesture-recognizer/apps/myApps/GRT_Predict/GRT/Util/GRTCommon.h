@@ -115,9 +115,14 @@ inline double SIGN(const double &a, const double &b) {return (b >= 0 ? (a >= 0 ?
 #include "TrainingResult.h"
 #include "TestResult.h"
 #include "CircularBuffer.h"
+#include "SlidingWindowStatistics.h"
+#include "FilterBank.h"
 #include "Timer.h"
 #include "Random.h"
 #include "Util.h"
+#include "SIMD.h"
+#include "Parallel.h"
+#include "MiniBatchGradientDescent.h"
 #include "EigenvalueDecomposition.h"
 #include "Cholesky.h"
 #include "LUDecomposition.h"
@@ -22,9 +22,15 @@
  */
 
 #include "LUDecomposition.h"
+#include "SIMD.h"
+#include "Parallel.h"
 
 namespace GRT {
 
+//The number of rows in each parallel task of the elimination, and the number of columns in each parallel task of solve
+#define GRT_LU_TASK_ROWS 16
+#define GRT_LU_BLOCK_COLS 64
+
 LUDecomposition::LUDecomposition(const MatrixDouble &a) : sing(false){
     
     debugLog.setProceedingText("[DEBUG LUDecomposition]");
@@ -73,11 +79,22 @@ LUDecomposition::LUDecomposition(const MatrixDouble &a) : sing(false){
 		}
 		indx[k]=imax;
 		if (lu[k][k] == 0.0) lu[k][k] = TINY;
-		for (i=k+1; i<N; i++) {
-			temp = lu[i][k] /= lu[k][k];
-			for (j=k+1;j<N;j++)
-				lu[i][j] -= temp * lu[k][j];
-		}
+		
+		//Eliminate column k from the rows below the pivot, each row is independent so large matrices are split across several threads
+		const unsigned int numRows = N-k-1;
+		const unsigned int numTasks = (numRows + GRT_LU_TASK_ROWS - 1) / GRT_LU_TASK_ROWS;
+		const double work = double(numRows) * double(numRows);
+		const unsigned int numWorkers = work >= GRT_MATRIX_MIN_PARALLEL_WORK ? Parallel::getNumWorkers( numTasks ) : 1;
+		const double *pivotRow = lu[k];
+		Parallel::forEach(numTasks,numWorkers,[&](unsigned int workerIndex,unsigned int task){
+			const unsigned int rowStart = k+1 + task*GRT_LU_TASK_ROWS;
+			const unsigned int rowEnd = rowStart+GRT_LU_TASK_ROWS < N ? rowStart+GRT_LU_TASK_ROWS : N;
+			for(unsigned int r=rowStart; r<rowEnd; r++){
+				double *row = lu[r];
+				const double factor = row[k] /= pivotRow[k];
+				SIMD::multiplyAdd(-factor,pivotRow+k+1,row+k+1,numRows);
+			}
+		});
 	}
 	
 }
@@ -118,17 +135,50 @@ bool LUDecomposition::solve_vector(const VectorDouble &b,VectorDouble &x)
 
 bool LUDecomposition::solve(const MatrixDouble &b,MatrixDouble &x)
 {
-	unsigned int m=b.getNumCols();
+	const unsigned int m=b.getNumCols();
 	if (b.getNumRows() != N || x.getNumRows() != N || b.getNumCols() != x.getNumCols() ){
         errorLog << "solve(const MatrixDouble &b,MatrixDouble &x) - the size of the two matrices does not match!" << endl;
 		return false;
     }
-	VectorDouble  xx(N);
-	for (unsigned int j=0; j<m; j++) {
-		for(unsigned int i=0; i<N; i++) xx[i] = b[i][j];
-		solve_vector(xx,xx);
-		for(unsigned int i=0; i<N; i++) x[i][j] = xx[i];
+	if( N == 0 || m == 0 ) return true;
+	
+	//Solve all the columns at once, working on rows of x so the substitutions are contiguous. This applies the same operations
+	//to each column, in the same order, as solve_vector
+	if( &b != &x ){
+		for(unsigned int i=0; i<N; i++) std::copy(b[i],b[i]+m,x[i]);
+	}
+	for(unsigned int i=0; i<N; i++){
+		if( indx[i] != int(i) ) std::swap_ranges(x[i],x[i]+m,x[ indx[i] ]);
 	}
+	
+	//The columns are independent, so blocks of columns can be solved in parallel
+	const unsigned int numBlocks = (m + GRT_LU_BLOCK_COLS - 1) / GRT_LU_BLOCK_COLS;
+	const double work = double(N) * double(N) * double(m);
+	const unsigned int numWorkers = work >= GRT_MATRIX_MIN_PARALLEL_WORK ? Parallel::getNumWorkers( numBlocks ) : 1;
+	Parallel::forEach(numBlocks,numWorkers,[&](unsigned int workerIndex,unsigned int block){
+		const unsigned int colStart = block*GRT_LU_BLOCK_COLS;
+		const unsigned int width = colStart+GRT_LU_BLOCK_COLS < m ? GRT_LU_BLOCK_COLS : m-colStart;
+		
+		//Forward substitution with the unit lower triangle
+		for(unsigned int i=1; i<N; i++){
+			double *xi = x[i] + colStart;
+			const double *l = lu[i];
+			for(unsigned int j=0; j<i; j++){
+				if( l[j] != 0.0 ) SIMD::multiplyAdd(-l[j],x[j]+colStart,xi,width);
+			}
+		}
+		
+		//Back substitution with the upper triangle
+		for(int i=int(N)-1; i>=0; i--){
+			double *xi = x[i] + colStart;
+			const double *u = lu[i];
+			for(unsigned int j=i+1; j<N; j++){
+				if( u[j] != 0.0 ) SIMD::multiplyAdd(-u[j],x[j]+colStart,xi,width);
+			}
+			for(unsigned int c=0; c<width; c++) xi[c] /= u[i];
+		}
+	});
+	
     return true;
 }
     
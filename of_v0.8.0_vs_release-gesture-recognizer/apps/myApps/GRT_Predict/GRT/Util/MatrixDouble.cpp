@@ -19,8 +19,20 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "MatrixDouble.h"
+#include "SIMD.h"
+#include "Parallel.h"
 
 namespace GRT{
+
+//The block sizes used by multiple(MatrixDouble), a [MULTIPLY_BLOCK_ROWS MULTIPLY_BLOCK_COLS] block of b is 128KB so it stays in the L2 cache
+#define GRT_MATRIX_MULTIPLY_BLOCK_ROWS 64
+#define GRT_MATRIX_MULTIPLY_BLOCK_COLS 256
+#define GRT_MATRIX_MULTIPLY_TASK_ROWS 16
+
+//The covariance matrix removes the mean from this many rows at a time, and uses at most this many chunks of rows
+#define GRT_MATRIX_COVARIANCE_BLOCK_ROWS 64
+#define GRT_MATRIX_COVARIANCE_MAX_NUM_CHUNKS 32
+#define GRT_MATRIX_COVARIANCE_MAX_CHUNK_VALUES 4194304
    
 MatrixDouble::MatrixDouble(){
     warningLog.setProceedingText("[WARNING MatrixDouble]");
@@ -185,10 +197,7 @@ VectorDouble MatrixDouble::multiple(const VectorDouble &b){
     VectorDouble c(M);
     
     for(unsigned int i=0; i<rows; i++){
-        c[i] = 0;
-        for(unsigned int j=0; j<cols; j++){
-            c[i] += dataPtr[i][j]*b[j];
-        }
+        c[i] = SIMD::dot(dataPtr[i],&b[0],cols);
     }
     
     return c;
@@ -207,28 +216,48 @@ MatrixDouble MatrixDouble::multiple(const MatrixDouble &b){
     }
     
     MatrixDouble c(M,L);
-    
-    for(unsigned int i=0; i<M; i++){
-        for(unsigned int j=0; j<L; j++){
-            c[i][j] = 0;
-            for(unsigned int k=0; k<K; k++){
-                c[i][j] += dataPtr[i][k] * b[k][j];
+    if( M == 0 || L == 0 ) return c;
+    
+    //Each task computes a block of rows of c. Within a task, c[i][j] += a[i][k] * b[k][j] is run over blocks of b, in k order,
+    //so each block of b is reused by all the rows of the task while it is in the cache
+    const unsigned int numTasks = (M + GRT_MATRIX_MULTIPLY_TASK_ROWS - 1) / GRT_MATRIX_MULTIPLY_TASK_ROWS;
+    const double work = double(M) * double(K) * double(L);
+    const unsigned int numWorkers = work >= GRT_MATRIX_MIN_PARALLEL_WORK ? Parallel::getNumWorkers( numTasks ) : 1;
+    Parallel::forEach(numTasks,numWorkers,[&](unsigned int workerIndex,unsigned int task){
+        const unsigned int rowStart = task*GRT_MATRIX_MULTIPLY_TASK_ROWS;
+        const unsigned int rowEnd = rowStart+GRT_MATRIX_MULTIPLY_TASK_ROWS < M ? rowStart+GRT_MATRIX_MULTIPLY_TASK_ROWS : M;
+        
+        for(unsigned int i=rowStart; i<rowEnd; i++){
+            std::fill(c[i],c[i]+L,0.0);
+        }
+        
+        for(unsigned int jb=0; jb<L; jb+=GRT_MATRIX_MULTIPLY_BLOCK_COLS){
+            const unsigned int width = jb+GRT_MATRIX_MULTIPLY_BLOCK_COLS < L ? GRT_MATRIX_MULTIPLY_BLOCK_COLS : L-jb;
+            for(unsigned int kb=0; kb<K; kb+=GRT_MATRIX_MULTIPLY_BLOCK_ROWS){
+                const unsigned int ke = kb+GRT_MATRIX_MULTIPLY_BLOCK_ROWS < K ? kb+GRT_MATRIX_MULTIPLY_BLOCK_ROWS : K;
+                for(unsigned int i=rowStart; i<rowEnd; i++){
+                    const double *a = dataPtr[i];
+                    double *ci = c[i] + jb;
+                    for(unsigned int k=kb; k<ke; k++){
+                        SIMD::multiplyAdd(a[k],b[k]+jb,ci,width);
+                    }
+                }
             }
         }
-    }
+    });
     
     return c;
 }
     
 VectorDouble MatrixDouble::getMean() const{
     
-    VectorDouble mean(cols);
+    VectorDouble mean(cols,0);
+    if( rows == 0 ) return mean;
     
+    for(unsigned int r=0; r<rows; r++){
+        SIMD::multiplyAdd(1.0,dataPtr[r],&mean[0],cols);
+    }
     for(unsigned int c=0; c<cols; c++){
-        mean[c] = 0;
-        for(unsigned int r=0; r<rows; r++){
-            mean[c] += dataPtr[r][c];
-        }
         mean[c] /= double( rows );
     }
     
@@ -240,10 +269,13 @@ VectorDouble MatrixDouble::getStdDev() const{
     VectorDouble mean = getMean();
 	VectorDouble stdDev(cols,0);
 	
-	for(unsigned int j=0; j<cols; j++){
-		for(unsigned int i=0; i<rows; i++){
-			stdDev[j] += (dataPtr[i][j]-mean[j])*(dataPtr[i][j]-mean[j]);
+	for(unsigned int i=0; i<rows; i++){
+		const double *x = dataPtr[i];
+		for(unsigned int j=0; j<cols; j++){
+			stdDev[j] += (x[j]-mean[j])*(x[j]-mean[j]);
 		}
+	}
+	for(unsigned int j=0; j<cols; j++){
 		stdDev[j] = sqrt( stdDev[j] / double(rows-1) );
 	}
     return stdDev;
@@ -251,16 +283,68 @@ VectorDouble MatrixDouble::getStdDev() const{
 
 MatrixDouble MatrixDouble::getCovarianceMatrix() const{
     
-    vector<double> mean = getMean();
-    MatrixDouble covMatrix(cols,cols);
-    
-    for(unsigned int j=0; j<cols; j++){
-        for(unsigned int k=0; k<cols; k++){
-            covMatrix[j][k] = 0;
-            for(unsigned int i=0; i<rows; i++){
-                covMatrix[j][k] += (dataPtr[i][j]-mean[j]) * (dataPtr[i][k]-mean[k]);
+    const unsigned int M = rows;
+    const unsigned int N = cols;
+    MatrixDouble covMatrix(N,N);
+    if( N == 0 ) return covMatrix;
+    covMatrix.setAllValues( 0 );
+    if( M == 0 ) return covMatrix;
+    
+    const VectorDouble mean = getMean();
+    
+    //Split the rows into chunks, the chunks only depend on the size of the matrix so the sums do not depend on the number of threads.
+    //Each chunk has its own [N N] buffer, so the number of chunks is also limited by the size of the matrix
+    const double workPerRow = 0.5 * double(N) * double(N+1);
+    unsigned int minChunkSize = (unsigned int)( GRT_MATRIX_MIN_PARALLEL_WORK / workPerRow );
+    if( minChunkSize < GRT_MATRIX_COVARIANCE_BLOCK_ROWS ) minChunkSize = GRT_MATRIX_COVARIANCE_BLOCK_ROWS;
+    unsigned int maxNumChunks = (unsigned int)( GRT_MATRIX_COVARIANCE_MAX_CHUNK_VALUES / ((size_t)N*N) );
+    if( maxNumChunks > GRT_MATRIX_COVARIANCE_MAX_NUM_CHUNKS ) maxNumChunks = GRT_MATRIX_COVARIANCE_MAX_NUM_CHUNKS;
+    if( maxNumChunks == 0 ) maxNumChunks = 1;
+    unsigned int numChunks = (M + minChunkSize - 1) / minChunkSize;
+    if( numChunks > maxNumChunks ) numChunks = maxNumChunks;
+    const unsigned int chunkSize = (M + numChunks - 1) / numChunks;
+    
+    VectorDouble chunkSums( (size_t)numChunks*N*N, 0 );
+    Parallel::forEach(numChunks,[&](unsigned int workerIndex,unsigned int chunk){
+        const unsigned int chunkStart = chunk*chunkSize;
+        const unsigned int chunkEnd = chunkStart+chunkSize < M ? chunkStart+chunkSize : M;
+        double *sum = &chunkSums[ (size_t)chunk*N*N ];
+        VectorDouble block( (size_t)GRT_MATRIX_COVARIANCE_BLOCK_ROWS*N );
+        
+        for(unsigned int blockStart=chunkStart; blockStart<chunkEnd; blockStart+=GRT_MATRIX_COVARIANCE_BLOCK_ROWS){
+            const unsigned int blockEnd = blockStart+GRT_MATRIX_COVARIANCE_BLOCK_ROWS < chunkEnd ? blockStart+GRT_MATRIX_COVARIANCE_BLOCK_ROWS : chunkEnd;
+            const unsigned int blockSize = blockEnd - blockStart;
+            
+            //Remove the mean from the rows of the block
+            for(unsigned int i=0; i<blockSize; i++){
+                const double *x = dataPtr[ blockStart+i ];
+                double *d = &block[ (size_t)i*N ];
+                for(unsigned int j=0; j<N; j++) d[j] = x[j] - mean[j];
+            }
+            
+            //Add the outer products of the block to the upper triangle, one row of the covariance matrix at a time so it stays in the cache
+            for(unsigned int j=0; j<N; j++){
+                double *s = sum + (size_t)j*N;
+                for(unsigned int i=0; i<blockSize; i++){
+                    const double *d = &block[ (size_t)i*N ];
+                    SIMD::multiplyAdd(d[j],d+j,s+j,N-j);
+                }
             }
-            covMatrix[j][k] /= double(rows-1);
+        }
+    });
+    
+    //Add up the chunks in order, then copy the upper triangle to the lower triangle so the matrix is exactly symmetric
+    for(unsigned int chunk=0; chunk<numChunks; chunk++){
+        const double *sum = &chunkSums[ (size_t)chunk*N*N ];
+        for(unsigned int j=0; j<N; j++){
+            SIMD::multiplyAdd(1.0,sum+(size_t)j*N+j,covMatrix[j]+j,N-j);
+        }
+    }
+    
+    for(unsigned int j=0; j<N; j++){
+        for(unsigned int k=j; k<N; k++){
+            covMatrix[j][k] /= double(M-1);
+            covMatrix[k][j] = covMatrix[j][k];
         }
     }
     
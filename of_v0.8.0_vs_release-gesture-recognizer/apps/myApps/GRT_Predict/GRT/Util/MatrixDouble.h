@@ -37,6 +37,9 @@ using namespace std;
 
 namespace GRT{
 
+//The number of multiply-adds a matrix function must do before it splits its work across several threads
+#define GRT_MATRIX_MIN_PARALLEL_WORK 262144
+
 class MatrixDouble : public Matrix<double>{
 public:
     MatrixDouble();
@@ -64,11 +67,19 @@ public:
     /**
      Performs the multiplcation of this matrix by the matrix b.
      c = a * b;
+     The product is computed in cache sized blocks of b, and large products are split across several threads by rows of c.
+     Each element of c is always summed in the same order, so the result does not depend on the number of threads.
      */
     MatrixDouble multiple(const MatrixDouble &b);
     
     VectorDouble getMean() const;
     VectorDouble getStdDev() const;
+    
+    /**
+     Gets the [cols cols] sample covariance matrix of the rows of this matrix.
+     The mean is removed from blocks of rows, which then update the upper triangle of the covariance matrix row by row.
+     Large matrices are split into fixed chunks of rows that are summed in parallel and then added up in chunk order.
+     */
     MatrixDouble getCovarianceMatrix() const;
     
     std::vector< MinMax > getRanges() const;
@@ -0,0 +1,280 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MiniBatchGradientDescent.h"
+
+namespace GRT{
+
+//The number of multiply-adds in each chunk of a batch, this needs to be large enough to cover the cost of starting a thread
+#define GRT_MBGD_MIN_CHUNK_WORK 65536
+#define GRT_MBGD_MIN_CHUNK_SIZE 256
+
+MiniBatchGradientDescent::MiniBatchGradientDescent(){
+    learningRate = 0.01;
+    minChange = 1.0e-10;
+    maxNumEpochs = 1000;
+    batchSize = 1;
+    validationSetSize = 0;
+    randomSeed = 0;
+    inputs = NULL;
+    targets = NULL;
+    numDimensions = 0;
+    linkFunction = IDENTITY_LINK;
+    numTrainingSamples = 0;
+    w0 = 0;
+    errorLog.setProceedingText("[ERROR MiniBatchGradientDescent]");
+}
+
+MiniBatchGradientDescent::~MiniBatchGradientDescent(){
+}
+
+bool MiniBatchGradientDescent::train(const VectorDouble &inputs,const VectorDouble &targets,const UINT numDimensions,const UINT linkFunction,double &w0,VectorDouble &w){
+
+    const UINT M = (UINT)targets.size();
+    const UINT N = numDimensions;
+    trainingErrors.clear();
+    validationErrors.clear();
+    numTrainingSamples = 0;
+
+    if( M == 0 ){
+        errorLog << "train(...) - There are no training samples!" << endl;
+        return false;
+    }
+
+    if( inputs.size() != (size_t)M*N || w.size() != N ){
+        errorLog << "train(...) - The size of the inputs or weights does not match the number of dimensions!" << endl;
+        return false;
+    }
+
+    if( linkFunction != IDENTITY_LINK && linkFunction != LOGISTIC_LINK ){
+        errorLog << "train(...) - Unknown link function: " << linkFunction << endl;
+        return false;
+    }
+
+    this->inputs = &inputs[0];
+    this->targets = &targets[0];
+    this->numDimensions = N;
+    this->linkFunction = linkFunction;
+    this->w0 = w0;
+    this->w = w;
+
+    //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
+    //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
+    //training samples. This random order is then used at each epoch.
+    Random random( randomSeed );
+    sampleOrder.resize(M);
+    for(UINT i=0; i<M; i++){
+        sampleOrder[i] = i;
+    }
+    for(UINT i=M-1; i>0; i--){
+        std::swap(sampleOrder[i],sampleOrder[ random.getRandomNumberInt(0,i+1) ]);
+    }
+
+    //Hold the last part of the random order out for validation, if needed
+    UINT numValidationSamples = (UINT)( (unsigned long long)M * validationSetSize / 100 );
+    if( numValidationSamples >= M ) numValidationSamples = 0;
+    numTrainingSamples = M - numValidationSamples;
+
+    const UINT B = batchSize < numTrainingSamples ? batchSize : numTrainingSamples;
+    const UINT chunkSize = getChunkSize();
+    const UINT maxNumChunks = (B + chunkSize - 1) / chunkSize;
+    chunkGradients.resize( maxNumChunks*(N+1) );
+    chunkErrors.resize( maxNumChunks );
+
+    double lastError = 0;
+    double bestValidationError = numeric_limits< double >::max();
+    double bestW0 = this->w0;
+    VectorDouble bestW = this->w;
+    UINT epoch = 0;
+    bool keepTraining = true;
+
+    while( keepTraining ){
+
+        //Run one epoch of training
+        double totalSquaredError = 0;
+        for(UINT batchStart=0; batchStart<numTrainingSamples; batchStart+=B){
+            const UINT batchEnd = batchStart+B < numTrainingSamples ? batchStart+B : numTrainingSamples;
+
+            if( batchEnd-batchStart == 1 ){
+                //Stochastic gradient descent, the update can be applied directly without storing the gradient
+                const UINT i = sampleOrder[batchStart];
+                const double *x = this->inputs + (size_t)i*N;
+                const double error = this->targets[i] - compute(x,N,linkFunction,this->w0,&this->w[0]);
+                totalSquaredError += error*error;
+                SIMD::multiplyAdd(learningRate*error,x,&this->w[0],N);
+                this->w0 += learningRate*error;
+                continue;
+            }
+
+            //Accumulate the gradient of each chunk of the batch, the chunks are independent so they can run in parallel
+            const UINT numChunks = (batchEnd - batchStart + chunkSize - 1) / chunkSize;
+            Parallel::forEach(numChunks,[&](UINT workerIndex,UINT c){
+                const UINT start = batchStart + c*chunkSize;
+                const UINT end = start+chunkSize < batchEnd ? start+chunkSize : batchEnd;
+                double *gradient = &chunkGradients[c*(N+1)];
+                std::fill(gradient,gradient+N+1,0.0);
+                chunkErrors[c] = accumulateGradient(start,end,gradient);
+            });
+
+            //Sum the chunks in order, so the result does not depend on which worker ran each chunk
+            double *gradient = &chunkGradients[0];
+            totalSquaredError += chunkErrors[0];
+            for(UINT c=1; c<numChunks; c++){
+                SIMD::multiplyAdd(1.0,&chunkGradients[c*(N+1)],gradient,N+1);
+                totalSquaredError += chunkErrors[c];
+            }
+
+            //Update the weights using the average gradient of the batch
+            const double stepSize = learningRate / double(batchEnd-batchStart);
+            SIMD::multiplyAdd(stepSize,gradient,&this->w[0],N);
+            this->w0 += stepSize * gradient[N];
+        }
+        trainingErrors.push_back( totalSquaredError );
+
+        if( isinf( totalSquaredError ) || isnan( totalSquaredError ) ){
+            errorLog << "train(...) - Training failed! The total squared error is NAN." << endl;
+            return false;
+        }
+
+        //Check for convergence, using the validation samples if there are any
+        double error = totalSquaredError;
+        if( numValidationSamples > 0 ){
+            error = computeError(numTrainingSamples,M);
+            validationErrors.push_back( error );
+
+            if( error < bestValidationError ){
+                bestValidationError = error;
+                bestW0 = this->w0;
+                bestW = this->w;
+            }
+        }
+
+        const double delta = fabs( error-lastError );
+        lastError = error;
+
+        if( delta <= minChange ){
+            keepTraining = false;
+        }
+
+        if( ++epoch >= maxNumEpochs ){
+            keepTraining = false;
+        }
+    }
+
+    //Return the weights, if there is a validation set then use the weights that gave the lowest validation error
+    if( numValidationSamples > 0 ){
+        w0 = bestW0;
+        w = bestW;
+    }else{
+        w0 = this->w0;
+        w = this->w;
+    }
+
+    this->inputs = NULL;
+    this->targets = NULL;
+
+    return true;
+}
+
+double MiniBatchGradientDescent::accumulateGradient(const UINT start,const UINT end,double *gradient){
+    const UINT N = numDimensions;
+    double totalSquaredError = 0;
+    for(UINT m=start; m<end; m++){
+        const UINT i = sampleOrder[m];
+        const double *x = inputs + (size_t)i*N;
+        const double error = targets[i] - compute(x,N,linkFunction,w0,&w[0]);
+        totalSquaredError += error*error;
+        if( gradient != NULL ){
+            SIMD::multiplyAdd(error,x,gradient,N);
+            gradient[N] += error;
+        }
+    }
+    return totalSquaredError;
+}
+
+double MiniBatchGradientDescent::computeError(const UINT start,const UINT end){
+    const UINT chunkSize = getChunkSize();
+    const UINT numChunks = (end - start + chunkSize - 1) / chunkSize;
+    if( chunkErrors.size() < numChunks ) chunkErrors.resize( numChunks );
+
+    Parallel::forEach(numChunks,[&](UINT workerIndex,UINT c){
+        const UINT chunkStart = start + c*chunkSize;
+        const UINT chunkEnd = chunkStart+chunkSize < end ? chunkStart+chunkSize : end;
+        chunkErrors[c] = accumulateGradient(chunkStart,chunkEnd,NULL);
+    });
+
+    double totalSquaredError = 0;
+    for(UINT c=0; c<numChunks; c++){
+        totalSquaredError += chunkErrors[c];
+    }
+    return totalSquaredError;
+}
+
+UINT MiniBatchGradientDescent::getChunkSize() const{
+    const UINT chunkSize = GRT_MBGD_MIN_CHUNK_WORK / (numDimensions+1);
+    return chunkSize > GRT_MBGD_MIN_CHUNK_SIZE ? chunkSize : GRT_MBGD_MIN_CHUNK_SIZE;
+}
+
+bool MiniBatchGradientDescent::setLearningRate(double learningRate){
+    if( learningRate > 0 ){
+        this->learningRate = learningRate;
+        return true;
+    }
+    return false;
+}
+
+bool MiniBatchGradientDescent::setMinChange(double minChange){
+    if( minChange >= 0 ){
+        this->minChange = minChange;
+        return true;
+    }
+    return false;
+}
+
+bool MiniBatchGradientDescent::setMaxNumEpochs(UINT maxNumEpochs){
+    if( maxNumEpochs > 0 ){
+        this->maxNumEpochs = maxNumEpochs;
+        return true;
+    }
+    return false;
+}
+
+bool MiniBatchGradientDescent::setBatchSize(UINT batchSize){
+    if( batchSize > 0 ){
+        this->batchSize = batchSize;
+        return true;
+    }
+    return false;
+}
+
+bool MiniBatchGradientDescent::setValidationSetSize(UINT validationSetSize){
+    if( validationSetSize < 100 ){
+        this->validationSetSize = validationSetSize;
+        return true;
+    }
+    return false;
+}
+
+bool MiniBatchGradientDescent::setRandomSeed(unsigned long long randomSeed){
+    this->randomSeed = randomSeed;
+    return true;
+}
+
+}; //End of namespace GRT
@@ -0,0 +1,149 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The MiniBatchGradientDescent class trains a linear model y = f(w0 + w'x), where f is either the identity (linear regression)
+ or the logistic sigmoid (logistic regression and the per-class Softmax models). It is shared by the LinearRegression,
+ LogisticRegression and Softmax modules.
+
+ Each epoch visits the training samples in a random order (the order is shuffled once, before the first epoch) in batches of
+ batchSize samples. The gradient of each batch is averaged and applied once, so a batch size of 1 is classic stochastic gradient
+ descent. Large batches are split into fixed size chunks whose gradients are accumulated in parallel and then summed in chunk
+ order, so the result does not depend on the number of threads.
+
+ If validationSetSize is greater than zero, that percentage of the samples is held out of the training. The error on the held out
+ samples is then used to check for convergence, and the weights with the lowest validation error are kept.
+ */
+
+#ifndef GRT_MINI_BATCH_GRADIENT_DESCENT_HEADER
+#define GRT_MINI_BATCH_GRADIENT_DESCENT_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class MiniBatchGradientDescent{
+public:
+    /**
+     Default Constructor
+     */
+    MiniBatchGradientDescent();
+
+    /**
+     Default Destructor
+     */
+    ~MiniBatchGradientDescent();
+
+    /**
+     Trains the linear model, starting from the weights in w0 and w.
+
+     @param const VectorDouble &inputs: the [numSamples numDimensions] row-major training samples
+     @param const VectorDouble &targets: the target value of each training sample
+     @param const UINT numDimensions: the number of dimensions of each training sample
+     @param const UINT linkFunction: the output function of the model, this should be one of the LinkFunctions enums
+     @param double &w0: the bias of the model, this should be set to the starting value and will be set to the trained value
+     @param VectorDouble &w: the weights of the model, these should be set to the starting values and will be set to the trained values
+     @return returns true if the model was trained, false if the training failed (for example if the error became NAN)
+     */
+    bool train(const VectorDouble &inputs,const VectorDouble &targets,const UINT numDimensions,const UINT linkFunction,double &w0,VectorDouble &w);
+
+    /**
+     Computes the output of the linear model for the input vector x.
+     */
+    static inline double compute(const double *x,const UINT numDimensions,const UINT linkFunction,const double w0,const double *w){
+        const double h = w0 + SIMD::dot(x,w,numDimensions);
+        if( linkFunction == LOGISTIC_LINK ) return 1.0 / (1.0 + exp(-h));
+        return h;
+    }
+
+    bool setLearningRate(double learningRate);
+    bool setMinChange(double minChange);
+    bool setMaxNumEpochs(UINT maxNumEpochs);
+    bool setBatchSize(UINT batchSize);
+    bool setValidationSetSize(UINT validationSetSize);
+    bool setRandomSeed(unsigned long long randomSeed);
+
+    /**
+     Gets the number of epochs that were run by the last call to train.
+     */
+    UINT getNumEpochs() const{ return (UINT)trainingErrors.size(); }
+
+    /**
+     Gets the sum of the squared training errors for each epoch of the last call to train. The errors are measured before each batch
+     updates the weights, as they are in stochastic gradient descent.
+     */
+    const VectorDouble& getTrainingErrors() const{ return trainingErrors; }
+
+    /**
+     Gets the sum of the squared validation errors for each epoch of the last call to train, this is empty if there is no validation set.
+     */
+    const VectorDouble& getValidationErrors() const{ return validationErrors; }
+
+    /**
+     Gets the number of samples that were used to train the model (i.e. not held out for validation) in the last call to train.
+     */
+    UINT getNumTrainingSamples() const{ return numTrainingSamples; }
+
+    enum LinkFunctions{IDENTITY_LINK=0,LOGISTIC_LINK};
+
+protected:
+    /**
+     Adds the gradient of the samples [start end) of the sample order to gradient (with the bias gradient in gradient[numDimensions])
+     and returns the sum of their squared errors. If gradient is NULL then only the error is computed.
+     */
+    double accumulateGradient(const UINT start,const UINT end,double *gradient);
+
+    /**
+     Computes the sum of the squared errors of the samples [start end) of the sample order, splitting the work across the workers.
+     */
+    double computeError(const UINT start,const UINT end);
+
+    /**
+     Gets the number of samples in each chunk of a batch, this only depends on the size of the samples so the chunks (and therefore
+     the order the gradients are summed in) are the same however many threads are used.
+     */
+    UINT getChunkSize() const;
+
+    double learningRate;
+    double minChange;
+    UINT maxNumEpochs;
+    UINT batchSize;
+    UINT validationSetSize;
+    unsigned long long randomSeed;
+
+    //The state of the current call to train
+    const double *inputs;
+    const double *targets;
+    UINT numDimensions;
+    UINT linkFunction;
+    UINT numTrainingSamples;
+    double w0;
+    VectorDouble w;
+    vector< UINT > sampleOrder;
+    VectorDouble chunkGradients;
+    VectorDouble chunkErrors;
+    VectorDouble trainingErrors;
+    VectorDouble validationErrors;
+
+    ErrorLog errorLog;
+};
+
+}; //End of namespace GRT
+
+#endif //GRT_MINI_BATCH_GRADIENT_DESCENT_HEADER
@@ -0,0 +1,173 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Parallel.h"
+
+namespace GRT{
+
+//A thread in the worker pool, it sleeps until startWorkers gives it part of a parallel loop to run
+class PoolThread{
+public:
+    PoolThread() : function(NULL), loop(NULL), workerIndex(0), group(NULL), hasWork(false), stop(false), inUse(false){}
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    void (*function)(void *loop,UINT workerIndex);
+    void *loop;
+    UINT workerIndex;
+    void *group;
+    bool hasWork;
+    bool stop;
+    bool inUse;         //Guarded by the pool mutex rather than the thread mutex
+};
+
+//The pool threads are never removed while the program is running, they are stopped and joined when it exits
+class ThreadPool{
+public:
+    ThreadPool() : numThreadsInUse(0){}
+
+    ~ThreadPool(){
+        for(size_t i=0; i<threads.size(); i++){
+            {
+                std::lock_guard< std::mutex > lock( threads[i]->mutex );
+                threads[i]->stop = true;
+            }
+            threads[i]->wakeUp.notify_one();
+        }
+        for(size_t i=0; i<threads.size(); i++){
+            threads[i]->thread.join();
+            delete threads[i];
+        }
+    }
+
+    std::mutex mutex;
+    std::vector< PoolThread* > threads;
+    UINT numThreadsInUse;
+};
+
+static ThreadPool& getThreadPool(){
+    static ThreadPool pool;
+    return pool;
+}
+
+UINT Parallel::maxNumThreads = 0;
+
+UINT Parallel::getMaxNumThreads(){
+    if( maxNumThreads == 0 ){
+        const UINT numHardwareThreads = (UINT)std::thread::hardware_concurrency();
+        return numHardwareThreads > 0 ? numHardwareThreads : 1;
+    }
+    return maxNumThreads;
+}
+
+bool Parallel::setMaxNumThreads(UINT maxNumThreads){
+    Parallel::maxNumThreads = maxNumThreads;
+    return true;
+}
+
+UINT Parallel::getNumWorkers(UINT numTasks){
+    const UINT numThreads = getMaxNumThreads();
+    if( numTasks == 0 ) return 1;
+    return numTasks < numThreads ? numTasks : numThreads;
+}
+
+UINT Parallel::startWorkers(UINT numThreads,WorkerFunction function,void *loop,WorkerGroup &group){
+    if( numThreads == 0 ) return 0;
+
+    ThreadPool &pool = getThreadPool();
+    std::lock_guard< std::mutex > poolLock( pool.mutex );
+
+    //The calling thread is not part of the pool, so only maxNumThreads-1 pool threads can be in use
+    const UINT maxNumPoolThreads = getMaxNumThreads()-1;
+    const UINT numAvailable = pool.numThreadsInUse < maxNumPoolThreads ? maxNumPoolThreads-pool.numThreadsInUse : 0;
+    const UINT numStarted = numThreads < numAvailable ? numThreads : numAvailable;
+    if( numStarted == 0 ) return 0;
+
+    pool.numThreadsInUse += numStarted;
+    group.numRunning = numStarted;
+
+    size_t threadIndex = 0;
+    for(UINT i=0; i<numStarted; i++){
+        //Use an idle thread if there is one, otherwise add a new thread to the pool
+        while( threadIndex < pool.threads.size() && pool.threads[threadIndex]->inUse ) threadIndex++;
+        if( threadIndex == pool.threads.size() ){
+            PoolThread *poolThread = new PoolThread();
+            poolThread->thread = std::thread(&Parallel::runPoolThread,poolThread);
+            pool.threads.push_back( poolThread );
+        }
+
+        PoolThread *poolThread = pool.threads[threadIndex++];
+        poolThread->inUse = true;
+        {
+            std::lock_guard< std::mutex > lock( poolThread->mutex );
+            poolThread->function = function;
+            poolThread->loop = loop;
+            poolThread->workerIndex = i+1;
+            poolThread->group = &group;
+            poolThread->hasWork = true;
+        }
+        poolThread->wakeUp.notify_one();
+    }
+
+    return numStarted;
+}
+
+void Parallel::waitForWorkers(WorkerGroup &group){
+    std::unique_lock< std::mutex > lock( group.mutex );
+    group.finished.wait( lock, [&group]{ return group.numRunning == 0; } );
+}
+
+void Parallel::runPoolThread(PoolThread *poolThread){
+    ThreadPool &pool = getThreadPool();
+
+    while( true ){
+        WorkerFunction function = NULL;
+        void *loop = NULL;
+        UINT workerIndex = 0;
+        WorkerGroup *group = NULL;
+        {
+            std::unique_lock< std::mutex > lock( poolThread->mutex );
+            poolThread->wakeUp.wait( lock, [poolThread]{ return poolThread->hasWork || poolThread->stop; } );
+            if( !poolThread->hasWork ) return;
+            function = poolThread->function;
+            loop = poolThread->loop;
+            workerIndex = poolThread->workerIndex;
+            group = static_cast< WorkerGroup* >( poolThread->group );
+            poolThread->hasWork = false;
+        }
+
+        function( loop, workerIndex );
+
+        //Return the thread to the pool before signalling the caller, so a loop that is started straight after this
+        //one can use it again
+        {
+            std::lock_guard< std::mutex > lock( pool.mutex );
+            poolThread->inUse = false;
+            pool.numThreadsInUse--;
+        }
+
+        //The group lives on the caller's stack, so it must not be used once the caller can see numRunning reach zero
+        std::lock_guard< std::mutex > lock( group->mutex );
+        if( --group->numRunning == 0 ) group->finished.notify_one();
+    }
+}
+
+}; //End of namespace GRT
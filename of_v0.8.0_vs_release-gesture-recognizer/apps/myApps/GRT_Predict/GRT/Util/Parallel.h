@@ -0,0 +1,157 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The Parallel class runs a number of independent tasks across several threads, it is used by the training algorithms
+ that can split their work into independent parts (for example one part per class or one part per training sample).
+
+ Tasks are handed out to the workers one at a time, so each call of the task function gets a task index in [0 numTasks)
+ and the index of the worker running it in [0 numWorkers). The worker index can be used to give each worker its own
+ accumulator, so the task function never has to lock anything. The calling thread is always used as worker 0.
+
+ The worker threads are started the first time they are needed and are then kept waiting in a pool, so a parallel
+ loop only has to wake them up rather than create and join new threads each time it is called. The number of pool
+ threads in use at any time is limited by the maximum number of threads, so nested parallel loops (such as training
+ the classes in parallel, where each class also trains in parallel) fall back to running the inner loop on the
+ calling thread once all the threads are in use.
+ */
+
+#ifndef GRT_PARALLEL_HEADER
+#define GRT_PARALLEL_HEADER
+
+#include "GRTTypedefs.h"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+namespace GRT{
+
+class PoolThread;
+
+class Parallel{
+public:
+    /**
+     Gets the maximum number of threads (including the calling thread) that can be used by a parallel loop.
+
+     @return returns the maximum number of threads
+     */
+    static UINT getMaxNumThreads();
+
+    /**
+     Sets the maximum number of threads (including the calling thread) that can be used by a parallel loop.
+     Setting this to 1 will run all the parallel loops on the calling thread. Setting this to 0 will reset the
+     maximum number of threads to the number of hardware threads.
+
+     @param UINT maxNumThreads: the new maximum number of threads
+     @return returns true if the value was updated
+     */
+    static bool setMaxNumThreads(UINT maxNumThreads);
+
+    /**
+     Gets the number of workers that would be used to run numTasks tasks if all the threads were free.
+     This should be used to size any per-worker buffers before calling forEach.
+
+     @param UINT numTasks: the number of tasks
+     @return returns the number of workers, this will be at least 1
+     */
+    static UINT getNumWorkers(UINT numTasks);
+
+    /**
+     Calls function(workerIndex,taskIndex) for each taskIndex in [0 numTasks), using at most numWorkers workers.
+     The function returns once all the tasks have finished.
+
+     @param UINT numTasks: the number of tasks to run
+     @param UINT numWorkers: the maximum number of workers, the workerIndex passed to the function will be less than this
+     @param Function function: the task function, this will be called concurrently from several threads
+     @return returns the number of workers that were actually used
+     */
+    template< class Function >
+    static UINT forEach(const UINT numTasks,UINT numWorkers,Function function){
+
+        if( numTasks == 0 ) return 0;
+        if( numWorkers > numTasks ) numWorkers = numTasks;
+        if( numWorkers == 0 ) numWorkers = 1;
+
+        //Wake up the pool threads, this might start less than we asked for if the other loops are using them
+        Loop< Function > loop(numTasks,function);
+        WorkerGroup group;
+        const UINT numExtraThreads = startWorkers( numWorkers-1, &Loop< Function >::run, &loop, group );
+
+        Loop< Function >::run( &loop, 0 );
+
+        waitForWorkers( group );
+
+        return numExtraThreads+1;
+    }
+
+    /**
+     Calls function(workerIndex,taskIndex) for each taskIndex in [0 numTasks), using getNumWorkers(numTasks) workers.
+
+     @param UINT numTasks: the number of tasks to run
+     @param Function function: the task function, this will be called concurrently from several threads
+     @return returns the number of workers that were actually used
+     */
+    template< class Function >
+    static UINT forEach(const UINT numTasks,Function function){
+        return forEach(numTasks,getNumWorkers(numTasks),function);
+    }
+
+protected:
+    typedef void (*WorkerFunction)(void *loop,UINT workerIndex);
+
+    //The state shared by the workers of one call to forEach
+    template< class Function >
+    class Loop{
+    public:
+        Loop(const UINT numTasks,Function &function) : numTasks(numTasks), function(function), nextTask(0){}
+
+        static void run(void *loop,UINT workerIndex){
+            Loop *self = static_cast< Loop* >( loop );
+            UINT taskIndex = 0;
+            while( (taskIndex = self->nextTask++) < self->numTasks ){
+                self->function(workerIndex,taskIndex);
+            }
+        }
+
+        const UINT numTasks;
+        Function &function;
+        std::atomic< UINT > nextTask;
+    };
+
+    //Used by the calling thread to wait for the pool threads it started
+    class WorkerGroup{
+    public:
+        WorkerGroup() : numRunning(0){}
+        std::mutex mutex;
+        std::condition_variable finished;
+        UINT numRunning;
+    };
+
+    static UINT startWorkers(UINT numThreads,WorkerFunction function,void *loop,WorkerGroup &group);
+    static void waitForWorkers(WorkerGroup &group);
+    static void runPoolThread(PoolThread *poolThread);
+
+    static UINT maxNumThreads;
+};
+
+}; //End of namespace GRT
+
+#endif //GRT_PARALLEL_HEADER
@@ -0,0 +1,444 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PrototypeSelection.h"
+
+namespace GRT{
+
+PrototypeSelection::PrototypeSelection(UINT K,bool useScaling,double warpingRadius){
+    this->K = K > 0 ? K : 1;
+    this->useScaling = useScaling;
+    this->warpingRadius = warpingRadius;
+    debugLog.setProceedingText("[DEBUG PrototypeSelection]");
+    warningLog.setProceedingText("[WARNING PrototypeSelection]");
+    errorLog.setProceedingText("[ERROR PrototypeSelection]");
+}
+
+PrototypeSelection::~PrototypeSelection(){}
+
+bool PrototypeSelection::editedNearestNeighbour(LabelledClassificationData &data,LabelledClassificationData &editedData){
+
+    const UINT M = data.getNumSamples();
+    const UINT N = data.getNumDimensions();
+
+    if( M < 2 ){
+        errorLog << "editedNearestNeighbour(LabelledClassificationData &data,LabelledClassificationData &editedData) - There must be at least 2 samples in the dataset!" << endl;
+        return false;
+    }
+
+    VectorDouble samples;
+    vector< UINT > labels;
+    getSamples(data,samples,labels);
+
+    const UINT numNeighbours = K < M ? K : M-1;
+    vector< unsigned char > keepSample(M,0);
+
+    //Each sample is tested against all the other samples, so the samples can be tested in parallel
+    Parallel::forEach(M,[&](UINT workerIndex,UINT i){
+        const double *x = &samples[ i*N ];
+        vector< IndexedDouble > neighbours;
+        neighbours.reserve( numNeighbours );
+
+        for(UINT j=0; j<M; j++){
+            if( j == i ) continue;
+            const double dist = SIMD::squaredDistance(x,&samples[ j*N ],N);
+            if( neighbours.size() < numNeighbours ){
+                neighbours.push_back( IndexedDouble(labels[j],dist) );
+            }else{
+                //Replace the furthest neighbour if this sample is closer
+                UINT maxIndex = 0;
+                for(UINT n=1; n<numNeighbours; n++){
+                    if( neighbours[n].value > neighbours[maxIndex].value ) maxIndex = n;
+                }
+                if( dist < neighbours[maxIndex].value ){
+                    neighbours[maxIndex] = IndexedDouble(labels[j],dist);
+                }
+            }
+        }
+
+        UINT numSameClass = 0;
+        for(UINT n=0; n<numNeighbours; n++){
+            if( neighbours[n].index == labels[i] ) numSameClass++;
+        }
+        keepSample[i] = numSameClass*2 > numNeighbours ? 1 : 0;
+    });
+
+    editedData.clear();
+    editedData.setNumDimensions( N );
+    editedData.setDatasetName( data.getDatasetName() );
+    editedData.setInfoText( data.getInfoText() );
+    for(UINT i=0; i<M; i++){
+        if( keepSample[i] ) editedData.addSample( data[i].getClassLabel(), data[i].getSample() );
+    }
+
+    debugLog << "editedNearestNeighbour(...) - Removed " << M-editedData.getNumSamples() << " of " << M << " samples" << endl;
+
+    return true;
+}
+
+bool PrototypeSelection::condensedNearestNeighbour(LabelledClassificationData &data,LabelledClassificationData &condensedData){
+
+    const UINT M = data.getNumSamples();
+    const UINT N = data.getNumDimensions();
+
+    if( M == 0 ){
+        errorLog << "condensedNearestNeighbour(LabelledClassificationData &data,LabelledClassificationData &condensedData) - There are no samples in the dataset!" << endl;
+        return false;
+    }
+
+    VectorDouble samples;
+    vector< UINT > labels;
+    getSamples(data,samples,labels);
+
+    //Start with the first sample of each class
+    vector< UINT > prototypes;
+    vector< unsigned char > isPrototype(M,0);
+    vector< UINT > classLabels;
+    for(UINT i=0; i<M; i++){
+        if( std::find(classLabels.begin(),classLabels.end(),labels[i]) == classLabels.end() ){
+            classLabels.push_back( labels[i] );
+            prototypes.push_back( i );
+            isPrototype[i] = 1;
+        }
+    }
+
+    //The samples are processed in blocks. The nearest prototype of every sample in a block is found in parallel (using the
+    //prototypes at the start of the block), then the samples are checked in order against the prototypes added during the block.
+    //This gives exactly the same prototypes as checking each sample against all the prototypes one at a time.
+    const UINT blockSize = 256;
+    vector< UINT > nearestPrototype(blockSize,0);
+    VectorDouble nearestDistance(blockSize,0);
+    bool prototypeAdded = true;
+    UINT numPasses = 0;
+
+    while( prototypeAdded ){
+        prototypeAdded = false;
+        numPasses++;
+
+        for(UINT blockStart=0; blockStart<M; blockStart+=blockSize){
+            const UINT blockEnd = blockStart+blockSize < M ? blockStart+blockSize : M;
+            const UINT numPrototypes = (UINT)prototypes.size();
+
+            Parallel::forEach(blockEnd-blockStart,[&](UINT workerIndex,UINT t){
+                const UINT i = blockStart + t;
+                if( isPrototype[i] ) return;
+                nearestPrototype[t] = findNearestNeighbour(&samples[ i*N ],samples,&prototypes[0],numPrototypes,N,nearestDistance[t]);
+            });
+
+            for(UINT i=blockStart; i<blockEnd; i++){
+                if( isPrototype[i] ) continue;
+                const UINT t = i - blockStart;
+                UINT nearest = nearestPrototype[t];
+                double minDist = nearestDistance[t];
+                for(UINT p=numPrototypes; p<prototypes.size(); p++){
+                    const double dist = SIMD::squaredDistance(&samples[ i*N ],&samples[ prototypes[p]*N ],N);
+                    if( dist < minDist ){
+                        minDist = dist;
+                        nearest = prototypes[p];
+                    }
+                }
+
+                //If the sample is misclassified by the current prototypes then it becomes a prototype
+                if( labels[ nearest ] != labels[i] ){
+                    prototypes.push_back( i );
+                    isPrototype[i] = 1;
+                    prototypeAdded = true;
+                }
+            }
+        }
+    }
+
+    condensedData.clear();
+    condensedData.setNumDimensions( N );
+    condensedData.setDatasetName( data.getDatasetName() );
+    condensedData.setInfoText( data.getInfoText() );
+    for(UINT i=0; i<M; i++){
+        if( isPrototype[i] ) condensedData.addSample( data[i].getClassLabel(), data[i].getSample() );
+    }
+
+    debugLog << "condensedNearestNeighbour(...) - Kept " << condensedData.getNumSamples() << " of " << M << " samples after " << numPasses << " passes" << endl;
+
+    return true;
+}
+
+bool PrototypeSelection::selectMedoids(LabelledTimeSeriesClassificationData &data,LabelledTimeSeriesClassificationData &medoidData,UINT numMedoidsPerClass){
+
+    const UINT M = data.getNumSamples();
+    const UINT N = data.getNumDimensions();
+
+    if( M == 0 ){
+        errorLog << "selectMedoids(LabelledTimeSeriesClassificationData &data,LabelledTimeSeriesClassificationData &medoidData,UINT numMedoidsPerClass) - There are no samples in the dataset!" << endl;
+        return false;
+    }
+
+    if( numMedoidsPerClass == 0 ){
+        errorLog << "selectMedoids(LabelledTimeSeriesClassificationData &data,LabelledTimeSeriesClassificationData &medoidData,UINT numMedoidsPerClass) - The number of medoids per class must be greater than zero!" << endl;
+        return false;
+    }
+
+    //Scale a copy of each time series if needed, the distances are computed on the scaled copies
+    vector< MatrixDouble > timeSeries( M );
+    vector< MinMax > ranges;
+    if( useScaling ) ranges = data.getRanges();
+    for(UINT i=0; i<M; i++){
+        timeSeries[i] = data[i].getData();
+        if( useScaling ){
+            for(UINT n=0; n<timeSeries[i].getNumRows(); n++){
+                for(UINT j=0; j<N; j++){
+                    const double range = ranges[j].maxValue - ranges[j].minValue;
+                    timeSeries[i][n][j] = range > 0 ? (timeSeries[i][n][j] - ranges[j].minValue) / range : 0;
+                }
+            }
+        }
+    }
+
+    vector< unsigned char > isMedoid(M,0);
+    vector< ClassTracker > classTracker = data.getClassTracker();
+
+    for(UINT k=0; k<classTracker.size(); k++){
+        vector< UINT > classIndexes;
+        for(UINT i=0; i<M; i++){
+            if( data[i].getClassLabel() == classTracker[k].classLabel ) classIndexes.push_back( i );
+        }
+        const UINT numExamples = (UINT)classIndexes.size();
+
+        if( numExamples <= numMedoidsPerClass ){
+            for(UINT i=0; i<numExamples; i++) isMedoid[ classIndexes[i] ] = 1;
+            continue;
+        }
+
+        //Compute the DTW distance between each pair of examples in this class, one row of the distance matrix per task
+        MatrixDouble distances(numExamples,numExamples);
+        Parallel::forEach(numExamples,[&](UINT workerIndex,UINT a){
+            distances[a][a] = 0;
+            for(UINT b=a+1; b<numExamples; b++){
+                distances[a][b] = computeDTWDistance(timeSeries[ classIndexes[a] ],timeSeries[ classIndexes[b] ],warpingRadius);
+            }
+        });
+        for(UINT a=0; a<numExamples; a++){
+            for(UINT b=0; b<a; b++) distances[a][b] = distances[b][a];
+        }
+
+        //Build the initial medoids greedily: start with the medoid of the whole class, then keep adding the example that
+        //reduces the summed distance of each example to its nearest medoid the most
+        vector< UINT > medoids;
+        VectorDouble nearestDistance(numExamples,0);
+        UINT bestIndex = 0;
+        double bestCost = numeric_limits<double>::max();
+        for(UINT a=0; a<numExamples; a++){
+            double cost = 0;
+            for(UINT b=0; b<numExamples; b++) cost += distances[a][b];
+            if( cost < bestCost ){
+                bestCost = cost;
+                bestIndex = a;
+            }
+        }
+        medoids.push_back( bestIndex );
+        for(UINT b=0; b<numExamples; b++) nearestDistance[b] = distances[bestIndex][b];
+
+        while( medoids.size() < numMedoidsPerClass ){
+            double bestGain = -1;
+            for(UINT a=0; a<numExamples; a++){
+                if( std::find(medoids.begin(),medoids.end(),a) != medoids.end() ) continue;
+                double gain = 0;
+                for(UINT b=0; b<numExamples; b++){
+                    if( distances[a][b] < nearestDistance[b] ) gain += nearestDistance[b] - distances[a][b];
+                }
+                if( gain > bestGain ){
+                    bestGain = gain;
+                    bestIndex = a;
+                }
+            }
+            medoids.push_back( bestIndex );
+            for(UINT b=0; b<numExamples; b++){
+                if( distances[bestIndex][b] < nearestDistance[b] ) nearestDistance[b] = distances[bestIndex][b];
+            }
+        }
+
+        //Refine the medoids: assign each example to its nearest medoid, then move each medoid to the example with the smallest
+        //summed distance to the other examples in its cluster, until the medoids stop changing
+        const UINT maxNumIterations = 100;
+        vector< UINT > assignments(numExamples,0);
+        for(UINT iter=0; iter<maxNumIterations; iter++){
+            for(UINT b=0; b<numExamples; b++){
+                double minDist = numeric_limits<double>::max();
+                for(UINT c=0; c<medoids.size(); c++){
+                    if( distances[ medoids[c] ][b] < minDist ){
+                        minDist = distances[ medoids[c] ][b];
+                        assignments[b] = c;
+                    }
+                }
+            }
+
+            bool medoidsChanged = false;
+            for(UINT c=0; c<medoids.size(); c++){
+                UINT newMedoid = medoids[c];
+                double minCost = numeric_limits<double>::max();
+                for(UINT a=0; a<numExamples; a++){
+                    if( assignments[a] != c ) continue;
+                    double cost = 0;
+                    for(UINT b=0; b<numExamples; b++){
+                        if( assignments[b] == c ) cost += distances[a][b];
+                    }
+                    if( cost < minCost ){
+                        minCost = cost;
+                        newMedoid = a;
+                    }
+                }
+                if( newMedoid != medoids[c] ){
+                    medoids[c] = newMedoid;
+                    medoidsChanged = true;
+                }
+            }
+            if( !medoidsChanged ) break;
+        }
+
+        for(UINT c=0; c<medoids.size(); c++) isMedoid[ classIndexes[ medoids[c] ] ] = 1;
+    }
+
+    medoidData.clear();
+    medoidData.setNumDimensions( N );
+    medoidData.setDatasetName( data.getDatasetName() );
+    medoidData.setInfoText( data.getInfoText() );
+    for(UINT i=0; i<M; i++){
+        if( isMedoid[i] ) medoidData.addSample( data[i].getClassLabel(), data[i].getData() );
+    }
+
+    debugLog << "selectMedoids(...) - Kept " << medoidData.getNumSamples() << " of " << M << " samples" << endl;
+
+    return true;
+}
+
+double PrototypeSelection::computeDTWDistance(const MatrixDouble &timeSeriesA,const MatrixDouble &timeSeriesB,double warpingRadius){
+
+    const UINT M = timeSeriesA.getNumRows();
+    const UINT N = timeSeriesB.getNumRows();
+    const UINT C = timeSeriesA.getNumCols();
+
+    if( M == 0 || N == 0 || timeSeriesB.getNumCols() != C ){
+        return INFINITY;
+    }
+
+    //The window is centred on the line from the first to the last cell of the cost matrix. It is made at least as wide as the
+    //slope of that line (and at least one cell), so the windows of two consecutive rows always overlap and there is always a path
+    const double slope = M > 1 ? (N-1)/double(M-1) : 0;
+    double radius = ceil( (M < N ? M : N) * warpingRadius );
+    if( radius < slope ) radius = slope;
+    if( radius < 1 ) radius = 1;
+
+    //Only the previous row of the cost matrix is needed, the cells outside the window are infinite
+    VectorDouble previousRow(N,INFINITY);
+    VectorDouble currentRow(N,INFINITY);
+    int previousStart = 0, previousEnd = -1;
+    int olderStart = 0, olderEnd = -1;
+
+    for(UINT i=0; i<M; i++){
+        const double centre = M > 1 ? i*slope : 0;
+        const int start = M > 1 ? (int)max(0.0,ceil(centre-radius)) : 0;
+        const int end = M > 1 ? (int)min(double(N-1),floor(centre+radius)) : int(N-1);
+
+        //The current row buffer still holds the row before the previous row, so clear the cells that were set
+        for(int j=olderStart; j<=olderEnd; j++) currentRow[j] = INFINITY;
+
+        const double *a = timeSeriesA[i];
+        for(int j=start; j<=end; j++){
+            const double cost = sqrt( SIMD::squaredDistance(a,timeSeriesB[j],C) );
+            double minValue;
+            if( i == 0 && j == 0 ) minValue = 0;
+            else{
+                minValue = previousRow[j];
+                if( j > 0 ){
+                    if( currentRow[j-1] < minValue ) minValue = currentRow[j-1];
+                    if( previousRow[j-1] < minValue ) minValue = previousRow[j-1];
+                }
+            }
+            currentRow[j] = cost + minValue;
+        }
+
+        olderStart = previousStart;
+        olderEnd = previousEnd;
+        previousStart = start;
+        previousEnd = end;
+        std::swap(previousRow,currentRow);
+    }
+
+    return previousRow[N-1] / (M+N);
+}
+
+bool PrototypeSelection::setK(UINT K){
+    if( K > 0 ){
+        this->K = K;
+        return true;
+    }
+    warningLog << "setK(UINT K) - K must be greater than zero!" << endl;
+    return false;
+}
+
+bool PrototypeSelection::enableScaling(bool useScaling){
+    this->useScaling = useScaling;
+    return true;
+}
+
+bool PrototypeSelection::setWarpingRadius(double warpingRadius){
+    if( warpingRadius >= 0 && warpingRadius <= 1 ){
+        this->warpingRadius = warpingRadius;
+        return true;
+    }
+    warningLog << "setWarpingRadius(double warpingRadius) - The warping radius must be between [0 1]!" << endl;
+    return false;
+}
+
+void PrototypeSelection::getSamples(LabelledClassificationData &data,VectorDouble &samples,vector< UINT > &labels){
+
+    const UINT M = data.getNumSamples();
+    const UINT N = data.getNumDimensions();
+    vector< MinMax > ranges;
+    if( useScaling ) ranges = data.getRanges();
+
+    //Store the samples in one contiguous array, so the distance computations can run straight through memory
+    samples.resize( M*N );
+    labels.resize( M );
+    for(UINT i=0; i<M; i++){
+        labels[i] = data[i].getClassLabel();
+        for(UINT j=0; j<N; j++){
+            double value = data[i][j];
+            if( useScaling ){
+                const double range = ranges[j].maxValue - ranges[j].minValue;
+                value = range > 0 ? (value - ranges[j].minValue) / range : 0;
+            }
+            samples[ i*N+j ] = value;
+        }
+    }
+}
+
+UINT PrototypeSelection::findNearestNeighbour(const double *x,const VectorDouble &samples,const UINT *prototypes,const UINT numPrototypes,const UINT numFeatures,double &minDist){
+    UINT nearest = prototypes[0];
+    minDist = numeric_limits<double>::max();
+    for(UINT p=0; p<numPrototypes; p++){
+        const double dist = SIMD::squaredDistance(x,&samples[ prototypes[p]*numFeatures ],numFeatures);
+        if( dist < minDist ){
+            minDist = dist;
+            nearest = prototypes[p];
+        }
+    }
+    return nearest;
+}
+
+} //End of namespace GRT
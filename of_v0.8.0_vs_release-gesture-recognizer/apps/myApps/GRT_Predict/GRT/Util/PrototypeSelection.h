@@ -0,0 +1,178 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ This class provides a number of tools that reduce the size of a training dataset by only keeping the examples (the
+ prototypes) that are needed to describe each class. Datasets recorded by hand often contain many near-duplicate examples,
+ and the prediction time of instance-based classifiers (such as KNN) grows with the number of stored examples, so a
+ reduced dataset can give a much faster model at the same accuracy.
+
+ For LabelledClassificationData (which can be used to train a KNN classifier):
+ - editedNearestNeighbour (Wilson editing) removes every example whose K nearest neighbours mostly belong to another class,
+   this removes noisy examples and mislabelled examples on the class boundaries.
+ - condensedNearestNeighbour (Hart condensing) keeps a subset of examples that classifies every example in the dataset
+   correctly with a 1-nearest neighbour rule, this removes the examples in the middle of each class. The result is the same
+   as the classic sequential algorithm, but the nearest neighbour searches are run in parallel.
+ Running editedNearestNeighbour before condensedNearestNeighbour usually gives the smallest dataset, as the noisy examples
+ would otherwise all be kept by the condensing.
+
+ For LabelledTimeSeriesClassificationData (which can be used to train a DTW classifier):
+ - selectMedoids keeps the K medoids of each class under the DTW distance, where each medoid is the example with the
+   smallest summed DTW distance to the other examples in its cluster. This reduces the size of the dataset from N examples
+   per class to K, which reduces the training time of the DTW classifier from N^2 to K^2 DTW distances per class.
+
+ If useScaling is enabled, the distances are computed on data scaled to [0 1] with the ranges of the input dataset (which
+ matches the scaling used by the classifiers), the reduced dataset always contains the original unscaled examples.
+ */
+
+#ifndef GRT_PROTOTYPE_SELECTION_HEADER
+#define GRT_PROTOTYPE_SELECTION_HEADER
+
+#include "../DataStructures/LabelledClassificationData.h"
+#include "../DataStructures/LabelledTimeSeriesClassificationData.h"
+
+namespace GRT{
+
+class PrototypeSelection{
+public:
+
+	/**
+     Default Constructor.
+
+     @param UINT K: the number of neighbours used by editedNearestNeighbour. Default value = 3
+     @param bool useScaling: sets if the data should be scaled to [0 1] before the distances are computed. Default value = false
+     @param double warpingRadius: the radius of the DTW warping window used by selectMedoids, as a fraction of the length of the shortest time series. Should be a value between [0 1]. Default value = 0.2
+    */
+    PrototypeSelection(UINT K=3,bool useScaling=false,double warpingRadius=0.2);
+
+	/**
+     Default Destructor
+    */
+	~PrototypeSelection();
+
+	/**
+     Defines the equals operator. Copies the settings from the rhs instance to this instance
+
+	@param const PrototypeSelection &rhs: the instance from which the settings will be copied
+	@return returns a reference to this instance
+    */
+	PrototypeSelection& operator= (const PrototypeSelection &rhs){
+		if( this != &rhs){
+            this->K = rhs.K;
+            this->useScaling = rhs.useScaling;
+            this->warpingRadius = rhs.warpingRadius;
+            this->debugLog = rhs.debugLog;
+            this->warningLog = rhs.warningLog;
+            this->errorLog = rhs.errorLog;
+		}
+		return *this;
+	}
+
+    /**
+     Removes every example whose K nearest neighbours (excluding itself) do not have a majority of the same class (Wilson editing).
+
+     @param LabelledClassificationData &data: the dataset that should be edited
+     @param LabelledClassificationData &editedData: the edited dataset
+     @return returns true if the dataset was edited, false otherwise
+    */
+    bool editedNearestNeighbour(LabelledClassificationData &data,LabelledClassificationData &editedData);
+
+    /**
+     Selects a subset of the examples that classifies every example in the dataset correctly using a 1-nearest neighbour rule
+     (Hart condensing). The search starts with the first example of each class and keeps passing over the dataset, adding any
+     example that is misclassified by the current subset, until a full pass adds no examples.
+
+     @param LabelledClassificationData &data: the dataset that should be condensed
+     @param LabelledClassificationData &condensedData: the condensed dataset
+     @return returns true if the dataset was condensed, false otherwise
+    */
+    bool condensedNearestNeighbour(LabelledClassificationData &data,LabelledClassificationData &condensedData);
+
+    /**
+     Clusters the examples of each class into numMedoidsPerClass clusters under the DTW distance (using the k-medoids algorithm)
+     and keeps the medoid of each cluster. Classes with less than numMedoidsPerClass examples are kept as they are.
+
+     @param LabelledTimeSeriesClassificationData &data: the dataset that should be reduced
+     @param LabelledTimeSeriesClassificationData &medoidData: the dataset containing the medoids of each class
+     @param UINT numMedoidsPerClass: the maximum number of examples that should be kept for each class
+     @return returns true if the medoids were selected, false otherwise
+    */
+    bool selectMedoids(LabelledTimeSeriesClassificationData &data,LabelledTimeSeriesClassificationData &medoidData,UINT numMedoidsPerClass);
+
+    /**
+     Computes the DTW distance between two time series, using the Euclidean distance between each pair of samples and a warping
+     window around the diagonal of the cost matrix. The cost of the warping path is normalised by the sum of the two lengths, so
+     the distances between time series of different lengths can be compared.
+
+     @param const MatrixDouble &timeSeriesA: the first time series, with one sample per row
+     @param const MatrixDouble &timeSeriesB: the second time series, this must have the same number of columns as timeSeriesA
+     @param double warpingRadius: the radius of the warping window, as a fraction of the length of the shortest time series
+     @return returns the DTW distance between the two time series, or INFINITY if the time series are empty
+    */
+    static double computeDTWDistance(const MatrixDouble &timeSeriesA,const MatrixDouble &timeSeriesB,double warpingRadius);
+
+    UINT getK() const{ return K; }
+    bool getUseScaling() const{ return useScaling; }
+    double getWarpingRadius() const{ return warpingRadius; }
+
+    /**
+     Sets the number of neighbours used by editedNearestNeighbour, this must be greater than zero.
+
+     @param UINT K: the new number of neighbours
+     @return returns true if the parameter was updated
+    */
+    bool setK(UINT K);
+
+    /**
+     Sets if the data should be scaled to [0 1] before the distances are computed.
+
+     @param bool useScaling: the new scaling flag
+     @return returns true if the parameter was updated
+    */
+    bool enableScaling(bool useScaling);
+
+    /**
+     Sets the radius of the DTW warping window used by selectMedoids, this should be a value between [0 1].
+
+     @param double warpingRadius: the new warping radius
+     @return returns true if the parameter was updated
+    */
+    bool setWarpingRadius(double warpingRadius);
+
+private:
+    void getSamples(LabelledClassificationData &data,VectorDouble &samples,vector< UINT > &labels);
+    UINT findNearestNeighbour(const double *x,const VectorDouble &samples,const UINT *prototypes,const UINT numPrototypes,const UINT numFeatures,double &minDist);
+
+    UINT K;
+    bool useScaling;
+    double warpingRadius;
+    DebugLog debugLog;
+    WarningLog warningLog;
+    ErrorLog errorLog;
+
+};
+
+} //End of namespace GRT
+
+#endif // GRT_PROTOTYPE_SELECTION_HEADER
@@ -0,0 +1,224 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The SIMD class contains a small number of vectorised kernels that operate on contiguous double arrays.
+ SSE2 is used when the compiler targets it (this is always the case for x64 builds), otherwise the kernels
+ fall back to unrolled scalar loops, so the results are the same on every platform up to rounding.
+*/
+
+#ifndef GRT_SIMD_HEADER
+#define GRT_SIMD_HEADER
+
+#include "GRTTypedefs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define GRT_USE_SSE2
+#endif
+
+namespace GRT{
+
+class SIMD{
+public:
+    /**
+     Computes the dot product of the first n elements of a and b.
+     */
+    static inline double dot(const double *a,const double *b,const UINT n){
+        UINT k = 0;
+#ifdef GRT_USE_SSE2
+        __m128d s0 = _mm_setzero_pd();
+        __m128d s1 = _mm_setzero_pd();
+        for(; k+4<=n; k+=4){
+            s0 = _mm_add_pd(s0,_mm_mul_pd(_mm_loadu_pd(a+k),_mm_loadu_pd(b+k)));
+            s1 = _mm_add_pd(s1,_mm_mul_pd(_mm_loadu_pd(a+k+2),_mm_loadu_pd(b+k+2)));
+        }
+        double sum = horizontalSum( _mm_add_pd(s0,s1) );
+#else
+        double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for(; k+4<=n; k+=4){
+            s0 += a[k]*b[k];
+            s1 += a[k+1]*b[k+1];
+            s2 += a[k+2]*b[k+2];
+            s3 += a[k+3]*b[k+3];
+        }
+        double sum = (s0+s1) + (s2+s3);
+#endif
+        for(; k<n; k++) sum += a[k]*b[k];
+        return sum;
+    }
+
+    /**
+     Computes the squared Euclidean distance between the first n elements of a and b.
+     */
+    static inline double squaredDistance(const double *a,const double *b,const UINT n){
+        UINT k = 0;
+        double sum = 0;
+#ifdef GRT_USE_SSE2
+        __m128d s0 = _mm_setzero_pd();
+        __m128d s1 = _mm_setzero_pd();
+        for(; k+4<=n; k+=4){
+            __m128d d0 = _mm_sub_pd(_mm_loadu_pd(a+k),_mm_loadu_pd(b+k));
+            __m128d d1 = _mm_sub_pd(_mm_loadu_pd(a+k+2),_mm_loadu_pd(b+k+2));
+            s0 = _mm_add_pd(s0,_mm_mul_pd(d0,d0));
+            s1 = _mm_add_pd(s1,_mm_mul_pd(d1,d1));
+        }
+        sum = horizontalSum( _mm_add_pd(s0,s1) );
+#endif
+        for(; k<n; k++){
+            const double d = a[k]-b[k];
+            sum += d*d;
+        }
+        return sum;
+    }
+
+    /**
+     For k in [0 n), computes y[k] -= w[k] * (x - mu[k])^2.
+     This lets a single scalar input be compared against n models at once, when the model parameters are stored contiguously.
+     */
+    static inline void subtractWeightedSquaredError(const double x,const double *mu,const double *w,double *y,const UINT n){
+        UINT k = 0;
+#ifdef GRT_USE_SSE2
+        const __m128d vx = _mm_set1_pd(x);
+        for(; k+2<=n; k+=2){
+            __m128d d = _mm_sub_pd(vx,_mm_loadu_pd(mu+k));
+            __m128d e = _mm_mul_pd(_mm_loadu_pd(w+k),_mm_mul_pd(d,d));
+            _mm_storeu_pd(y+k,_mm_sub_pd(_mm_loadu_pd(y+k),e));
+        }
+#endif
+        for(; k<n; k++){
+            const double d = x-mu[k];
+            y[k] -= w[k]*d*d;
+        }
+    }
+
+    /**
+     For k in [0 n), computes y[k] += a * x[k].
+     */
+    static inline void multiplyAdd(const double a,const double *x,double *y,const UINT n){
+        UINT k = 0;
+#ifdef GRT_USE_SSE2
+        const __m128d va = _mm_set1_pd(a);
+        for(; k+4<=n; k+=4){
+            _mm_storeu_pd(y+k,_mm_add_pd(_mm_loadu_pd(y+k),_mm_mul_pd(va,_mm_loadu_pd(x+k))));
+            _mm_storeu_pd(y+k+2,_mm_add_pd(_mm_loadu_pd(y+k+2),_mm_mul_pd(va,_mm_loadu_pd(x+k+2))));
+        }
+#endif
+        for(; k<n; k++) y[k] += a*x[k];
+    }
+
+    /**
+     For k in [0 n), computes the momentum update u = a * update[k] + b * gradient[k], then sets update[k] = u and adds u to weights[k].
+     */
+    static inline void momentumUpdate(const double a,double *update,const double b,const double *gradient,double *weights,const UINT n){
+        UINT k = 0;
+#ifdef GRT_USE_SSE2
+        const __m128d va = _mm_set1_pd(a);
+        const __m128d vb = _mm_set1_pd(b);
+        for(; k+2<=n; k+=2){
+            __m128d u = _mm_add_pd(_mm_mul_pd(va,_mm_loadu_pd(update+k)),_mm_mul_pd(vb,_mm_loadu_pd(gradient+k)));
+            _mm_storeu_pd(update+k,u);
+            _mm_storeu_pd(weights+k,_mm_add_pd(_mm_loadu_pd(weights+k),u));
+        }
+#endif
+        for(; k<n; k++){
+            const double u = a*update[k] + b*gradient[k];
+            update[k] = u;
+            weights[k] += u;
+        }
+    }
+
+    /**
+     For k in [0 n), applies the plane rotation (x[k], y[k]) = (c * x[k] + s * y[k], c * y[k] - s * x[k]).
+     This is the Givens rotation used by the SVD and eigenvalue decompositions, applied to two rows at once.
+     */
+    static inline void rotate(const double c,const double s,double *x,double *y,const UINT n){
+        UINT k = 0;
+#ifdef GRT_USE_SSE2
+        const __m128d vc = _mm_set1_pd(c);
+        const __m128d vs = _mm_set1_pd(s);
+        for(; k+2<=n; k+=2){
+            const __m128d vx = _mm_loadu_pd(x+k);
+            const __m128d vy = _mm_loadu_pd(y+k);
+            _mm_storeu_pd(x+k,_mm_add_pd(_mm_mul_pd(vx,vc),_mm_mul_pd(vy,vs)));
+            _mm_storeu_pd(y+k,_mm_sub_pd(_mm_mul_pd(vy,vc),_mm_mul_pd(vx,vs)));
+        }
+#endif
+        for(; k<n; k++){
+            const double xk = x[k];
+            const double yk = y[k];
+            x[k] = xk*c + yk*s;
+            y[k] = yk*c - xk*s;
+        }
+    }
+
+    /**
+     Computes C = A * B', where A is an [m k] row-major matrix, B is an [n k] row-major matrix and C is an [m n] row-major matrix.
+     Every element of C is the dot product of two contiguous rows, and the rows of B are processed in blocks that fit in the
+     L1 cache so each block is reused by all the rows of A before it is evicted.
+     */
+    static inline void multiplyTransposed(const double *A,const UINT m,const UINT k,const double *B,const UINT n,double *C){
+        const UINT blockSize = getBlockSize( k );
+        for(UINT jb=0; jb<n; jb+=blockSize){
+            const UINT je = jb+blockSize < n ? jb+blockSize : n;
+            for(UINT i=0; i<m; i++){
+                const double *a = A + i*k;
+                double *c = C + i*n;
+                for(UINT j=jb; j<je; j++){
+                    c[j] = dot(a,B+j*k,k);
+                }
+            }
+        }
+    }
+
+    /**
+     Computes C = A * B, where A is an [m k] row-major matrix, B is a [k n] row-major matrix and C is an [m n] row-major matrix.
+     */
+    static inline void multiply(const double *A,const UINT m,const UINT k,const double *B,const UINT n,double *C){
+        for(UINT i=0; i<m; i++){
+            const double *a = A + i*k;
+            double *c = C + i*n;
+            for(UINT j=0; j<n; j++) c[j] = 0;
+            for(UINT p=0; p<k; p++){
+                multiplyAdd(a[p],B+p*n,c,n);
+            }
+        }
+    }
+
+protected:
+    /**
+     Gets the number of rows of length k that fit in 16KB, which leaves half of a typical L1 cache for the other operands.
+     */
+    static inline UINT getBlockSize(const UINT k){
+        const UINT blockSize = k > 0 ? 2048 / k : 2048;
+        return blockSize > 0 ? blockSize : 1;
+    }
+
+#ifdef GRT_USE_SSE2
+    static inline double horizontalSum(__m128d v){
+        double t[2];
+        _mm_storeu_pd(t,v);
+        return t[0] + t[1];
+    }
+#endif
+};
+
+}; //End of namespace GRT
+
+#endif //GRT_SIMD_HEADER
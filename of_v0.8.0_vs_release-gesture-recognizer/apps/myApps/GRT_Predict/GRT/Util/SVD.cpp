@@ -18,6 +18,7 @@
  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "SVD.h"
+#include "SIMD.h"
 
 namespace GRT{
 	
@@ -120,9 +121,10 @@ double SVD::inv_condition() {
 
 bool SVD::decompose() {
 	bool flag;
-	int i,its,j,jj,k,l,nm,N,M;
+	int i,its,j,k,l,nm,N,M;
 	double anorm,c,f,g,h,s,scale,x,y,z;
 	vector <double> rv1(n);
+	vector <double> work(n);
 	g = scale = anorm = 0.0;
 	N = int(n);
 	M = int(m);
@@ -142,11 +144,11 @@ bool SVD::decompose() {
 				g = -SIGN(sqrt(s),f);
 				h=f*g-s;
 				u[i][i]=f-g;
-				for (j=l-1;j<N;j++) {
-					for (s=0.0,k=i;k<M;k++) s += u[k][i] * u[k][j];
-					f=s/h;
-					for (k=i;k<M;k++) u[k][j] += f * u[k][i];
-				}
+				//Apply the reflection to the remaining columns, a row at a time so the rows of u are read contiguously
+				for (j=l-1;j<N;j++) work[j]=0.0;
+				for (k=i;k<M;k++) SIMD::multiplyAdd(u[k][i],u[k]+l-1,&work[l-1],N-l+1);
+				for (j=l-1;j<N;j++) work[j] /= h;
+				for (k=i;k<M;k++) SIMD::multiplyAdd(u[k][i],&work[l-1],u[k]+l-1,N-l+1);
 				for (k=i;k<M;k++) u[k][i] *= scale; 
 			}
 		}
@@ -165,8 +167,8 @@ bool SVD::decompose() {
 				u[i][l-1]=f-g;
 				for (k=l-1;k<N;k++) rv1[k]=u[i][k]/h;
 				for (j=l-1;j<M;j++) {
-					for (s=0.0,k=l-1;k<N;k++) s += u[j][k]*u[i][k];
-					for (k=l-1;k<N;k++) u[j][k] += s*rv1[k];
+					s = SIMD::dot(u[j]+l-1,u[i]+l-1,N-l+1);
+					SIMD::multiplyAdd(s,&rv1[l-1],u[j]+l-1,N-l+1);
 				}
 				for (k=l-1;k<N;k++) u[i][k]*= scale;
 			}
@@ -178,10 +180,9 @@ bool SVD::decompose() {
 			if (g != 0.0) {
 				for (j=l;j<N;j++)
 					v[j][i]=u[i][j]/u[i][l]/g;
-				for (j=l;j<N;j++) {
-					for (s=0.0,k=l;k<N;k++) s += u[i][k]*v[k][j];
-					for (k=l;k<N;k++) v[k][j] += s*v[k][i];
-				}
+				for (j=l;j<N;j++) work[j]=0.0;
+				for (k=l;k<N;k++) SIMD::multiplyAdd(u[i][k],v[k]+l,&work[l],N-l);
+				for (k=l;k<N;k++) SIMD::multiplyAdd(v[k][i],&work[l],v[k]+l,N-l);
 			}
 			for (j=l;j<N;j++) v[i][j]=v[j][i]=0.0;
 		}
@@ -195,15 +196,22 @@ bool SVD::decompose() {
 		for (j=l;j<N;j++) u[i][j]=0.0;
 		if (g != 0.0) {
 			g=1.0/g;
-			for (j=l;j<N;j++) {
-				for (s=0.0,k=l;k<M;k++) s += u[k][i]*u[k][j];
-				f=(s/u[i][i])*g;
-				for (k=i;k<M;k++) u[k][j] += f*u[k][i];
-			}
+			for (j=l;j<N;j++) work[j]=0.0;
+			for (k=l;k<M;k++) SIMD::multiplyAdd(u[k][i],u[k]+l,&work[l],N-l);
+			for (j=l;j<N;j++) work[j]=(work[j]/u[i][i])*g;
+			for (k=i;k<M;k++) SIMD::multiplyAdd(u[k][i],&work[l],u[k]+l,N-l);
 			for (j=i;j<M;j++) u[j][i] *= g;
 		} else for (j=i;j<M;j++) u[j][i] =0.0;
 		++u[i][i];
 	}
+	
+	//The rotations of the QR iterations are applied to pairs of columns of u and v, so they are applied to the transposes
+	//of u and v instead, where each column is a contiguous row
+	Matrix< double > ut(N,M);
+	Matrix< double > vt(N,N);
+	for (i=0;i<M;i++) for (j=0;j<N;j++) ut[j][i]=u[i][j];
+	for (i=0;i<N;i++) for (j=0;j<N;j++) vt[j][i]=v[i][j];
+	
 	for (k=N-1;k>=0;k--) {
 		for (its=0;its<MAX_NUM_SVD_ITER;its++) {
 			flag=true;
@@ -228,23 +236,20 @@ bool SVD::decompose() {
 					h=1.0/h;
 					c=g*h;
 					s = -f*h;
-					for (j=0;j<M;j++) {
-						y=u[j][nm];
-						z=u[j][i];
-						u[j][nm]=y*c+z*s;
-						u[j][i]=z*c-y*s;
-					}
+					SIMD::rotate(c,s,ut[nm],ut[i],M);
 				}
 			}
 			z=w[k];
 			if (l == k) {
 				if (z < 0.0) {
 					w[k] = -z;
-					for (j=0;j<N;j++) v[j][k] = -v[j][k];
+					for (j=0;j<N;j++) vt[k][j] = -vt[k][j];
 				}
 				break;
 			}
 			if (its == MAX_NUM_SVD_ITER-1){
+				for (i=0;i<M;i++) for (j=0;j<N;j++) u[i][j]=ut[j][i];
+				for (i=0;i<N;i++) for (j=0;j<N;j++) v[i][j]=vt[j][i];
 				return false;
 			}
 			x=w[l];
@@ -270,12 +275,7 @@ bool SVD::decompose() {
 				g=g*c-x*s;
 				h=y*s;
 				y *= c;
-				for (jj=0;jj<N;jj++) {
-					x=v[jj][j];
-					z=v[jj][i];
-					v[jj][j]=x*c+z*s;
-					v[jj][i]=z*c-x*s;
-				}
+				SIMD::rotate(c,s,vt[j],vt[i],N);
 				z=pythag(f,h);
 				w[j]=z;
 				if (z) {
@@ -285,12 +285,7 @@ bool SVD::decompose() {
 				}
 				f=c*g+s*y;
 				x=c*y-s*g;
-				for (jj=0;jj<M;jj++) {
-					y=u[jj][j];
-					z=u[jj][i];
-					u[jj][j]=y*c+z*s;
-					u[jj][i]=z*c-y*s;
-				}
+				SIMD::rotate(c,s,ut[j],ut[i],M);
 			}
 			rv1[l]=0.0;
 			rv1[k]=f;
@@ -298,6 +293,9 @@ bool SVD::decompose() {
 		}
 	}
 	
+	for (i=0;i<M;i++) for (j=0;j<N;j++) u[i][j]=ut[j][i];
+	for (i=0;i<N;i++) for (j=0;j<N;j++) v[i][j]=vt[j][i];
+	
 	return true;
 }
 
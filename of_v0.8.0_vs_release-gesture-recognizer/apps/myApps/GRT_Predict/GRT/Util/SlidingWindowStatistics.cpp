@@ -0,0 +1,209 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SlidingWindowStatistics.h"
+
+namespace GRT{
+
+SlidingWindowStatistics::SlidingWindowStatistics(UINT windowSize,UINT numDimensions,UINT numSegments){
+    errorLog.setProceedingText("[ERROR SlidingWindowStatistics]");
+    initialized = false;
+    this->windowSize = 0;
+    this->numDimensions = 0;
+    this->numSegments = 0;
+    segmentSize = 0;
+    numValuesInWindow = 0;
+    numUpdatesSinceAnchor = 0;
+
+    if( windowSize > 0 && numDimensions > 0 ){
+        init(windowSize,numDimensions,numSegments);
+    }
+}
+
+SlidingWindowStatistics::SlidingWindowStatistics(const SlidingWindowStatistics &rhs){
+    *this = rhs;
+}
+
+SlidingWindowStatistics::~SlidingWindowStatistics(){}
+
+SlidingWindowStatistics& SlidingWindowStatistics::operator=(const SlidingWindowStatistics &rhs){
+    if( this != &rhs ){
+        this->initialized = rhs.initialized;
+        this->windowSize = rhs.windowSize;
+        this->numDimensions = rhs.numDimensions;
+        this->numSegments = rhs.numSegments;
+        this->segmentSize = rhs.segmentSize;
+        this->numValuesInWindow = rhs.numValuesInWindow;
+        this->numUpdatesSinceAnchor = rhs.numUpdatesSinceAnchor;
+        this->anchor = rhs.anchor;
+        this->sums = rhs.sums;
+        this->squaredSums = rhs.squaredSums;
+        this->errorLog = rhs.errorLog;
+
+        //The CircularBuffer only copies the values that have been pushed into it, so the zeros that fill the rest of the window
+        //are copied here as well
+        this->buffer = rhs.buffer;
+        for(UINT i=0; i<rhs.buffer.getSize(); i++){
+            this->buffer(i) = rhs.buffer(i);
+        }
+    }
+    return *this;
+}
+
+bool SlidingWindowStatistics::init(UINT windowSize,UINT numDimensions,UINT numSegments){
+
+    initialized = false;
+
+    if( windowSize == 0 || numDimensions == 0 || numSegments == 0 ){
+        errorLog << "init(UINT windowSize,UINT numDimensions,UINT numSegments) - The window size, number of dimensions and number of segments must be greater than zero!" << endl;
+        return false;
+    }
+
+    if( windowSize % numSegments != 0 ){
+        errorLog << "init(UINT windowSize,UINT numDimensions,UINT numSegments) - The window size must be divisible by the number of segments!" << endl;
+        return false;
+    }
+
+    this->windowSize = windowSize;
+    this->numDimensions = numDimensions;
+    this->numSegments = numSegments;
+    segmentSize = windowSize / numSegments;
+    initialized = true;
+
+    return reset();
+}
+
+bool SlidingWindowStatistics::reset(){
+
+    if( !initialized ) return false;
+
+    buffer.resize( windowSize, VectorDouble(numDimensions,0) );
+    anchor.clear();
+    anchor.resize(numDimensions,0);
+    sums.clear();
+    sums.resize(numSegments*numDimensions,0);
+    squaredSums.clear();
+    squaredSums.resize(numSegments*numDimensions,0);
+    numValuesInWindow = 0;
+    numUpdatesSinceAnchor = 0;
+
+    return true;
+}
+
+bool SlidingWindowStatistics::push_back(const VectorDouble &x){
+
+    if( !initialized ){
+        errorLog << "push_back(const VectorDouble &x) - Not initialized!" << endl;
+        return false;
+    }
+
+    if( x.size() != numDimensions ){
+        errorLog << "push_back(const VectorDouble &x) - The size of the input vector (" << x.size() << ") does not match the number of dimensions (" << numDimensions << ")!" << endl;
+        return false;
+    }
+
+    return push_back( &x[0] );
+}
+
+bool SlidingWindowStatistics::push_back(const double *x){
+
+    if( !initialized ){
+        errorLog << "push_back(const double *x) - Not initialized!" << endl;
+        return false;
+    }
+
+    if( x == NULL ){
+        errorLog << "push_back(const double *x) - The input pointer is NULL!" << endl;
+        return false;
+    }
+
+    if( numValuesInWindow < windowSize ){
+        //The window is filled from the front, so the new vector replaces the zero at the next free position
+        const VectorDouble &oldValue = buffer[ numValuesInWindow ];
+        double *segmentSums = &sums[ (numValuesInWindow/segmentSize)*numDimensions ];
+        double *segmentSquaredSums = &squaredSums[ (numValuesInWindow/segmentSize)*numDimensions ];
+        for(UINT j=0; j<numDimensions; j++){
+            const double o = oldValue[j] - anchor[j];
+            const double v = x[j] - anchor[j];
+            segmentSums[j] += v - o;
+            segmentSquaredSums[j] += v*v - o*o;
+        }
+        numValuesInWindow++;
+    }else{
+        //The oldest vector of each segment moves into the previous segment, the oldest vector of the first segment leaves the
+        //window and the new vector joins the last segment
+        for(UINT s=0; s<numSegments; s++){
+            const VectorDouble &outgoing = buffer[ s*segmentSize ];
+            const double *incoming = s+1 < numSegments ? &buffer[ (s+1)*segmentSize ][0] : x;
+            double *segmentSums = &sums[ s*numDimensions ];
+            double *segmentSquaredSums = &squaredSums[ s*numDimensions ];
+            for(UINT j=0; j<numDimensions; j++){
+                const double o = outgoing[j] - anchor[j];
+                const double v = incoming[j] - anchor[j];
+                segmentSums[j] += v - o;
+                segmentSquaredSums[j] += v*v - o*o;
+            }
+        }
+    }
+
+    //Copy the new vector into the slot the buffer will write to next, so the buffer does not need a temporary vector
+    VectorDouble &slot = buffer( buffer.getWritePointerPosition() );
+    for(UINT j=0; j<numDimensions; j++){
+        slot[j] = x[j];
+    }
+    buffer.push_back( slot );
+
+    //Recompute the sums from the window every windowSize updates, so rounding errors can not build up
+    if( ++numUpdatesSinceAnchor >= windowSize ){
+        anchorSums();
+    }
+
+    return true;
+}
+
+void SlidingWindowStatistics::anchorSums(){
+
+    numUpdatesSinceAnchor = 0;
+
+    //Move the anchor to the mean of the window, so the sums of squares are of small numbers
+    for(UINT j=0; j<numDimensions; j++) anchor[j] = 0;
+    for(UINT i=0; i<windowSize; i++){
+        const VectorDouble &value = buffer[i];
+        for(UINT j=0; j<numDimensions; j++) anchor[j] += value[j];
+    }
+    for(UINT j=0; j<numDimensions; j++) anchor[j] /= windowSize;
+
+    for(UINT k=0; k<sums.size(); k++){
+        sums[k] = 0;
+        squaredSums[k] = 0;
+    }
+    for(UINT i=0; i<windowSize; i++){
+        const VectorDouble &value = buffer[i];
+        double *segmentSums = &sums[ (i/segmentSize)*numDimensions ];
+        double *segmentSquaredSums = &squaredSums[ (i/segmentSize)*numDimensions ];
+        for(UINT j=0; j<numDimensions; j++){
+            const double v = value[j] - anchor[j];
+            segmentSums[j] += v;
+            segmentSquaredSums[j] += v*v;
+        }
+    }
+}
+
+} //End of namespace GRT
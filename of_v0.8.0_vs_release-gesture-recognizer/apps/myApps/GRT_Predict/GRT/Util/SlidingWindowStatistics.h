@@ -0,0 +1,229 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The SlidingWindowStatistics class keeps a sliding window of the last N input vectors (in a CircularBuffer) together with the
+ running sum and sum of squares of each dimension, so the mean, variance, energy, etc. of the window can be read in constant
+ time instead of being recomputed from the whole window for every new sample. It is used by the moving average filters and
+ the windowed feature extraction modules.
+
+ The window can be split into a number of equal segments (the frames used by the TimeDomainFeatures for example), in which
+ case the sums are kept for each segment. When a new vector is added, the oldest vector of each segment moves into the
+ previous segment, so the cost of adding a vector is O(numSegments * numDimensions) regardless of the window size, and
+ nothing is allocated after the init function has been called.
+
+ The window starts filled with zeros (in the same way as the CircularBuffer), the first N vectors fill the window from the
+ front, after which each new vector is added to the back of the window and the oldest vector is removed from the front.
+
+ Running sums of squares lose precision when the mean of the data is large compared to its spread, and slowly drift as values
+ are added and removed. To avoid this, the sums are kept relative to an anchor (the mean of the window) and are recomputed
+ exactly from the window every N vectors, which costs O(numDimensions) per vector on average.
+ */
+
+#ifndef GRT_SLIDING_WINDOW_STATISTICS_HEADER
+#define GRT_SLIDING_WINDOW_STATISTICS_HEADER
+
+#include "GRTTypedefs.h"
+#include "CircularBuffer.h"
+
+namespace GRT{
+
+class SlidingWindowStatistics{
+public:
+    /**
+     Default Constructor.
+
+     @param UINT windowSize: the number of vectors in the window. Default value = 0 (the instance must then be initialized with init)
+     @param UINT numDimensions: the size of each vector. Default value = 0
+     @param UINT numSegments: the number of segments the window is split into, the window size must be divisible by this. Default value = 1
+     */
+    SlidingWindowStatistics(UINT windowSize=0,UINT numDimensions=0,UINT numSegments=1);
+
+    /**
+     Copy Constructor, copies the window (including the values that have not been replaced yet) from the rhs instance.
+     */
+    SlidingWindowStatistics(const SlidingWindowStatistics &rhs);
+
+    /**
+     Default Destructor.
+     */
+    ~SlidingWindowStatistics();
+
+    /**
+     Sets the equals operator, copies the window (including the values that have not been replaced yet) from the rhs instance.
+     */
+    SlidingWindowStatistics& operator=(const SlidingWindowStatistics &rhs);
+
+    /**
+     Initializes the window, all the values in the window will be set to zero.
+
+     @param UINT windowSize: the number of vectors in the window, must be greater than zero
+     @param UINT numDimensions: the size of each vector, must be greater than zero
+     @param UINT numSegments: the number of segments the window is split into, the window size must be divisible by this
+     @return returns true if the window was initialized, false otherwise
+     */
+    bool init(UINT windowSize,UINT numDimensions,UINT numSegments=1);
+
+    /**
+     Sets all the values in the window (and the sums) back to zero.
+
+     @return returns true if the window was reset, false if the window has not been initialized
+     */
+    bool reset();
+
+    /**
+     Adds a new vector to the window, removing the oldest vector if the window is full.
+
+     @param const VectorDouble &x: the new vector, this must have numDimensions elements
+     @return returns true if the vector was added, false otherwise
+     */
+    bool push_back(const VectorDouble &x);
+
+    /**
+     Adds a new vector to the window, removing the oldest vector if the window is full.
+
+     @param const double *x: the new vector, this must point to numDimensions values
+     @return returns true if the vector was added, false otherwise
+     */
+    bool push_back(const double *x);
+
+    /**
+     Gets the sum of (x - offset) and the sum of (x - offset)^2 over one segment of the window, for one dimension.
+     These are computed from the running sums, so the offset (the first value in the window for example) can change for each
+     call without having to revisit the values in the window.
+
+     @param UINT segment: the index of the segment, where 0 is the oldest segment
+     @param UINT dimension: the index of the dimension
+     @param double offset: the value subtracted from each value in the segment
+     @param double &sum: returns the sum of (x - offset)
+     @param double &sumSquares: returns the sum of (x - offset)^2
+     */
+    inline void getMoments(const UINT segment,const UINT dimension,const double offset,double &sum,double &sumSquares) const{
+        const UINT index = segment*numDimensions + dimension;
+        const double d = offset - anchor[ dimension ];
+        const double n = segmentSize;
+        sum = sums[ index ] - n*d;
+        sumSquares = squaredSums[ index ] - 2*d*sums[ index ] + n*d*d;
+        if( sumSquares < 0 ) sumSquares = 0;
+    }
+
+    /**
+     Gets the mean of the values in one segment of the window for one dimension.
+
+     @param UINT segment: the index of the segment, where 0 is the oldest segment
+     @param UINT dimension: the index of the dimension
+     @return returns the mean of the values in the segment
+     */
+    inline double getSegmentMean(const UINT segment,const UINT dimension) const{
+        return sums[ segment*numDimensions + dimension ] / segmentSize + anchor[ dimension ];
+    }
+
+    /**
+     Gets the sum of the values in the whole window for one dimension.
+
+     @param UINT dimension: the index of the dimension
+     @return returns the sum of the values in the window
+     */
+    inline double getSum(const UINT dimension) const{
+        double sum = 0;
+        for(UINT s=0; s<numSegments; s++) sum += sums[ s*numDimensions + dimension ];
+        return sum + windowSize*anchor[ dimension ];
+    }
+
+    /**
+     Gets the mean of the values in the whole window for one dimension (including any zeros that have not been replaced yet).
+
+     @param UINT dimension: the index of the dimension
+     @return returns the mean of the values in the window
+     */
+    inline double getMean(const UINT dimension) const{
+        return getSum( dimension ) / windowSize;
+    }
+
+    /**
+     Gets the (population) variance of the values in the whole window for one dimension.
+
+     @param UINT dimension: the index of the dimension
+     @return returns the variance of the values in the window
+     */
+    inline double getVariance(const UINT dimension) const{
+        double sum = 0;
+        double sumSquares = 0;
+        for(UINT s=0; s<numSegments; s++){
+            sum += sums[ s*numDimensions + dimension ];
+            sumSquares += squaredSums[ s*numDimensions + dimension ];
+        }
+        const double mean = sum / windowSize;
+        const double variance = sumSquares / windowSize - mean*mean;
+        return variance > 0 ? variance : 0;
+    }
+
+    /**
+     Gets a vector from the window, where index 0 is the oldest vector.
+     */
+    inline const VectorDouble& operator[](const UINT index) const{
+        return buffer[ index ];
+    }
+
+    bool getInitialized() const{ return initialized; }
+    bool getBufferFilled() const{ return buffer.getBufferFilled(); }
+    UINT getWindowSize() const{ return windowSize; }
+    UINT getNumDimensions() const{ return numDimensions; }
+    UINT getNumSegments() const{ return numSegments; }
+    UINT getSegmentSize() const{ return segmentSize; }
+
+    /**
+     Gets the number of vectors that have been added to the window, this is capped at the window size.
+
+     @return returns the number of vectors in the window
+     */
+    UINT getNumValuesInWindow() const{ return numValuesInWindow; }
+
+    /**
+     Gets the circular buffer holding the values in the window.
+
+     @return returns a reference to the buffer
+     */
+    const CircularBuffer< VectorDouble >& getBuffer() const{ return buffer; }
+
+protected:
+    void anchorSums();
+
+    bool initialized;
+    UINT windowSize;
+    UINT numDimensions;
+    UINT numSegments;
+    UINT segmentSize;
+    UINT numValuesInWindow;
+    UINT numUpdatesSinceAnchor;
+    CircularBuffer< VectorDouble > buffer;
+    VectorDouble anchor;                    //The value each dimension's sums are relative to
+    VectorDouble sums;                      //The sum of (x - anchor) for each segment and dimension
+    VectorDouble squaredSums;               //The sum of (x - anchor)^2 for each segment and dimension
+    ErrorLog errorLog;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_SLIDING_WINDOW_STATISTICS_HEADER
@@ -34,7 +34,7 @@ bool GRT_Recognizer::initPipeline(string trainingdatafile, int dimension)
     //Turn on null rejection, this lets the classifier output the predicted class label of 0 when the likelihood of a gesture is low
     dtw.enableNullRejection( true);
     
-    //Set the null rejection coefficient to 3, this controls the thresholds for the automatic null rejection
+    //Set the null rejection coefficient to 2, this controls the thresholds for the automatic null rejection
     //You can increase this value if you find that your real-time gestures are not being recognized
     //If you are getting too many false positives then you should decrease this value
     dtw.setNullRejectionCoeff(2);
@@ -47,8 +47,12 @@ bool GRT_Recognizer::initPipeline(string trainingdatafile, int dimension)
     dtw.setOffsetTimeseriesUsingFirstSample(true);
   
 
-    //Add the classifier to the pipeline (after we do this, we don't need the DTW classifier anymore)
-    pipeline.setClassifier( dtw );
+    //Only evaluate the DTW templates of the 2 classes the (much faster) first stage classifier ranks highest
+    CascadeDTW cascade(2);
+    cascade.setDTW( dtw );
+
+    //Add the classifier to the pipeline (after we do this, we don't need the DTW or cascade classifiers anymore)
+    pipeline.setClassifier( cascade );
 	//pipeline.addPreProcessingModule(MovingAverageFilter(5,dimension));
 	//pipeline.addFeatureExtractionModule(FFT(16,1, dimension));
 	/*ClassLabelFilter myFilter = ClassLabelFilter();
@@ -56,6 +60,23 @@ bool GRT_Recognizer::initPipeline(string trainingdatafile, int dimension)
 	myFilter.setBufferSize(2);*/
 
 	pipeline.addPostProcessingModule(ClassLabelChangeFilter());
+
+	//Report the shortlist recall for each shortlist size, so the shortlist size can be tuned. The recall is measured on 20% of the
+	//training data, held out from a copy of the cascade that is only used for this, the pipeline is still trained with all the data
+	TrainingLog trainingLog("[GRT_Recognizer]");
+	LabelledTimeSeriesClassificationData validationTrainingData = trainingData;
+	LabelledTimeSeriesClassificationData validationData = validationTrainingData.partition(80,true);
+	CascadeDTW validationCascade = cascade;
+	if( validationData.getNumSamples() > 0 && validationCascade.train( validationTrainingData ) ){
+		for(UINT k=1; k<=validationCascade.getNumClasses(); k++){
+			double recall = 0;
+			validationCascade.setShortlistSize( k );
+			if( validationCascade.computeShortlistRecall( validationData, recall ) ){
+				trainingLog << "Shortlist size " << k << ": shortlist recall " << recall << endl;
+			}
+		}
+	}
+
 	pipeline.train(trainingData);
 
 	return true;